@@ -36,11 +36,15 @@
 #define CACHE_ALT_REMOVED       -2
 
 static const uint8_t CACHE_DB_MAJOR_VERSION = 24;
-static const uint8_t CACHE_DB_MINOR_VERSION = 2;
+static const uint8_t CACHE_DB_MINOR_VERSION = 3;
 // This is used in various comparisons because otherwise if the minor version is 0,
 // the compile fails because the condition is always true or false. Running it through
 // VersionNumber prevents that.
 extern const ts::VersionNumber CACHE_DB_VERSION;
+// Docs before this version have alternates in the older marshalled format, see HTTPInfo::unmarshal_v24_1.
+extern const ts::VersionNumber CACHE_DB_VERSION_HTTPINFO;
+// Docs before this version have the byte sum checksum, see DOC_FLAG_CRC32C.
+extern const ts::VersionNumber CACHE_DB_VERSION_CRC32C;
 
 static const uint8_t CACHE_DIR_MAJOR_VERSION = 18;
 static const uint8_t CACHE_DIR_MINOR_VERSION = 0;
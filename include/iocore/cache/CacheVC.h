@@ -154,6 +154,7 @@ struct CacheVC : public CacheVConnection {
   int openReadFromWriterMain(int event, Event *e);
   int openReadFromWriterFailure(int event, Event *);
   int openReadChooseWriter(int event, Event *e);
+  int openReadWaitForWriter(OpenDirEntry *cod);
   int openReadDirDelete(int event, Event *e);
 
   int openWriteCloseDir(int event, Event *e);
@@ -301,7 +302,7 @@ struct CacheVC : public CacheVConnection {
       unsigned int update                  : 1;
       unsigned int remove                  : 1;
       unsigned int remove_aborted_writers  : 1;
-      unsigned int open_read_timeout       : 1; // UNUSED
+      unsigned int open_read_timeout       : 1; // waiting on OpenDirEntry::readers
       unsigned int data_done               : 1;
       unsigned int read_from_writer_called : 1;
       unsigned int not_from_ram_cache      : 1; // entire object was from ram cache
@@ -311,6 +312,7 @@ struct CacheVC : public CacheVConnection {
       unsigned int hit_evacuate            : 1;
       unsigned int compressed_in_ram       : 1; // compressed state in ram cache
       unsigned int allow_empty_doc         : 1; // used for cache empty http document
+      unsigned int admission_retry         : 1; // already counted by admission, see CACHE_WRITE_OPT_RETRY
     } f;
   };
   // BTF optimization used to skip reading stuff in cache partition that doesn't contain any
@@ -46,6 +46,7 @@ struct EventIO;
 
 class ServerSessionPool;
 class PreWarmQueue;
+class HttpMilestoneHistograms;
 
 class Event;
 class Continuation;
@@ -364,9 +365,10 @@ public:
   */
   Event *start_event = nullptr;
 
-  ServerSessionPool *server_session_pool = nullptr;
-  PreWarmQueue      *prewarm_queue       = nullptr;
-  ConnectingPool    *connecting_pool     = nullptr;
+  ServerSessionPool       *server_session_pool  = nullptr;
+  PreWarmQueue            *prewarm_queue        = nullptr;
+  ConnectingPool          *connecting_pool      = nullptr;
+  HttpMilestoneHistograms *milestone_histograms = nullptr;
 
   /** Default handler used until it is overridden.
 
@@ -23,9 +23,12 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "tscore/ink_platform.h"
 #include "tscore/Diags.h"
 #include "iocore/eventsystem/Thread.h"
+#include "iocore/eventsystem/LockProfiler.h"
 
 #define MAX_LOCK_TIME               HRTIME_MSECONDS(200)
 #define THREAD_MUTEX_THREAD_HOLDING (-1024 * 1024)
@@ -53,13 +56,13 @@
 #ifdef DEBUG
 #define WEAK_SCOPED_MUTEX_LOCK(_l, _m, _t) WeakMutexLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t);
 #else // DEBUG
-#define WEAK_SCOPED_MUTEX_LOCK(_l, _m, _t) WeakMutexLock _l(_m, _t);
+#define WEAK_SCOPED_MUTEX_LOCK(_l, _m, _t) WeakMutexLock _l(MakeSourceLocation(), _m, _t);
 #endif // DEBUG
 
 #ifdef DEBUG
 #define SCOPED_MUTEX_LOCK(_l, _m, _t) MutexLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t)
 #else // DEBUG
-#define SCOPED_MUTEX_LOCK(_l, _m, _t) MutexLock _l(_m, _t)
+#define SCOPED_MUTEX_LOCK(_l, _m, _t) MutexLock _l(MakeSourceLocation(), _m, _t)
 #endif // DEBUG
 
 /**
@@ -79,13 +82,13 @@
 #ifdef DEBUG
 #define WEAK_MUTEX_TRY_LOCK(_l, _m, _t) WeakMutexTryLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t);
 #else // DEBUG
-#define WEAK_MUTEX_TRY_LOCK(_l, _m, _t) WeakMutexTryLock _l(_m, _t);
+#define WEAK_MUTEX_TRY_LOCK(_l, _m, _t) WeakMutexTryLock _l(MakeSourceLocation(), _m, _t);
 #endif // DEBUG
 
 #ifdef DEBUG
 #define MUTEX_TRY_LOCK(_l, _m, _t) MutexTryLock _l(MakeSourceLocation(), (char *)nullptr, _m, _t)
 #else // DEBUG
-#define MUTEX_TRY_LOCK(_l, _m, _t) MutexTryLock _l(_m, _t)
+#define MUTEX_TRY_LOCK(_l, _m, _t) MutexTryLock _l(MakeSourceLocation(), _m, _t)
 #endif // DEBUG
 
 /**
@@ -107,13 +110,13 @@
 #ifdef DEBUG
 #define MUTEX_TAKE_TRY_LOCK(_m, _t) Mutex_trylock(MakeSourceLocation(), (char *)nullptr, _m, _t)
 #else
-#define MUTEX_TAKE_TRY_LOCK(_m, _t) Mutex_trylock(_m, _t)
+#define MUTEX_TAKE_TRY_LOCK(_m, _t) Mutex_trylock(MakeSourceLocation(), _m, _t)
 #endif
 
 #ifdef DEBUG
 #define MUTEX_TAKE_LOCK(_m, _t) Mutex_lock(MakeSourceLocation(), (char *)nullptr, _m, _t)
 #else
-#define MUTEX_TAKE_LOCK(_m, _t) Mutex_lock(_m, _t)
+#define MUTEX_TAKE_LOCK(_m, _t) Mutex_lock(MakeSourceLocation(), _m, _t)
 #endif // DEBUG
 
 #define MUTEX_UNTAKE_LOCK(_m, _t) Mutex_unlock(_m, _t)
@@ -121,6 +124,8 @@
 /////////////////////////////////////
 
 class EThread;
+class Event;
+class Continuation;
 using EThreadPtr = EThread *;
 
 #if DEBUG
@@ -179,6 +184,37 @@ public:
 
   int nthread_holding;
 
+  /**
+    Enable waiting for the release of this mutex.
+
+    Set by the creator of the mutex before it is shared. If set, a
+    continuation that fails to get the lock can call wait_for_release()
+    rather than retry on a timer, and each release checks for waiters.
+    This costs a fence on every release, so it is only worth it for
+    contended mutexes.
+
+  */
+  bool handoff = false;
+
+  /**
+    Events of the continuations waiting for the release of this mutex.
+
+    A stack linked through Event::link, pushed by wait_for_release()
+    and taken whole by wake_waiters().
+
+  */
+  std::atomic<Event *> waiters{nullptr};
+
+  /**
+    Site of the acquisition being timed by the LockProfiler, if any.
+
+    Set by LockProfiler::acquired() for a sampled acquisition, and
+    cleared when the holder releases the mutex.
+
+  */
+  LockProfiler::Slot *profile_slot  = nullptr;
+  ink_hrtime          profile_start = 0;
+
 #ifdef DEBUG
   ink_hrtime     hold_time;
   SourceLocation srcloc;
@@ -244,6 +280,39 @@ public:
   {
     ink_mutex_init(&the_mutex);
   }
+
+  /**
+    Schedule a continuation as soon as this mutex is released.
+
+    For a continuation that failed to get the lock, in place of
+    rescheduling itself after a fixed delay. The continuation is called
+    back on @a t with @a callback_event, like an event from
+    EThread::schedule_in(), so the latency is bounded by how long the
+    holder keeps the lock rather than by the retry delay. If the mutex
+    was released in the meantime the continuation is scheduled at once.
+    The mutex must have @a handoff set.
+
+    @param c The continuation to schedule.
+    @param t The current EThread, on which to schedule @a c.
+    @param callback_event The event code to pass to @a c.
+    @return The Event, which can be cancelled like any other.
+
+  */
+  Event *wait_for_release(Continuation *c, EThread *t, int callback_event);
+
+  /// Schedule all the waiters, called after a release if @a handoff is set.
+  void
+  wake_waiters()
+  {
+    // Order the release of the_mutex before the load, see wait_for_release().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed)) {
+      this->schedule_waiters();
+    }
+  }
+
+private:
+  void schedule_waiters();
 };
 
 // The ClassAllocator for ProxyMutexes
@@ -251,8 +320,9 @@ extern ClassAllocator<ProxyMutex> mutexAllocator;
 
 inline bool
 Mutex_trylock(
+  const SourceLocation &location,
 #ifdef DEBUG
-  const SourceLocation &location, const char *ahandler,
+  const char *ahandler,
 #endif
   ProxyMutex *m, EThread *t)
 {
@@ -260,6 +330,9 @@ Mutex_trylock(
   ink_assert(t == reinterpret_cast<EThread *>(this_thread()));
   if (m->thread_holding != t) {
     if (!ink_mutex_try_acquire(&m->the_mutex)) {
+      if (LockProfiler::is_enabled()) {
+        LockProfiler::missed(location);
+      }
 #ifdef DEBUG
       lock_waiting(m->srcloc, m->handler);
 #ifdef LOCK_CONTENTION_PROFILING
@@ -272,6 +345,9 @@ Mutex_trylock(
       return false;
     }
     m->thread_holding = t;
+    if (LockProfiler::is_enabled()) {
+      LockProfiler::acquired(m, location);
+    }
 #ifdef DEBUG
     m->srcloc    = location;
     m->handler   = ahandler;
@@ -295,28 +371,40 @@ Mutex_trylock(
 
 inline bool
 Mutex_trylock(
+  const SourceLocation &location,
 #ifdef DEBUG
-  const SourceLocation &location, const char *ahandler,
+  const char *ahandler,
 #endif
   Ptr<ProxyMutex> &m, EThread *t)
 {
   return Mutex_trylock(
+    location,
 #ifdef DEBUG
-    location, ahandler,
+    ahandler,
 #endif
     m.get(), t);
 }
 
 inline int
 Mutex_lock(
+  const SourceLocation &location,
 #ifdef DEBUG
-  const SourceLocation &location, const char *ahandler,
+  const char *ahandler,
 #endif
   ProxyMutex *m, EThread *t)
 {
   ink_assert(t != nullptr);
   if (m->thread_holding != t) {
-    ink_mutex_acquire(&m->the_mutex);
+    if (!LockProfiler::is_enabled()) {
+      ink_mutex_acquire(&m->the_mutex);
+    } else {
+      if (!ink_mutex_try_acquire(&m->the_mutex)) {
+        ink_hrtime start = ink_get_hrtime();
+        ink_mutex_acquire(&m->the_mutex);
+        LockProfiler::blocked(location, ink_get_hrtime() - start);
+      }
+      LockProfiler::acquired(m, location);
+    }
     m->thread_holding = t;
     ink_assert(m->thread_holding);
 #ifdef DEBUG
@@ -341,14 +429,16 @@ Mutex_lock(
 
 inline int
 Mutex_lock(
+  const SourceLocation &location,
 #ifdef DEBUG
-  const SourceLocation &location, const char *ahandler,
+  const char *ahandler,
 #endif
   Ptr<ProxyMutex> &m, EThread *t)
 {
   return Mutex_lock(
+    location,
 #ifdef DEBUG
-    location, ahandler,
+    ahandler,
 #endif
     m.get(), t);
 }
@@ -370,9 +460,15 @@ Mutex_unlock(ProxyMutex *m, EThread *t)
       m->srcloc  = SourceLocation(nullptr, nullptr, 0);
       m->handler = nullptr;
 #endif // DEBUG
+      if (m->profile_slot) {
+        LockProfiler::released(m);
+      }
       ink_assert(m->thread_holding);
       m->thread_holding = nullptr;
       ink_mutex_release(&m->the_mutex);
+      if (m->handoff) {
+        m->wake_waiters();
+      }
     }
   }
 }
@@ -393,16 +489,18 @@ public:
   WeakMutexLock() = default;
 
   WeakMutexLock(
+    const SourceLocation &location,
 #ifdef DEBUG
-    const SourceLocation &location, const char *ahandler,
+    const char *ahandler,
 #endif // DEBUG
     Ptr<ProxyMutex> &am, EThread *t)
     : m(am), locked_p(true)
   {
     if (m.get()) {
       Mutex_lock(
+        location,
 #ifdef DEBUG
-        location, ahandler,
+        ahandler,
 #endif // DEBUG
         m, t);
     }
@@ -446,15 +544,17 @@ public:
   MutexLock() = default;
 
   MutexLock(
+    const SourceLocation &location,
 #ifdef DEBUG
-    const SourceLocation &location, const char *ahandler,
+    const char *ahandler,
 #endif // DEBUG
     Ptr<ProxyMutex> &am, EThread *t)
     : m(am), locked_p(true)
   {
     Mutex_lock(
+      location,
 #ifdef DEBUG
-      location, ahandler,
+      ahandler,
 #endif // DEBUG
       m, t);
   }
@@ -497,16 +597,18 @@ public:
   WeakMutexTryLock() = default;
 
   WeakMutexTryLock(
+    const SourceLocation &location,
 #ifdef DEBUG
-    const SourceLocation &location, const char *ahandler,
+    const char *ahandler,
 #endif // DEBUG
     Ptr<ProxyMutex> &am, EThread *t)
     : m(am)
   {
     if (m.get()) {
       lock_acquired = Mutex_trylock(
+        location,
 #ifdef DEBUG
-        location, ahandler,
+        ahandler,
 #endif // DEBUG
         m, t);
     } else {
@@ -581,15 +683,17 @@ public:
   MutexTryLock() = default;
 
   MutexTryLock(
+    const SourceLocation &location,
 #ifdef DEBUG
-    const SourceLocation &location, const char *ahandler,
+    const char *ahandler,
 #endif // DEBUG
     Ptr<ProxyMutex> &am, EThread *t)
     : m(am)
   {
     lock_acquired = Mutex_trylock(
+      location,
 #ifdef DEBUG
-      location, ahandler,
+      ahandler,
 #endif // DEBUG
       m, t);
   }
@@ -654,6 +758,9 @@ ProxyMutex::free()
   print_lock_stats(1);
 #endif
 #endif
+  if (handoff) {
+    wake_waiters();
+  }
   ink_mutex_destroy(&the_mutex);
   mutexAllocator.free(this);
 }
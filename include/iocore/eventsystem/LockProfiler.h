@@ -0,0 +1,106 @@
+/** @file
+
+  Contention profile of ProxyMutex acquisitions
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "tscore/ink_hrtime.h"
+#include "tsutil/SourceLocation.h"
+
+class ProxyMutex;
+
+/**
+  Contention profile of ProxyMutex acquisitions, per call site.
+
+  The call site is the SourceLocation captured by the lock macros. While
+  the profiler is enabled, each thread counts the acquisitions, failed try
+  locks and blocking waits of every site in a table of its own, without
+  locks. One acquisition in @c sample_period is also timed to measure how
+  long the lock is held. collect() merges the tables of all the threads.
+
+  The profiler is controlled by proxy.config.lock_profiling.enabled and
+  proxy.config.lock_profiling.sample_period, and read with the
+  admin_server_get_lock_profile JSON-RPC method or traffic_ctl server
+  lock-profile. When disabled, the cost to a lock operation is a load
+  of @c enabled.
+
+*/
+class LockProfiler
+{
+public:
+  /// Statistics of the acquisitions at one call site.
+  struct Site {
+    SourceLocation location{nullptr, nullptr, 0};
+    uint64_t       acquires      = 0; ///< Successful acquisitions.
+    uint64_t       misses        = 0; ///< Failed try locks.
+    uint64_t       blocks        = 0; ///< Blocking acquisitions that had to wait.
+    uint64_t       wait_time     = 0; ///< Total wait of the blocking acquisitions, in nanoseconds.
+    uint64_t       holds         = 0; ///< Sampled acquisitions.
+    uint64_t       hold_time     = 0; ///< Total hold time of the sampled acquisitions, in nanoseconds.
+    uint64_t       max_hold_time = 0; ///< Longest sampled hold, in nanoseconds.
+  };
+
+  /// Per thread table of sites, opaque outside of the profiler.
+  struct Slot;
+
+  /// Whether lock operations are profiled.
+  static std::atomic<bool> enabled;
+
+  /// Time one acquisition in this many, at least 1.
+  static std::atomic<int> sample_period;
+
+  static bool
+  is_enabled()
+  {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /// Count a successful acquisition of @a m, maybe sample its hold time.
+  static void acquired(ProxyMutex *m, const SourceLocation &location);
+  /// Count a failed try lock.
+  static void missed(const SourceLocation &location);
+  /// Count a blocking acquisition that waited @a wait.
+  static void blocked(const SourceLocation &location, ink_hrtime wait);
+  /// Record the hold time of a sampled acquisition of @a m, called before it is released.
+  static void released(ProxyMutex *m);
+
+  /**
+    Merge the tables of all the threads.
+
+    The counts are those since the last reset(). The maximum hold time
+    is only approximately reset, a hold that ends during reset() may be
+    kept.
+
+    @return The sites, in no particular order.
+  */
+  static std::vector<Site> collect();
+
+  /// Start the counts again from zero.
+  static void reset();
+
+  /// Read the configuration and watch for updates.
+  static void init();
+};
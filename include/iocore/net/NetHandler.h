@@ -24,6 +24,7 @@
 #pragma once
 
 #include <atomic>
+#include <vector>
 
 #include "iocore/eventsystem/Continuation.h"
 #include "iocore/eventsystem/EThread.h"
@@ -215,6 +216,31 @@ public:
    */
   void stopCop(NetEvent *ne);
 
+  /**
+    Defer a flush of output to the tail of the event loop.
+
+    @a c is called back once with NET_EVENT_FLUSH, with its mutex held,
+    before the write ready list is processed. The output of everything that
+    ran on the thread in this loop is then written together. Only be called
+    on the thread of this NetHandler.
+
+    @param c Continuation to be called back.
+   */
+  void defer_flush(Continuation *c);
+  /**
+    Remove a deferred flush, for a continuation which is going away.
+
+    @param c Continuation passed to defer_flush.
+   */
+  void cancel_flush(Continuation *c);
+  void process_flush_list();
+
+  bool
+  has_deferred_flush() const
+  {
+    return !_flush_list.empty();
+  }
+
   // Signal the epoll_wait to terminate.
   void signalActivity() override;
 
@@ -231,6 +257,9 @@ public:
   inline static DbgCtl dbg_ctl_iocore_net{"iocore_net"};
 
 private:
+  std::vector<Continuation *> _flush_list;
+  std::vector<Continuation *> _flushing; ///< The deferred flushes being processed, kept to reuse the allocation.
+
   // The following settings are used potentially by accept threads. These are
   // shared across threads via std::atomic rather than being pulled through a
   // TS_EVENT_MGMT_UPDATE event like with the Config settings above because
@@ -39,7 +39,8 @@ struct UDPPacketInternal {
   uint16_t segment_size = 0;
 
   int        reqGenerationNum = 0;
-  ink_hrtime delivery_time    = 0; // when to deliver packet
+  ink_hrtime delivery_time    = 0;     // when to deliver packet
+  bool       paced            = false; // delivery_time is a pacing deadline, see proxy.config.udp.pacing
 
   Ptr<IOBufferBlock> chain;
   Continuation      *cont = nullptr; // callback on error
@@ -75,6 +76,12 @@ public:
   int64_t        getPktLength();
   uint8_t       *get_entire_chain_buffer(size_t *buf_len);
 
+  /**
+     Send the packet at its delivery time with a finer granularity than the
+     scheduling slots, for transports that pace their packets.
+  */
+  void set_paced(bool paced);
+
   /**
      Add IOBufferBlock (chain) to end of packet.
      @param block block chain to add.
@@ -124,6 +131,12 @@ UDPPacket::setContinuation(Continuation *c)
   p.cont = c;
 }
 
+inline void
+UDPPacket::set_paced(bool paced)
+{
+  p.paced = paced;
+}
+
 inline void
 UDPPacket::setConnection(UDPConnection *c)
 {
@@ -25,12 +25,19 @@
 
 #include "iocore/net/quic/QUICTypes.h"
 #include "iocore/net/quic/QUICConnection.h"
-#include "iocore/net/quic/MTHashTable.h"
 
+#include <unordered_map>
+
+/*
+ * The connections of one QUIC packet handler, by connection ID
+ *
+ * Connection ID steering delivers all packets of a connection to the thread of the packet handler which issued its connection
+ * IDs, so a table is only used from that thread and has no locks.
+ */
 class QUICConnectionTable
 {
 public:
-  QUICConnectionTable(int hash_table_size = 65521) : _connections(hash_table_size) {}
+  QUICConnectionTable(int hash_table_size = 65521) { _connections.reserve(hash_table_size); }
   ~QUICConnectionTable();
   /*
    * Insert an entry
@@ -54,5 +61,13 @@ public:
   QUICConnection *lookup(QUICConnectionId cid);
 
 private:
-  MTHashTable<QUICConnectionId, QUICConnection *> _connections;
+  struct Hash {
+    size_t
+    operator()(const QUICConnectionId &cid) const
+    {
+      return static_cast<uint64_t>(cid);
+    }
+  };
+
+  std::unordered_map<QUICConnectionId, QUICConnection *, Hash> _connections;
 };
@@ -36,4 +36,5 @@ enum {
   QUIC_EVENT_SHUTDOWN,
   QUIC_EVENT_LD_SHUTDOWN,
   QUIC_EVENT_STATELESS_RESET,
+  QUIC_EVENT_PACKET_STEERED,
 };
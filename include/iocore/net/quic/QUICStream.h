@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "tscore/ExtensiblePriority.h"
 #include "tscore/List.h"
 
 #include "iocore/eventsystem/Event.h"
@@ -74,7 +75,16 @@ public:
    */
   void set_io_adapter(QUICStreamAdapter *adapter);
 
+  /**
+   * Set the [RFC 9218] priority of this stream, from a Priority header or a PRIORITY_UPDATE frame
+   *
+   * It orders the streams that are filled with data and is passed to quiche, which orders the frames it sends.
+   */
+  void                      set_priority(const ExtensiblePriority &priority);
+  const ExtensiblePriority &priority() const;
+
   LINK(QUICStream, link);
+  ExtensiblePriorityQueue<QUICStream>::Entry priority_entry{this};
 
 protected:
   QUICConnectionInfoProvider *_connection_info  = nullptr;
@@ -83,6 +93,7 @@ protected:
   uint64_t                    _received_bytes   = 0;
   uint64_t                    _sent_bytes       = 0;
   bool                        _has_no_more_data = false;
+  bool                        _priority_changed = false;
 };
 
 class QUICStreamStateListener
@@ -275,6 +275,15 @@ public:
   uint8_t length() const;
   bool    is_zero() const;
   void    randomize();
+  /// Randomize, with the first byte set to the owner id of the issuing packet handler, see @c quic_steering.
+  void randomize(uint8_t owner);
+
+  /// The owner id of a connection ID this server issued.
+  uint8_t
+  owner() const
+  {
+    return this->_id[0];
+  }
 
 private:
   uint64_t _hashcode() const;
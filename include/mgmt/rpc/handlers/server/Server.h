@@ -26,5 +26,6 @@ namespace rpc::handlers::server
 {
 swoc::Rv<YAML::Node> server_start_drain(std::string_view const &id, YAML::Node const &params);
 swoc::Rv<YAML::Node> server_stop_drain(std::string_view const &id, YAML::Node const &);
+swoc::Rv<YAML::Node> server_get_lock_profile(std::string_view const &id, YAML::Node const &params);
 void                 server_shutdown(YAML::Node const &);
 } // namespace rpc::handlers::server
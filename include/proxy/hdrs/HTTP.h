@@ -1342,6 +1342,7 @@ public:
   int        marshal(char *buf, int len);
   static int unmarshal(char *buf, int len, RefCountObj *block_ref);
   static int unmarshal_v24_1(char *buf, int len, RefCountObj *block_ref);
+  static int unmarshal_length(char *buf, int len);
   void       set_buffer_reference(RefCountObj *block_ref);
   int        get_handle(char *buf, int len);
 
@@ -33,6 +33,7 @@
 #include "tscore/ParseRules.h"
 #include "proxy/hdrs/HdrHeap.h"
 #include "proxy/hdrs/HdrToken.h"
+#include "proxy/hdrs/MIMEScan.h"
 
 #include "swoc/TextView.h"
 
@@ -447,6 +448,7 @@ public:
    * @param output_shares_input [out] Whether @a output is in @a input.
    * @param eof_p [in] The source for @a input is done, no more data will ever be available.
    * @param scan_type [in] Whether to check for line folding.
+   * @param index [in,out] Structural index of the block containing @a input, if any.
    * @return The result of scanning.
    *
    * @a input is updated to remove text that was scanned. @a output is updated to be a view of the
@@ -457,8 +459,12 @@ public:
    * set until scanning has completed). If @a scan_type is @c FIELD then folded lines are
    * accumulated in to a single line stored in the internal buffer. Otherwise the scanning
    * terminates at the first CR/LF.
+   *
+   * If @a index is provided it is used to locate line ends and must cover the same block of text
+   * as @a input for the duration of the parse. Otherwise the line end is found by a direct scan.
    */
-  ParseResult get(swoc::TextView &input, swoc::TextView &output, bool &output_shares_input, bool eof_p, ScanType scan_type);
+  ParseResult get(swoc::TextView &input, swoc::TextView &output, bool &output_shares_input, bool eof_p, ScanType scan_type,
+                  mime_scan::Index *index = nullptr);
 
 protected:
   /** Append @a text to the internal buffer.
@@ -0,0 +1,168 @@
+/** @file
+
+  Vectorized character class scanning for MIME / HTTP/1.x header blocks.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "swoc/TextView.h"
+
+/** Character class scanning for header blocks.
+ *
+ * The header parser needs to locate line ends, locate the name / value separator and reject
+ * control characters. Rather than walking each line a byte at a time, these routines classify
+ * 16 (SSE2) or 32 (AVX2) bytes per step. The implementation is selected once at startup based on
+ * the CPU, with a portable scalar version used elsewhere.
+ *
+ * A "control" character here is exactly @c ParseRules::is_control - 0x00-0x08, 0x0a-0x1f, 0x7f.
+ */
+namespace mime_scan
+{
+/// Result when a character is not found.
+static constexpr size_t npos = swoc::TextView::npos;
+
+/// Vector implementation in use.
+enum class Impl {
+  SCALAR, ///< Byte at a time.
+  SSE2,   ///< 16 bytes per step.
+  AVX2,   ///< 32 bytes per step.
+};
+
+/// @return The implementation selected for this CPU.
+Impl impl();
+
+/// @return A printable name for @a impl.
+const char *impl_name(Impl impl);
+
+/** Force a specific implementation.
+ *
+ * @param impl Implementation to use.
+ * @return @c true if @a impl is supported on this CPU and was selected.
+ *
+ * This is intended for testing and benchmarking.
+ */
+bool set_impl(Impl impl);
+
+/** Find the end of a line.
+ *
+ * @param text Text to scan.
+ * @param nul_p [out] Set to @c true if a NUL was found before the LF, unchanged otherwise.
+ * @return Offset of the first LF in @a text, or @c npos.
+ */
+size_t find_eol(swoc::TextView text, bool &nul_p);
+
+/** Find the first control character.
+ *
+ * @param text Text to scan.
+ * @return Offset of the first control character in @a text, or @c npos.
+ */
+size_t find_control(swoc::TextView text);
+
+/** Structural index over a window of a header block.
+ *
+ * The window is classified in a single pass, producing bitmaps of the LF, colon, NUL and control
+ * characters. Subsequent lookups for line ends, separators and invalid characters are then bit
+ * operations rather than re-scanning the text. The window slides forward through the block as
+ * lookups move past its end, so the index is bounded in size regardless of the header size.
+ *
+ * An index is only valid while the underlying text is unchanged. It is intended to be a local
+ * variable for the duration of a single parse call. If the text is modified in place (e.g. line
+ * unfolding) @c erase must be called for the modified positions.
+ */
+class Index
+{
+  using self_type = Index;
+
+public:
+  /// Window size in bytes.
+  static constexpr size_t WINDOW_SIZE = 512;
+
+  /** Find the end of the line starting at @a text.
+   *
+   * @param text Text to scan, which must be part of a single header block.
+   * @param nul_p [out] Set to @c true if a NUL was found before the LF, unchanged otherwise.
+   * @return Offset of the first LF in @a text, or @c npos.
+   */
+  size_t find_eol(swoc::TextView text, bool &nul_p);
+
+  /** Find the name / value separator.
+   *
+   * @param line A header field line.
+   * @return Offset of the first colon in @a line, or @c npos.
+   */
+  size_t find_colon(swoc::TextView line);
+
+  /** Check for control characters.
+   *
+   * @param text Text to check.
+   * @return @c true if @a text contains a control character.
+   *
+   * If @a text is not covered by the current window it is scanned directly.
+   */
+  bool has_control(swoc::TextView text);
+
+  /** Remove the character at @a p from the index.
+   *
+   * @param p Location of a character that was overwritten with a non-control, non-special character.
+   */
+  void erase(const char *p);
+
+protected:
+  static constexpr size_t N_WORDS = WINDOW_SIZE / 64;
+
+  /// Bitmaps for a classified window.
+  struct Bits {
+    uint64_t lf[N_WORDS];
+    uint64_t colon[N_WORDS];
+    uint64_t nul[N_WORDS];
+    uint64_t ctl[N_WORDS];
+  };
+
+  const char *_base = nullptr; ///< Start of the indexed window.
+  size_t      _size = 0;       ///< Number of valid bytes in the window.
+  Bits        _bits;           ///< Classification of the window.
+
+  /// @return @c true if @a p is inside the indexed window.
+  bool contains(const char *p) const;
+
+  /** Classify a new window.
+   *
+   * @param text Start of the window is @a text and the size is at most @c WINDOW_SIZE.
+   */
+  void load(swoc::TextView text);
+
+  /** Find the first set bit in @a map in the range [ @a start, @a end ) of the window.
+   *
+   * @return Offset of the set bit from the window base, or @c npos.
+   */
+  size_t search(uint64_t const *map, size_t start, size_t end) const;
+};
+
+inline bool
+Index::contains(const char *p) const
+{
+  return _base != nullptr && p >= _base && p < _base + _size;
+}
+
+} // namespace mime_scan
@@ -159,6 +159,10 @@ struct HttpStatsBlock {
   Metrics::Counter::AtomicType *origin_shutdown_tunnel_server_no_keep_alive;
   Metrics::Counter::AtomicType *origin_shutdown_tunnel_server_plugin_tunnel;
   Metrics::Counter::AtomicType *origin_shutdown_tunnel_transform_read;
+  Metrics::Counter::AtomicType *origin_steal_attempts;
+  Metrics::Counter::AtomicType *origin_steal_probes;
+  Metrics::Counter::AtomicType *origin_steal_success;
+  Metrics::Counter::AtomicType *origin_steal_time;
   Metrics::Counter::AtomicType *outgoing_requests;
   Metrics::Counter::AtomicType *parent_count;
   Metrics::Counter::AtomicType *parent_proxy_request_total_bytes;
@@ -265,6 +269,11 @@ struct HttpStatsBlock {
   Metrics::Counter::AtomicType *total_transactions_time;
   Metrics::Counter::AtomicType *total_x_redirect;
   Metrics::Counter::AtomicType *trace_requests;
+  Metrics::Counter::AtomicType *txn_arena_allocations;
+  Metrics::Counter::AtomicType *txn_arena_blocks;
+  Metrics::Counter::AtomicType *txn_arena_blocks_reused;
+  Metrics::Counter::AtomicType *txn_arena_bytes;
+  Metrics::Counter::AtomicType *txn_arena_release_time;
   Metrics::Gauge::AtomicType   *tunnel_current_active_connections;
   Metrics::Counter::AtomicType *tunnels;
   Metrics::Counter::AtomicType *ua_begin_time;
@@ -767,7 +776,8 @@ public:
   MgmtByte send_100_continue_response = 0;
   MgmtByte disallow_post_100_continue = 0;
 
-  MgmtByte server_session_sharing_pool = TS_SERVER_SESSION_SHARING_POOL_THREAD;
+  MgmtByte server_session_sharing_pool             = TS_SERVER_SESSION_SHARING_POOL_THREAD;
+  MgmtInt  server_session_sharing_steal_max_probes = 0;
 
   ConnectionTracker::GlobalConfig global_connection_tracker_config;
 
@@ -0,0 +1,103 @@
+/** @file
+
+  Latency histograms for pairs of transaction milestones.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "tsutil/Histogram.h"
+#include "proxy/Milestones.h"
+
+/** Histograms of the time between pairs of transaction milestones.
+ *
+ * The pairs are configured by @c proxy.config.http.milestone_histograms.pairs, e.g.
+ * <tt>TS_MILESTONE_UA_BEGIN-TS_MILESTONE_SERVER_FIRST_READ</tt>. Each net thread has an instance in which it records the
+ * transactions it finishes, without locking or atomics. The instances are merged when the statistics are synchronized and
+ * the percentiles of the merged histograms are published as @c proxy.process.http.milestone.<i>pair</i>.p50 etc.
+ */
+class HttpMilestoneHistograms
+{
+  using self_type = HttpMilestoneHistograms; ///< Self reference type.
+
+public:
+  /// Microseconds, 8 buckets for each power of 2 up to about 134 seconds.
+  using Graph = ts::Histogram<24, 3>;
+  /// Bucket counts of a @c Graph.
+  using Counts = std::array<Graph::raw_type, Graph::N_BUCKETS>;
+
+  /// A configured pair of milestones.
+  struct Pair {
+    TSMilestonesType start;
+    TSMilestonesType end;
+    std::string      name; ///< Statistic name of the pair, e.g. "ua_begin_to_server_first_read".
+  };
+
+  /// Percentiles published for each pair, in parts per thousand.
+  static constexpr std::array<unsigned, 4> PERCENTILES = {500, 900, 990, 999};
+  /// Statistic suffixes of @c PERCENTILES.
+  static constexpr std::array<std::string_view, 4> PERCENTILE_NAMES = {"p50", "p90", "p99", "p999"};
+
+  explicit HttpMilestoneHistograms(size_t n_pairs) : _graphs(n_pairs) {}
+
+  /** Record the configured pairs of a finished transaction.
+   *
+   * @param pairs The configured pairs.
+   * @param milestones The milestones of the transaction.
+   *
+   * Pairs with either milestone unset, or in the wrong order, are skipped.
+   */
+  void record(std::vector<Pair> const &pairs, TransactionMilestones const &milestones);
+
+  /// Add the bucket counts of pair @a idx to @a counts.
+  void add_to(size_t idx, Counts &counts);
+
+  /** Parse a configured list of pairs.
+   *
+   * @param spec Pairs separated by spaces or commas, each two milestone names separated by '-'. The "TS_MILESTONE_" prefix
+   * of the names is optional and case is ignored.
+   * @param pairs [out] The pairs.
+   * @param error [out] The invalid pair, if any.
+   * @return @c true if all the pairs are valid.
+   */
+  static bool parse(std::string_view spec, std::vector<Pair> &pairs, std::string &error);
+
+  /** Estimate a percentile from bucket counts.
+   *
+   * @param counts The bucket counts.
+   * @param permille The percentile, in parts per thousand.
+   * @return The sample value, interpolated within its bucket, or 0 if there are no samples.
+   */
+  static Graph::raw_type percentile(Counts const &counts, unsigned permille);
+
+  /// Read the configuration, set up the net threads and register the statistics.
+  static void init();
+
+  /// The configured pairs.
+  static std::vector<Pair> pairs;
+
+private:
+  std::vector<Graph> _graphs; ///< One per pair.
+};
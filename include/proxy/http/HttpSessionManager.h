@@ -36,6 +36,9 @@
 #include "proxy/PoolableSession.h"
 #include "swoc/IntrusiveHashMap.h"
 
+#include <array>
+#include <atomic>
+
 class ProxyTransaction;
 class HttpSM;
 
@@ -101,10 +104,30 @@ public:
   /// Close all sessions and then clear the table.
   void purge();
 
+  /** Check if the pool may have a session matching @ addr and @a host_hash.
+
+      This does not lock the pool, it is for other threads to skip the pools that cannot have a
+      match. The answer is from a summary of hashes, so it may be a false positive, and it may be
+      stale if the pool is being changed.
+  */
+  bool may_contain(sockaddr const *addr, CryptoHash const &host_hash, TSServerSessionSharingMatchMask match_style) const;
+
   // Pools of server sessions.
   // Note that each server session is stored in both pools.
   IPTable   m_ip_pool;
   FQDNTable m_fqdn_pool;
+
+private:
+  static constexpr size_t SUMMARY_SIZE = 1024; ///< Power of 2.
+  using Summary                        = std::array<std::atomic<uint32_t>, SUMMARY_SIZE>;
+
+  /// Adjust the summaries for @a ssn being added to or removed from the pools.
+  void summarize(PoolableSession *ssn, int delta);
+
+  // Number of pooled sessions per bucket of the address and host name hashes. These are only
+  // changed with the pool locked, but read without the lock by may_contain.
+  Summary m_ip_summary{};
+  Summary m_fqdn_summary{};
 };
 
 class HttpSessionManager
@@ -127,6 +150,12 @@ public:
   {
     return m_pool_type;
   }
+  /// Set the number of other thread pools that may be searched on a miss in the thread pool.
+  void
+  set_steal_max_probes(int n)
+  {
+    m_steal_max_probes = n;
+  }
 
 private:
   /// Global pool, used if not per thread pools.
@@ -134,7 +163,11 @@ private:
   ServerSessionPool             *m_g_pool = nullptr;
   HSMresult_t                    _acquire_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
                                                   TSServerSessionSharingMatchMask match_style, TSServerSessionSharingPoolType pool_type);
-  TSServerSessionSharingPoolType m_pool_type = TS_SERVER_SESSION_SHARING_POOL_THREAD;
+  /// Take a session from the pool of another thread and move it to this thread.
+  HSMresult_t _steal_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
+                             TSServerSessionSharingMatchMask match_style);
+  TSServerSessionSharingPoolType m_pool_type        = TS_SERVER_SESSION_SHARING_POOL_THREAD;
+  int                            m_steal_max_probes = 0;
 };
 
 extern HttpSessionManager httpSessionManager;
@@ -257,6 +257,7 @@ public:
     CACHE_WL_SUCCESS,
     CACHE_WL_FAIL,
     CACHE_WL_READ_RETRY,
+    CACHE_WL_NOT_ADMITTED, ///< The cache declined to store the object.
   };
 
   enum ClientTransactionResult_t {
@@ -30,6 +30,7 @@
 #include "tscore/ink_error.h"
 
 #include <cstdint>
+#include <cmath>
 #include <algorithm>
 
 namespace PreWarm
@@ -37,12 +38,15 @@ namespace PreWarm
 enum class Algorithm {
   V1 = 1,
   V2,
+  V3,
 };
 
 inline PreWarm::Algorithm
 algorithm_version(int i)
 {
   switch (i) {
+  case 3:
+    return PreWarm::Algorithm::V3;
   case 2:
     return PreWarm::Algorithm::V2;
   case 1:
@@ -119,4 +123,106 @@ prewarm_size_v2_on_event_interval(uint32_t hit, uint32_t miss, uint32_t current_
   return n;
 }
 
+/**
+   Demand of a destination for algorithm v3
+
+   Holt's linear (double exponential) smoothing of the number of connections requested, hit + miss, in each period. The
+   level follows the demand and the trend follows ramps such as a daily peak, so the pool grows ahead of the demand rather
+   than one period behind it.
+ */
+struct Demand {
+  static constexpr double ALPHA = 0.5; ///< Weight of the last period in the level
+  static constexpr double BETA  = 0.3; ///< Weight of the last change of the level in the trend
+
+  double level  = 0;
+  double trend  = 0;
+  bool   primed = false;
+
+  void
+  update(uint32_t requested)
+  {
+    if (!primed) {
+      level  = requested;
+      primed = true;
+      return;
+    }
+
+    const double last = level;
+
+    level = ALPHA * requested + (1 - ALPHA) * (level + trend);
+    trend = BETA * (level - last) + (1 - BETA) * trend;
+  }
+
+  /// Connections expected to be requested in the next period
+  double
+  forecast() const
+  {
+    return std::max(0.0, level + trend);
+  }
+};
+
+/**
+   Pool size for algorithm v3
+
+   The forecast demand of the next period, with @rate as head room.
+
+   @params min : min connections (configured)
+   @params max : max connections (configured), -1 : unlimited
+
+   @return target size of the pool
+ */
+inline uint32_t
+prewarm_target_v3(const Demand &demand, uint32_t min, int32_t max, double rate)
+{
+  uint32_t n = std::ceil(demand.forecast() * rate);
+
+  n = std::max(n, min);
+
+  if (max >= 0) {
+    n = std::min(n, static_cast<uint32_t>(max));
+  }
+
+  return n;
+}
+
+/**
+   Budget of algorithm v3
+
+   When the targets of all the pools of a thread exceed @budget, the part of each target above its min is scaled down by
+   the returned factor. The mins are always kept.
+
+   @params sum_min : sum of the mins of the pools
+   @params sum_target : sum of the targets of the pools, each of them at least its min
+   @params budget : connections for all the pools, 0 : unlimited
+
+   @return scale of the part of the targets above the mins, between 0 and 1
+ */
+inline double
+prewarm_budget_scale_v3(uint64_t sum_min, uint64_t sum_target, uint32_t budget)
+{
+  if (budget == 0 || sum_target <= budget) {
+    return 1.0;
+  }
+
+  if (sum_min >= budget) {
+    return 0.0;
+  }
+
+  return static_cast<double>(budget - sum_min) / (sum_target - sum_min);
+}
+
+/**
+   Periodical pre-warming for algorithm v3
+
+   Expand the pool size to @target, the budgeted target of prewarm_target_v3. The event based pre-warming replaces the
+   connections taken from the pool while the pool is below @target.
+
+   @return how many connections needs to be pre-warmed for next period
+ */
+inline uint32_t
+prewarm_size_v3_on_event_interval(uint32_t target, uint32_t current_size)
+{
+  return current_size < target ? target - current_size : 0;
+}
+
 } // namespace PreWarm
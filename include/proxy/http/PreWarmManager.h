@@ -270,6 +270,8 @@ private:
     PreWarm::SPtrConstConf     conf;
     PreWarm::SPtrConstStatsIds stats_ids;
     Stat                       stat;
+    PreWarm::Demand            demand;     ///< for algorithm v3
+    uint32_t                   target = 0; ///< for algorithm v3
   };
 
   using Map = std::unordered_map<PreWarm::SPtrConstDst, Info, PreWarm::DstHash, PreWarm::DstKeyEqual>;
@@ -286,11 +288,13 @@ private:
   // hooks for pre-warming pool size algorithm
   void _prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const Info &info);
   void _prewarm_on_dequeue(const PreWarm::SPtrConstDst &dst, const Info &info);
+  void _update_targets();
 
   ////
   // Variables
   //
   PreWarm::Algorithm _algorithm = PreWarm::Algorithm::V1;
+  uint32_t           _budget    = 0; ///< Max connections of all the pools of this thread for algorithm v3, 0 : unlimited
 
   Event     *_tick_event   = nullptr;
   ink_hrtime _event_period = HRTIME_SECONDS(1);
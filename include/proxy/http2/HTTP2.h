@@ -57,6 +57,7 @@ const size_t HTTP2_PING_LEN               = 8;
 const size_t HTTP2_GOAWAY_LEN             = 8;
 const size_t HTTP2_WINDOW_UPDATE_LEN      = 4;
 const size_t HTTP2_SETTINGS_PARAMETER_LEN = 6;
+const size_t HTTP2_PRIORITY_UPDATE_LEN    = 4; // Without the Priority Field Value
 
 // SETTINGS initial values. NOTE: These should not be modified
 // unless the protocol changes! Do not change this thinking you
@@ -118,10 +119,41 @@ struct Http2StatsBlock {
   Metrics::Counter::AtomicType *window_update_frames_in;
   Metrics::Counter::AtomicType *continuation_frames_in;
   Metrics::Counter::AtomicType *unknown_frames_in;
+  Metrics::Counter::AtomicType *write_frames[8];
+  Metrics::Counter::AtomicType *write_bytes[7];
 };
 
 extern Http2StatsBlock http2_rsb;
 
+/** Histograms of the frames and bytes in each write of a session.
+ *
+ * A write hands the pending frames of the session to the network layer. The buckets are powers of two for frames and powers of
+ * four for bytes, the last bucket counts everything larger.
+ */
+struct Http2WriteStats {
+  static constexpr int FRAME_BUCKETS = 8; ///< 1, 2, 4 ... 64 frames and more.
+  static constexpr int BYTE_BUCKETS  = 7; ///< 256, 1K, 4K ... 256K bytes and more.
+
+  uint32_t frames[FRAME_BUCKETS] = {};
+  uint32_t bytes[BYTE_BUCKETS]   = {};
+
+  static int frame_bucket(uint32_t n_frames);
+  static int byte_bucket(uint64_t n_bytes);
+
+  void
+  record(uint32_t n_frames, uint64_t n_bytes)
+  {
+    ++frames[frame_bucket(n_frames)];
+    ++bytes[byte_bucket(n_bytes)];
+  }
+
+  /// Add the histograms to the process metrics.
+  void publish() const;
+};
+
+static_assert(Http2WriteStats::FRAME_BUCKETS == sizeof(Http2StatsBlock::write_frames) / sizeof(Http2StatsBlock::write_frames[0]));
+static_assert(Http2WriteStats::BYTE_BUCKETS == sizeof(Http2StatsBlock::write_bytes) / sizeof(Http2StatsBlock::write_bytes[0]));
+
 // [RFC 7540] 6.9.1. The Flow Control Window
 static const Http2WindowSize HTTP2_MAX_WINDOW_SIZE = 0x7FFFFFFF;
 
@@ -178,6 +210,16 @@ enum Http2FrameType {
   HTTP2_FRAME_TYPE_MAX,
 };
 
+// [RFC 9218] 7.1. An extension frame, outside of the densely numbered core types. It is counted as an unknown frame.
+const uint8_t HTTP2_FRAME_TYPE_PRIORITY_UPDATE = 0x10;
+
+// Values of proxy.config.http2.stream_priority_enabled
+enum Http2StreamPriority : uint32_t {
+  HTTP2_STREAM_PRIORITY_NONE            = 0, ///< Streams send as soon as they have data.
+  HTTP2_STREAM_PRIORITY_DEPENDENCY_TREE = 1, ///< [RFC 7540] 5.3 dependencies and weights.
+  HTTP2_STREAM_PRIORITY_EXTENSIBLE      = 2, ///< [RFC 9218] urgency and incremental.
+};
+
 extern Metrics::Counter::AtomicType *http2_frame_metrics_in[HTTP2_FRAME_TYPE_MAX + 1];
 
 // [RFC 7540] 6.1. Data
@@ -371,11 +413,26 @@ bool http2_parse_goaway(IOVec, Http2Goaway &);
 
 bool http2_parse_window_update(IOVec, uint32_t &);
 
+bool http2_parse_priority_update(IOVec, Http2StreamId &);
+
 Http2ErrorCode http2_decode_header_blocks(HTTPHdr *, const uint8_t *, const uint32_t, uint32_t *, HpackHandle &, bool, uint32_t,
                                           bool is_outbound = false);
 
 Http2ErrorCode http2_encode_header_blocks(HTTPHdr *, uint8_t *, uint32_t, uint32_t *, HpackHandle &, int32_t);
 
+/** Adapt the write thresholds of a session to its TCP connection.
+ *
+ * Frames are written once a congestion window of them is pending, as no more can leave in this round trip anyway, and are held
+ * for at most a quarter of the round trip time. The configured thresholds are the upper bounds.
+ *
+ * @param size The size threshold, in bytes.
+ * @param time The time threshold.
+ * @param cwnd The congestion window in bytes, 0 if unknown.
+ * @param rtt The smoothed round trip time, 0 if unknown.
+ */
+void http2_adapt_write_thresholds(uint32_t &size, ink_hrtime &time, uint32_t size_limit, ink_hrtime time_limit, uint64_t cwnd,
+                                  ink_hrtime rtt);
+
 ParseResult http2_convert_header_from_2_to_1_1(HTTPHdr *);
 ParseResult http2_convert_header_from_1_1_to_2(HTTPHdr *);
 void        http2_init();
@@ -436,6 +493,7 @@ public:
   static uint32_t write_buffer_block_size;
   static float    write_size_threshold;
   static uint32_t write_time_threshold;
+  static uint32_t write_coalescing;
   static uint32_t buffer_water_mark;
 
   static void init();
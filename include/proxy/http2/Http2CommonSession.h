@@ -59,6 +59,8 @@ enum class Http2SsnMilestone {
   LAST_ENTRY,
 };
 
+class NetHandler;
+
 size_t const HTTP2_HEADER_BUFFER_SIZE_INDEX = CLIENT_CONNECTION_FIRST_READ_BUFFER_SIZE_INDEX;
 
 /**
@@ -88,6 +90,8 @@ public:
   void    write_reenable();
   int64_t xmit(const Http2TxFrame &frame, bool flush = true);
   void    flush();
+  /// The deferred flush, from NET_EVENT_FLUSH.
+  void    flush_deferred();
 
   int64_t          get_connection_id();
   Ptr<ProxyMutex> &get_mutex();
@@ -156,9 +160,21 @@ protected:
 
   Http2FrameHeader current_hdr              = {0, 0, 0, 0};
   uint32_t         _write_size_threshold    = 0;
-  uint32_t         _write_time_threshold    = 100;
+  ink_hrtime       _write_time_threshold    = HRTIME_MSECONDS(100);
   ink_hrtime       _write_buffer_last_flush = 0;
 
+  /// The configured write thresholds, the upper bounds of the adapted ones.
+  uint32_t   _write_size_limit      = 0;
+  ink_hrtime _write_time_limit      = HRTIME_MSECONDS(100);
+  ink_hrtime _write_thresholds_time = 0; ///< When the thresholds were last adapted.
+
+  /// Set the write thresholds from the configuration, for a write buffer of @a buffer_size bytes.
+  void _init_write_thresholds(int64_t buffer_size);
+  void _adapt_write_thresholds();
+
+  /// Hand the pending frames to the network layer.
+  void _write_pending_frames();
+
   History<HISTORY_DEFAULT_SIZE>                                                     _history;
   Milestones<Http2SsnMilestone, static_cast<size_t>(Http2SsnMilestone::LAST_ENTRY)> _milestones;
 
@@ -174,6 +190,11 @@ protected:
   int    _n_frame_read   = 0;
 
   uint32_t _pending_sending_data_size = 0;
+  uint32_t _pending_sending_frames    = 0;
+
+  /// The thread's NetHandler, while a flush is deferred to the loop tail.
+  NetHandler     *_deferred_flush = nullptr;
+  Http2WriteStats _write_stats;
 
   int64_t read_from_early_data      = 0;
   bool    cur_frame_from_early_data = false;
@@ -32,6 +32,7 @@
 #include "proxy/http2/HPACK.h"
 #include "proxy/http2/Http2Stream.h"
 #include "proxy/http2/Http2DependencyTree.h"
+#include "tscore/ExtensiblePriority.h"
 #include "tscore/FrequencyCounter.h"
 
 class Http2CommonSession;
@@ -87,6 +88,12 @@ public:
   DependencyTree          *dependency_tree    = nullptr;
   ActivityCop<Http2Stream> _cop;
 
+  /** Streams with DATA to send, by [RFC 9218] urgency.
+   *
+   * Used instead of the dependency tree if proxy.config.http2.stream_priority_enabled is 2.
+   */
+  ExtensiblePriorityQueue<Http2Stream> urgency_queue;
+
   /** The HTTP/2 settings configured by ATS and dictated to the peer via
    * SETTINGS frames. */
   Http2ConnectionSettings local_settings;
@@ -157,6 +164,7 @@ public:
   // HTTP/2 frame sender
   void                     schedule_stream_to_send_priority_frames(Http2Stream *stream);
   void                     send_data_frames_depends_on_priority();
+  void                     reprioritize_stream(Http2Stream *stream, const ExtensiblePriority &priority);
   void                     schedule_stream_to_send_data_frames(Http2Stream *stream);
   void                     schedule_retransmit(ink_hrtime t);
   void                     cancel_retransmit();
@@ -223,6 +231,7 @@ private:
   Http2Error rcv_goaway_frame(const Http2Frame &);
   Http2Error rcv_window_update_frame(const Http2Frame &);
   Http2Error rcv_continuation_frame(const Http2Frame &);
+  Http2Error rcv_priority_update_frame(const Http2Frame &);
 
   using http2_frame_dispatch = Http2Error (Http2ConnectionState::*)(const Http2Frame &);
   static constexpr http2_frame_dispatch _frame_handlers[HTTP2_FRAME_TYPE_MAX] = {
@@ -240,6 +249,10 @@ private:
 
   unsigned _adjust_concurrent_stream();
 
+  /** Send a DATA frame of the most urgent stream, [RFC 9218] 10.
+   */
+  void _send_data_frames_by_urgency();
+
   /** Receive and process a SETTINGS frame with the ACK flag set.
    *
    * This function will process any settings updates that have now been
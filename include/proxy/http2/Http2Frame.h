@@ -67,12 +67,16 @@ protected:
 
 /**
    DATA Frame
+
+   If @a reference is set, a large payload is written as references to the blocks of @a r rather
+   than copied. This saves a copy if the output is written to the network from the blocks, but
+   not if it has to be copied again, as the SSL write path does to fill TLS records.
  */
 class Http2DataFrame : public Http2TxFrame
 {
 public:
-  Http2DataFrame(Http2StreamId stream_id, uint8_t flags, IOBufferReader *r, uint32_t l)
-    : Http2TxFrame({l, HTTP2_FRAME_TYPE_DATA, flags, stream_id}), _reader(r), _payload_len(l)
+  Http2DataFrame(Http2StreamId stream_id, uint8_t flags, IOBufferReader *r, uint32_t l, bool reference = false)
+    : Http2TxFrame({l, HTTP2_FRAME_TYPE_DATA, flags, stream_id}), _reader(r), _payload_len(l), _reference(reference)
   {
   }
 
@@ -81,6 +85,7 @@ public:
 private:
   IOBufferReader *_reader      = nullptr;
   uint32_t        _payload_len = 0;
+  bool            _reference   = false;
 };
 
 /**
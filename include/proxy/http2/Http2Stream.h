@@ -29,6 +29,7 @@
 #include "proxy/ProxyTransaction.h"
 #include "proxy/http2/Http2DebugNames.h"
 #include "proxy/http2/Http2DependencyTree.h"
+#include "tscore/ExtensiblePriority.h"
 #include "tscore/History.h"
 #include "proxy/Milestones.h"
 
@@ -184,9 +185,10 @@ public:
   bool parsing_header_done       = false;
   bool is_first_transaction_flag = false;
 
-  HTTPHdr                    _send_header;
-  IOBufferReader            *_send_reader  = nullptr;
-  Http2DependencyTree::Node *priority_node = nullptr;
+  HTTPHdr                                     _send_header;
+  IOBufferReader                             *_send_reader  = nullptr;
+  Http2DependencyTree::Node                  *priority_node = nullptr;
+  ExtensiblePriorityQueue<Http2Stream>::Entry urgency_entry{this};
 
   Http2ConnectionState &get_connection_state();
 
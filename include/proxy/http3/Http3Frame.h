@@ -29,6 +29,9 @@
 #include "iocore/net/quic/QUICApplication.h"
 #include "proxy/http3/Http3Types.h"
 
+#include <string>
+#include <string_view>
+
 class Http3Frame
 {
 public:
@@ -148,6 +151,28 @@ private:
   const char    *_error_reason = nullptr;
 };
 
+//
+// PRIORITY_UPDATE Frame
+//
+
+class Http3PriorityUpdateFrame : public Http3Frame
+{
+public:
+  Http3PriorityUpdateFrame() : Http3Frame(Http3FrameType::PRIORITY_UPDATE) {}
+  Http3PriorityUpdateFrame(const uint8_t *buf, size_t len);
+
+  void reset(const uint8_t *buf, size_t len) override;
+
+  bool             is_valid() const;
+  uint64_t         prioritized_element_id() const;
+  std::string_view priority_field_value() const;
+
+private:
+  bool        _valid                  = false;
+  uint64_t    _prioritized_element_id = 0;
+  std::string _priority_field_value;
+};
+
 using Http3FrameDeleterFunc  = void (*)(Http3Frame *p);
 using Http3FrameUPtr         = std::unique_ptr<Http3Frame, Http3FrameDeleterFunc>;
 using Http3DataFrameUPtr     = std::unique_ptr<Http3DataFrame, Http3FrameDeleterFunc>;
@@ -159,10 +184,11 @@ using Http3FrameUPtr        = std::unique_ptr<Http3Frame, Http3FrameDeleterFunc>
 using Http3DataFrameUPtr    = std::unique_ptr<Http3DataFrame, Http3FrameDeleterFunc>;
 using Http3HeadersFrameUPtr = std::unique_ptr<Http3HeadersFrame, Http3FrameDeleterFunc>;
 
-extern ClassAllocator<Http3Frame>         http3FrameAllocator;
-extern ClassAllocator<Http3DataFrame>     http3DataFrameAllocator;
-extern ClassAllocator<Http3HeadersFrame>  http3HeadersFrameAllocator;
-extern ClassAllocator<Http3SettingsFrame> http3SettingsFrameAllocator;
+extern ClassAllocator<Http3Frame>               http3FrameAllocator;
+extern ClassAllocator<Http3DataFrame>           http3DataFrameAllocator;
+extern ClassAllocator<Http3HeadersFrame>        http3HeadersFrameAllocator;
+extern ClassAllocator<Http3SettingsFrame>       http3SettingsFrameAllocator;
+extern ClassAllocator<Http3PriorityUpdateFrame> http3PriorityUpdateFrameAllocator;
 
 class Http3FrameDeleter
 {
@@ -200,6 +226,13 @@ public:
     frame->~Http3Frame();
     http3SettingsFrameAllocator.free(static_cast<Http3SettingsFrame *>(frame));
   }
+
+  static void
+  delete_priority_update_frame(Http3Frame *frame)
+  {
+    frame->~Http3Frame();
+    http3PriorityUpdateFrameAllocator.free(static_cast<Http3PriorityUpdateFrame *>(frame));
+  }
 };
 
 //
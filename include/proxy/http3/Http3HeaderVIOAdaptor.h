@@ -27,10 +27,12 @@
 #include "proxy/hdrs/VersionConverter.h"
 #include "proxy/http3/Http3FrameHandler.h"
 
+class QUICStream;
+
 class Http3HeaderVIOAdaptor : public Continuation, public Http3FrameHandler
 {
 public:
-  Http3HeaderVIOAdaptor(VIO *sink, HTTPType http_type, QPACK *qpack, uint64_t stream_id);
+  Http3HeaderVIOAdaptor(VIO *sink, HTTPType http_type, QPACK *qpack, QUICStream &stream);
   ~Http3HeaderVIOAdaptor();
 
   // Http3FrameHandler
@@ -42,10 +44,11 @@ public:
   int  event_handler(int event, Event *data);
 
 private:
-  VIO     *_sink_vio    = nullptr;
-  QPACK   *_qpack       = nullptr;
-  uint64_t _stream_id   = 0;
-  bool     _is_complete = false;
+  VIO        *_sink_vio    = nullptr;
+  QPACK      *_qpack       = nullptr;
+  QUICStream &_stream;
+  uint64_t    _stream_id   = 0;
+  bool        _is_complete = false;
 
   HTTPHdr          _header; ///< HTTP header buffer for decoding
   VersionConverter _hvc;
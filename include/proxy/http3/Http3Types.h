@@ -63,8 +63,12 @@ enum class Http3FrameType : uint64_t {
   MAX_PUSH_ID   = 0x0D,
   X_MAX_DEFINED = 0x0D,
   UNKNOWN       = 0x0E,
+  // Extension frames have large type values, they are mapped to the values below by Http3Frame::type().
+  PRIORITY_UPDATE = 0x0F, ///< [RFC 9218] 7.2, for a request stream
 };
 
+constexpr uint64_t HTTP3_PRIORITY_UPDATE_FRAME_TYPE = 0xF0700;
+
 enum class Http3ErrorClass {
   UNDEFINED,
   CONNECTION,
@@ -0,0 +1,317 @@
+/** @file
+
+  Columnar segments of log entries
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "proxy/logging/LogField.h"
+
+struct LogEntryHeader;
+
+/*-------------------------------------------------------------------------
+  Columnar log files
+
+  A columnar log file is a sequence of segments, one for each LogBuffer
+  written by the log object. A segment stores the entries of the buffer by
+  field rather than by entry, so that a reader can scan a few fields of
+  many entries without touching the others. All values are in host byte
+  order, as in binary logs.
+
+  Segment layout, each part starting on an 8 byte boundary:
+
+    LogColumnarSegmentHeader
+    LogColumnarColumnHeader[column_count]
+    field symbol string, printf string, NUL terminated
+    column names, not terminated, name_len bytes each
+    column data, at the offset of each column header
+
+  Column 0 is the entry timestamp in microseconds, the fields of the
+  format follow in order. Column data is encoded by its type:
+
+    LOG_COLUMN_DELTA  integers, zigzag varint of the difference from the
+                      previous row (from 0 for the first row)
+    LOG_COLUMN_PLAIN  strings, varint length then bytes for each row;
+                      IPs, length byte (0, 4 or 16) then the address
+    LOG_COLUMN_DICT   strings, dict_count entries of varint length and
+                      bytes, then a varint dictionary index for each row
+  -------------------------------------------------------------------------*/
+
+constexpr uint32_t LOG_COLUMNAR_MAGIC   = 0x4c435354; // "TSCL" in little endian
+constexpr uint16_t LOG_COLUMNAR_VERSION = 1;
+/// Rows of a segment, far more than a LogBuffer holds. A segment with more is rejected by the reader.
+constexpr uint32_t LOG_COLUMNAR_MAX_ROWS = 1 << 24;
+
+/// Type of the timestamp column, the field columns have their @c LogField::Type.
+constexpr uint8_t LOG_COLUMN_TIMESTAMP = LogField::N_TYPES;
+
+enum LogColumnEncoding : uint8_t {
+  LOG_COLUMN_DELTA = 0,
+  LOG_COLUMN_PLAIN,
+  LOG_COLUMN_DICT,
+};
+
+struct LogColumnarSegmentHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t column_count; ///< Including the timestamp column.
+  uint32_t row_count;
+  uint32_t length;     ///< Of the segment, including this header.
+  uint32_t symbol_len; ///< Of the field symbol string, including the terminator.
+  uint32_t printf_len; ///< Of the printf string, including the terminator.
+  int64_t  low_timestamp;
+  int64_t  high_timestamp;
+};
+
+struct LogColumnarColumnHeader {
+  uint8_t  type;
+  uint8_t  encoding;
+  uint16_t name_len;
+  uint32_t offset; ///< Of the data from the start of the segment.
+  uint32_t length;
+  uint32_t dict_count;
+};
+
+/** The columns of a log format.
+ *
+ * The schema is shared by the writers of a log object, which encode buffers on the preprocessing
+ * threads concurrently.
+ */
+class LogColumnarSchema
+{
+public:
+  struct Column {
+    std::string    name;
+    LogField::Type type;
+  };
+
+  LogColumnarSchema(const char *symbol_str, const char *printf_str, std::vector<Column> columns);
+
+  /// Columns for the fields of a format, named by their symbol or as @c {name}symbol for containers.
+  LogColumnarSchema(const char *symbol_str, const char *printf_str, const LogFieldList &fields);
+
+  /// Whether the schema encodes entries of buffers with these format strings.
+  bool matches(const char *symbol_str, const char *printf_str) const;
+
+  const std::string &
+  symbol_str() const
+  {
+    return _symbol_str;
+  }
+
+  const std::string &
+  printf_str() const
+  {
+    return _printf_str;
+  }
+
+  const std::vector<Column> &
+  columns() const
+  {
+    return _columns;
+  }
+
+private:
+  std::string         _symbol_str;
+  std::string         _printf_str;
+  std::vector<Column> _columns;
+};
+
+/** Encode log entries as a columnar segment.
+ *
+ * Strings are referenced, not copied, so the entries must stay valid until the segment is
+ * finished.
+ */
+class LogColumnarWriter
+{
+public:
+  explicit LogColumnarWriter(const LogColumnarSchema &schema);
+
+  /** Add an entry marshalled by the fields of the schema.
+   *
+   * @return @c false if the fields overrun the entry or the segment has @c LOG_COLUMNAR_MAX_ROWS
+   * rows, the entry is not added.
+   */
+  bool add(const LogEntryHeader *entry);
+
+  uint32_t
+  rows() const
+  {
+    return _rows;
+  }
+
+  /// Append the segment of the added entries to @a out and start a new one.
+  void finish(std::string &out);
+
+private:
+  struct Values {
+    std::vector<int64_t>          ints;
+    std::vector<std::string_view> views; ///< Strings, or the address bytes of IPs.
+  };
+
+  const LogColumnarSchema &_schema;
+  std::vector<Values>      _values; ///< Per column, the timestamp first.
+  uint32_t                 _rows = 0;
+};
+
+/** A segment of a columnar log, read in place.
+ *
+ * The segment references the data it is parsed from, which is typically a mapped file.
+ */
+class LogColumnarSegment
+{
+public:
+  /** Parse the segment at the start of @a data.
+   *
+   * @return @c false if @a data does not start with a complete, valid segment.
+   */
+  bool parse(const char *data, size_t len);
+
+  /// Whether @a data starts as a columnar segment.
+  static bool is_columnar(const char *data, size_t len);
+
+  uint32_t
+  length() const
+  {
+    return _header->length;
+  }
+
+  uint32_t
+  rows() const
+  {
+    return _header->row_count;
+  }
+
+  int
+  columns() const
+  {
+    return _header->column_count;
+  }
+
+  int64_t
+  low_timestamp() const
+  {
+    return _header->low_timestamp;
+  }
+
+  int64_t
+  high_timestamp() const
+  {
+    return _header->high_timestamp;
+  }
+
+  const char *
+  symbol_str() const
+  {
+    return _symbol_str;
+  }
+
+  const char *
+  printf_str() const
+  {
+    return _printf_str;
+  }
+
+  uint8_t
+  type(int col) const
+  {
+    return _columns[col].type;
+  }
+
+  uint8_t
+  encoding(int col) const
+  {
+    return _columns[col].encoding;
+  }
+
+  std::string_view
+  name(int col) const
+  {
+    return _names[col];
+  }
+
+  /// The index of the column named @a name, -1 if there is none.
+  int find(std::string_view name) const;
+
+  /// Decode an integer or timestamp column.
+  bool read_ints(int col, std::vector<int64_t> &out) const;
+
+  /// Decode a string or IP column, the values reference the segment.
+  bool read_strings(int col, std::vector<std::string_view> &out) const;
+
+  /** Decode a dictionary encoded string column without resolving the values.
+   *
+   * @return @c false if the column is not dictionary encoded.
+   */
+  bool read_dictionary(int col, std::vector<std::string_view> &dict, std::vector<uint32_t> &index) const;
+
+  /** Marshal each row back into a log entry, as for a LogBuffer.
+   *
+   * @param fn Called with each entry, which is valid for the call. Return @c false to stop.
+   * @return @c false if a column can not be decoded.
+   */
+  bool for_each_entry(const std::function<bool(const LogEntryHeader *)> &fn) const;
+
+private:
+  const char                     *_data       = nullptr;
+  const LogColumnarSegmentHeader *_header     = nullptr;
+  const LogColumnarColumnHeader  *_columns    = nullptr;
+  const char                     *_symbol_str = nullptr;
+  const char                     *_printf_str = nullptr;
+  std::vector<std::string_view>   _names;
+};
+
+/// A columnar log file mapped for reading.
+class LogColumnarFile
+{
+public:
+  LogColumnarFile() = default;
+  ~LogColumnarFile();
+
+  LogColumnarFile(const LogColumnarFile &)            = delete;
+  LogColumnarFile &operator=(const LogColumnarFile &) = delete;
+
+  /// Map @a path, @c false with @c errno set if it can not be opened or mapped.
+  bool open(const char *path);
+
+  /** Read the next segment.
+   *
+   * @return @c false at the end of the file or at a truncated or invalid segment.
+   */
+  bool next(LogColumnarSegment &segment);
+
+  std::string_view
+  data() const
+  {
+    return {_data, _size};
+  }
+
+private:
+  const char *_data   = nullptr;
+  size_t      _size   = 0;
+  size_t      _offset = 0;
+};
@@ -0,0 +1,95 @@
+/** @file
+
+  Streaming compression of ASCII log files
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+enum LogCompressionType {
+  LOG_COMPRESSION_NONE,
+  LOG_COMPRESSION_GZIP,
+  LOG_COMPRESSION_ZSTD,
+};
+
+/** A streaming encoder for the ASCII output of a log file.
+ *
+ * The output of a file is a sequence of frames, gzip members or zstd frames, which the usual
+ * tools decompress as one stream. A frame is started by the first write after the file is opened
+ * and is ended when the file is rolled or closed. Each write is flushed to a block boundary so
+ * that the file can be read up to the last complete write while the frame is still open.
+ *
+ * Only used from the log flush thread, it is not thread safe.
+ */
+class LogCompressor
+{
+public:
+  /** Create an encoder.
+   *
+   * @param type The compression type, not @c LOG_COMPRESSION_NONE.
+   * @param level The compression level, 0 for the default of @a type.
+   * @return The encoder, @c nullptr if @a type is not supported by this build.
+   */
+  static std::unique_ptr<LogCompressor> create(LogCompressionType type, int level = 0);
+
+  /** Parse the name of a compression type.
+   *
+   * @return @c true if @a name is "none", "gzip" or "zstd".
+   */
+  static bool parse(std::string_view name, LogCompressionType &type);
+
+  static const char *name(LogCompressionType type);
+
+  /** The file name extension of @a type, appended to the default ".log" extension.
+   *
+   * @return ".gz" or ".zst", @c nullptr if @a type is @c LOG_COMPRESSION_NONE or is not supported
+   * by this build.
+   */
+  static const char *extension(LogCompressionType type);
+
+  virtual ~LogCompressor() = default;
+
+  /** Compress @a data, starting a new frame if there is none.
+   *
+   * @param out The compressed output is appended to this.
+   * @return @c false on an encoder error, the frame is then abandoned.
+   */
+  virtual bool write(std::string_view data, std::string &out) = 0;
+
+  /** End the current frame, if there is one.
+   *
+   * @param out The end of the frame is appended to this.
+   * @return @c false on an encoder error.
+   */
+  virtual bool finish(std::string &out) = 0;
+
+  bool
+  in_frame() const
+  {
+    return _in_frame;
+  }
+
+protected:
+  bool _in_frame = false;
+};
@@ -190,6 +190,9 @@ public:
   static bool      isContainerUpdateFieldSupported(Container container);
 
 private:
+  friend class LogColumnarSchema;
+  friend class LogRenderPlan;
+
   char                 *m_name;
   char                 *m_symbol;
   Type                  m_type;
@@ -25,12 +25,18 @@
 
 #include <cstdarg>
 #include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
 
 #include "tscore/ink_platform.h"
 #include "proxy/logging/LogBufferSink.h"
+#include "proxy/logging/LogCompressor.h"
 
 class LogBuffer;
 struct LogBufferHeader;
+class LogColumnarSchema;
+class LogRenderPlan;
 class LogObject;
 class BaseLogFile;
 class BaseMetaInfo;
@@ -89,14 +95,62 @@ public:
     return m_escape_type;
   }
 
+  /** Compress the ASCII output of the file.
+   *
+   * Must be called before the file is opened.
+   *
+   * @return @c false if the output is not compressed, because the file is not an ASCII file or
+   * @a type is not supported by this build.
+   */
+  bool set_compression(LogCompressionType type, int level = 0);
+
+  bool
+  is_compressed() const
+  {
+    return m_compressor != nullptr;
+  }
+
+  /** Render entries with @a plan, for buffers of the format it was compiled from.
+   *
+   * Entries of other buffers are rendered by @c LogBuffer::to_ascii.
+   */
+  void
+  set_render_plan(std::shared_ptr<const LogRenderPlan> plan)
+  {
+    m_render_plan = std::move(plan);
+  }
+
+  /// Encode the entries of buffers of the schema's format, for a columnar file.
+  void
+  set_columnar_schema(std::shared_ptr<const LogColumnarSchema> schema)
+  {
+    m_columnar_schema = std::move(schema);
+  }
+
+  /** Compress data for the file, from the flush thread after the file is opened.
+   *
+   * @return The compressed data, valid until the next call, empty on an encoder error.
+   */
+  std::string_view compress(const char *data, int len);
+
   const char *
   get_format_name() const
   {
-    return (m_file_format == LOG_FILE_BINARY ? "binary" : (m_file_format == LOG_FILE_PIPE ? "ascii_pipe" : "ascii"));
+    switch (m_file_format) {
+    case LOG_FILE_BINARY:
+      return "binary";
+    case LOG_FILE_PIPE:
+      return "ascii_pipe";
+    case LOG_FILE_COLUMNAR:
+      return "columnar";
+    default:
+      return "ascii";
+    }
   }
 
   static int  write_ascii_logbuffer(LogBufferHeader *buffer_header, int fd, const char *path, const char *alt_format = nullptr);
   int         write_ascii_logbuffer3(LogBufferHeader *buffer_header, const char *alt_format = nullptr);
+  int         write_columnar_logbuffer(LogBufferHeader *buffer_header);
   static bool rolled_logfile(char *file);
   static bool exists(const char *pathname);
 
@@ -128,6 +182,13 @@ private:
   char         *m_name;
   LogEscapeType m_escape_type;
 
+  std::unique_ptr<LogCompressor>           m_compressor;
+  std::string                              m_compressed; // output of m_compressor, reused between writes
+  std::shared_ptr<const LogRenderPlan>     m_render_plan;
+  std::shared_ptr<const LogColumnarSchema> m_columnar_schema;
+
+  void finish_compressed_frame();
+
 public:
   BaseLogFile *m_log; // BaseLogFile backs the actual file on disk
   char        *m_header;
@@ -25,9 +25,13 @@
 
 #define LOG_FIELD_MARKER '\377'
 
+#include <memory>
+
 #include "tscore/ink_platform.h"
 #include "proxy/logging/LogField.h"
 
+class LogRenderPlan;
+
 enum LogFormatType {
   // We start the numbering at 4 to compatibility with Traffic Server 4.x, which used
   // to have the predefined log formats enumerated above ...
@@ -38,7 +42,8 @@ enum LogFormatType {
 enum LogFileFormat {
   LOG_FILE_BINARY,
   LOG_FILE_ASCII,
-  LOG_FILE_PIPE, // ie. ASCII pipe
+  LOG_FILE_PIPE,     // ie. ASCII pipe
+  LOG_FILE_COLUMNAR, // see LogColumnar.h
   N_LOGFILE_TYPES
 };
 
@@ -121,6 +126,13 @@ public:
     return m_interval_sec;
   }
 
+  /// The format compiled for rendering entries as ASCII, @c nullptr for text formats.
+  std::shared_ptr<const LogRenderPlan>
+  render_plan() const
+  {
+    return m_render_plan;
+  }
+
 public:
   static int32_t    id_from_name(const char *name);
   static LogFormat *format_from_specification(char *spec, char **file_name, char **file_header, LogFileFormat *file_type);
@@ -165,6 +177,8 @@ private:
   LogFormatType m_format_type;
   LogEscapeType m_escape_type;
 
+  std::shared_ptr<const LogRenderPlan> m_render_plan;
+
 public:
   LINK(LogFormat, link);
 
@@ -45,9 +45,10 @@
   consist of a list of LogObjects.
   -------------------------------------------------------------------------*/
 
-#define LOG_FILE_ASCII_OBJECT_FILENAME_EXTENSION  ".log"
-#define LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION ".blog"
-#define LOG_FILE_PIPE_OBJECT_FILENAME_EXTENSION   ".pipe"
+#define LOG_FILE_ASCII_OBJECT_FILENAME_EXTENSION    ".log"
+#define LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION   ".blog"
+#define LOG_FILE_PIPE_OBJECT_FILENAME_EXTENSION     ".pipe"
+#define LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION ".clog"
 
 #define FLUSH_ARRAY_SIZE (512 * 4)
 
@@ -88,15 +89,18 @@ public:
     BINARY                   = 1,
     WRITES_TO_PIPE           = 4,
     LOG_OBJECT_FMT_TIMESTAMP = 8, // always format a timestamp into each log line (for raw text logs)
+    COLUMNAR                 = 16,
   };
 
   // BINARY: log is written in binary format (rather than ascii)
   // WRITES_TO_PIPE: object writes to a named pipe rather than to a file
+  // COLUMNAR: log is written in columnar segments (rather than ascii)
 
   LogObject(LogConfig *cfg, const LogFormat *format, const char *log_dir, const char *basename, LogFileFormat file_format,
             const char *header, Log::RollingEnabledValues rolling_enabled, int flush_threads, int rolling_interval_sec = 0,
             int rolling_offset_hr = 0, int rolling_size_mb = 0, bool auto_created = false, int rolling_max_count = 0,
-            int rolling_min_count = 0, bool reopen_after_rolling = false, int pipe_buffer_size = 0, bool m_fast = false);
+            int rolling_min_count = 0, bool reopen_after_rolling = false, int pipe_buffer_size = 0, bool m_fast = false,
+            LogCompressionType compression = LOG_COMPRESSION_NONE, int compression_level = 0);
   ~LogObject() override;
 
   void add_filter(LogFilter *filter, bool copy = true);
@@ -280,7 +284,8 @@ private:
   int  m_pipe_buffer_size;
   bool m_fast; // use fast buffering (thread local logbuffers)
 
-  void generate_filenames(const char *log_dir, const char *basename, LogFileFormat file_format);
+  void generate_filenames(const char *log_dir, const char *basename, LogFileFormat file_format,
+                          LogCompressionType compression = LOG_COMPRESSION_NONE);
   void _setup_rolling(LogConfig *cfg, Log::RollingEnabledValues rolling_enabled, int rolling_interval_sec, int rolling_offset_hr,
                       int rolling_size_mb);
   unsigned _roll_files(long interval_start, long interval_end);
@@ -0,0 +1,105 @@
+/** @file
+
+  A log format compiled for rendering entries as ASCII
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "proxy/logging/LogField.h"
+
+struct LogEntryHeader;
+
+/** The steps to render an entry of a log format as ASCII.
+ *
+ * @c LogBuffer::to_ascii walks the printf string of the format and dispatches each field through
+ * @c LogField::unmarshal for every entry. A plan is compiled once, when the format is created, into
+ * a flat array of ops, each a literal span followed by a field decoder resolved to its function, so
+ * that rendering is a loop of copies and direct calls into the output buffer.
+ *
+ * The plan owns its fields, it can outlive the format it was compiled from.
+ */
+class LogRenderPlan
+{
+public:
+  /** Compile a format.
+   *
+   * @param symbol_str The field symbols of the format, as in a buffer header.
+   * @param printf_str The printf string of the format, as in a buffer header.
+   * @param escape_type The escaping of string fields.
+   */
+  LogRenderPlan(const char *symbol_str, const char *printf_str, LogEscapeType escape_type);
+
+  LogRenderPlan(const LogRenderPlan &)            = delete;
+  LogRenderPlan &operator=(const LogRenderPlan &) = delete;
+
+  /// Whether the format could be compiled, which fails if there are more field markers than fields.
+  bool
+  valid() const
+  {
+    return _valid;
+  }
+
+  /// Whether the plan renders entries of buffers with these format strings.
+  bool matches(const char *symbol_str, const char *printf_str) const;
+
+  /** Render an entry.
+   *
+   * @param entry The entry, followed by its marshalled fields.
+   * @param buf The output, not terminated.
+   * @param len The size of @a buf.
+   * @return The number of bytes written, 0 if the entry does not fit.
+   */
+  int render(const LogEntryHeader *entry, char *buf, int len) const;
+
+private:
+  struct Op {
+    enum Kind : uint8_t {
+      LITERAL, ///< Only the literal span.
+      PLAIN,
+      SLICE,
+      MAP,
+    };
+
+    uint32_t  literal_offset = 0; ///< Offset of the literal span in @c _literals.
+    uint32_t  literal_len    = 0;
+    Kind      kind           = LITERAL;
+    LogField *field          = nullptr;
+    union {
+      LogField::UnmarshalFunc          plain = nullptr;
+      LogField::UnmarshalFuncWithSlice slice;
+      LogField::UnmarshalFuncWithMap   map;
+    };
+  };
+
+  std::string     _symbol_str;
+  std::string     _printf_str;
+  LogEscapeType   _escape_type;
+  LogFieldList    _fields;
+  std::string     _literals;
+  std::vector<Op> _ops;
+  bool            _valid = false;
+
+  int overflow() const;
+};
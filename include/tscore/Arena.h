@@ -25,6 +25,7 @@
 
 #include <sys/types.h>
 #include <memory.h>
+#include <cstdint>
 #include "tscore/ink_assert.h"
 
 struct ArenaBlock {
@@ -34,9 +35,23 @@ struct ArenaBlock {
   char        data[8];
 };
 
+/** Bump allocator, all memory is released at once by @c reset.
+
+    Default size blocks are recycled through a small per thread cache before going back to the
+    global freelist, so an arena that is created and reset on the same thread (e.g. one per
+    transaction) does not touch shared allocator state in the steady state.
+ */
 class Arena
 {
 public:
+  /// Allocation counts since the last @c reset.
+  struct Stats {
+    uint64_t allocs        = 0; ///< Number of allocations.
+    uint64_t bytes         = 0; ///< Bytes requested.
+    uint64_t blocks        = 0; ///< Blocks added to the arena.
+    uint64_t blocks_reused = 0; ///< Blocks taken from the per thread cache.
+  };
+
   Arena() {}
   ~Arena() { reset(); }
   void  *alloc(size_t size, size_t alignment = sizeof(double));
@@ -48,8 +63,15 @@ public:
 
   void reset();
 
+  const Stats &
+  stats() const
+  {
+    return m_stats;
+  }
+
 private:
   ArenaBlock *m_blocks = nullptr;
+  Stats       m_stats;
 };
 
 /*-------------------------------------------------------------------------
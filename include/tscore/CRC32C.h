@@ -0,0 +1,47 @@
+/** @file
+
+  CRC-32C (Castagnoli) checksum.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ts
+{
+/** Compute the CRC-32C of @a len bytes at @a data.
+ *
+ * @a crc is the result for the preceding data, to checksum data in pieces.
+ *
+ * The SSE 4.2 CRC32 instruction is used on x86-64 CPUs which have it, and the ARMv8 CRC32C
+ * instructions on builds for ARM CPUs with the CRC extension. Otherwise a table driven
+ * implementation is used.
+ */
+uint32_t crc32c(const void *data, size_t len, uint32_t crc = 0);
+
+/// Table driven CRC-32C, for testing and comparison.
+uint32_t crc32c_sw(const void *data, size_t len, uint32_t crc = 0);
+
+/// @return @c true if @c crc32c uses CPU instructions.
+bool crc32c_hw_available();
+
+} // namespace ts
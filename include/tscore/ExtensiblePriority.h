@@ -0,0 +1,196 @@
+/** @file
+
+  Extensible Priorities (RFC 9218) and a stream scheduler for them.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/ink_assert.h"
+#include "tscore/List.h"
+
+#include <cstdint>
+#include <string_view>
+
+/** The priority parameters of a request, [RFC 9218] 4.
+ */
+struct ExtensiblePriority {
+  static constexpr uint8_t URGENCY_LEVELS  = 8;
+  static constexpr uint8_t DEFAULT_URGENCY = 3;
+
+  uint8_t urgency     = DEFAULT_URGENCY; ///< 0 is the most urgent.
+  bool    incremental = false;           ///< Whether the response can be used as it arrives.
+
+  /** Parse a Priority header field value or the value of a PRIORITY_UPDATE frame.
+   *
+   * The value is a Structured Fields Dictionary ([RFC 8941] 3.2). Parameters that are missing, unknown or out of range are
+   * ignored and a value that is not a valid Dictionary is ignored as a whole, which leaves the defaults.
+   */
+  static ExtensiblePriority parse(std::string_view value);
+
+  bool
+  operator==(const ExtensiblePriority &that) const
+  {
+    return urgency == that.urgency && incremental == that.incremental;
+  }
+
+  bool
+  operator!=(const ExtensiblePriority &that) const
+  {
+    return !(*this == that);
+  }
+};
+
+/** A scheduler of streams by Extensible Priorities, [RFC 9218] 10.
+ *
+ * There is a round robin list per urgency level and the scheduler picks the head of the most urgent list that is not empty.
+ * After a stream sent some data it is rotated to the tail of its list if it is incremental and stays at the head otherwise,
+ * so that non-incremental streams are served one at a time, in the order they became ready.
+ *
+ * The list links are in an @c Entry embedded in the stream, the scheduler never allocates.
+ */
+template <class C> class ExtensiblePriorityQueue
+{
+public:
+  class Entry
+  {
+  public:
+    explicit Entry(C *owner) : _owner(owner) {}
+
+    const ExtensiblePriority &
+    priority() const
+    {
+      return _priority;
+    }
+
+    /// Set the priority of an entry that is not queued, use @c reprioritize otherwise.
+    void
+    set_priority(const ExtensiblePriority &priority)
+    {
+      ink_assert(!_queued);
+      _priority = priority;
+    }
+
+    LINK(Entry, link);
+
+  private:
+    friend class ExtensiblePriorityQueue;
+
+    C                 *_owner = nullptr;
+    ExtensiblePriority _priority;
+    bool               _queued = false;
+  };
+
+  /// Add @a e to the tail of its urgency list, if it is not queued yet.
+  void push(Entry &e);
+
+  /// Remove @a e, if it is queued.
+  void remove(Entry &e);
+
+  /// The stream to send next, or @c nullptr if there is none.
+  C *top() const;
+
+  /// Move @a e behind the other streams of its urgency, if it is incremental.
+  void sent(Entry &e);
+
+  /// Change the priority of @a e, moving it to the tail of the new urgency list if it is queued.
+  void reprioritize(Entry &e, const ExtensiblePriority &priority);
+
+  bool
+  empty() const
+  {
+    return _levels == 0;
+  }
+
+  bool
+  in(const Entry &e) const
+  {
+    return e._queued;
+  }
+
+private:
+  Queue<Entry> _lists[ExtensiblePriority::URGENCY_LEVELS];
+  uint8_t      _levels = 0; ///< Bit per urgency level that has a stream queued.
+};
+
+template <class C>
+void
+ExtensiblePriorityQueue<C>::push(Entry &e)
+{
+  if (e._queued) {
+    return;
+  }
+  _lists[e._priority.urgency].enqueue(&e);
+  _levels   |= 1 << e._priority.urgency;
+  e._queued  = true;
+}
+
+template <class C>
+void
+ExtensiblePriorityQueue<C>::remove(Entry &e)
+{
+  if (!e._queued) {
+    return;
+  }
+  Queue<Entry> &list = _lists[e._priority.urgency];
+  list.remove(&e);
+  if (list.empty()) {
+    _levels &= ~(1 << e._priority.urgency);
+  }
+  e._queued = false;
+}
+
+template <class C>
+C *
+ExtensiblePriorityQueue<C>::top() const
+{
+  if (_levels == 0) {
+    return nullptr;
+  }
+  return _lists[__builtin_ctz(_levels)].head->_owner;
+}
+
+template <class C>
+void
+ExtensiblePriorityQueue<C>::sent(Entry &e)
+{
+  ink_assert(e._queued);
+  Queue<Entry> &list = _lists[e._priority.urgency];
+  if (e._priority.incremental && list.tail != &e) {
+    list.remove(&e);
+    list.enqueue(&e);
+  }
+}
+
+template <class C>
+void
+ExtensiblePriorityQueue<C>::reprioritize(Entry &e, const ExtensiblePriority &priority)
+{
+  ink_assert(priority.urgency < ExtensiblePriority::URGENCY_LEVELS);
+  if (e._priority == priority) {
+    return;
+  }
+  bool queued = e._queued;
+  remove(e);
+  e._priority = priority;
+  if (queued) {
+    push(e);
+  }
+}
@@ -177,14 +177,31 @@ union head_p {
 #error "unsupported processor"
 #endif
 
+/*
+ * Each freelist has a separate list per NUMA node. A thread uses the list of the node it is bound
+ * to (see ink_freelist_set_thread_node) and new chunks for that list are allocated from address
+ * space reserved for, and bound to, that node. Threads which are not bound use node 0. An item is
+ * returned to the list of the node its memory belongs to, whichever thread frees it. Only when the
+ * memory of its node is exhausted does a thread take items from the lists of the other nodes.
+ */
+#define INK_FREELIST_MAX_NODES 8
+// Default address space reserved for the chunks of each NUMA node, see ink_freelist_set_node_limit.
+#define INK_FREELIST_NODE_LIMIT (static_cast<size_t>(64) << 30)
+
+struct alignas(64) InkFreeListNode {
+  head_p  head;
+  int32_t used;      // items taken from this list less items returned to it
+  int32_t allocated; // items allocated in chunks for this list
+};
+
 struct _InkFreeList {
-  head_p      head;
-  const char *name;
-  uint32_t    type_size, chunk_size, used, allocated, alignment;
-  uint32_t    allocated_base, used_base;
-  uint32_t    hugepages_failure;
-  bool        use_hugepages;
-  int         advice;
+  const char     *name;
+  uint32_t        type_size, chunk_size, alignment;
+  uint32_t        allocated_base, used_base;
+  uint32_t        hugepages_failure;
+  bool            use_hugepages;
+  int             advice;
+  InkFreeListNode nodes[INK_FREELIST_MAX_NODES];
 };
 
 using InkFreeListOps = struct ink_freelist_ops;
@@ -211,6 +228,19 @@ void  ink_freelists_dump(FILE *f);
 void  ink_freelists_dump_baselinerel(FILE *f);
 void  ink_freelists_snap_baseline();
 
+/*
+ * NUMA node support. The node is the operating system index of the NUMA node the calling thread
+ * is bound to, or -1 if the thread is not bound to a single node. Nodes from INK_FREELIST_MAX_NODES
+ * on are rejected with a warning, and the thread uses node 0.
+ */
+void ink_freelist_set_thread_node(int node);
+int  ink_freelist_thread_node();
+// Bytes allocated for, and bytes currently free in, the lists of @a node across all freelists.
+void ink_freelists_node_stats(int node, uint64_t *allocated, uint64_t *free);
+// Limit the memory for the chunks of each NUMA node to @a bytes, for the nodes which have not
+// allocated yet. Threads of a node at its limit take free items from the other nodes.
+void ink_freelist_set_node_limit(size_t bytes);
+
 struct InkAtomicList {
   InkAtomicList() {}
   head_p      head{};
@@ -75,7 +75,7 @@ public:
   /// Samples less than this go in the underflow range.
   static constexpr raw_type UNDERFLOW_BOUND = static_cast<raw_type>(1) << N_SPAN_BITS;
   /// Sample equal or greater than this  go in the overflow bucket.
-  static constexpr raw_type OVERFLOW_BOUND = static_cast<raw_type>(1) << (N_RANGE_BITS + N_SPAN_BITS + 1);
+  static constexpr raw_type OVERFLOW_BOUND = static_cast<raw_type>(1) << (N_RANGE_BITS + N_SPAN_BITS);
 
   /** Add @sample to the histogram.
    *
@@ -172,7 +172,7 @@ Histogram<R, S>::min_for_bucket(unsigned idx) -> raw_type
   raw_type base      = 0; // minimum value for the range (not span!).
   raw_type span_size = 1; // for @a range 0 or 1
   if (range > 0) {
-    base = 1 << (range + N_SPAN_BITS - 1);
+    base = static_cast<raw_type>(1) << (range + N_SPAN_BITS - 1);
     if (range > 1) { // at @a range == 1 this would be 0, which is wrong.
       span_size = base >> N_SPAN_BITS;
     }
@@ -39,8 +39,14 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <zlib.h>
+#include <atomic>
 #include <fstream>
 #include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <ts/remap.h>
 
@@ -48,6 +54,8 @@
 
 #include <tsutil/ts_ip.h>
 
+#include "yaml-cpp/yaml.h"
+
 #include "tscore/ink_config.h"
 #if HAVE_BROTLI_ENCODE_H
 #include <brotli/encode.h>
@@ -68,6 +76,9 @@ static const swoc::IP6Range DEFAULT_IP6{swoc::IP6Addr::MIN, swoc::IP6Addr::MAX};
 /* global holding the path used for access to this JSON data */
 std::string const DEFAULT_URL_PATH = "_stats";
 
+/* JSON-RPC method serving the stats snapshots */
+static constexpr std::string_view RPC_METHOD_NAME{"stats_over_http_snapshot"};
+
 // from mod_deflate:
 // ZLIB's compression algorithm uses a
 // 0-9 based scale that GZIP does where '1' is 'Best speed'
@@ -105,8 +116,8 @@ struct config_holder_t {
   config_t       *config;
 };
 
-enum output_format { JSON_OUTPUT, CSV_OUTPUT };
-enum encoding_format { NONE, DEFLATE, GZIP, BR };
+enum output_format { JSON_OUTPUT, CSV_OUTPUT, PROMETHEUS_OUTPUT, N_OUTPUT_FORMATS };
+enum encoding_format { NONE, DEFLATE, GZIP, BR, N_ENCODING_FORMATS };
 
 int    configReloadRequests = 0;
 int    configReloads        = 0;
@@ -120,18 +131,6 @@ static config_t        *get_config(TSCont cont);
 static config_holder_t *new_config_holder(const char *path);
 static bool             is_ipmap_allowed(const config_t *config, const struct sockaddr *addr);
 
-#if HAVE_BROTLI_ENCODE_H
-struct b_stream {
-  BrotliEncoderState *br;
-  uint8_t            *next_in;
-  size_t              avail_in;
-  uint8_t            *next_out;
-  size_t              avail_out;
-  size_t              total_in;
-  size_t              total_out;
-};
-#endif
-
 struct stats_state {
   TSVConn net_vc;
   TSVIO   read_vio;
@@ -142,15 +141,45 @@ struct stats_state {
   TSIOBufferReader resp_reader;
 
   int             output_bytes;
-  int             body_written;
   output_format   output;
   encoding_format encoding;
-  z_stream        zstrm;
-#if HAVE_BROTLI_ENCODE_H
-  b_stream bstrm;
-#endif
+  uint64_t        since; ///< Only the stats changed after this snapshot version, 0 for all of them.
+};
+
+/* A snapshot of the stats. Snapshots are taken every snapshot_interval milliseconds on a task thread, or for each scrape if
+   that is 0, and are not changed once published. The body of a full scrape is rendered and compressed at most once per
+   snapshot, and the bodies scraped from a snapshot are rendered ahead of the scrapes of the next one.
+ */
+struct stat_value {
+  std::string      name;
+  std::string      value; ///< Formatted, unquoted.
+  TSRecordDataType type;
+  uint64_t         changed; ///< Version of the snapshot in which the value last changed.
+};
+
+struct rendered_body {
+  bool            done     = false;
+  encoding_format encoding = NONE; ///< The encoding of @a body, @c NONE if compressing failed.
+  std::string     body;
+};
+
+struct stats_snapshot {
+  uint64_t                version  = 0;
+  uint64_t                epoch_ms = 0;
+  std::vector<stat_value> stats;
+
+  std::mutex    body_mutex;
+  rendered_body bodies[N_OUTPUT_FORMATS][N_ENCODING_FORMATS];
 };
 
+using snapshot_ptr = std::shared_ptr<stats_snapshot>;
+
+static int                   snapshot_interval = 0;
+static std::mutex            snapshot_mutex; ///< Serializes taking snapshots.
+static std::mutex            current_mutex;  ///< Guards @c current_snapshot.
+static snapshot_ptr          current_snapshot;
+static std::atomic<unsigned> scraped_bodies{0}; ///< Bit per format and encoding scraped from the current snapshot.
+
 static char *
 nstr(const char *s)
 {
@@ -159,29 +188,6 @@ nstr(const char *s)
   return mys;
 }
 
-#if HAVE_BROTLI_ENCODE_H
-encoding_format
-init_br(stats_state *my_state)
-{
-  my_state->bstrm.br = nullptr;
-
-  my_state->bstrm.br = BrotliEncoderCreateInstance(nullptr, nullptr, nullptr);
-  if (!my_state->bstrm.br) {
-    Dbg(dbg_ctl, "Brotli Encoder Instance Failed");
-    return NONE;
-  }
-  BrotliEncoderSetParameter(my_state->bstrm.br, BROTLI_PARAM_QUALITY, BROTLI_COMPRESSION_LEVEL);
-  BrotliEncoderSetParameter(my_state->bstrm.br, BROTLI_PARAM_LGWIN, BROTLI_LGW);
-  my_state->bstrm.next_in   = nullptr;
-  my_state->bstrm.avail_in  = 0;
-  my_state->bstrm.total_in  = 0;
-  my_state->bstrm.next_out  = nullptr;
-  my_state->bstrm.avail_out = 0;
-  my_state->bstrm.total_out = 0;
-  return BR;
-}
-#endif
-
 namespace
 {
 inline uint64_t
@@ -191,33 +197,52 @@ ms_since_epoch()
 }
 } // namespace
 
-encoding_format
-init_gzip(stats_state *my_state, int mode)
-{
-  my_state->zstrm.next_in   = Z_NULL;
-  my_state->zstrm.avail_in  = 0;
-  my_state->zstrm.total_in  = 0;
-  my_state->zstrm.next_out  = Z_NULL;
-  my_state->zstrm.avail_out = 0;
-  my_state->zstrm.total_out = 0;
-  my_state->zstrm.zalloc    = Z_NULL;
-  my_state->zstrm.zfree     = Z_NULL;
-  my_state->zstrm.opaque    = Z_NULL;
-  my_state->zstrm.data_type = Z_ASCII;
-  int err = deflateInit2(&my_state->zstrm, ZLIB_COMPRESSION_LEVEL, Z_DEFLATED, mode, ZLIB_MEMLEVEL, Z_DEFAULT_STRATEGY);
+// Takes the uncompressed body and compresses it into out. Returns false if compression failed.
+static bool
+gzip_body(const std::string &in, int mode, std::string &out)
+{
+  z_stream zstrm;
+  memset(&zstrm, 0, sizeof(zstrm));
+  zstrm.data_type = Z_ASCII;
+  int err         = deflateInit2(&zstrm, ZLIB_COMPRESSION_LEVEL, Z_DEFLATED, mode, ZLIB_MEMLEVEL, Z_DEFAULT_STRATEGY);
   if (err != Z_OK) {
     Dbg(dbg_ctl, "gzip initialization failed");
-    return NONE;
-  } else {
-    Dbg(dbg_ctl, "gzip initialized successfully");
-    if (mode == GZIP_MODE) {
-      return GZIP;
-    } else if (mode == DEFLATE_MODE) {
-      return DEFLATE;
-    }
+    return false;
+  }
+
+  out.resize(deflateBound(&zstrm, in.size()));
+  zstrm.next_in   = (Bytef *)in.data();
+  zstrm.avail_in  = in.size();
+  zstrm.next_out  = (Bytef *)out.data();
+  zstrm.avail_out = out.size();
+  err             = deflate(&zstrm, Z_FINISH);
+  if (err != Z_STREAM_END) {
+    Dbg(dbg_ctl, "deflate error: %d", err);
+  }
+  out.resize(zstrm.total_out);
+
+  if (int end_err = deflateEnd(&zstrm); end_err != Z_OK) {
+    Dbg(dbg_ctl, "deflate end err: %d", end_err);
+  }
+  return err == Z_STREAM_END;
+}
+
+#if HAVE_BROTLI_ENCODE_H
+static bool
+br_body(const std::string &in, std::string &out)
+{
+  size_t outputsize = BrotliEncoderMaxCompressedSize(in.size());
+  out.resize(outputsize);
+  if (BrotliEncoderCompress(BROTLI_COMPRESSION_LEVEL, BROTLI_LGW, BROTLI_DEFAULT_MODE, in.size(),
+                            reinterpret_cast<const uint8_t *>(in.data()), &outputsize,
+                            reinterpret_cast<uint8_t *>(out.data())) == BROTLI_FALSE) {
+    Dbg(dbg_ctl, "brotli compress error");
+    return false;
   }
-  return NONE;
+  out.resize(outputsize);
+  return true;
 }
+#endif
 
 static void
 stats_cleanup(TSCont contp, stats_state *my_state)
@@ -247,119 +272,32 @@ stats_process_accept(TSCont contp, stats_state *my_state)
 }
 
 static int
-stats_add_data_to_resp_buffer(const char *s, stats_state *my_state)
+stats_add_data_to_resp_buffer(const char *s, int s_len, stats_state *my_state)
 {
-  int s_len = strlen(s);
-
   TSIOBufferWrite(my_state->resp_buffer, s, s_len);
 
   return s_len;
 }
 
-static const char RESP_HEADER_JSON[] = "HTTP/1.0 200 OK\r\nContent-Type: text/json\r\nCache-Control: no-cache\r\n\r\n";
-static const char RESP_HEADER_JSON_GZIP[] =
-  "HTTP/1.0 200 OK\r\nContent-Type: text/json\r\nContent-Encoding: gzip\r\nCache-Control: no-cache\r\n\r\n";
-static const char RESP_HEADER_JSON_DEFLATE[] =
-  "HTTP/1.0 200 OK\r\nContent-Type: text/json\r\nContent-Encoding: deflate\r\nCache-Control: no-cache\r\n\r\n";
-static const char RESP_HEADER_JSON_BR[] =
-  "HTTP/1.0 200 OK\r\nContent-Type: text/json\r\nContent-Encoding: br\r\nCache-Control: no-cache\r\n\r\n";
-static const char RESP_HEADER_CSV[] = "HTTP/1.0 200 OK\r\nContent-Type: text/csv\r\nCache-Control: no-cache\r\n\r\n";
-static const char RESP_HEADER_CSV_GZIP[] =
-  "HTTP/1.0 200 OK\r\nContent-Type: text/csv\r\nContent-Encoding: gzip\r\nCache-Control: no-cache\r\n\r\n";
-static const char RESP_HEADER_CSV_DEFLATE[] =
-  "HTTP/1.0 200 OK\r\nContent-Type: text/csv\r\nContent-Encoding: deflate\r\nCache-Control: no-cache\r\n\r\n";
-static const char RESP_HEADER_CSV_BR[] =
-  "HTTP/1.0 200 OK\r\nContent-Type: text/csv\r\nContent-Encoding: br\r\nCache-Control: no-cache\r\n\r\n";
+static const char *const CONTENT_TYPES[N_OUTPUT_FORMATS] = {"text/json", "text/csv", "text/plain; version=0.0.4"};
+static const char *const CONTENT_ENCODINGS[N_ENCODING_FORMATS] = {nullptr, "deflate", "gzip", "br"};
 
 static int
 stats_add_resp_header(stats_state *my_state)
 {
-  switch (my_state->output) {
-  case JSON_OUTPUT:
-    if (my_state->encoding == GZIP) {
-      return stats_add_data_to_resp_buffer(RESP_HEADER_JSON_GZIP, my_state);
-    } else if (my_state->encoding == DEFLATE) {
-      return stats_add_data_to_resp_buffer(RESP_HEADER_JSON_DEFLATE, my_state);
-    } else if (my_state->encoding == BR) {
-      return stats_add_data_to_resp_buffer(RESP_HEADER_JSON_BR, my_state);
-    } else {
-      return stats_add_data_to_resp_buffer(RESP_HEADER_JSON, my_state);
-    }
-    break;
-  case CSV_OUTPUT:
-    if (my_state->encoding == GZIP) {
-      return stats_add_data_to_resp_buffer(RESP_HEADER_CSV_GZIP, my_state);
-    } else if (my_state->encoding == DEFLATE) {
-      return stats_add_data_to_resp_buffer(RESP_HEADER_CSV_DEFLATE, my_state);
-    } else if (my_state->encoding == BR) {
-      return stats_add_data_to_resp_buffer(RESP_HEADER_CSV_BR, my_state);
-    } else {
-      return stats_add_data_to_resp_buffer(RESP_HEADER_CSV, my_state);
-    }
-    break;
-  default:
-    TSError("stats_add_resp_header: Unknown output format");
-    break;
-  }
-  return stats_add_data_to_resp_buffer(RESP_HEADER_JSON, my_state);
-}
+  char b[256];
+  int  len;
 
-static void
-stats_process_read(TSCont contp, TSEvent event, stats_state *my_state)
-{
-  Dbg(dbg_ctl, "stats_process_read(%d)", event);
-  if (event == TS_EVENT_VCONN_READ_READY) {
-    my_state->output_bytes = stats_add_resp_header(my_state);
-    TSVConnShutdown(my_state->net_vc, 1, 0);
-    my_state->write_vio = TSVConnWrite(my_state->net_vc, contp, my_state->resp_reader, INT64_MAX);
-  } else if (event == TS_EVENT_ERROR) {
-    TSError("[%s] stats_process_read: Received TS_EVENT_ERROR", PLUGIN_NAME);
-  } else if (event == TS_EVENT_VCONN_EOS) {
-    /* client may end the connection, simply return */
-    return;
-  } else if (event == TS_EVENT_NET_ACCEPT_FAILED) {
-    TSError("[%s] stats_process_read: Received TS_EVENT_NET_ACCEPT_FAILED", PLUGIN_NAME);
+  if (CONTENT_ENCODINGS[my_state->encoding]) {
+    len = snprintf(b, sizeof(b), "HTTP/1.0 200 OK\r\nContent-Type: %s\r\nContent-Encoding: %s\r\nCache-Control: no-cache\r\n\r\n",
+                   CONTENT_TYPES[my_state->output], CONTENT_ENCODINGS[my_state->encoding]);
   } else {
-    printf("Unexpected Event %d\n", event);
-    TSReleaseAssert(!"Unexpected Event");
+    len = snprintf(b, sizeof(b), "HTTP/1.0 200 OK\r\nContent-Type: %s\r\nCache-Control: no-cache\r\n\r\n",
+                   CONTENT_TYPES[my_state->output]);
   }
+  return stats_add_data_to_resp_buffer(b, len, my_state);
 }
 
-#define APPEND(a) my_state->output_bytes += stats_add_data_to_resp_buffer(a, my_state)
-#define APPEND_STAT_JSON(a, fmt, v)                                              \
-  do {                                                                           \
-    char b[256];                                                                 \
-    if (snprintf(b, sizeof(b), "\"%s\": \"" fmt "\",\n", a, v) < (int)sizeof(b)) \
-      APPEND(b);                                                                 \
-  } while (0)
-#define APPEND_STAT_JSON_NUMERIC(a, fmt, v)                                          \
-  do {                                                                               \
-    char b[256];                                                                     \
-    if (integer_counters) {                                                          \
-      if (snprintf(b, sizeof(b), "\"%s\": " fmt ",\n", a, v) < (int)sizeof(b)) {     \
-        APPEND(b);                                                                   \
-      }                                                                              \
-    } else {                                                                         \
-      if (snprintf(b, sizeof(b), "\"%s\": \"" fmt "\",\n", a, v) < (int)sizeof(b)) { \
-        APPEND(b);                                                                   \
-      }                                                                              \
-    }                                                                                \
-  } while (0)
-
-#define APPEND_STAT_CSV(a, fmt, v)                                     \
-  do {                                                                 \
-    char b[256];                                                       \
-    if (snprintf(b, sizeof(b), "%s," fmt "\n", a, v) < (int)sizeof(b)) \
-      APPEND(b);                                                       \
-  } while (0)
-#define APPEND_STAT_CSV_NUMERIC(a, fmt, v)                               \
-  do {                                                                   \
-    char b[256];                                                         \
-    if (snprintf(b, sizeof(b), "%s," fmt "\n", a, v) < (int)sizeof(b)) { \
-      APPEND(b);                                                         \
-    }                                                                    \
-  } while (0)
-
 // This wraps uint64_t values to the int64_t range to fit into a Java long. Java 8 has an unsigned long which
 // can interoperate with a full uint64_t, but it's unlikely that much of the ecosystem supports that yet.
 static uint64_t
@@ -373,170 +311,262 @@ wrap_unsigned_counter(uint64_t value)
 }
 
 static void
-json_out_stat(TSRecordType rec_type, void *edata, int registered, const char *name, TSRecordDataType data_type, TSRecordData *datum)
+snapshot_stat(TSRecordType rec_type, void *edata, int registered, const char *name, TSRecordDataType data_type,
+              TSRecordData *datum)
 {
-  stats_state *my_state = static_cast<stats_state *>(edata);
+  stats_snapshot *snap = static_cast<stats_snapshot *>(edata);
+  char            b[64];
 
   switch (data_type) {
   case TS_RECORDDATATYPE_COUNTER:
-    APPEND_STAT_JSON_NUMERIC(name, "%" PRIu64, wrap_unsigned_counter(datum->rec_counter));
+    snprintf(b, sizeof(b), "%" PRIu64, wrap_unsigned_counter(datum->rec_counter));
     break;
   case TS_RECORDDATATYPE_INT:
-    APPEND_STAT_JSON_NUMERIC(name, "%" PRIu64, wrap_unsigned_counter(datum->rec_int));
+    snprintf(b, sizeof(b), "%" PRIu64, wrap_unsigned_counter(datum->rec_int));
     break;
   case TS_RECORDDATATYPE_FLOAT:
-    APPEND_STAT_JSON_NUMERIC(name, "%f", datum->rec_float);
+    snprintf(b, sizeof(b), "%f", datum->rec_float);
     break;
   case TS_RECORDDATATYPE_STRING:
-    APPEND_STAT_JSON(name, "%s", datum->rec_string);
-    break;
+    snap->stats.push_back({name, datum->rec_string ? datum->rec_string : "", data_type, snap->version});
+    return;
   default:
     Dbg(dbg_ctl, "unknown type for %s: %d", name, data_type);
-    break;
+    return;
   }
+  snap->stats.push_back({name, b, data_type, snap->version});
 }
 
 static void
-csv_out_stat(TSRecordType rec_type, void *edata, int registered, const char *name, TSRecordDataType data_type, TSRecordData *datum)
+json_out_stat(std::string &out, std::string_view name, std::string_view value, bool numeric)
 {
-  stats_state *my_state = static_cast<stats_state *>(edata);
-  switch (data_type) {
-  case TS_RECORDDATATYPE_COUNTER:
-    APPEND_STAT_CSV_NUMERIC(name, "%" PRIu64, wrap_unsigned_counter(datum->rec_counter));
-    break;
-  case TS_RECORDDATATYPE_INT:
-    APPEND_STAT_CSV_NUMERIC(name, "%" PRIu64, wrap_unsigned_counter(datum->rec_int));
+  out.append("\"").append(name).append("\": ");
+  if (numeric && integer_counters) {
+    out.append(value).append(",\n");
+  } else {
+    out.append("\"").append(value).append("\",\n");
+  }
+}
+
+static void
+json_out_stats(const stats_snapshot &snap, uint64_t since, std::string &out)
+{
+  out.append("{ \"global\": {\n");
+  for (auto const &stat : snap.stats) {
+    if (stat.changed > since) {
+      json_out_stat(out, stat.name, stat.value, stat.type != TS_RECORDDATATYPE_STRING);
+    }
+  }
+  json_out_stat(out, "current_time_epoch_ms", std::to_string(snap.epoch_ms), true);
+  json_out_stat(out, "snapshot_version", std::to_string(snap.version), true);
+  out.append("\"server\": \"").append(TSTrafficServerVersionGet()).append("\"\n");
+  out.append("  }\n}\n");
+}
+
+static void
+csv_out_stats(const stats_snapshot &snap, uint64_t since, std::string &out)
+{
+  for (auto const &stat : snap.stats) {
+    if (stat.changed > since) {
+      out.append(stat.name).append(",").append(stat.value).append("\n");
+    }
+  }
+  out.append("current_time_epoch_ms,").append(std::to_string(snap.epoch_ms)).append("\n");
+  out.append("snapshot_version,").append(std::to_string(snap.version)).append("\n");
+  out.append("version,").append(TSTrafficServerVersionGet()).append("\n");
+}
+
+// Prometheus text exposition format. Names are mapped to the metric name characters, string values are left out.
+static void
+prometheus_out_stats(const stats_snapshot &snap, uint64_t since, std::string &out)
+{
+  out.append("# snapshot_version ").append(std::to_string(snap.version)).append("\n");
+  for (auto const &stat : snap.stats) {
+    if (stat.changed > since && stat.type != TS_RECORDDATATYPE_STRING) {
+      size_t start = out.size();
+      out.append(stat.name);
+      for (size_t i = start; i < out.size(); ++i) {
+        if (!isalnum(out[i]) && out[i] != '_' && out[i] != ':') {
+          out[i] = '_';
+        }
+      }
+      out.append(" ").append(stat.value).append("\n");
+    }
+  }
+  out.append("traffic_server_info{version=\"").append(TSTrafficServerVersionGet()).append("\"} 1\n");
+}
+
+// Renders the body of a scrape. Returns the encoding of the body, NONE if compressing failed.
+static encoding_format
+render_body(const stats_snapshot &snap, output_format output, encoding_format encoding, uint64_t since, std::string &out)
+{
+  std::string text;
+  std::string &body = encoding == NONE ? out : text;
+
+  body.reserve(snap.stats.size() * 64);
+  switch (output) {
+  case JSON_OUTPUT:
+    json_out_stats(snap, since, body);
     break;
-  case TS_RECORDDATATYPE_FLOAT:
-    APPEND_STAT_CSV_NUMERIC(name, "%f", datum->rec_float);
+  case CSV_OUTPUT:
+    csv_out_stats(snap, since, body);
     break;
-  case TS_RECORDDATATYPE_STRING:
-    APPEND_STAT_CSV(name, "%s", datum->rec_string);
+  case PROMETHEUS_OUTPUT:
+    prometheus_out_stats(snap, since, body);
     break;
   default:
-    Dbg(dbg_ctl, "unknown type for %s: %d", name, data_type);
+    TSError("[%s] render_body: Unknown output type", PLUGIN_NAME);
     break;
   }
+
+  bool compressed = false;
+  if (encoding == GZIP || encoding == DEFLATE) {
+    compressed = gzip_body(text, encoding == GZIP ? GZIP_MODE : DEFLATE_MODE, out);
+  }
+#if HAVE_BROTLI_ENCODE_H
+  else if (encoding == BR) {
+    compressed = br_body(text, out);
+  }
+#endif
+  if (encoding != NONE && !compressed) {
+    out = std::move(text);
+    return NONE;
+  }
+  return encoding;
 }
 
-static void
-json_out_stats(stats_state *my_state)
+static unsigned
+body_bit(output_format output, encoding_format encoding)
 {
-  const char *version;
-  APPEND("{ \"global\": {\n");
-  TSRecordDump((TSRecordType)(TS_RECORDTYPE_PLUGIN | TS_RECORDTYPE_NODE | TS_RECORDTYPE_PROCESS), json_out_stat, my_state);
-  version = TSTrafficServerVersionGet();
-  APPEND_STAT_JSON_NUMERIC("current_time_epoch_ms", "%" PRIu64, ms_since_epoch());
-  APPEND("\"server\": \"");
-  APPEND(version);
-  APPEND("\"\n");
+  return 1u << (int(output) * N_ENCODING_FORMATS + int(encoding));
+}
 
-  APPEND("  }\n}\n");
+// Renders the full body of a scrape once per snapshot. Must be called with the snapshot's body_mutex held.
+static rendered_body &
+snapshot_body(stats_snapshot &snap, output_format output, encoding_format encoding)
+{
+  rendered_body &r = snap.bodies[output][encoding];
+  if (!r.done) {
+    r.encoding = render_body(snap, output, encoding, 0, r.body);
+    r.done     = true;
+  }
+  return r;
 }
 
-#if HAVE_BROTLI_ENCODE_H
-// Takes an input stats state struct holding the uncompressed
-// stats values. Compresses and copies it back into the state struct
-static void
-br_out_stats(stats_state *my_state)
+static snapshot_ptr
+take_snapshot()
 {
-  size_t  outputsize = BrotliEncoderMaxCompressedSize(my_state->output_bytes);
-  uint8_t inputbuf[my_state->output_bytes];
-  uint8_t outputbuf[outputsize];
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+  snapshot_ptr                prev;
+  {
+    std::lock_guard<std::mutex> current_lock(current_mutex);
+    prev = current_snapshot;
+  }
 
-  memset(&inputbuf, 0, sizeof(inputbuf));
-  memset(&outputbuf, 0, sizeof(outputbuf));
+  auto snap      = std::make_shared<stats_snapshot>();
+  snap->version  = prev ? prev->version + 1 : 1;
+  snap->epoch_ms = ms_since_epoch();
+  snap->stats.reserve(prev ? prev->stats.size() : 0);
+  TSRecordDump((TSRecordType)(TS_RECORDTYPE_PLUGIN | TS_RECORDTYPE_NODE | TS_RECORDTYPE_PROCESS), snapshot_stat, snap.get());
+
+  // Carry over the version of the last change of the values that did not change. The records are dumped in the same
+  // order each time, new ones at the end, so the previous value is found by position.
+  if (prev) {
+    for (size_t i = 0; i < snap->stats.size() && i < prev->stats.size(); ++i) {
+      auto &stat = snap->stats[i];
+      auto &old  = prev->stats[i];
+      if (stat.name == old.name && stat.value == old.value) {
+        stat.changed = old.changed;
+      }
+    }
+  }
 
-  int64_t inputbytes = TSIOBufferReaderCopy(my_state->resp_reader, &inputbuf, my_state->output_bytes);
+  // Render ahead the bodies scraped from the previous snapshot. Without an interval, each snapshot serves a single scrape,
+  // which renders only its own body.
+  if (snapshot_interval > 0) {
+    unsigned scraped = scraped_bodies.exchange(0);
+    for (int output = 0; output < N_OUTPUT_FORMATS; ++output) {
+      for (int encoding = 0; encoding < N_ENCODING_FORMATS; ++encoding) {
+        if (scraped & body_bit(static_cast<output_format>(output), static_cast<encoding_format>(encoding))) {
+          snapshot_body(*snap, static_cast<output_format>(output), static_cast<encoding_format>(encoding));
+        }
+      }
+    }
+  }
 
-  // Consume existing uncompressed buffer now that it has been stored to
-  // free up the buffer to contain the compressed data
-  int64_t toconsume = TSIOBufferReaderAvail(my_state->resp_reader);
-  TSIOBufferReaderConsume(my_state->resp_reader, toconsume);
-  my_state->output_bytes -= toconsume;
-  BROTLI_BOOL err = BrotliEncoderCompress(BROTLI_DEFAULT_QUALITY, BROTLI_DEFAULT_WINDOW, BROTLI_DEFAULT_MODE, inputbytes, inputbuf,
-                                          &outputsize, outputbuf);
+  std::lock_guard<std::mutex> current_lock(current_mutex);
+  current_snapshot = snap;
+  return snap;
+}
 
-  if (err == BROTLI_FALSE) {
-    Dbg(dbg_ctl, "brotli compress error");
+static snapshot_ptr
+get_snapshot()
+{
+  if (snapshot_interval > 0) {
+    std::lock_guard<std::mutex> lock(current_mutex);
+    if (current_snapshot) {
+      return current_snapshot;
+    }
   }
-  my_state->output_bytes += TSIOBufferWrite(my_state->resp_buffer, outputbuf, outputsize);
-  BrotliEncoderDestroyInstance(my_state->bstrm.br);
+  return take_snapshot();
+}
+
+static int
+snapshot_handler(TSCont contp, TSEvent event, void *edata)
+{
+  take_snapshot();
+  return 0;
 }
-#endif
 
-// Takes an input stats state struct holding the uncompressed
-// stats values. Compresses and copies it back into the state struct
 static void
-gzip_out_stats(stats_state *my_state)
-{
-  char inputbuf[my_state->output_bytes];
-  char outputbuf[deflateBound(&my_state->zstrm, my_state->output_bytes)];
-  memset(&inputbuf, 0, sizeof(inputbuf));
-  memset(&outputbuf, 0, sizeof(outputbuf));
-
-  int64_t inputbytes = TSIOBufferReaderCopy(my_state->resp_reader, &inputbuf, my_state->output_bytes);
-
-  // Consume existing uncompressed buffer now that it has been stored to
-  // free up the buffer to contain the compressed data
-  int64_t toconsume = TSIOBufferReaderAvail(my_state->resp_reader);
-  TSIOBufferReaderConsume(my_state->resp_reader, toconsume);
-
-  my_state->output_bytes    -= toconsume;
-  my_state->zstrm.avail_in   = inputbytes;
-  my_state->zstrm.avail_out  = sizeof(outputbuf);
-  my_state->zstrm.next_in    = (Bytef *)inputbuf;
-  my_state->zstrm.next_out   = (Bytef *)outputbuf;
-  int err                    = deflate(&my_state->zstrm, Z_FINISH);
-  if (err != Z_STREAM_END) {
-    Dbg(dbg_ctl, "deflate error: %d", err);
+stats_add_resp(stats_state *my_state)
+{
+  snapshot_ptr snap = get_snapshot();
+
+  if (my_state->since > 0) {
+    std::string body;
+    my_state->encoding      = render_body(*snap, my_state->output, my_state->encoding, my_state->since, body);
+    my_state->output_bytes  = stats_add_resp_header(my_state);
+    my_state->output_bytes += stats_add_data_to_resp_buffer(body.data(), body.size(), my_state);
+    return;
   }
 
-  err = deflateEnd(&my_state->zstrm);
-  if (err != Z_OK) {
-    Dbg(dbg_ctl, "deflate end err: %d", err);
+  if (snapshot_interval > 0) {
+    scraped_bodies.fetch_or(body_bit(my_state->output, my_state->encoding));
   }
 
-  my_state->output_bytes += TSIOBufferWrite(my_state->resp_buffer, outputbuf, my_state->zstrm.total_out);
+  std::lock_guard<std::mutex> lock(snap->body_mutex);
+  rendered_body              &r = snapshot_body(*snap, my_state->output, my_state->encoding);
+  my_state->encoding            = r.encoding;
+  my_state->output_bytes        = stats_add_resp_header(my_state);
+  my_state->output_bytes       += stats_add_data_to_resp_buffer(r.body.data(), r.body.size(), my_state);
 }
 
 static void
-csv_out_stats(stats_state *my_state)
+stats_process_read(TSCont contp, TSEvent event, stats_state *my_state)
 {
-  TSRecordDump((TSRecordType)(TS_RECORDTYPE_PLUGIN | TS_RECORDTYPE_NODE | TS_RECORDTYPE_PROCESS), csv_out_stat, my_state);
-  const char *version = TSTrafficServerVersionGet();
-  APPEND_STAT_CSV_NUMERIC("current_time_epoch_ms", "%" PRIu64, ms_since_epoch());
-  APPEND_STAT_CSV("version", "%s", version);
+  Dbg(dbg_ctl, "stats_process_read(%d)", event);
+  if (event == TS_EVENT_VCONN_READ_READY) {
+    stats_add_resp(my_state);
+    TSVConnShutdown(my_state->net_vc, 1, 0);
+    my_state->write_vio = TSVConnWrite(my_state->net_vc, contp, my_state->resp_reader, my_state->output_bytes);
+  } else if (event == TS_EVENT_ERROR) {
+    TSError("[%s] stats_process_read: Received TS_EVENT_ERROR", PLUGIN_NAME);
+  } else if (event == TS_EVENT_VCONN_EOS) {
+    /* client may end the connection, simply return */
+    return;
+  } else if (event == TS_EVENT_NET_ACCEPT_FAILED) {
+    TSError("[%s] stats_process_read: Received TS_EVENT_NET_ACCEPT_FAILED", PLUGIN_NAME);
+  } else {
+    printf("Unexpected Event %d\n", event);
+    TSReleaseAssert(!"Unexpected Event");
+  }
 }
 
 static void
 stats_process_write(TSCont contp, TSEvent event, stats_state *my_state)
 {
   if (event == TS_EVENT_VCONN_WRITE_READY) {
-    if (my_state->body_written == 0) {
-      my_state->body_written = 1;
-      switch (my_state->output) {
-      case JSON_OUTPUT:
-        json_out_stats(my_state);
-        break;
-      case CSV_OUTPUT:
-        csv_out_stats(my_state);
-        break;
-      default:
-        TSError("stats_process_write: Unknown output type\n");
-        break;
-      }
-
-      if ((my_state->encoding == GZIP) || (my_state->encoding == DEFLATE)) {
-        gzip_out_stats(my_state);
-      }
-#if HAVE_BROTLI_ENCODE_H
-      else if (my_state->encoding == BR) {
-        br_out_stats(my_state);
-      }
-#endif
-      TSVIONBytesSet(my_state->write_vio, my_state->output_bytes);
-    }
     TSVIOReenable(my_state->write_vio);
   } else if (event == TS_EVENT_VCONN_WRITE_COMPLETE) {
     stats_cleanup(contp, my_state);
@@ -547,6 +577,38 @@ stats_process_write(TSCont contp, TSEvent event, stats_state *my_state)
   }
 }
 
+// JSON-RPC access to the snapshots, the stats changed since the snapshot version "since", or all of them.
+static void
+stats_rpc_snapshot(const char *id, TSYaml p)
+{
+  try {
+    YAML::Node params = *reinterpret_cast<YAML::Node *>(p);
+    uint64_t   since  = 0;
+    if (params.IsMap() && params["since"]) {
+      since = params["since"].as<uint64_t>();
+    }
+
+    snapshot_ptr snap = get_snapshot();
+    YAML::Node   resp;
+    YAML::Node   stats{YAML::NodeType::Sequence};
+    for (auto const &stat : snap->stats) {
+      if (stat.changed > since) {
+        YAML::Node node;
+        node["name"]  = stat.name;
+        node["value"] = stat.value;
+        stats.push_back(node);
+      }
+    }
+    resp["version"]  = snap->version;
+    resp["epoch_ms"] = snap->epoch_ms;
+    resp["stats"]    = stats;
+    TSRPCHandlerDone(reinterpret_cast<TSYaml>(&resp));
+  } catch (YAML::Exception const &ex) {
+    std::string descr{ex.what()};
+    TSRPCHandlerError(1, descr.c_str(), descr.size());
+  }
+}
+
 static int
 stats_dostuff(TSCont contp, TSEvent event, void *edata)
 {
@@ -623,11 +685,34 @@ stats_origin(TSCont contp, TSEvent event, void *edata)
     // Parse the Accept header, default to JSON output unless its another supported format
     if (!strncasecmp(str, "text/csv", len)) {
       my_state->output = CSV_OUTPUT;
+    } else if (swoc::TextView accept{str, size_t(len)};
+               accept.starts_with_nocase("text/plain") || accept.find("openmetrics-text") != swoc::TextView::npos) {
+      my_state->output = PROMETHEUS_OUTPUT;
     } else {
       my_state->output = JSON_OUTPUT;
     }
   }
 
+  // The query can also select the format, and ask for the stats changed since a snapshot version.
+  if (int query_len = 0; const char *query = TSUrlHttpQueryGet(reqp, url_loc, &query_len)) {
+    swoc::TextView q{query, size_t(query_len)};
+    while (q) {
+      swoc::TextView value = q.take_prefix_at('&');
+      swoc::TextView key   = value.take_prefix_at('=');
+      if (key == "format") {
+        if (value == "json") {
+          my_state->output = JSON_OUTPUT;
+        } else if (value == "csv") {
+          my_state->output = CSV_OUTPUT;
+        } else if (value == "prometheus") {
+          my_state->output = PROMETHEUS_OUTPUT;
+        }
+      } else if (key == "since") {
+        my_state->since = swoc::svtou(value);
+      }
+    }
+  }
+
   // Check for Accept Encoding and init
   accept_encoding_field = TSMimeHdrFieldFind(reqp, hdr_loc, TS_MIME_FIELD_ACCEPT_ENCODING, TS_MIME_LEN_ACCEPT_ENCODING);
   my_state->encoding    = NONE;
@@ -636,15 +721,15 @@ stats_origin(TSCont contp, TSEvent event, void *edata)
     const char *str = TSMimeHdrFieldValueStringGet(reqp, hdr_loc, accept_encoding_field, -1, &len);
     if (len >= TS_HTTP_LEN_DEFLATE && strstr(str, TS_HTTP_VALUE_DEFLATE) != nullptr) {
       Dbg(dbg_ctl, "Saw deflate in accept encoding");
-      my_state->encoding = init_gzip(my_state, DEFLATE_MODE);
+      my_state->encoding = DEFLATE;
     } else if (len >= TS_HTTP_LEN_GZIP && strstr(str, TS_HTTP_VALUE_GZIP) != nullptr) {
       Dbg(dbg_ctl, "Saw gzip in accept encoding");
-      my_state->encoding = init_gzip(my_state, GZIP_MODE);
+      my_state->encoding = GZIP;
     }
 #if HAVE_BROTLI_ENCODE_H
     else if (len >= TS_HTTP_LEN_BROTLI && strstr(str, TS_HTTP_VALUE_BROTLI) != nullptr) {
       Dbg(dbg_ctl, "Saw br in accept encoding");
-      my_state->encoding = init_br(my_state);
+      my_state->encoding = BR;
     }
 #endif
     else {
@@ -681,14 +766,17 @@ TSPluginInit(int argc, const char *argv[])
 {
   TSPluginRegistrationInfo info;
 
-  static const char          usage[]    = PLUGIN_NAME ".so [--integer-counters] [PATH]";
+  static const char          usage[]    = PLUGIN_NAME ".so [--integer-counters] [--snapshot-interval MS] [PATH]";
   static const struct option longopts[] = {
-    {(char *)("integer-counters"), no_argument, nullptr, 'i'},
-    {(char *)("wrap-counters"),    no_argument, nullptr, 'w'},
-    {nullptr,                      0,           nullptr, 0  }
+    {(char *)("integer-counters"),  no_argument,       nullptr, 'i'},
+    {(char *)("wrap-counters"),     no_argument,       nullptr, 'w'},
+    {(char *)("snapshot-interval"), required_argument, nullptr, 's'},
+    {nullptr,                       0,                 nullptr, 0  }
   };
-  TSCont           main_cont, config_cont;
-  config_holder_t *config_holder;
+  TSCont              main_cont, config_cont, snapshot_cont;
+  config_holder_t    *config_holder;
+  TSRPCProviderHandle rpc_provider;
+  TSRPCHandlerOptions rpc_opt{{false}};
 
   info.plugin_name   = PLUGIN_NAME;
   info.vendor_name   = "Apache Software Foundation";
@@ -700,13 +788,16 @@ TSPluginInit(int argc, const char *argv[])
   }
 
   for (;;) {
-    switch (getopt_long(argc, (char *const *)argv, "iw", longopts, nullptr)) {
+    switch (getopt_long(argc, (char *const *)argv, "iws:", longopts, nullptr)) {
     case 'i':
       integer_counters = true;
       break;
     case 'w':
       wrap_counters = true;
       break;
+    case 's':
+      snapshot_interval = atoi(optarg);
+      break;
     case -1:
       goto init;
     default:
@@ -736,6 +827,18 @@ init:
   TSContDataSet(main_cont, (void *)config_holder);
   TSHttpHookAdd(TS_HTTP_READ_REQUEST_HDR_HOOK, main_cont);
 
+  if (snapshot_interval > 0) {
+    snapshot_cont = TSContCreate(snapshot_handler, TSMutexCreate());
+    TSContScheduleEveryOnPool(snapshot_cont, snapshot_interval, TS_THREAD_POOL_TASK);
+  }
+
+  rpc_provider = TSRPCRegister(PLUGIN_NAME, strlen(PLUGIN_NAME), YAMLCPP_LIB_VERSION, strlen(YAMLCPP_LIB_VERSION));
+  if (rpc_provider == nullptr ||
+      TSRPCRegisterMethodHandler(RPC_METHOD_NAME.data(), RPC_METHOD_NAME.size(), stats_rpc_snapshot, rpc_provider, &rpc_opt) ==
+        TS_ERROR) {
+    TSError("[%s] failed to register the %s JSON-RPC method", PLUGIN_NAME, RPC_METHOD_NAME.data());
+  }
+
   /* Create continuation for management updates to re-read config file */
   if (config_holder->config_path != nullptr) {
     config_cont = TSContCreate(config_handler, TSMutexCreate());
@@ -36,6 +36,7 @@
 #include "iocore/aio/AIO_fault_injection.h"
 #endif
 
+#include <algorithm>
 #include <atomic>
 #include <unordered_set>
 #include <fstream>
@@ -44,6 +45,8 @@
 #include <filesystem>
 
 constexpr ts::VersionNumber CACHE_DB_VERSION(CACHE_DB_MAJOR_VERSION, CACHE_DB_MINOR_VERSION);
+constexpr ts::VersionNumber CACHE_DB_VERSION_HTTPINFO(24, 2);
+constexpr ts::VersionNumber CACHE_DB_VERSION_CRC32C(24, 3);
 
 static size_t DEFAULT_RAM_CACHE_MULTIPLIER = 10; // I.e. 10x 1MB per 1GB of disk.
 
@@ -69,12 +72,24 @@ int     cache_config_force_sector_size             = 0;
 int     cache_config_target_fragment_size          = DEFAULT_TARGET_FRAGMENT_SIZE;
 int     cache_config_agg_write_backlog             = AGG_SIZE * 2;
 int     cache_config_enable_checksum               = 0;
+int     cache_config_checksum_verify_percent       = 100;
+int     cache_config_recovery_queue_depth          = 4;
 int     cache_config_alt_rewrite_max_size          = 4096;
 int     cache_config_read_while_writer             = 0;
 int     cache_config_mutex_retry_delay             = 2;
+int     cache_config_mutex_handoff                 = 1;
 int     cache_read_while_writer_retry_delay        = 50;
 int     cache_config_read_while_writer_max_retries = 10;
+int     cache_config_read_while_writer_max_waiters = 256;
+int     cache_config_read_while_writer_timeout     = 1000;
 int     cache_config_persist_bad_disks             = false;
+int     cache_config_tier_promote_hits             = 2;
+int     cache_config_tier_promote_max_size         = 1048576;
+int     cache_config_tier_demote                   = 1;
+int     cache_config_admission_min_hits            = 0;
+int     cache_config_admission_write_rate          = 0;
+int     cache_config_admission_defer_backlog       = 0;
+int     cache_config_admission_defer_max           = 1000;
 
 // Globals
 
@@ -183,21 +198,36 @@ register_cache_stats(CacheStatsBlock *rsb, const std::string prefix)
   rsb->directory_collision   = Metrics::Counter::createPtr(prefix + ".directory_collision");
   rsb->read_busy_success     = Metrics::Counter::createPtr(prefix + ".read_busy.success");
   rsb->read_busy_failure     = Metrics::Counter::createPtr(prefix + ".read_busy.failure");
+  rsb->rww_collapsed         = Metrics::Counter::createPtr(prefix + ".read_while_writer.collapsed");
+  rsb->rww_timeout           = Metrics::Counter::createPtr(prefix + ".read_while_writer.timeout");
+  rsb->rww_overflow          = Metrics::Counter::createPtr(prefix + ".read_while_writer.overflow");
   rsb->write_bytes           = Metrics::Counter::createPtr(prefix + ".write_bytes_stat");
   rsb->hdr_vector_marshal    = Metrics::Counter::createPtr(prefix + ".vector_marshals");
   rsb->hdr_marshal           = Metrics::Counter::createPtr(prefix + ".hdr_marshals");
   rsb->hdr_marshal_bytes     = Metrics::Counter::createPtr(prefix + ".hdr_marshal_bytes");
+  rsb->hdr_unmarshal         = Metrics::Counter::createPtr(prefix + ".hdr_unmarshals");
   rsb->gc_bytes_evacuated    = Metrics::Counter::createPtr(prefix + ".gc_bytes_evacuated");
   rsb->gc_frags_evacuated    = Metrics::Counter::createPtr(prefix + ".gc_frags_evacuated");
   rsb->directory_wrap        = Metrics::Counter::createPtr(prefix + ".wrap_count");
   rsb->directory_sync_count  = Metrics::Counter::createPtr(prefix + ".sync.count");
   rsb->directory_sync_bytes  = Metrics::Counter::createPtr(prefix + ".sync.bytes");
   rsb->directory_sync_time   = Metrics::Counter::createPtr(prefix + ".sync.time");
+  rsb->checksum_verified     = Metrics::Counter::createPtr(prefix + ".checksum.verified");
+  rsb->checksum_failure      = Metrics::Counter::createPtr(prefix + ".checksum.failure");
+  rsb->recovery_stripes      = Metrics::Gauge::createPtr(prefix + ".recovery.stripes");
+  rsb->recovery_bytes_read   = Metrics::Counter::createPtr(prefix + ".recovery.bytes_read");
+  rsb->recovery_bytes_total  = Metrics::Gauge::createPtr(prefix + ".recovery.bytes_total");
+  rsb->recovery_eta          = Metrics::Gauge::createPtr(prefix + ".recovery.eta");
   rsb->span_errors_read      = Metrics::Counter::createPtr(prefix + ".span.errors.read");
   rsb->span_errors_write     = Metrics::Counter::createPtr(prefix + ".span.errors.write");
   rsb->span_failing          = Metrics::Gauge::createPtr(prefix + ".span.failing");
   rsb->span_offline          = Metrics::Gauge::createPtr(prefix + ".span.offline");
   rsb->span_online           = Metrics::Gauge::createPtr(prefix + ".span.online");
+
+  rsb->admission_admitted           = Metrics::Counter::createPtr(prefix + ".admission.admitted");
+  rsb->admission_deferred           = Metrics::Counter::createPtr(prefix + ".admission.deferred");
+  rsb->admission_rejected_frequency = Metrics::Counter::createPtr(prefix + ".admission.rejected.frequency");
+  rsb->admission_rejected_budget    = Metrics::Counter::createPtr(prefix + ".admission.rejected.budget");
 }
 
 // ToDo: This gets called as part of librecords collection continuation, probably change this later.
@@ -868,12 +898,11 @@ cmprtable(const void *aa, const void *bb)
   return 0;
 }
 
-void
-build_vol_hash_table(CacheHostRecord *cp)
+static void
+build_stripe_hash_table(Stripe **stripes, int num_vols, unsigned short **hash_table)
 {
-  int           num_vols = cp->num_vols;
-  unsigned int *mapping  = static_cast<unsigned int *>(ats_malloc(sizeof(unsigned int) * num_vols));
-  Stripe      **p        = static_cast<Stripe **>(ats_malloc(sizeof(Stripe *) * num_vols));
+  unsigned int *mapping = static_cast<unsigned int *>(ats_malloc(sizeof(unsigned int) * num_vols));
+  Stripe      **p       = static_cast<Stripe **>(ats_malloc(sizeof(Stripe *) * num_vols));
 
   memset(mapping, 0, num_vols * sizeof(unsigned int));
   memset(p, 0, num_vols * sizeof(Stripe *));
@@ -883,23 +912,23 @@ build_vol_hash_table(CacheHostRecord *cp)
   uint64_t used     = 0;
   // initialize number of elements per vol
   for (int i = 0; i < num_vols; i++) {
-    if (DISK_BAD(cp->stripes[i]->disk)) {
+    if (DISK_BAD(stripes[i]->disk)) {
       bad_vols++;
       continue;
     }
     mapping[map]  = i;
-    p[map++]      = cp->stripes[i];
-    total        += (cp->stripes[i]->len >> STORE_BLOCK_SHIFT);
+    p[map++]      = stripes[i];
+    total        += (stripes[i]->len >> STORE_BLOCK_SHIFT);
   }
 
   num_vols -= bad_vols;
 
   if (!num_vols || !total) {
     // all the disks are corrupt,
-    if (cp->vol_hash_table) {
-      new_Freer(cp->vol_hash_table, CACHE_MEM_FREE_TIMEOUT);
+    if (*hash_table) {
+      new_Freer(*hash_table, CACHE_MEM_FREE_TIMEOUT);
     }
-    cp->vol_hash_table = nullptr;
+    *hash_table = nullptr;
     ats_free(mapping);
     ats_free(p);
     return;
@@ -964,7 +993,7 @@ build_vol_hash_table(CacheHostRecord *cp)
     Dbg(dbg_ctl_cache_init, "build_vol_hash_table index %d mapped to %d requested %d got %d", i, mapping[i], forvol[i], gotvol[i]);
   }
   // install new table
-  if (nullptr != (old_table = ink_atomic_swap(&(cp->vol_hash_table), ttable))) {
+  if (nullptr != (old_table = ink_atomic_swap(hash_table, ttable))) {
     new_Freer(old_table, CACHE_MEM_FREE_TIMEOUT);
   }
   ats_free(mapping);
@@ -976,6 +1005,15 @@ build_vol_hash_table(CacheHostRecord *cp)
   ats_free(rtable);
 }
 
+void
+build_vol_hash_table(CacheHostRecord *cp)
+{
+  build_stripe_hash_table(cp->stripes, cp->num_vols, &cp->vol_hash_table);
+  if (cp->num_fast_vols) {
+    build_stripe_hash_table(cp->fast_stripes, cp->num_fast_vols, &cp->fast_vol_hash_table);
+  }
+}
+
 void
 Cache::vol_initialized(bool result)
 {
@@ -1195,6 +1233,8 @@ Cache::open(bool clear, bool /* fix ATS_UNUSED */)
             cp->stripes[vol_no]->cache_vol = cp;
             blocks                         = q->b->len;
 
+            cp->stripes[vol_no]->mutex->handoff = cache_config_mutex_handoff;
+
             bool vol_clear = clear || d->cleared || q->new_block;
             cp->stripes[vol_no]->init(d->path, blocks, q->b->offset, vol_clear);
             vol_no++;
@@ -1226,8 +1266,12 @@ Cache::lookup(Continuation *cont, const CacheKey *key, CacheFragType type, const
     return ACTION_RESULT_DONE;
   }
 
-  Stripe  *stripe = key_to_stripe(key, hostname, host_len);
+  Stripe  *fast   = nullptr;
+  Stripe  *stripe = key_to_stripe(key, hostname, host_len, &fast);
   CacheVC *c      = new_CacheVC(cont);
+  if (fast && cache_tier_probe(fast, key, c->mutex->thread_holding)) {
+    stripe = fast;
+  }
   SET_CONTINUATION_HANDLER(c, &CacheVC::openReadStartHead);
   c->vio.op  = VIO::READ;
   c->op_type = static_cast<int>(CacheOpType::Lookup);
@@ -1263,7 +1307,11 @@ Cache::remove(Continuation *cont, const CacheKey *key, CacheFragType type, const
 
   CACHE_TRY_LOCK(lock, cont->mutex, this_ethread());
   ink_assert(lock.is_locked());
-  Stripe *stripe = key_to_stripe(key, hostname, host_len);
+  Stripe *fast   = nullptr;
+  Stripe *stripe = key_to_stripe(key, hostname, host_len, &fast);
+  if (fast) {
+    cache_tier_invalidate(fast, key, cont->mutex->thread_holding);
+  }
   // coverity[var_decl]
   Dir result;
   dir_clear(&result); // initialized here, set result empty so we can recognize missed lock
@@ -1345,6 +1393,7 @@ cplist_update()
       if (config_vol->number == cp->vol_number) {
         if (cp->scheme == config_vol->scheme) {
           cp->ramcache_enabled = config_vol->ramcache_enabled;
+          cp->tier             = config_vol->tier;
           config_vol->cachep   = cp;
         } else {
           /* delete this volume from all the disks */
@@ -1629,6 +1678,7 @@ cplist_reconfigure()
           delete new_cp;
           return -1;
         }
+        new_cp->tier = config_vol->tier;
         cp_list.enqueue(new_cp);
         cp_list_len++;
         config_vol->cachep  = new_cp;
@@ -1808,7 +1858,7 @@ rebuild_host_table(Cache *cache)
 
 // if generic_host_rec.stripes == nullptr, what do we do???
 Stripe *
-Cache::key_to_stripe(const CacheKey *key, const char *hostname, int host_len)
+Cache::key_to_stripe(const CacheKey *key, const char *hostname, int host_len, Stripe **fast)
 {
   ReplaceablePtr<CacheHostTable>::ScopedReader hosttable(&this->hosttable);
 
@@ -1816,6 +1866,10 @@ Cache::key_to_stripe(const CacheKey *key, const char *hostname, int host_len)
   unsigned short        *hash_table = hosttable->gen_host_rec.vol_hash_table;
   const CacheHostRecord *host_rec   = &hosttable->gen_host_rec;
 
+  if (fast) {
+    *fast = nullptr;
+  }
+
   if (hosttable->m_numEntries > 0 && host_len) {
     CacheHostResult res;
     hosttable->Match(hostname, host_len, &res);
@@ -1827,6 +1881,9 @@ Cache::key_to_stripe(const CacheKey *key, const char *hostname, int host_len)
           snprintf(format_str, sizeof(format_str), "Volume: %%xd for host: %%.%ds", host_len);
           Dbg(dbg_ctl_cache_hosting, format_str, res.record, hostname);
         }
+        if (fast && res.record->fast_vol_hash_table) {
+          *fast = res.record->fast_stripes[res.record->fast_vol_hash_table[h]];
+        }
         return res.record->stripes[host_hash_table[h]];
       }
     }
@@ -1837,6 +1894,9 @@ Cache::key_to_stripe(const CacheKey *key, const char *hostname, int host_len)
       snprintf(format_str, sizeof(format_str), "Generic volume: %%xd for host: %%.%ds", host_len);
       Dbg(dbg_ctl_cache_hosting, format_str, host_rec, hostname);
     }
+    if (fast && host_rec->fast_vol_hash_table) {
+      *fast = host_rec->fast_stripes[host_rec->fast_vol_hash_table[h]];
+    }
     return host_rec->stripes[hash_table[h]];
   } else {
     return host_rec->stripes[0];
@@ -1895,12 +1955,21 @@ ink_cache_init(ts::ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_config_mutex_retry_delay, "proxy.config.cache.mutex_retry_delay");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.mutex_retry_delay = %dms", cache_config_mutex_retry_delay);
 
+  REC_EstablishStaticConfigInt32(cache_config_mutex_handoff, "proxy.config.cache.mutex_handoff");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.mutex_handoff = %d", cache_config_mutex_handoff);
+
   REC_EstablishStaticConfigInt32(cache_config_read_while_writer_max_retries, "proxy.config.cache.read_while_writer.max_retries");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.read_while_writer.max_retries = %d", cache_config_read_while_writer_max_retries);
 
   REC_EstablishStaticConfigInt32(cache_read_while_writer_retry_delay, "proxy.config.cache.read_while_writer_retry.delay");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.read_while_writer_retry.delay = %dms", cache_read_while_writer_retry_delay);
 
+  REC_EstablishStaticConfigInt32(cache_config_read_while_writer_max_waiters, "proxy.config.cache.read_while_writer.max_waiters");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.read_while_writer.max_waiters = %d", cache_config_read_while_writer_max_waiters);
+
+  REC_EstablishStaticConfigInt32(cache_config_read_while_writer_timeout, "proxy.config.cache.read_while_writer.wait_timeout");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.read_while_writer.wait_timeout = %dms", cache_config_read_while_writer_timeout);
+
   REC_EstablishStaticConfigInt32(cache_config_hit_evacuate_percent, "proxy.config.cache.hit_evacuate_percent");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.hit_evacuate_percent = %d", cache_config_hit_evacuate_percent);
 
@@ -1926,6 +1995,13 @@ ink_cache_init(ts::ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_config_enable_checksum, "proxy.config.cache.enable_checksum");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.enable_checksum = %d", cache_config_enable_checksum);
 
+  REC_EstablishStaticConfigInt32(cache_config_checksum_verify_percent, "proxy.config.cache.checksum_verify_percent");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.checksum_verify_percent = %d", cache_config_checksum_verify_percent);
+
+  REC_ReadConfigInteger(cache_config_recovery_queue_depth, "proxy.config.cache.recovery_queue_depth");
+  cache_config_recovery_queue_depth = std::clamp(cache_config_recovery_queue_depth, 1, 64);
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.recovery_queue_depth = %d", cache_config_recovery_queue_depth);
+
   REC_EstablishStaticConfigInt32(cache_config_alt_rewrite_max_size, "proxy.config.cache.alt_rewrite_max_size");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.alt_rewrite_max_size = %d", cache_config_alt_rewrite_max_size);
 
@@ -1934,7 +2010,29 @@ ink_cache_init(ts::ModuleVersion v)
   REC_RegisterConfigUpdateFunc("proxy.config.cache.enable_read_while_writer", update_cache_config, nullptr);
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.enable_read_while_writer = %d", cache_config_read_while_writer);
 
+  REC_EstablishStaticConfigInt32(cache_config_tier_promote_hits, "proxy.config.cache.tier.promote_hits");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.tier.promote_hits = %d", cache_config_tier_promote_hits);
+
+  REC_EstablishStaticConfigInt32(cache_config_tier_promote_max_size, "proxy.config.cache.tier.promote_max_size");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.tier.promote_max_size = %d", cache_config_tier_promote_max_size);
+
+  REC_EstablishStaticConfigInt32(cache_config_tier_demote, "proxy.config.cache.tier.demote");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.tier.demote = %d", cache_config_tier_demote);
+
+  REC_EstablishStaticConfigInt32(cache_config_admission_min_hits, "proxy.config.cache.admission.min_hits");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.admission.min_hits = %d", cache_config_admission_min_hits);
+
+  REC_EstablishStaticConfigInt32(cache_config_admission_write_rate, "proxy.config.cache.admission.write_rate");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.admission.write_rate = %d", cache_config_admission_write_rate);
+
+  REC_EstablishStaticConfigInt32(cache_config_admission_defer_backlog, "proxy.config.cache.admission.defer_backlog");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.admission.defer_backlog = %d", cache_config_admission_defer_backlog);
+
+  REC_EstablishStaticConfigInt32(cache_config_admission_defer_max, "proxy.config.cache.admission.defer_max");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.admission.defer_max = %d", cache_config_admission_defer_max);
+
   register_cache_stats(&cache_rsb, "proxy.process.cache");
+  register_cache_tier_stats("proxy.process.cache.tier");
 
   REC_ReadConfigInteger(cacheProcessor.wait_for_cache, "proxy.config.http.wait_for_cache");
 
@@ -1979,9 +2077,10 @@ CacheProcessor::open_read(Continuation *cont, const HttpCacheKey *key, CacheHTTP
 //----------------------------------------------------------------------------
 Action *
 CacheProcessor::open_write(Continuation *cont, int expected_size, const HttpCacheKey *key, CacheHTTPHdr *request,
-                           CacheHTTPInfo *old_info, time_t pin_in_cache, CacheFragType type)
+                           CacheHTTPInfo *old_info, time_t pin_in_cache, CacheFragType type, int options)
 {
-  return caches[type]->open_write(cont, &key->hash, old_info, pin_in_cache, nullptr /* key1 */, type, key->hostname, key->hostlen);
+  return caches[type]->open_write(cont, &key->hash, old_info, pin_in_cache, nullptr /* key1 */, type, key->hostname, key->hostlen,
+                                  options);
 }
 
 //----------------------------------------------------------------------------
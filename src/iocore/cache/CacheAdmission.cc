@@ -0,0 +1,248 @@
+/** @file
+
+  Admission control for cache writes.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_Cache.h"
+#include "P_CacheAdmission.h"
+
+#include <algorithm>
+
+namespace
+{
+DbgCtl dbg_ctl_cache_admission{"cache_admission"};
+
+/** TinyLFU admission with a write budget.
+ *
+ * The first sighting of a key only enters the doorkeeper, later sightings are counted in the
+ * sketch. A key is admitted once it has been seen @c min_hits times, as long as the stripe has
+ * write budget left. While the aggregation backlog is above @c defer_backlog new writes wait,
+ * for at most @c defer_max milliseconds, before they are considered.
+ */
+class CacheAdmissionTinyLFU : public CacheAdmission
+{
+public:
+  CacheAdmissionTinyLFU() : _doorkeeper(CacheFrequencySketch::DEFAULT_WIDTH * 8) {}
+
+  Result admit(const CryptoHash &key, int64_t pending, ink_hrtime waited, ink_hrtime now, bool retry) override;
+  void   wrote(int64_t bytes, ink_hrtime now) override;
+
+private:
+  unsigned _count(const CryptoHash &key, bool retry);
+
+  CacheDoorkeeper      _doorkeeper;
+  CacheFrequencySketch _sketch;
+  uint64_t             _generation = 0;
+  CacheWriteBudget     _budget;
+};
+
+unsigned
+CacheAdmissionTinyLFU::_count(const CryptoHash &key, bool retry)
+{
+  if (_sketch.generation() != _generation) {
+    _generation = _sketch.generation();
+    _doorkeeper.clear();
+  }
+  if (retry) {
+    return _doorkeeper.contains(key) ? 1 + _sketch.estimate(key) : 1;
+  }
+  if (!_doorkeeper.put(key)) {
+    return 1;
+  }
+  return 1 + _sketch.increment(key);
+}
+
+CacheAdmission::Result
+CacheAdmissionTinyLFU::admit(const CryptoHash &key, int64_t pending, ink_hrtime waited, ink_hrtime now, bool retry)
+{
+  // Deferred writes are not counted until they are considered, so a retry is not another sighting.
+  if (cache_config_admission_defer_backlog > 0 && pending > cache_config_admission_defer_backlog &&
+      waited < HRTIME_MSECONDS(cache_config_admission_defer_max)) {
+    return Result::Defer;
+  }
+  if (cache_config_admission_min_hits > 1 &&
+      _count(key, retry) < std::min<unsigned>(cache_config_admission_min_hits, CacheFrequencySketch::MAX_COUNT + 1)) {
+    return Result::RejectFrequency;
+  }
+  _budget.set_rate(cache_config_admission_write_rate, now);
+  if (!_budget.available(now)) {
+    return Result::RejectBudget;
+  }
+  return Result::Admit;
+}
+
+void
+CacheAdmissionTinyLFU::wrote(int64_t bytes, ink_hrtime now)
+{
+  _budget.set_rate(cache_config_admission_write_rate, now);
+  _budget.charge(bytes, now);
+}
+
+bool
+admission_enabled()
+{
+  return cache_config_admission_min_hits > 1 || cache_config_admission_write_rate > 0 || cache_config_admission_defer_backlog > 0;
+}
+
+} // end anonymous namespace
+
+CacheAdmission *
+new_CacheAdmission()
+{
+  return new CacheAdmissionTinyLFU;
+}
+
+CacheDoorkeeper::CacheDoorkeeper(unsigned bits)
+{
+  int n = 6;
+  while ((1U << n) < bits) {
+    ++n;
+  }
+  _shift = 32 - n;
+  _bits.assign((1U << n) / 64, 0);
+}
+
+unsigned
+CacheDoorkeeper::_index(const CryptoHash &key, int probe) const
+{
+  // The sketch hashes the 32 bit words of the key, so mix whole 64 bit words here.
+  uint64_t h = (key.u64[probe] ^ (key.u64[1 - probe] >> 29)) * 0x9E3779B97F4A7C15ULL;
+  return static_cast<uint32_t>(h >> 32) >> _shift;
+}
+
+bool
+CacheDoorkeeper::put(const CryptoHash &key)
+{
+  bool present = true;
+  for (int probe = 0; probe < 2; ++probe) {
+    unsigned i    = _index(key, probe);
+    uint64_t mask = uint64_t(1) << (i % 64);
+    if (!(_bits[i / 64] & mask)) {
+      present       = false;
+      _bits[i / 64] |= mask;
+    }
+  }
+  return present;
+}
+
+bool
+CacheDoorkeeper::contains(const CryptoHash &key) const
+{
+  for (int probe = 0; probe < 2; ++probe) {
+    unsigned i = _index(key, probe);
+    if (!(_bits[i / 64] & (uint64_t(1) << (i % 64)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+CacheDoorkeeper::clear()
+{
+  std::fill(_bits.begin(), _bits.end(), 0);
+}
+
+void
+CacheWriteBudget::set_rate(int64_t rate, ink_hrtime now)
+{
+  if (rate != _rate) {
+    _rate   = rate;
+    _tokens = rate;
+    _last   = now;
+  }
+}
+
+void
+CacheWriteBudget::_refill(ink_hrtime now)
+{
+  // A budget overdrawn by a large write may take longer than a second to recover.
+  ink_hrtime elapsed = std::min<ink_hrtime>(now - _last, HRTIME_HOURS(1));
+  if (auto added = static_cast<int64_t>(static_cast<double>(_rate) * elapsed / HRTIME_SECOND); added > 0) {
+    // Only move the clock when tokens were added, so slow rates are not rounded away.
+    _tokens = std::min(_rate, _tokens + added);
+    _last   = now;
+  }
+}
+
+bool
+CacheWriteBudget::available(ink_hrtime now)
+{
+  if (!_rate) {
+    return true;
+  }
+  this->_refill(now);
+  return _tokens > 0;
+}
+
+void
+CacheWriteBudget::charge(int64_t bytes, ink_hrtime now)
+{
+  if (_rate) {
+    this->_refill(now);
+    _tokens -= bytes;
+  }
+}
+
+int
+cache_admission_check(Stripe *stripe, CacheVC *cont)
+{
+  ink_assert(stripe->mutex->thread_holding == this_ethread());
+  if (!admission_enabled()) {
+    return 0;
+  }
+  if (!stripe->admission) {
+    stripe->admission = new_CacheAdmission();
+  }
+
+  ink_hrtime now = ink_get_hrtime();
+  switch (stripe->admission->admit(cont->first_key, stripe->get_agg_todo_size(), now - cont->start_time, now,
+                                   cont->f.admission_retry)) {
+  case CacheAdmission::Result::Admit:
+    Metrics::Counter::increment(cache_rsb.admission_admitted);
+    Metrics::Counter::increment(stripe->cache_vol->vol_rsb.admission_admitted);
+    return 0;
+  case CacheAdmission::Result::Defer:
+    Metrics::Counter::increment(cache_rsb.admission_deferred);
+    Metrics::Counter::increment(stripe->cache_vol->vol_rsb.admission_deferred);
+    return -1;
+  case CacheAdmission::Result::RejectFrequency:
+    Dbg(dbg_ctl_cache_admission, "not admitted, too few hits: %X", cont->first_key.slice32(0));
+    Metrics::Counter::increment(cache_rsb.admission_rejected_frequency);
+    Metrics::Counter::increment(stripe->cache_vol->vol_rsb.admission_rejected_frequency);
+    break;
+  case CacheAdmission::Result::RejectBudget:
+    Dbg(dbg_ctl_cache_admission, "not admitted, write budget used: %X", cont->first_key.slice32(0));
+    Metrics::Counter::increment(cache_rsb.admission_rejected_budget);
+    Metrics::Counter::increment(stripe->cache_vol->vol_rsb.admission_rejected_budget);
+    break;
+  }
+  // Not a failure of the cache, the caller goes on without writing the object.
+  return ECACHE_NOT_ADMITTED;
+}
+
+void
+cache_admission_wrote(Stripe *stripe, int64_t bytes)
+{
+  if (stripe->admission) {
+    stripe->admission->wrote(bytes, ink_get_hrtime());
+  }
+}
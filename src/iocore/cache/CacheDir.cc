@@ -57,6 +57,48 @@ DbgCtl dbg_ctl_dir_lookaside{"dir_lookaside"};
 
 ClassAllocator<OpenDirEntry> openDirEntryAllocator("openDirEntry");
 
+namespace
+{
+// Reschedule a waiting reader to run immediately on the thread it waits on,
+// cancelling its timeout. Fails if the reader's mutex is busy. The reader's
+// state is only changed under its mutex, as it may run as soon as that is
+// released.
+bool
+wake_reader(CacheVC *c, EThread *t)
+{
+  CACHE_TRY_LOCK(lock, c->mutex, t);
+  if (!lock.is_locked()) {
+    return false;
+  }
+  c->f.open_read_timeout = 0;
+  EThread *home          = c->trigger ? c->trigger->ethread : t;
+  c->cancel_trigger();
+  c->trigger = home->schedule_imm(c);
+  return true;
+}
+
+// Signal the readers of an object once the stripe lock can be taken.
+struct OpenDirSignalCont : public Continuation {
+  CryptoHash key;
+  OpenDir   *open_dir;
+
+  int
+  signal(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+  {
+    if (OpenDirEntry *od = open_dir->open_read(&key)) {
+      od->signal_readers(this_ethread());
+    }
+    delete this;
+    return EVENT_DONE;
+  }
+
+  OpenDirSignalCont(OpenDir *d, const CryptoHash *k) : Continuation(d->mutex), key(*k), open_dir(d)
+  {
+    SET_HANDLER(&OpenDirSignalCont::signal);
+  }
+};
+} // namespace
+
 // OpenDir
 
 OpenDir::OpenDir()
@@ -95,6 +137,7 @@ OpenDir::open_write(CacheVC *cont, int allow_if_writers, int max_writers)
   od->writers.push(cont);
   od->num_writers           = 1;
   od->max_writers           = max_writers;
+  od->num_readers           = 0;
   od->vector.data.data      = &od->vector.data.fast_data[0];
   od->dont_update_directory = false;
   od->move_resident_alt     = false;
@@ -114,10 +157,7 @@ OpenDir::signal_readers(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   EThread                                  *t = mutex->thread_holding;
   CacheVC                                  *c = nullptr;
   while ((c = delayed_readers.dequeue())) {
-    CACHE_TRY_LOCK(lock, c->mutex, t);
-    if (lock.is_locked()) {
-      c->f.open_read_timeout = 0;
-      c->handleEvent(EVENT_IMMEDIATE, nullptr);
+    if (wake_reader(c, t)) {
       continue;
     }
     newly_delayed_readers.push(c);
@@ -133,6 +173,36 @@ OpenDir::signal_readers(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   return 0;
 }
 
+/*
+   Retry waking a reader whose mutex was busy when it was signalled. The
+   reader must already be off its OpenDirEntry. A retry is pending whenever
+   delayed_readers is not empty.
+   */
+void
+OpenDir::delay_reader(CacheVC *c, EThread *t)
+{
+  bool pending = delayed_readers.head != nullptr;
+  delayed_readers.push(c);
+  if (!pending) {
+    EThread *t1 = c->mutex->thread_holding;
+    if (!t1) {
+      t1 = t;
+    }
+    t1->schedule_in(this, HRTIME_MSECONDS(cache_config_mutex_retry_delay));
+  }
+}
+
+/*
+   Signal the readers of key from a thread that could not take the stripe
+   lock. The OpenDirEntry is looked up again under the lock, as the writers
+   may have left in the meantime.
+   */
+void
+OpenDir::signal_readers(const CryptoHash *key, EThread *t)
+{
+  t->schedule_imm(new OpenDirSignalCont(this, key));
+}
+
 int
 OpenDir::close_write(CacheVC *cont)
 {
@@ -143,8 +213,8 @@ OpenDir::close_write(CacheVC *cont)
     unsigned int h = cont->first_key.slice32(0);
     int          b = h % OPEN_DIR_BUCKETS;
     bucket[b].remove(cont->od);
-    delayed_readers.append(cont->od->readers);
-    signal_readers(0, nullptr);
+    // Readers that could not be woken now are retried from delayed_readers, and find no writer.
+    cont->od->signal_readers(this_ethread());
     cont->od->vector.clear();
     THREAD_FREE(cont->od, openDirEntryAllocator, cont->mutex->thread_holding);
   }
@@ -165,6 +235,11 @@ OpenDir::open_read(const CryptoHash *key) const
   return nullptr;
 }
 
+/*
+   Park a reader until the writers have made progress, or for at most msec.
+   The reader is woken on its own thread by signal_readers. If it times out
+   instead, it must remove itself from readers under the stripe lock.
+   */
 int
 OpenDirEntry::wait(CacheVC *cont, int msec)
 {
@@ -173,9 +248,32 @@ OpenDirEntry::wait(CacheVC *cont, int msec)
   ink_assert(!cont->trigger);
   cont->trigger = cont->stripe->mutex->thread_holding->schedule_in_local(cont, HRTIME_MSECONDS(msec));
   readers.push(cont);
+  num_readers++;
   return EVENT_CONT;
 }
 
+/*
+   Wake the parked readers, called by a writer under the stripe lock once it
+   has set its response headers or written its first fragment. Readers whose
+   mutex is busy are moved to the stripe's delayed_readers and retried on a
+   short timer, as nothing may signal this entry again.
+   */
+void
+OpenDirEntry::signal_readers(EThread *t)
+{
+  CacheVC *c = nullptr;
+  while ((c = readers.pop())) {
+    num_readers--;
+    Metrics::Counter::increment(cache_rsb.rww_collapsed);
+    Metrics::Counter::increment(c->stripe->cache_vol->vol_rsb.rww_collapsed);
+    if (!wake_reader(c, t)) {
+      // The reader finds its OpenDirEntry again once woken, see CacheVC::openReadFromWriter.
+      c->od = nullptr;
+      c->stripe->open_dir.delay_reader(c, t);
+    }
+  }
+}
+
 //
 // Cache Directory
 //
@@ -1023,7 +1121,11 @@ Lrestart:
   {
     CACHE_TRY_LOCK(lock, gstripes[stripe_index]->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
-      trigger = eventProcessor.schedule_in(this, HRTIME_MSECONDS(cache_config_mutex_retry_delay));
+      if (stripe->mutex->handoff) {
+        trigger = stripe->mutex->wait_for_release(this, mutex->thread_holding, EVENT_INTERVAL);
+      } else {
+        trigger = eventProcessor.schedule_in(this, HRTIME_MSECONDS(cache_config_mutex_retry_delay));
+      }
       return EVENT_CONT;
     }
 
@@ -163,7 +163,7 @@ CacheEvacuateDocVC::evacuateReadHead(int /* event ATS_UNUSED */, Event * /* e AT
   alternate_tmp = nullptr;
   if (doc->doc_type == CACHE_FRAG_TYPE_HTTP && doc->hlen) {
     // its an http document
-    if (this->load_http_info(&vector, doc) != doc->hlen) {
+    if (this->load_http_info(&vector, doc, this->buf.get()) != doc->hlen) {
       Note("bad vector detected during evacuation");
       goto Ldone;
     }
@@ -419,7 +419,6 @@ CacheHostTable::BuildTable(const char *config_file_path)
 int
 CacheHostRecord::Init(CacheType typ)
 {
-  int                    i, j;
   extern Queue<CacheVol> cp_list;
   extern int             cp_list_len;
 
@@ -441,24 +440,14 @@ CacheHostRecord::Init(CacheType typ)
     Warning("error: No volumes found for Cache Type %d", type);
     return -1;
   }
-  stripes     = static_cast<Stripe **>(ats_malloc(num_vols * sizeof(Stripe *)));
-  int counter = 0;
-  for (i = 0; i < num_cachevols; i++) {
-    CacheVol *cachep1 = cp[i];
-    for (j = 0; j < cachep1->num_vols; j++) {
-      stripes[counter++] = cachep1->stripes[j];
-    }
-  }
-  ink_assert(counter == num_vols);
-
-  build_vol_hash_table(this);
+  init_stripes();
   return 0;
 }
 
 int
 CacheHostRecord::Init(matcher_line *line_info, CacheType typ)
 {
-  int                    i, j;
+  int                    i;
   extern Queue<CacheVol> cp_list;
   int                    is_vol_present = 0;
   char                   config_file[PATH_NAME_MAX];
@@ -563,18 +552,46 @@ CacheHostRecord::Init(matcher_line *line_info, CacheType typ)
   if (!num_vols) {
     return -1;
   }
-  stripes     = static_cast<Stripe **>(ats_malloc(num_vols * sizeof(Stripe *)));
-  int counter = 0;
-  for (i = 0; i < num_cachevols; i++) {
+  init_stripes();
+  return 0;
+}
+
+void
+CacheHostRecord::init_stripes()
+{
+  int num_fast = 0;
+  for (int i = 0; i < num_cachevols; i++) {
+    if (cp[i]->tier == CacheTier::Fast) {
+      num_fast += cp[i]->num_vols;
+    }
+  }
+  // Without a capacity volume there is nothing to put a fast tier in front of, use the fast volumes directly.
+  if (num_fast == num_vols) {
+    num_fast = 0;
+  }
+  num_vols      -= num_fast;
+  num_fast_vols  = num_fast;
+
+  stripes = static_cast<Stripe **>(ats_malloc(num_vols * sizeof(Stripe *)));
+  if (num_fast_vols) {
+    fast_stripes = static_cast<Stripe **>(ats_malloc(num_fast_vols * sizeof(Stripe *)));
+  }
+  int counter      = 0;
+  int fast_counter = 0;
+  for (int i = 0; i < num_cachevols; i++) {
     CacheVol *cachep = cp[i];
-    for (j = 0; j < cp[i]->num_vols; j++) {
-      stripes[counter++] = cachep->stripes[j];
+    for (int j = 0; j < cachep->num_vols; j++) {
+      if (num_fast_vols && cachep->tier == CacheTier::Fast) {
+        fast_stripes[fast_counter++] = cachep->stripes[j];
+      } else {
+        stripes[counter++] = cachep->stripes[j];
+      }
     }
   }
   ink_assert(counter == num_vols);
+  ink_assert(fast_counter == num_fast_vols);
 
   build_vol_hash_table(this);
-  return 0;
 }
 
 void
@@ -654,6 +671,7 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
     int         size             = 0;
     int         in_percent       = 0;
     bool        ramcache_enabled = true;
+    CacheTier   tier             = CacheTier::Capacity;
 
     while (true) {
       // skip all blank spaces at beginning of line
@@ -753,6 +771,18 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
           err = "Unexpected end of line";
           break;
         }
+      } else if (strcasecmp(tmp, "tier") == 0) { // match tier
+        tmp += 5;
+        if (!strcasecmp(tmp, "fast")) {
+          tmp  += 4;
+          tier  = CacheTier::Fast;
+        } else if (!strcasecmp(tmp, "capacity")) {
+          tmp  += 8;
+          tier  = CacheTier::Capacity;
+        } else {
+          err = "Unexpected end of line";
+          break;
+        }
       }
 
       // ends here
@@ -778,6 +808,7 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
       configp->size             = size;
       configp->cachep           = nullptr;
       configp->ramcache_enabled = ramcache_enabled;
+      configp->tier             = tier;
       cp_queue.enqueue(configp);
       num_volumes++;
       if (scheme == CACHE_HTTP_TYPE) {
@@ -785,8 +816,8 @@ ConfigVolumes::BuildListFromString(char *config_file_path, char *file_buf)
       } else {
         ink_release_assert(!"Unexpected non-HTTP cache volume");
       }
-      Dbg(dbg_ctl_cache_hosting, "added volume=%d, scheme=%d, size=%d percent=%d, ramcache enabled=%d", volume_number, scheme, size,
-          in_percent, ramcache_enabled);
+      Dbg(dbg_ctl_cache_hosting, "added volume=%d, scheme=%d, size=%d percent=%d, ramcache enabled=%d, tier=%s", volume_number,
+          scheme, size, in_percent, ramcache_enabled, tier == CacheTier::Fast ? "fast" : "capacity");
     }
 
     tmp = bufTok.iterNext(&i_state);
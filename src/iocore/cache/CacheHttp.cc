@@ -132,7 +132,7 @@ CacheHTTPInfoVector::print(char *buffer, size_t buf_size, bool temps)
   purl = 1;
 
   for (i = 0; i < xcount; i++) {
-    if (data[i].alternate.valid()) {
+    if (get(i)->valid()) {
       if (purl) {
         Arena arena;
         char *url;
@@ -168,7 +168,7 @@ CacheHTTPInfoVector::marshal_length()
   int length = 0;
 
   for (int i = 0; i < xcount; i++) {
-    length += data[i].alternate.marshal_length();
+    length += get(i)->marshal_length();
   }
 
   return length;
@@ -185,7 +185,7 @@ CacheHTTPInfoVector::marshal(char *buf, int length)
   ink_assert(!(((intptr_t)buf) & 3)); // buf must be aligned
 
   for (int i = 0; i < xcount; i++) {
-    int tmp  = data[i].alternate.marshal(buf, length);
+    int tmp  = get(i)->marshal(buf, length);
     length  -= tmp;
     buf     += tmp;
     count++;
@@ -223,6 +223,9 @@ CacheHTTPInfoVector::unmarshal(const char *buf, int length, RefCountObj *block_p
 }
 
 /*-------------------------------------------------------------------------
+  Alternates which are still marshalled are left that way, if there is a
+  @a block_ptr to unmarshal them against later. Selecting an alternate
+  usually touches only some of them, so get() unmarshals each on first use.
   -------------------------------------------------------------------------*/
 uint32_t
 CacheHTTPInfoVector::get_handles(const char *buf, int length, RefCountObj *block_ptr)
@@ -236,16 +239,46 @@ CacheHTTPInfoVector::get_handles(const char *buf, int length, RefCountObj *block
   vector_buf = block_ptr;
 
   while (length - (buf - start) > static_cast<int>(sizeof(HTTPCacheAlt))) {
-    int tmp = info.get_handle(const_cast<char *>(buf), length - (buf - start));
+    char *alt = const_cast<char *>(buf);
+    int   tmp = info.get_handle(alt, length - (buf - start));
+    if (tmp < 0 && block_ptr) {
+      tmp        = HTTPInfo::unmarshal_length(alt, length - (buf - start));
+      info.m_alt = reinterpret_cast<HTTPCacheAlt *>(alt);
+    }
     if (tmp < 0) {
       ink_assert(!"CacheHTTPInfoVector::unmarshal get_handle() failed");
       return static_cast<uint32_t>(-1);
     }
     buf += tmp;
 
-    data(xcount).alternate = info;
+    data(xcount).alternate   = info;
+    data(xcount).marshal_len = tmp;
     xcount++;
   }
 
   return (const_cast<caddr_t>(buf) - const_cast<caddr_t>(start));
 }
+
+/*-------------------------------------------------------------------------
+  -------------------------------------------------------------------------*/
+void
+CacheHTTPInfoVector::unmarshal_alternate(int idx)
+{
+  HTTPCacheAlt *alt = data[idx].alternate.m_alt;
+
+  Metrics::Counter::increment(cache_rsb.hdr_unmarshal);
+  if (HTTPInfo::unmarshal(reinterpret_cast<char *>(alt), data[idx].marshal_len, vector_buf.get()) < 0) {
+    // Keep the alternate so the layout of the vector does not change, but without headers or an
+    // object key so that it is never selected.
+    alt->m_magic         = CACHE_ALT_MAGIC_ALIVE;
+    alt->m_unmarshal_len = data[idx].marshal_len;
+    for (HTTPHdr *hdr : {&alt->m_request_hdr, &alt->m_response_hdr}) {
+      hdr->m_heap = nullptr;
+      hdr->m_http = nullptr;
+      hdr->m_mime = nullptr;
+    }
+    alt->m_frag_offset_count = 0;
+    alt->m_frag_offsets      = nullptr;
+    memset(alt->m_object_key, 0, sizeof(alt->m_object_key));
+  }
+}
@@ -48,11 +48,18 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheFragType type, co
   }
   ink_assert(caches[type] == this);
 
-  Stripe       *stripe = key_to_stripe(key, hostname, host_len);
+  Stripe       *fast   = nullptr;
+  Stripe       *stripe = key_to_stripe(key, hostname, host_len, &fast);
   Dir           result, *last_collision = nullptr;
   ProxyMutex   *mutex = cont->mutex.get();
   OpenDirEntry *od    = nullptr;
   CacheVC      *c     = nullptr;
+
+  // Probe the fast tier first, a copy there is read like any other object of that stripe.
+  if (fast && cache_tier_probe(fast, key, mutex->thread_holding)) {
+    stripe = fast;
+    fast   = nullptr;
+  }
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked() || (od = stripe->open_read(key)) || dir_probe(key, stripe, &result, &last_collision)) {
@@ -71,7 +78,7 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheFragType type, co
       goto Lmiss;
     }
     if (!lock.is_locked()) {
-      CONT_SCHED_LOCK_RETRY(c);
+      CONT_SCHED_STRIPE_LOCK_RETRY(c);
       return &c->_action;
     }
     if (c->od) {
@@ -116,12 +123,18 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheHTTPHdr *request,
   }
   ink_assert(caches[type] == this);
 
-  Stripe       *stripe = key_to_stripe(key, hostname, host_len);
+  Stripe       *fast   = nullptr;
+  Stripe       *stripe = key_to_stripe(key, hostname, host_len, &fast);
   Dir           result, *last_collision = nullptr;
   ProxyMutex   *mutex = cont->mutex.get();
   OpenDirEntry *od    = nullptr;
   CacheVC      *c     = nullptr;
 
+  if (fast && cache_tier_probe(fast, key, mutex->thread_holding)) {
+    stripe = fast;
+    fast   = nullptr;
+  }
+
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked() || (od = stripe->open_read(key)) || dir_probe(key, stripe, &result, &last_collision)) {
@@ -139,7 +152,7 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheHTTPHdr *request,
     }
     if (!lock.is_locked()) {
       SET_CONTINUATION_HANDLER(c, &CacheVC::openReadStartHead);
-      CONT_SCHED_LOCK_RETRY(c);
+      CONT_SCHED_STRIPE_LOCK_RETRY(c);
       return &c->_action;
     }
     if (!c) {
@@ -149,6 +162,10 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheHTTPHdr *request,
       goto Lwriter;
     }
     // hit
+    Metrics::Counter::increment(cache_tier_rsb.tier[static_cast<int>(stripe->cache_vol->tier)].read_hits);
+    if (fast) {
+      cache_tier_note_hit(stripe, fast, key, &result);
+    }
     c->dir = c->first_dir = result;
     c->last_collision     = last_collision;
     SET_CONTINUATION_HANDLER(c, &CacheVC::openReadStartHead);
@@ -187,7 +204,7 @@ CacheVC::load_http_info(CacheHTTPInfoVector *info, Doc *doc, RefCountObj *block_
   if (!this->f.doc_from_ram_cache && // ram cache is always already fixed up.
                                      // If this is an old object, the object version will be old or 0, in either case this is
                                      // correct. Forget the 4.2 compatibility, always update older versioned objects.
-      ts::VersionNumber(doc->v_major, doc->v_minor) < CACHE_DB_VERSION) {
+      ts::VersionNumber(doc->v_major, doc->v_minor) < CACHE_DB_VERSION_HTTPINFO) {
     for (int i = info->xcount - 1; i >= 0; --i) {
       info->data(i).alternate.m_alt->m_response_hdr.m_mime->recompute_accelerators_and_presence_bits();
       info->data(i).alternate.m_alt->m_request_hdr.m_mime->recompute_accelerators_and_presence_bits();
@@ -314,6 +331,35 @@ CacheVC::openReadChooseWriter(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSE
   return EVENT_NONE;
 }
 
+/*
+   Wait for the writer to set its response headers or write its first
+   fragment. The reader is parked on the OpenDirEntry and woken by the writer,
+   or polls as before if too many readers are already waiting. Readers that
+   are not woken within the timeout fail with ECACHE_DOC_BUSY and go to the
+   origin. Must be called under the stripe lock.
+   */
+int
+CacheVC::openReadWaitForWriter(OpenDirEntry *cod)
+{
+  if (cod->num_readers >= cache_config_read_while_writer_max_waiters) {
+    if (cache_config_read_while_writer_max_waiters > 0) {
+      Metrics::Counter::increment(cache_rsb.rww_overflow);
+      Metrics::Counter::increment(stripe->cache_vol->vol_rsb.rww_overflow);
+    }
+    VC_SCHED_WRITER_RETRY();
+  }
+  int msec = cache_config_read_while_writer_timeout - ink_hrtime_to_msec(ink_get_hrtime() - start_time);
+  if (msec <= 0) {
+    Metrics::Counter::increment(cache_rsb.rww_timeout);
+    Metrics::Counter::increment(stripe->cache_vol->vol_rsb.rww_timeout);
+    return openReadFromWriterFailure(CACHE_EVENT_OPEN_READ_FAILED, reinterpret_cast<Event *>(-ECACHE_DOC_BUSY));
+  }
+  DDbg(dbg_ctl_cache_read_agg, "%p: key: %X waiting %d ms for writer, %d waiting", this, first_key.slice32(1), msec,
+       cod->num_readers);
+  od = cod;
+  return cod->wait(this, msec);
+}
+
 int
 CacheVC::openReadFromWriter(int event, Event *e)
 {
@@ -332,13 +378,32 @@ CacheVC::openReadFromWriter(int event, Event *e)
   cancel_trigger();
   intptr_t err = ECACHE_DOC_BUSY;
   DDbg(dbg_ctl_cache_read_agg, "%p: key: %X In openReadFromWriter", this, first_key.slice32(1));
-  if (_action.cancelled) {
+  if (_action.cancelled && !f.open_read_timeout) {
     od = nullptr; // only open for read so no need to close
     return free_CacheVC(this);
   }
   CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
   if (!lock.is_locked()) {
-    VC_SCHED_LOCK_RETRY();
+    VC_SCHED_STRIPE_LOCK_RETRY();
+  }
+  if (f.open_read_timeout) {
+    // Still waiting, so the writer did not wake this reader in time.
+    f.open_read_timeout = 0;
+    if (od) {
+      od->readers.remove(this);
+      od->num_readers--;
+      writer_lock_retry = cache_config_read_while_writer_max_retries;
+      Metrics::Counter::increment(cache_rsb.rww_timeout);
+      Metrics::Counter::increment(stripe->cache_vol->vol_rsb.rww_timeout);
+    } else {
+      // The writers left, see OpenDir::close_write.
+      stripe->open_dir.delayed_readers.remove(this);
+    }
+    if (_action.cancelled) {
+      MUTEX_RELEASE(lock);
+      od = nullptr;
+      return free_CacheVC(this);
+    }
   }
   od = stripe->open_read(&first_key); // recheck in case the lock failed
   if (!od) {
@@ -362,7 +427,7 @@ CacheVC::openReadFromWriter(int event, Event *e)
     } else if (ret == EVENT_CONT) {
       ink_assert(!write_vc);
       if (writer_lock_retry < cache_config_read_while_writer_max_retries) {
-        VC_SCHED_WRITER_RETRY();
+        return openReadWaitForWriter(stripe->open_read(&first_key));
       } else {
         return openReadFromWriterFailure(CACHE_EVENT_OPEN_READ_FAILED, (Event *)-err);
       }
@@ -400,7 +465,7 @@ CacheVC::openReadFromWriter(int event, Event *e)
     }
     DDbg(dbg_ctl_cache_read_agg, "%p: key: %X writer: closed:%d, fragment:%d, retry: %d", this, first_key.slice32(1),
          write_vc->closed, write_vc->fragment, writer_lock_retry);
-    VC_SCHED_WRITER_RETRY();
+    return openReadWaitForWriter(cod);
   }
 
   CACHE_TRY_LOCK(writer_lock, write_vc->mutex, mutex->thread_holding);
@@ -556,7 +621,7 @@ CacheVC::openReadClose(int event, Event * /* e ATS_UNUSED */)
   }
   CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
   if (!lock.is_locked()) {
-    VC_SCHED_LOCK_RETRY();
+    VC_SCHED_STRIPE_LOCK_RETRY();
   }
   if (f.hit_evacuate && dir_valid(stripe, &first_dir) && closed > 0) {
     if (f.single_fragment) {
@@ -583,7 +648,7 @@ CacheVC::openReadReadDone(int event, Event *e)
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
-      VC_SCHED_LOCK_RETRY();
+      VC_SCHED_STRIPE_LOCK_RETRY();
     }
     if (event == AIO_EVENT_DONE && !io.ok()) {
       goto Lerror;
@@ -780,7 +845,7 @@ CacheVC::openReadMain(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
       CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
       if (!lock.is_locked()) {
         SET_HANDLER(&CacheVC::openReadDirDelete);
-        VC_SCHED_LOCK_RETRY();
+        VC_SCHED_STRIPE_LOCK_RETRY();
       }
 
       dir_delete(&earliest_key, stripe, &earliest_dir);
@@ -804,6 +869,7 @@ CacheVC::openReadMain(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   vio.buffer.writer()->append_block(b);
   vio.ndone += bytes;
   doc_pos   += bytes;
+  Metrics::Counter::increment(cache_tier_rsb.tier[static_cast<int>(stripe->cache_vol->tier)].read_bytes, bytes);
   if (vio.ntodo() <= 0) {
     return calluser(VC_EVENT_READ_COMPLETE);
   } else {
@@ -832,7 +898,7 @@ Lread: {
   CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
   if (!lock.is_locked()) {
     SET_HANDLER(&CacheVC::openReadMain);
-    VC_SCHED_LOCK_RETRY();
+    VC_SCHED_STRIPE_LOCK_RETRY();
   }
   if (dir_probe(&key, stripe, &dir, &last_collision)) {
     SET_HANDLER(&CacheVC::openReadReadDone);
@@ -891,7 +957,7 @@ CacheVC::openReadStartEarliest(int /* event ATS_UNUSED */, Event * /* e ATS_UNUS
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
-      VC_SCHED_LOCK_RETRY();
+      VC_SCHED_STRIPE_LOCK_RETRY();
     }
     if (!buf) {
       goto Lread;
@@ -957,7 +1023,7 @@ CacheVC::openReadStartEarliest(int /* event ATS_UNUSED */, Event * /* e ATS_UNUS
       // don't want any writers while we are evacuating the vector
       if (!stripe->open_write(this, false, 1)) {
         Doc     *doc1 = reinterpret_cast<Doc *>(first_buf->data());
-        uint32_t len  = this->load_http_info(write_vector, doc1);
+        uint32_t len  = this->load_http_info(write_vector, doc1, first_buf.get());
         ink_assert(len == doc1->hlen && write_vector->count() > 0);
         write_vector->remove(alternate_index, true);
         // if the vector had one alternate, delete it's directory entry
@@ -1042,7 +1108,7 @@ CacheVC::openReadVecWrite(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
-      VC_SCHED_LOCK_RETRY();
+      VC_SCHED_STRIPE_LOCK_RETRY();
     }
     if (io.ok()) {
       ink_assert(f.evac_vector);
@@ -1098,7 +1164,7 @@ CacheVC::openReadStartHead(int event, Event *e)
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
-      VC_SCHED_LOCK_RETRY();
+      VC_SCHED_STRIPE_LOCK_RETRY();
     }
     if (!buf) {
       goto Lread;
@@ -1149,7 +1215,7 @@ CacheVC::openReadStartHead(int event, Event *e)
       if (!doc->hlen) {
         goto Ldone;
       }
-      if ((uml = this->load_http_info(&vector, doc)) != doc->hlen) {
+      if ((uml = this->load_http_info(&vector, doc, buf.get())) != doc->hlen) {
         if (buf) {
           HTTPCacheAlt *alt        = reinterpret_cast<HTTPCacheAlt *>(doc->hdr());
           int32_t       alt_length = 0;
@@ -1316,7 +1382,7 @@ CacheVC::openReadDirDelete(int event, Event *e)
 {
   MUTEX_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
   if (!lock.is_locked()) {
-    VC_SCHED_LOCK_RETRY();
+    VC_SCHED_STRIPE_LOCK_RETRY();
   }
 
   dir_delete(&earliest_key, stripe, &earliest_dir);
@@ -0,0 +1,90 @@
+/** @file
+
+  Approximate access frequency of cache objects.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_CacheSketch.h"
+
+#include <algorithm>
+
+CacheFrequencySketch::CacheFrequencySketch(unsigned width)
+{
+  int bits = 1;
+  while ((1U << bits) < width) {
+    ++bits;
+  }
+  _shift       = 32 - bits;
+  _sample_size = uint64_t(10) << bits;
+  _counters.assign(DEPTH << bits, 0);
+}
+
+unsigned
+CacheFrequencySketch::_index(const CryptoHash &key, int row) const
+{
+  // Multiplicative hash of a different word of the key for each row.
+  uint32_t h = key.slice32(row) * 0x9E3779B1U;
+  return (row << (32 - _shift)) + (h >> _shift);
+}
+
+unsigned
+CacheFrequencySketch::increment(const CryptoHash &key)
+{
+  unsigned idx[DEPTH];
+  unsigned count = MAX_COUNT;
+
+  for (int row = 0; row < DEPTH; ++row) {
+    idx[row] = _index(key, row);
+    count    = std::min<unsigned>(count, _counters[idx[row]]);
+  }
+  if (count < MAX_COUNT) {
+    // Conservative update, only the counters at the minimum are incremented.
+    for (unsigned i : idx) {
+      if (_counters[i] == count) {
+        ++_counters[i];
+      }
+    }
+    ++count;
+  }
+  if (++_additions >= _sample_size) {
+    this->age();
+  }
+  return count;
+}
+
+unsigned
+CacheFrequencySketch::estimate(const CryptoHash &key) const
+{
+  unsigned count = MAX_COUNT;
+  for (int row = 0; row < DEPTH; ++row) {
+    count = std::min<unsigned>(count, _counters[_index(key, row)]);
+  }
+  return count;
+}
+
+void
+CacheFrequencySketch::age()
+{
+  for (auto &c : _counters) {
+    c >>= 1;
+  }
+  _additions /= 2;
+  ++_generation;
+}
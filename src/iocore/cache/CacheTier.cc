@@ -0,0 +1,358 @@
+/** @file
+
+  Cache storage tiers: promotion of frequently read objects to a fast tier and demotion of fast tier
+  copies back to the capacity tier.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_Cache.h"
+#include "P_CacheDoc.h"
+#include "P_CacheTier.h"
+
+#include <algorithm>
+#include <atomic>
+
+CacheTierStatsBlock cache_tier_rsb;
+
+namespace
+{
+DbgCtl dbg_ctl_cache_tier{"cache_tier"};
+
+/** Copy of a single fragment object from one tier to the other.
+ *
+ * The head fragment is read from the source stripe without unmarshalling, so it can be written
+ * verbatim through the aggregation buffer of the target stripe like an evacuated document. The
+ * directory entry in the target stripe is inserted only if the source is still current.
+ */
+class CacheTierVC : public CacheVC
+{
+public:
+  int readDone(int event, Event *e);
+  int writeStart(int event, Event *e);
+  int writeDone(int event, Event *e);
+
+  int release();
+
+  Stripe *home     = nullptr; ///< Capacity tier stripe of the object.
+  Stripe *fast     = nullptr; ///< Fast tier stripe of the object.
+  bool    promote  = true;    ///< Copy to @a fast, else to @a home.
+  int64_t demoting = 0;       ///< Bytes counted in @c demote_bytes_in_flight.
+};
+
+ClassAllocator<CacheTierVC, true> cacheTierVCAllocator("cacheTierVC");
+
+// Demotion reads started by a scan and not yet written, bounded by the write backlog.
+std::atomic<int64_t> demote_bytes_in_flight{0};
+
+struct CacheTierInvalidateCont : public Continuation {
+  CacheKey key;
+  Stripe  *stripe;
+
+  int invalidate(int event, Event *e);
+
+  CacheTierInvalidateCont(Stripe *s, const CacheKey *k) : Continuation(s->mutex), key(*k), stripe(s)
+  {
+    SET_HANDLER(&CacheTierInvalidateCont::invalidate);
+  }
+};
+
+// Delete all directory entries for @a key from @a stripe, the lock for which must be held.
+bool
+delete_copies(Stripe *stripe, const CacheKey *key)
+{
+  Dir  dir, *last_collision = nullptr;
+  bool deleted              = false;
+  while (dir_probe(key, stripe, &dir, &last_collision) && dir_delete(key, stripe, &dir)) {
+    last_collision = nullptr;
+    deleted        = true;
+  }
+  return deleted;
+}
+
+// @return @c true if @a stripe still has the head of @a key at the offset of @a dir.
+bool
+has_head_at(Stripe *stripe, const CacheKey *key, const Dir *dir)
+{
+  Dir e, *last_collision = nullptr;
+  while (dir_probe(key, stripe, &e, &last_collision)) {
+    if (dir_offset(&e) == dir_offset(dir)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+start_copy(Stripe *source, const Dir *dir, const CacheKey *key, Stripe *home, Stripe *fast, int64_t demoting)
+{
+  CacheTierVC *c = cacheTierVCAllocator.alloc();
+  c->mutex       = source->mutex;
+  c->stripe      = source;
+  c->home        = home;
+  c->fast        = fast;
+  c->promote     = source == home;
+  c->demoting    = demoting;
+  c->first_key   = *key;
+  c->dir         = *dir;
+
+  c->io.aiocb.aio_fildes = source->fd;
+  c->io.aiocb.aio_offset = source->vol_offset(dir);
+  c->io.aiocb.aio_nbytes = dir_approx_size(dir);
+  if (static_cast<off_t>(c->io.aiocb.aio_offset + c->io.aiocb.aio_nbytes) > static_cast<off_t>(source->skip + source->len)) {
+    c->io.aiocb.aio_nbytes = source->skip + source->len - c->io.aiocb.aio_offset;
+  }
+  c->buf              = new_IOBufferData(iobuffer_size_to_index(c->io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+  c->io.aiocb.aio_buf = c->buf->data();
+  c->io.action        = c;
+  c->io.thread        = AIO_CALLBACK_THREAD_ANY;
+  SET_CONTINUATION_HANDLER(c, &CacheTierVC::readDone);
+  ink_assert(ink_aio_read(&c->io) >= 0);
+}
+
+int
+CacheTierVC::release()
+{
+  if (demoting) {
+    demote_bytes_in_flight -= demoting;
+  }
+  cancel_trigger();
+  io.action = nullptr;
+  cacheTierVCAllocator.free(this);
+  return EVENT_DONE;
+}
+
+int
+CacheTierVC::readDone(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  Doc *doc = reinterpret_cast<Doc *>(buf->data());
+
+  ink_assert(stripe->mutex->thread_holding == this_ethread());
+  if (!io.ok() || doc->magic != DOC_MAGIC || static_cast<int64_t>(doc->len) > io.aio_result || !doc->single_fragment() ||
+      !dir_valid(stripe, &dir)) {
+    goto Lfail;
+  }
+  if (!promote) {
+    // A demotion starts from the directory entry, which has only the tag of the key.
+    first_key = doc->first_key;
+  }
+  if (!(doc->first_key == first_key) || !dir_compare_tag(&dir, &first_key)) {
+    goto Lfail;
+  }
+
+  if (doc->doc_type == CACHE_FRAG_TYPE_HTTP) {
+    // The head is written to the other tier as read, so unmarshal a copy to check the alternates.
+    Ptr<IOBufferData> hdr = make_ptr(new_IOBufferData(iobuffer_size_to_index(doc->hlen, MAX_BUFFER_SIZE_INDEX), MEMALIGNED));
+    CacheKey          object_key;
+
+    memcpy(hdr->data(), doc->hdr(), doc->hlen);
+    if (!doc->hlen || vector.unmarshal(hdr->data(), doc->hlen, hdr.get()) != static_cast<int>(doc->hlen) || vector.count() != 1) {
+      goto Lfail;
+    }
+    vector.get(0)->object_key_get(&object_key);
+    if (!(object_key == doc->key)) {
+      goto Lfail;
+    }
+    if (!promote) {
+      int         host_len = 0;
+      const char *hostname = vector.get(0)->request_get()->url_get()->host_get(&host_len);
+      home                 = stripe->cache->key_to_stripe(&first_key, hostname, host_len);
+    }
+    vector.clear();
+  } else if (!promote) {
+    home = stripe->cache->key_to_stripe(&first_key, nullptr, 0);
+  }
+
+  if (home == fast) {
+    // The fast volume is not in front of a capacity volume for this object.
+    return release();
+  }
+
+  Dbg(dbg_ctl_cache_tier, "%s %X, %d bytes", promote ? "promote" : "demote", first_key.slice32(0), doc->len);
+  mutex = promote ? fast->mutex : home->mutex;
+  SET_HANDLER(&CacheTierVC::writeStart);
+  eventProcessor.schedule_imm(this, ET_CALL);
+  return EVENT_CONT;
+
+Lfail:
+  vector.clear();
+  Metrics::Counter::increment(promote ? cache_tier_rsb.promotion_failures : cache_tier_rsb.demotion_failures);
+  return release();
+}
+
+int
+CacheTierVC::writeStart(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  Doc *doc = reinterpret_cast<Doc *>(buf->data());
+
+  stripe        = promote ? fast : home;
+  overwrite_dir = dir;
+  agg_len       = stripe->round_to_approx_size(doc->len);
+  write_len     = doc->data_len(); // subject the copy to the write backlog limit
+  f.evacuator   = 1;
+  dir_set_approx_size(&overwrite_dir, agg_len);
+  dir_set_pinned(&overwrite_dir, 0);
+  dir_set_head(&overwrite_dir, true);
+  dir_clear(&dir);
+
+  SET_HANDLER(&CacheTierVC::writeDone);
+  if (agg_len > AGG_SIZE || !stripe->add_writer(this)) {
+    Metrics::Counter::increment(promote ? cache_tier_rsb.promotion_failures : cache_tier_rsb.demotion_failures);
+    return release();
+  }
+  if (!stripe->is_io_in_progress()) {
+    // This may complete the copy and free this.
+    stripe->aggWrite(EVENT_NONE, nullptr);
+  }
+  return EVENT_CONT;
+}
+
+int
+CacheTierVC::writeDone(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  ink_assert(stripe->mutex->thread_holding == this_ethread());
+  bool inserted = false;
+
+  // agg_copy sets the offset of the copy, there is none if the aggregation write was abandoned.
+  if (dir_offset(&dir)) {
+    if (promote) {
+      // The capacity tier must still have this version of the object, without a writer replacing it.
+      CACHE_TRY_LOCK(lock, home->mutex, mutex->thread_holding);
+      if (lock.is_locked() && !home->open_read(&first_key) && has_head_at(home, &first_key, &overwrite_dir)) {
+        delete_copies(fast, &first_key);
+        inserted = dir_insert(&first_key, fast, &dir);
+      }
+    } else {
+      // Only needed if the capacity tier no longer has the object.
+      Dir e, *last_collision = nullptr;
+      if (!home->open_read(&first_key) && !dir_probe(&first_key, home, &e, &last_collision)) {
+        inserted = dir_insert(&first_key, home, &dir);
+      }
+    }
+  }
+
+  if (promote) {
+    Metrics::Counter::increment(inserted ? cache_tier_rsb.promotions : cache_tier_rsb.promotion_failures);
+  } else {
+    Metrics::Counter::increment(inserted ? cache_tier_rsb.demotions : cache_tier_rsb.demotion_failures);
+  }
+  return release();
+}
+
+int
+CacheTierInvalidateCont::invalidate(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  if (delete_copies(stripe, &key)) {
+    Metrics::Counter::increment(cache_tier_rsb.invalidations);
+  }
+  delete this;
+  return EVENT_DONE;
+}
+
+} // end anonymous namespace
+
+void
+register_cache_tier_stats(const std::string &prefix)
+{
+  cache_tier_rsb.tier[static_cast<int>(CacheTier::Capacity)].read_hits  = Metrics::Counter::createPtr(prefix + ".capacity.read.hits");
+  cache_tier_rsb.tier[static_cast<int>(CacheTier::Capacity)].read_bytes = Metrics::Counter::createPtr(prefix + ".capacity.read.bytes");
+  cache_tier_rsb.tier[static_cast<int>(CacheTier::Fast)].read_hits      = Metrics::Counter::createPtr(prefix + ".fast.read.hits");
+  cache_tier_rsb.tier[static_cast<int>(CacheTier::Fast)].read_bytes     = Metrics::Counter::createPtr(prefix + ".fast.read.bytes");
+
+  cache_tier_rsb.promotions         = Metrics::Counter::createPtr(prefix + ".promotions");
+  cache_tier_rsb.promotion_failures = Metrics::Counter::createPtr(prefix + ".promotion_failures");
+  cache_tier_rsb.demotions          = Metrics::Counter::createPtr(prefix + ".demotions");
+  cache_tier_rsb.demotion_failures  = Metrics::Counter::createPtr(prefix + ".demotion_failures");
+  cache_tier_rsb.invalidations      = Metrics::Counter::createPtr(prefix + ".invalidations");
+}
+
+bool
+cache_tier_probe(Stripe *fast, const CacheKey *key, EThread *thread)
+{
+  CACHE_TRY_LOCK(lock, fast->mutex, thread);
+  if (!lock.is_locked()) {
+    return false;
+  }
+  Dir dir, *last_collision = nullptr;
+  return dir_probe(key, fast, &dir, &last_collision);
+}
+
+void
+cache_tier_note_hit(Stripe *home, Stripe *fast, const CacheKey *key, const Dir *dir)
+{
+  ink_assert(home->mutex->thread_holding == this_ethread());
+  unsigned threshold = std::min<unsigned>(cache_config_tier_promote_hits, CacheFrequencySketch::MAX_COUNT);
+  if (!threshold || static_cast<int64_t>(dir_approx_size(dir)) > cache_config_tier_promote_max_size) {
+    return;
+  }
+  if (!home->tier_sketch) {
+    home->tier_sketch = new CacheFrequencySketch();
+  }
+  // Only when the estimate reaches the threshold, so there is at most one promotion in flight for a key.
+  if (home->tier_sketch->increment(*key) == threshold && dir_agg_valid(home, dir) && !dir_agg_buf_valid(home, dir)) {
+    start_copy(home, dir, key, home, fast, 0);
+  }
+}
+
+void
+cache_tier_invalidate(Stripe *fast, const CacheKey *key, EThread *thread)
+{
+  CACHE_TRY_LOCK(lock, fast->mutex, thread);
+  if (lock.is_locked()) {
+    if (delete_copies(fast, key)) {
+      Metrics::Counter::increment(cache_tier_rsb.invalidations);
+    }
+  } else {
+    eventProcessor.schedule_imm(new CacheTierInvalidateCont(fast, key), ET_CALL);
+  }
+}
+
+void
+cache_tier_scan_for_demotion(Stripe *fast)
+{
+  if (!cache_config_tier_demote) {
+    return;
+  }
+  // The region the write position reaches next, after the region of the previous scan.
+  int ps = fast->offset_to_vol_offset(fast->scan_pos + EVACUATION_SIZE);
+  int pe = fast->offset_to_vol_offset(fast->scan_pos + EVACUATION_SIZE + (fast->len / PIN_SCAN_EVERY));
+  for (int i = 0; i < fast->direntries(); i++) {
+    Dir *e = &fast->dir[i];
+    if (dir_is_empty(e) || !dir_head(e) || dir_phase(e) == fast->header->phase || dir_offset(e) < ps || dir_offset(e) >= pe) {
+      continue;
+    }
+    cache_tier_demote(fast, e);
+  }
+}
+
+bool
+cache_tier_demote(Stripe *fast, const Dir *dir)
+{
+  ink_assert(fast->mutex->thread_holding == this_ethread());
+  int64_t bytes = dir_approx_size(dir);
+  if (demote_bytes_in_flight + bytes > cache_config_agg_write_backlog) {
+    Metrics::Counter::increment(cache_tier_rsb.demotion_failures);
+    return false;
+  }
+  demote_bytes_in_flight += bytes;
+  CacheKey key;
+  key.clear();
+  start_copy(fast, dir, &key, nullptr, fast, bytes);
+  return true;
+}
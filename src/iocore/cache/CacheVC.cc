@@ -311,20 +311,15 @@ CacheVC::dead(int /* event ATS_UNUSED */, Event * /*e ATS_UNUSED */)
 static void
 unmarshal_helper(Doc *doc, Ptr<IOBufferData> &buf, int &okay)
 {
-  using UnmarshalFunc              = int(char *buf, int len, RefCountObj *block_ref);
-  UnmarshalFunc    *unmarshal_func = &HTTPInfo::unmarshal;
-  ts::VersionNumber version(doc->v_major, doc->v_minor);
-
   // introduced by https://github.com/apache/trafficserver/pull/4874, this is used to distinguish the doc version
   // before and after #4847
-  if (version < CACHE_DB_VERSION) {
-    unmarshal_func = &HTTPInfo::unmarshal_v24_1;
-  }
-
-  char *tmp = doc->hdr();
-  int   len = doc->hlen;
+  bool  old_format = ts::VersionNumber(doc->v_major, doc->v_minor) < CACHE_DB_VERSION_HTTPINFO;
+  char *tmp        = doc->hdr();
+  int   len        = doc->hlen;
   while (len > 0) {
-    int r = unmarshal_func(tmp, len, buf.get());
+    // Alternates in the current format are unmarshalled when they are used, see
+    // CacheHTTPInfoVector::get(). Only check that they are sane here.
+    int r = old_format ? HTTPInfo::unmarshal_v24_1(tmp, len, buf.get()) : HTTPInfo::unmarshal_length(tmp, len);
     if (r < 0) {
       ink_assert(!"CacheVC::handleReadDone unmarshal failed");
       okay = 0;
@@ -356,7 +351,7 @@ CacheVC::handleReadDone(int event, Event *e)
   {
     MUTEX_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
-      VC_SCHED_LOCK_RETRY();
+      VC_SCHED_STRIPE_LOCK_RETRY();
     }
     if ((!dir_valid(stripe, &dir)) || (!io.ok())) {
       if (!io.ok()) {
@@ -405,17 +400,20 @@ CacheVC::handleReadDone(int event, Event *e)
       if (!f.doc_from_ram_cache) {
         f.not_from_ram_cache = 1;
       }
-      if (cache_config_enable_checksum && doc->checksum != DOC_NO_CHECKSUM) {
-        // verify that the checksum matches
-        uint32_t checksum = 0;
-        for (char *b = doc->hdr(); b < reinterpret_cast<char *>(doc) + doc->len; b++) {
-          checksum += *b;
-        }
-        ink_assert(checksum == doc->checksum);
-        if (checksum != doc->checksum) {
+      // Verify a sample of the fragments read from disk. Fragments from the RAM cache were sampled
+      // when they were read from disk.
+      if (cache_config_enable_checksum && doc->checksum != DOC_NO_CHECKSUM && !f.doc_from_ram_cache &&
+          (cache_config_checksum_verify_percent >= 100 ||
+           static_cast<int>(this_ethread()->generator.random() % 100) < cache_config_checksum_verify_percent)) {
+        Metrics::Counter::increment(cache_rsb.checksum_verified);
+        Metrics::Counter::increment(stripe->cache_vol->vol_rsb.checksum_verified);
+        if (!doc->checksum_ok()) {
           Note("cache: checksum error for [%" PRIu64 " %" PRIu64 "] len %d, hlen %d, disk %s, offset %" PRIu64 " size %zu",
                doc->first_key.b[0], doc->first_key.b[1], doc->len, doc->hlen, stripe->path, (uint64_t)io.aiocb.aio_offset,
                (size_t)io.aiocb.aio_nbytes);
+          Metrics::Counter::increment(cache_rsb.checksum_failure);
+          Metrics::Counter::increment(stripe->cache_vol->vol_rsb.checksum_failure);
+          // The caller removes the directory entry and treats this as a miss.
           doc->magic = DOC_CORRUPT;
           okay       = 0;
         }
@@ -562,7 +560,7 @@ CacheVC::removeEvent(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   {
     MUTEX_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
-      VC_SCHED_LOCK_RETRY();
+      VC_SCHED_STRIPE_LOCK_RETRY();
     }
     if (_action.cancelled) {
       if (od) {
@@ -944,7 +942,7 @@ CacheVC::scanOpenWrite(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
       Dbg(dbg_ctl_cache_scan, "stripe->mutex %p:scanOpenWrite", this);
-      VC_SCHED_LOCK_RETRY();
+      VC_SCHED_STRIPE_LOCK_RETRY();
     }
 
     Dbg(dbg_ctl_cache_scan, "trying for writer lock");
@@ -1062,6 +1060,16 @@ CacheVC::set_http_info(CacheHTTPInfo *ainfo)
 
   alternate.copy_shallow(ainfo);
   ainfo->clear();
+
+  // Readers waiting for the headers can choose this writer now.
+  if (od) {
+    CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
+    if (lock.is_locked()) {
+      od->signal_readers(mutex->thread_holding);
+    } else {
+      stripe->open_dir.signal_readers(&first_key, mutex->thread_holding);
+    }
+  }
 }
 
 void
@@ -663,7 +663,7 @@ agg_copy(char *p, CacheVC *vc)
     doc->doc_type    = vc->frag_type;
     doc->v_major     = CACHE_DB_MAJOR_VERSION;
     doc->v_minor     = CACHE_DB_MINOR_VERSION;
-    doc->unused      = 0; // force this for forward compatibility.
+    doc->flags       = 0; // force this for forward compatibility.
     doc->total_len   = vc->total_len;
     doc->first_key   = vc->first_key;
     doc->sync_serial = stripe->header->sync_serial;
@@ -758,10 +758,8 @@ agg_copy(char *p, CacheVC *vc)
 #endif
     }
     if (cache_config_enable_checksum) {
-      doc->checksum = 0;
-      for (char *b = doc->hdr(); b < reinterpret_cast<char *>(doc) + doc->len; b++) {
-        doc->checksum += *b;
-      }
+      // The fragment was just copied in, so this is computed from the CPU cache.
+      doc->set_checksum();
     }
     if (vc->frag_type == CACHE_FRAG_TYPE_HTTP && vc->f.single_fragment) {
       ink_assert(doc->hlen);
@@ -848,6 +846,9 @@ Stripe::periodic_scan()
 {
   evacuate_cleanup();
   scan_for_pinned_documents();
+  if (cache_vol->tier == CacheTier::Fast) {
+    cache_tier_scan_for_demotion(this);
+  }
   if (header->write_pos == start) {
     scan_pos = start;
   }
@@ -962,6 +963,7 @@ Lagain:
    */
   io.thread = AIO_CALLBACK_THREAD_AIO;
   SET_HANDLER(&Stripe::aggWriteDone);
+  cache_admission_wrote(this, io.aiocb.aio_nbytes);
   ink_aio_write(&io);
 
 Lwait:
@@ -1019,7 +1021,7 @@ CacheVC::openWriteCloseDir(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED *
     if (!lock.is_locked()) {
       SET_HANDLER(&CacheVC::openWriteCloseDir);
       ink_assert(!is_io_in_progress());
-      VC_SCHED_LOCK_RETRY();
+      VC_SCHED_STRIPE_LOCK_RETRY();
     }
     stripe->close_write(this);
     if (closed < 0 && fragment) {
@@ -1072,7 +1074,7 @@ CacheVC::openWriteCloseHeadDone(int event, Event *e)
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
-      VC_LOCK_RETRY_EVENT();
+      VC_STRIPE_LOCK_RETRY_EVENT();
     }
     od->writing_vec = false;
     if (!io.ok()) {
@@ -1151,7 +1153,7 @@ CacheVC::openWriteCloseDataDone(int event, Event *e)
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, this_ethread());
     if (!lock.is_locked()) {
-      VC_LOCK_RETRY_EVENT();
+      VC_STRIPE_LOCK_RETRY_EVENT();
     }
     if (!fragment) {
       ink_assert(key == earliest_key);
@@ -1166,6 +1168,9 @@ CacheVC::openWriteCloseDataDone(int event, Event *e)
     fragment++;
     write_pos += write_len;
     dir_insert(&key, stripe, &dir);
+    if (fragment == 1 && od) {
+      od->signal_readers(this_ethread());
+    }
     blocks = iobufferblock_skip(blocks.get(), &offset, &length, write_len);
     next_CacheKey(&key, &key);
     if (length) {
@@ -1245,7 +1250,7 @@ CacheVC::openWriteWriteDone(int event, Event *e)
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
-      VC_LOCK_RETRY_EVENT();
+      VC_STRIPE_LOCK_RETRY_EVENT();
     }
     // store the earliest directory. Need to remove the earliest dir
     // in case the writer aborts.
@@ -1262,6 +1267,10 @@ CacheVC::openWriteWriteDone(int event, Event *e)
     ++fragment;
     write_pos += write_len;
     dir_insert(&key, stripe, &dir);
+    if (fragment == 1 && od) {
+      // Readers waiting for the first fragment can start reading it.
+      od->signal_readers(mutex->thread_holding);
+    }
     DDbg(dbg_ctl_cache_insert, "WriteDone: %X, %X, %d", key.slice32(0), first_key.slice32(0), write_len);
     blocks = iobufferblock_skip(blocks.get(), &offset, &length, write_len);
     next_CacheKey(&key, &key);
@@ -1386,7 +1395,7 @@ CacheVC::openWriteOverwrite(int event, Event *e)
 Lcollision: {
   CACHE_TRY_LOCK(lock, stripe->mutex, this_ethread());
   if (!lock.is_locked()) {
-    VC_LOCK_RETRY_EVENT();
+    VC_STRIPE_LOCK_RETRY_EVENT();
   }
   int res = dir_probe(&first_key, stripe, &dir, &last_collision);
   if (res > 0) {
@@ -1419,7 +1428,7 @@ CacheVC::openWriteStartDone(int event, Event *e)
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
-      VC_LOCK_RETRY_EVENT();
+      VC_STRIPE_LOCK_RETRY_EVENT();
     }
 
     if (_action.cancelled && (!od || !od->has_multiple_writers())) {
@@ -1472,6 +1481,9 @@ CacheVC::openWriteStartDone(int event, Event *e)
       if ((err = stripe->open_write(this, if_writers, cache_config_http_max_alts > 1 ? cache_config_http_max_alts : 0)) > 0) {
         goto Lfailure;
       }
+      if (err < 0) {
+        VC_SCHED_LOCK_RETRY();
+      }
       if (od->has_multiple_writers()) {
         MUTEX_RELEASE(lock);
         SET_HANDLER(&CacheVC::openWriteMain);
@@ -1561,8 +1573,12 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheFragType frag_ty
   SCOPED_MUTEX_LOCK(lock, c->mutex, this_ethread());
   c->vio.op      = VIO::WRITE;
   c->op_type     = static_cast<int>(CacheOpType::Write);
-  c->stripe      = key_to_stripe(key, hostname, host_len);
+  Stripe *fast   = nullptr;
+  c->stripe      = key_to_stripe(key, hostname, host_len, &fast);
   Stripe *stripe = c->stripe;
+  if (fast) {
+    cache_tier_invalidate(fast, key, c->mutex->thread_holding);
+  }
   Metrics::Gauge::increment(cache_rsb.status[c->op_type].active);
   Metrics::Gauge::increment(stripe->cache_vol->vol_rsb.status[c->op_type].active);
   c->first_key = c->key = *key;
@@ -1577,15 +1593,25 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheFragType frag_ty
   do {
     rand_CacheKey(&c->key);
   } while (DIR_MASK_TAG(c->key.slice32(2)) == DIR_MASK_TAG(c->first_key.slice32(2)));
-  c->earliest_key     = c->key;
-  c->info             = nullptr;
-  c->f.overwrite      = (options & CACHE_WRITE_OPT_OVERWRITE) != 0;
-  c->f.close_complete = (options & CACHE_WRITE_OPT_CLOSE_COMPLETE) != 0;
-  c->f.sync           = (options & CACHE_WRITE_OPT_SYNC) == CACHE_WRITE_OPT_SYNC;
+  c->earliest_key      = c->key;
+  c->info              = nullptr;
+  c->f.overwrite       = (options & CACHE_WRITE_OPT_OVERWRITE) != 0;
+  c->f.close_complete  = (options & CACHE_WRITE_OPT_CLOSE_COMPLETE) != 0;
+  c->f.sync            = (options & CACHE_WRITE_OPT_SYNC) == CACHE_WRITE_OPT_SYNC;
+  c->f.admission_retry = (options & CACHE_WRITE_OPT_RETRY) != 0;
   // coverity[Y2K38_SAFETY:FALSE]
   c->pin_in_cache = static_cast<uint32_t>(apin_in_cache);
 
-  if ((res = c->stripe->open_write_lock(c, false, 1)) > 0) {
+  {
+    CACHE_TRY_LOCK(lock, c->stripe->mutex, cont->mutex->thread_holding);
+    if (!lock.is_locked()) {
+      SET_CONTINUATION_HANDLER(c, &CacheVC::openWriteStartBegin);
+      c->trigger = CONT_SCHED_STRIPE_LOCK_RETRY(c);
+      return &c->_action;
+    }
+    res = c->stripe->open_write(c, false, 1);
+  }
+  if (res > 0) {
     // document currently being written, abort
     Metrics::Counter::increment(cache_rsb.status[c->op_type].failure);
     Metrics::Counter::increment(stripe->cache_vol->vol_rsb.status[c->op_type].failure);
@@ -1594,6 +1620,7 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheFragType frag_ty
     return ACTION_RESULT_DONE;
   }
   if (res < 0) {
+    // deferred by admission control, the stripe lock is free so wait for the retry delay
     SET_CONTINUATION_HANDLER(c, &CacheVC::openWriteStartBegin);
     c->trigger = CONT_SCHED_LOCK_RETRY(c);
     return &c->_action;
@@ -1615,7 +1642,7 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheFragType frag_ty
 // main entry point for writing of http documents
 Action *
 Cache::open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *info, time_t apin_in_cache,
-                  const CacheKey * /* key1 ATS_UNUSED */, CacheFragType type, const char *hostname, int host_len)
+                  const CacheKey * /* key1 ATS_UNUSED */, CacheFragType type, const char *hostname, int host_len, int options)
 {
   if (!CacheProcessor::IsCacheReady(type)) {
     cont->handleEvent(CACHE_EVENT_OPEN_WRITE_FAILED, (void *)-ECACHE_NOT_READY);
@@ -1638,11 +1665,16 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *info,
   do {
     rand_CacheKey(&c->key);
   } while (DIR_MASK_TAG(c->key.slice32(2)) == DIR_MASK_TAG(c->first_key.slice32(2)));
-  c->earliest_key = c->key;
-  c->frag_type    = CACHE_FRAG_TYPE_HTTP;
-  c->stripe       = key_to_stripe(key, hostname, host_len);
-  Stripe *stripe  = c->stripe;
-  c->info         = info;
+  c->earliest_key      = c->key;
+  c->frag_type         = CACHE_FRAG_TYPE_HTTP;
+  Stripe *fast         = nullptr;
+  c->stripe            = key_to_stripe(key, hostname, host_len, &fast);
+  Stripe *stripe       = c->stripe;
+  c->info              = info;
+  c->f.admission_retry = (options & CACHE_WRITE_OPT_RETRY) != 0;
+  if (fast) {
+    cache_tier_invalidate(fast, key, c->mutex->thread_holding);
+  }
   if (c->info && (uintptr_t)info != CACHE_ALLOW_MULTIPLE_WRITES) {
     /*
        Update has the following code paths :
@@ -1693,6 +1725,12 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *info,
       if ((err = c->stripe->open_write(c, if_writers, cache_config_http_max_alts > 1 ? cache_config_http_max_alts : 0)) > 0) {
         goto Lfailure;
       }
+      if (err < 0) {
+        // deferred by admission control, the stripe lock is free so wait for the retry delay
+        SET_CONTINUATION_HANDLER(c, &CacheVC::openWriteStartDone);
+        CONT_SCHED_LOCK_RETRY(c);
+        return &c->_action;
+      }
       // If there are multiple writers, then this one cannot be an update.
       // Only the first writer can do an update. If that's the case, we can
       // return success to the state machine now.;
@@ -1724,7 +1762,7 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *info,
     }
     // missed lock
     SET_CONTINUATION_HANDLER(c, &CacheVC::openWriteStartDone);
-    CONT_SCHED_LOCK_RETRY(c);
+    CONT_SCHED_STRIPE_LOCK_RETRY(c);
     return &c->_action;
   }
 
@@ -0,0 +1,137 @@
+/** @file
+
+  Admission control for cache writes.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "P_CacheSketch.h"
+#include "tscore/CryptoHash.h"
+#include "tscore/ink_hrtime.h"
+
+#include <cstdint>
+#include <vector>
+
+class CacheVC;
+class Stripe;
+
+extern int cache_config_admission_min_hits;
+extern int cache_config_admission_write_rate;
+extern int cache_config_admission_defer_backlog;
+extern int cache_config_admission_defer_max;
+
+/** Generic cache write admission interface.
+ *
+ * A stripe consults its admission policy before a new object is written, with the stripe lock
+ * held. Writes already admitted, updates and evacuations are not subject to admission, but the
+ * bytes they add to the aggregation buffer are reported with @c wrote.
+ */
+class CacheAdmission
+{
+public:
+  enum class Result {
+    Admit,           ///< Write the object.
+    Defer,           ///< Ask again later, the stripe is behind.
+    RejectFrequency, ///< The object has not been seen often enough.
+    RejectBudget,    ///< The stripe has used its write budget.
+  };
+
+  /** Decide whether to write the object @a key.
+   *
+   * @a pending is the number of bytes waiting for the aggregation buffer, @a waited is how long the
+   * write has already been deferred. A @a retry of a write which was already considered is not
+   * another request for the object.
+   */
+  virtual Result admit(const CryptoHash &key, int64_t pending, ink_hrtime waited, ink_hrtime now, bool retry = false) = 0;
+
+  /// @a bytes were copied to the aggregation buffer at @a now.
+  virtual void wrote(int64_t bytes, ink_hrtime now) = 0;
+
+  virtual ~CacheAdmission() {}
+};
+
+/// Default policy, a TinyLFU frequency filter and a write budget configured by @c proxy.config.cache.admission.
+CacheAdmission *new_CacheAdmission();
+
+/** Set of recently seen keys in front of a frequency sketch.
+ *
+ * A one hit object only sets bits here and does not take space in the sketch. The doorkeeper is
+ * cleared whenever the sketch ages, so both forget at the same rate.
+ */
+class CacheDoorkeeper
+{
+public:
+  /// @a bits is rounded up to a power of 2.
+  explicit CacheDoorkeeper(unsigned bits);
+
+  /// Add @a key, @return @c true if it was already present.
+  bool put(const CryptoHash &key);
+
+  /// @return @c true if @a key is present, false positives are possible.
+  bool contains(const CryptoHash &key) const;
+
+  void clear();
+
+private:
+  unsigned _index(const CryptoHash &key, int probe) const;
+
+  int                   _shift;
+  std::vector<uint64_t> _bits;
+};
+
+/** Bytes a stripe may write, refilled at a constant rate.
+ *
+ * The budget holds at most one second of writes. Writes are charged after the fact and may overdraw
+ * the budget, new writes are refused until it is positive again.
+ */
+class CacheWriteBudget
+{
+public:
+  /// Set the refill rate to @a rate bytes per second, 0 for no limit.
+  void set_rate(int64_t rate, ink_hrtime now);
+
+  /// @return @c true if a new write may start at @a now.
+  bool available(ink_hrtime now);
+
+  void charge(int64_t bytes, ink_hrtime now);
+
+  int64_t
+  tokens() const
+  {
+    return _tokens;
+  }
+
+private:
+  void _refill(ink_hrtime now);
+
+  int64_t    _rate   = 0;
+  int64_t    _tokens = 0;
+  ink_hrtime _last   = 0;
+};
+
+/** Run the admission policy of @a stripe for the write @a cont. The lock for @a stripe must be held.
+ *
+ * @return 0 to write, -1 to retry later or @c ECACHE_NOT_ADMITTED if the write is refused.
+ */
+int cache_admission_check(Stripe *stripe, CacheVC *cont);
+
+/// Charge @a bytes copied to the aggregation buffer of @a stripe against its write budget.
+void cache_admission_wrote(Stripe *stripe, int64_t bytes);
@@ -211,7 +211,7 @@ struct Dir {
 LINK_FORWARD_DECLARATION(CacheVC, opendir_link) // forward declaration
 struct OpenDirEntry {
   DLL<CacheVC, Link_CacheVC_opendir_link> writers; // list of all the current writers
-  DLL<CacheVC, Link_CacheVC_opendir_link> readers; // list of all the current readers - not used
+  DLL<CacheVC, Link_CacheVC_opendir_link> readers; // readers waiting for the writers to make progress
   CacheHTTPInfoVector                     vector;  // Vector for the http document. Each writer
                                                    // maintains a pointer to this vector and
                                                    // writes it down to disk.
@@ -221,6 +221,7 @@ struct OpenDirEntry {
                                                    // inserted, otherwise this dir is overwritten
   uint16_t num_writers;                            // num of current writers
   uint16_t max_writers;                            // max number of simultaneous writers allowed
+  uint16_t num_readers;                            // num of waiting readers
   bool     dont_update_directory;                  // if set, the first_dir is not updated.
   bool     move_resident_alt;                      // if set, single_doc_dir is inserted.
   bool     reading_vec;                            // somebody is currently reading the vector
@@ -228,7 +229,8 @@ struct OpenDirEntry {
 
   LINK(OpenDirEntry, link);
 
-  int wait(CacheVC *c, int msec);
+  int  wait(CacheVC *c, int msec);
+  void signal_readers(EThread *t);
 
   bool
   has_multiple_writers()
@@ -245,6 +247,8 @@ struct OpenDir : public Continuation {
   int           close_write(CacheVC *c);
   OpenDirEntry *open_read(const CryptoHash *key) const;
   int           signal_readers(int event, Event *e);
+  void          signal_readers(const CryptoHash *key, EThread *t);
+  void          delay_reader(CacheVC *c, EThread *t);
 
   OpenDir();
 };
@@ -23,7 +23,9 @@
 
 #pragma once
 
+#include "iocore/cache/CacheDefs.h"
 #include "tscore/CryptoHash.h"
+#include "tscore/CRC32C.h"
 
 #include <cstdint>
 
@@ -31,6 +33,9 @@
 #define DOC_CORRUPT     ((uint32_t)0xDEADBABE)
 #define DOC_NO_CHECKSUM ((uint32_t)0xA0B0C0D0)
 
+// Doc::flags
+#define DOC_FLAG_CRC32C 0x01 ///< Doc::checksum is the CRC-32C, otherwise the byte sum. Set from CACHE_DB_VERSION_CRC32C.
+
 // Note : hdr() needs to be 8 byte aligned.
 struct Doc {
   uint32_t magic;     // DOC_MAGIC
@@ -49,7 +54,7 @@ struct Doc {
   uint32_t doc_type : 8; ///< Doc type - indicates the format of this structure and its content.
   uint32_t v_major  : 8; ///< Major version number.
   uint32_t v_minor  : 8; ///< Minor version number.
-  uint32_t unused   : 8; ///< Unused, forced to zero.
+  uint32_t flags    : 8; ///< DOC_FLAG_*, zero in older versions.
   uint32_t sync_serial;
   uint32_t write_serial;
   uint32_t pinned; ///< pinned until - CAVEAT: use uint32_t instead of time_t for the cache compatibility
@@ -64,6 +69,9 @@ struct Doc {
   char    *hdr();
   char    *data();
 
+  void set_checksum();
+  bool checksum_ok();
+
   using self_type = Doc;
 };
 
@@ -96,3 +104,28 @@ Doc::data()
 {
   return this->hdr() + this->hlen;
 }
+
+/// Set the checksum of the header and data, which must be in place.
+inline void
+Doc::set_checksum()
+{
+  this->flags    |= DOC_FLAG_CRC32C;
+  this->checksum  = ts::crc32c(this->hdr(), this->len - sizeof(self_type));
+}
+
+/// @return @c false if the checksum of the header and data does not match.
+inline bool
+Doc::checksum_ok()
+{
+  if (this->checksum == DOC_NO_CHECKSUM) {
+    return true;
+  }
+  if ((this->flags & DOC_FLAG_CRC32C) && ts::VersionNumber(this->v_major, this->v_minor) >= CACHE_DB_VERSION_CRC32C) {
+    return this->checksum == ts::crc32c(this->hdr(), this->len - sizeof(self_type));
+  }
+  uint32_t sum = 0;
+  for (char *b = this->hdr(); b < reinterpret_cast<char *>(this) + this->len; b++) {
+    sum += *b;
+  }
+  return this->checksum == sum;
+}
@@ -42,11 +42,14 @@ struct CacheHostRecord {
 
   void UpdateMatch(CacheHostResult *r);
   void Print() const;
+  void init_stripes();
 
   ~CacheHostRecord()
   {
     ats_free(stripes);
     ats_free(vol_hash_table);
+    ats_free(fast_stripes);
+    ats_free(fast_vol_hash_table);
     ats_free(cp);
   }
 
@@ -57,6 +60,11 @@ struct CacheHostRecord {
   CacheVol      **cp             = nullptr;
   int             num_cachevols  = 0;
 
+  // Stripes of fast tier volumes, which hold copies of frequently read objects of the above stripes.
+  Stripe        **fast_stripes        = nullptr;
+  int             num_fast_vols       = 0;
+  unsigned short *fast_vol_hash_table = nullptr;
+
   CacheHostRecord() {}
 };
 
@@ -295,6 +303,7 @@ struct ConfigVol {
   off_t     size;
   bool      in_percent;
   bool      ramcache_enabled;
+  CacheTier tier = CacheTier::Capacity;
   int       percent;
   CacheVol *cachep;
   LINK(ConfigVol, link);
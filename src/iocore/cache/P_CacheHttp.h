@@ -40,6 +40,7 @@ enum {
 
 struct vec_info {
   CacheHTTPInfo alternate;
+  int           marshal_len = 0; ///< Length of @a alternate while it is still marshalled.
 };
 
 struct CacheHTTPInfoVector {
@@ -70,16 +71,22 @@ struct CacheHTTPInfoVector {
   int      marshal(char *buf, int length);
   uint32_t get_handles(const char *buf, int length, RefCountObj *block_ptr = nullptr);
   int      unmarshal(const char *buf, int length, RefCountObj *block_ptr);
+  void     unmarshal_alternate(int idx);
 
   CacheArray<vec_info> data;
   int                  xcount = 0;
   Ptr<RefCountObj>     vector_buf;
 };
 
+/// Alternates left marshalled by @c get_handles are unmarshalled here, on first use. The caller
+/// must hold the stripe lock, as the buffer may be shared through the RAM cache.
 inline CacheHTTPInfo *
 CacheHTTPInfoVector::get(int idx)
 {
   ink_assert(idx >= 0);
   ink_assert(idx < xcount);
+  if (data[idx].alternate.m_alt && data[idx].alternate.m_alt->m_magic == CACHE_ALT_MAGIC_MARSHALED) {
+    unmarshal_alternate(idx);
+  }
   return &data[idx].alternate;
 }
@@ -78,6 +78,25 @@ struct EvacuationBlock;
     return EVENT_CONT;                                                                                         \
   } while (0)
 
+// Retry when the stripe lock is released, or after the retry delay if it has no handoff.
+#define VC_SCHED_STRIPE_LOCK_RETRY()                                                        \
+  do {                                                                                      \
+    if (stripe->mutex->handoff) {                                                           \
+      trigger = stripe->mutex->wait_for_release(this, mutex->thread_holding, EVENT_INTERVAL); \
+      return EVENT_CONT;                                                                    \
+    }                                                                                       \
+    VC_SCHED_LOCK_RETRY();                                                                  \
+  } while (0)
+
+#define VC_STRIPE_LOCK_RETRY_EVENT()                                               \
+  do {                                                                             \
+    if (stripe->mutex->handoff) {                                                  \
+      trigger = stripe->mutex->wait_for_release(this, mutex->thread_holding, event); \
+      return EVENT_CONT;                                                           \
+    }                                                                              \
+    VC_LOCK_RETRY_EVENT();                                                         \
+  } while (0)
+
 #define CONT_SCHED_LOCK_RETRY_RET(_c)                                                                  \
   do {                                                                                                 \
     _c->mutex->thread_holding->schedule_in_local(_c, HRTIME_MSECONDS(cache_config_mutex_retry_delay)); \
@@ -86,6 +105,11 @@ struct EvacuationBlock;
 
 #define CONT_SCHED_LOCK_RETRY(_c) _c->mutex->thread_holding->schedule_in_local(_c, HRTIME_MSECONDS(cache_config_mutex_retry_delay))
 
+// Schedule a new CacheVC that missed its stripe lock for when the lock is released, or after the retry delay.
+#define CONT_SCHED_STRIPE_LOCK_RETRY(_c)                                                                             \
+  (_c->stripe->mutex->handoff ? _c->stripe->mutex->wait_for_release(_c, _c->mutex->thread_holding, EVENT_INTERVAL) : \
+                                CONT_SCHED_LOCK_RETRY(_c))
+
 #define VC_SCHED_WRITER_RETRY()                                           \
   do {                                                                    \
     ink_assert(!trigger);                                                 \
@@ -109,6 +133,8 @@ extern int cache_config_max_doc_size;
 extern int cache_config_min_average_object_size;
 extern int cache_config_agg_write_backlog;
 extern int cache_config_enable_checksum;
+extern int cache_config_checksum_verify_percent;
+extern int cache_config_recovery_queue_depth;
 extern int cache_config_alt_rewrite_max_size;
 extern int cache_config_read_while_writer;
 extern int cache_config_agg_write_backlog;
@@ -120,8 +146,11 @@ extern int cache_config_hit_evacuate_size_limit;
 extern int cache_config_force_sector_size;
 extern int cache_config_target_fragment_size;
 extern int cache_config_mutex_retry_delay;
+extern int cache_config_mutex_handoff;
 extern int cache_read_while_writer_retry_delay;
 extern int cache_config_read_while_writer_max_retries;
+extern int cache_config_read_while_writer_max_waiters;
+extern int cache_config_read_while_writer_timeout;
 
 #define PUSH_HANDLER(_x)                                          \
   do {                                                            \
@@ -366,12 +395,17 @@ Stripe::close_write(CacheVC *cont)
   return open_dir.close_write(cont);
 }
 
-// Returns 0 on success or a positive error code on failure
+// Returns 0 on success, -1 if the write was deferred by admission control or a positive error code on failure
 inline int
 Stripe::open_write(CacheVC *cont, int allow_if_writers, int max_writers)
 {
   Stripe *stripe    = this;
   bool    agg_error = false;
+  if (cont->op_type == static_cast<int>(CacheOpType::Write)) {
+    if (int err = cache_admission_check(this, cont); err) {
+      return err;
+    }
+  }
   if (!cont->f.remove) {
     agg_error = (!cont->f.update && this->get_agg_todo_size() > cache_config_agg_write_backlog);
 #ifdef CACHE_AGG_FAIL_RATE
@@ -576,7 +610,7 @@ struct Cache {
                         CacheFragType type, const char *hostname, int host_len);
   Action     *open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *old_info, time_t pin_in_cache = (time_t)0,
                          const CacheKey *key1 = nullptr, CacheFragType type = CACHE_FRAG_TYPE_HTTP, const char *hostname = nullptr,
-                         int host_len = 0);
+                         int host_len = 0, int options = 0);
   static void generate_key(CryptoHash *hash, CacheURL *url);
   static void generate_key(HttpCacheKey *hash, CacheURL *url, bool ignore_query = false, cache_generation_t generation = -1);
 
@@ -584,7 +618,12 @@ struct Cache {
 
   int open_done();
 
-  Stripe *key_to_stripe(const CacheKey *key, const char *hostname, int host_len);
+  /** Find the stripe for @a key.
+   *
+   * @param fast If not @c nullptr, set to the fast tier stripe for @a key or @c nullptr if there is no fast tier.
+   * @return The capacity tier stripe, to which all writes of @a key go.
+   */
+  Stripe *key_to_stripe(const CacheKey *key, const char *hostname, int host_len, Stripe **fast = nullptr);
 
   Cache() {}
 };
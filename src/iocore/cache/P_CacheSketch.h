@@ -0,0 +1,78 @@
+/** @file
+
+  Approximate access frequency of cache objects.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/CryptoHash.h"
+
+#include <cstdint>
+#include <vector>
+
+/** Approximate access frequency of the objects in a stripe.
+ *
+ * A count-min sketch of small saturating counters with conservative update, so the estimate of a
+ * key increases by exactly one for each access until it saturates. All counters are halved after
+ * a number of accesses proportional to the width, so the estimate reflects recent accesses.
+ */
+class CacheFrequencySketch
+{
+public:
+  static constexpr int      DEPTH         = 4;
+  static constexpr unsigned MAX_COUNT     = 15;
+  static constexpr unsigned DEFAULT_WIDTH = 1 << 16;
+
+  /// @a width is rounded up to a power of 2.
+  explicit CacheFrequencySketch(unsigned width = DEFAULT_WIDTH);
+
+  /// Count an access of @a key, @return The estimated access count including this access.
+  unsigned increment(const CryptoHash &key);
+
+  /// @return The estimated access count of @a key.
+  unsigned estimate(const CryptoHash &key) const;
+
+  /// Halve all counters.
+  void age();
+
+  /// @return The number of times the counters have been halved.
+  uint64_t
+  generation() const
+  {
+    return _generation;
+  }
+
+  /// @return The width of a row, a power of 2.
+  unsigned
+  width() const
+  {
+    return 1U << (32 - _shift);
+  }
+
+private:
+  unsigned _index(const CryptoHash &key, int row) const;
+
+  int                  _shift;
+  uint64_t             _additions  = 0;
+  uint64_t             _generation = 0;
+  uint64_t             _sample_size;
+  std::vector<uint8_t> _counters;
+};
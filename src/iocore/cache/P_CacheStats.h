@@ -52,19 +52,34 @@ struct CacheStatsBlock {
   Metrics::Counter::AtomicType *directory_collision   = nullptr;
   Metrics::Counter::AtomicType *read_busy_success     = nullptr;
   Metrics::Counter::AtomicType *read_busy_failure     = nullptr;
+  Metrics::Counter::AtomicType *rww_collapsed         = nullptr;
+  Metrics::Counter::AtomicType *rww_timeout           = nullptr;
+  Metrics::Counter::AtomicType *rww_overflow          = nullptr;
   Metrics::Counter::AtomicType *gc_bytes_evacuated    = nullptr;
   Metrics::Counter::AtomicType *gc_frags_evacuated    = nullptr;
   Metrics::Counter::AtomicType *write_bytes           = nullptr;
   Metrics::Counter::AtomicType *hdr_vector_marshal    = nullptr;
   Metrics::Counter::AtomicType *hdr_marshal           = nullptr;
   Metrics::Counter::AtomicType *hdr_marshal_bytes     = nullptr;
+  Metrics::Counter::AtomicType *hdr_unmarshal         = nullptr;
   Metrics::Counter::AtomicType *directory_wrap        = nullptr;
   Metrics::Counter::AtomicType *directory_sync_count  = nullptr;
   Metrics::Counter::AtomicType *directory_sync_time   = nullptr;
   Metrics::Counter::AtomicType *directory_sync_bytes  = nullptr;
+  Metrics::Counter::AtomicType *checksum_verified     = nullptr;
+  Metrics::Counter::AtomicType *checksum_failure      = nullptr;
+  Metrics::Gauge::AtomicType   *recovery_stripes      = nullptr;
+  Metrics::Counter::AtomicType *recovery_bytes_read   = nullptr;
+  Metrics::Gauge::AtomicType   *recovery_bytes_total  = nullptr;
+  Metrics::Gauge::AtomicType   *recovery_eta          = nullptr;
   Metrics::Counter::AtomicType *span_errors_read      = nullptr;
   Metrics::Counter::AtomicType *span_errors_write     = nullptr;
   Metrics::Gauge::AtomicType   *span_offline          = nullptr;
   Metrics::Gauge::AtomicType   *span_online           = nullptr;
   Metrics::Gauge::AtomicType   *span_failing          = nullptr;
+
+  Metrics::Counter::AtomicType *admission_admitted           = nullptr;
+  Metrics::Counter::AtomicType *admission_deferred           = nullptr;
+  Metrics::Counter::AtomicType *admission_rejected_frequency = nullptr;
+  Metrics::Counter::AtomicType *admission_rejected_budget    = nullptr;
 };
@@ -0,0 +1,91 @@
+/** @file
+
+  Cache storage tiers: a fast tier (for example NVMe) in front of the capacity volumes.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "iocore/cache/CacheDefs.h"
+#include "P_CacheSketch.h"
+#include "tsutil/Metrics.h"
+
+#include <cstdint>
+#include <string>
+
+class EThread;
+class Stripe;
+struct Dir;
+
+using ts::Metrics;
+
+/** Storage tier of a cache volume, set with @c tier= in volume.config.
+ *
+ * Objects are always written to the capacity tier. Objects which are read often are copied
+ * (promoted) to a fast tier volume, and reads probe the fast tier first. A fast tier copy which is
+ * about to be overwritten is copied back (demoted) to the capacity tier if the capacity tier no
+ * longer has the object.
+ */
+enum class CacheTier { Capacity = 0, Fast, Last };
+
+struct CacheTierStatsBlock {
+  struct {
+    Metrics::Counter::AtomicType *read_hits  = nullptr;
+    Metrics::Counter::AtomicType *read_bytes = nullptr;
+  } tier[static_cast<int>(CacheTier::Last)];
+
+  Metrics::Counter::AtomicType *promotions         = nullptr;
+  Metrics::Counter::AtomicType *promotion_failures = nullptr;
+  Metrics::Counter::AtomicType *demotions          = nullptr;
+  Metrics::Counter::AtomicType *demotion_failures  = nullptr;
+  Metrics::Counter::AtomicType *invalidations      = nullptr;
+};
+
+extern CacheTierStatsBlock cache_tier_rsb;
+
+extern int cache_config_tier_promote_hits;
+extern int cache_config_tier_promote_max_size;
+extern int cache_config_tier_demote;
+
+void register_cache_tier_stats(const std::string &prefix);
+
+/** Check for a copy of @a key in the fast stripe @a fast.
+ *
+ * @return @c true if the lock for @a fast was acquired by @a thread and @a fast has a directory
+ * entry for @a key.
+ */
+bool cache_tier_probe(Stripe *fast, const CacheKey *key, EThread *thread);
+
+/** Count a read of @a key from its capacity stripe @a home and start a promotion to @a fast if the
+ * key has been read often enough. The lock for @a home must be held.
+ */
+void cache_tier_note_hit(Stripe *home, Stripe *fast, const CacheKey *key, const Dir *dir);
+
+/// Remove the copy of @a key from @a fast, for a write or remove of @a key in the capacity tier.
+void cache_tier_invalidate(Stripe *fast, const CacheKey *key, EThread *thread);
+
+/// Start demotion of objects in @a fast which are about to be overwritten. The lock for @a fast must be held.
+void cache_tier_scan_for_demotion(Stripe *fast);
+
+/** Start demotion of the head at @a dir in @a fast. The lock for @a fast must be held.
+ *
+ * @return @c false if the demotion was not started because of the write backlog.
+ */
+bool cache_tier_demote(Stripe *fast, const Dir *dir);
@@ -23,9 +23,11 @@
 
 #pragma once
 
+#include "P_CacheAdmission.h"
 #include "P_CacheDir.h"
 #include "P_CacheDoc.h"
 #include "P_CacheStats.h"
+#include "P_CacheTier.h"
 #include "P_RamCache.h"
 #include "iocore/cache/AggregateWriteBuffer.h"
 
@@ -140,7 +142,6 @@ public:
   int                  segments            = 0;
   off_t                buckets             = 0;
   off_t                recover_pos         = 0;
-  off_t                prev_recover_pos    = 0;
   off_t                scan_pos            = 0;
   off_t                skip                = 0; // start of headers
   off_t                start               = 0; // start of data
@@ -177,6 +178,12 @@ public:
   int64_t           first_fragment_offset = 0;
   Ptr<IOBufferData> first_fragment_data;
 
+  // Read frequency of objects in a capacity stripe with a fast tier, created on first use.
+  CacheFrequencySketch *tier_sketch = nullptr;
+
+  // Write admission policy, created on first use.
+  CacheAdmission *admission = nullptr;
+
   void cancel_trigger();
 
   int recover_data();
@@ -346,6 +353,7 @@ struct CacheVol {
   off_t        size             = 0;
   int          num_vols         = 0;
   bool         ramcache_enabled = true;
+  CacheTier    tier             = CacheTier::Capacity;
   Stripe     **stripes          = nullptr;
   DiskStripe **disk_stripes     = nullptr;
   LINK(CacheVol, link);
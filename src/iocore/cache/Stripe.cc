@@ -36,6 +36,8 @@
 #include "tscore/ink_assert.h"
 #include "tscore/ink_memory.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 
 namespace
@@ -60,6 +62,39 @@ struct StripeInitInfo {
   AIOCallbackInternal vol_aio[4];
   char               *vol_h_f;
 
+  /** Reads of consecutive chunks of the directory or of the data, up to @c depth in flight.
+   *
+   * Directory chunks are read directly into the directory, in any order. Data chunks are read
+   * into a ring of buffers, which the recovery scan consumes in order.
+   */
+  struct Read {
+    AIOCallbackInternal io;
+    bool                done = false;
+  };
+  enum class Recover { CheckLastWrite, CheckWrapStart, Scan };
+  enum class Then { None, Restart, Done, Clear };
+
+  int   depth       = 1;
+  off_t chunk       = 0;
+  Read *reads       = nullptr;
+  char *dir_buf     = nullptr; ///< Directory being read, or @c nullptr for data reads.
+  off_t dir_pos     = 0;       ///< Disk offset of @a dir_buf.
+  char *data_buf    = nullptr; ///< Data chunk buffers.
+  int   first       = 0;       ///< Index of the oldest read.
+  int   queued      = 0;       ///< Number of reads from @a first, done or in flight.
+  int   in_flight   = 0;
+  bool  read_failed = false;
+  off_t fail_pos    = 0; ///< Disk offset of the earliest failed read, if @a read_failed.
+  off_t window_pos  = 0; ///< Disk offset of the oldest read.
+  off_t next_pos    = 0; ///< Disk offset of the next read.
+  off_t end_pos     = 0; ///< Disk offset to read up to.
+
+  Recover  recover_state   = Recover::Scan;
+  Then     then            = Then::None; ///< Deferred until the reads in flight are done.
+  uint32_t max_sync_serial = 0;
+  int64_t  bytes_expected  = 0; ///< Estimate of the bytes to read, for the recovery progress stats.
+  int64_t  bytes_issued    = 0;
+
   StripeInitInfo()
   {
     recover_pos = 0;
@@ -69,14 +104,174 @@ struct StripeInitInfo {
 
   ~StripeInitInfo()
   {
+    ink_assert(in_flight == 0);
     for (auto &i : vol_aio) {
       i.action = nullptr;
       i.mutex.clear();
     }
+    for (int i = 0; reads && i < depth; ++i) {
+      reads[i].io.action = nullptr;
+      reads[i].io.mutex.clear();
+    }
+    delete[] reads;
     free(vol_h_f);
+    free(data_buf);
+  }
+
+  void start_reads(Stripe *stripe, off_t pos, off_t end);
+  void fill(Stripe *stripe);
+  void read_done(Stripe *stripe, AIOCallback *op);
+  Doc *doc_at(Stripe *stripe, off_t pos);
+
+  /// Whether the read of disk offset @a pos failed.
+  bool
+  failed_at(off_t pos) const
+  {
+    return read_failed && pos >= fail_pos;
   }
 };
 
+namespace
+{
+// When the first stripe started initializing, for the recovery ETA.
+std::atomic<ink_hrtime> recovery_start{0};
+
+void
+recovery_progress(Stripe *stripe, int64_t expected, int64_t read)
+{
+  ink_hrtime elapsed = ink_get_hrtime() - recovery_start.load();
+
+  for (CacheStatsBlock *rsb : {&cache_rsb, stripe->cache_vol ? &stripe->cache_vol->vol_rsb : nullptr}) {
+    if (!rsb) {
+      continue;
+    }
+    Metrics::Gauge::increment(rsb->recovery_bytes_total, expected);
+    Metrics::Counter::increment(rsb->recovery_bytes_read, read);
+
+    int64_t total = Metrics::Gauge::load(rsb->recovery_bytes_total);
+    int64_t done  = Metrics::Counter::load(rsb->recovery_bytes_read);
+    if (done > 0 && total > done) {
+      Metrics::Gauge::store(rsb->recovery_eta, static_cast<int64_t>((total - done) * (static_cast<double>(elapsed) / done)) /
+                                                 HRTIME_SECOND);
+    } else {
+      Metrics::Gauge::store(rsb->recovery_eta, 0);
+    }
+  }
+}
+} // namespace
+
+/// Start reading from disk offset @a pos up to @a end. No reads may be in flight.
+void
+StripeInitInfo::start_reads(Stripe *stripe, off_t pos, off_t end)
+{
+  ink_assert(in_flight == 0);
+  if (!reads) {
+    reads = new Read[depth];
+  }
+  read_failed = false;
+  first       = 0;
+  queued     = 0;
+  window_pos = pos;
+  next_pos   = pos;
+  end_pos    = end;
+  fill(stripe);
+}
+
+/// Queue reads until @a depth are in the window or the end is reached.
+void
+StripeInitInfo::fill(Stripe *stripe)
+{
+  while (queued < depth && next_pos < end_pos && !read_failed) {
+    int   i = (first + queued) % depth;
+    Read &r = reads[i];
+
+    r.done                  = false;
+    r.io.aiocb.aio_fildes   = stripe->fd;
+    r.io.aiocb.aio_offset   = next_pos;
+    r.io.aiocb.aio_nbytes   = std::min(chunk, end_pos - next_pos);
+    r.io.aiocb.aio_buf      = dir_buf ? dir_buf + (next_pos - dir_pos) : data_buf + i * chunk;
+    r.io.action             = stripe;
+    r.io.thread             = AIO_CALLBACK_THREAD_ANY;
+    r.io.then               = nullptr;
+    next_pos               += r.io.aiocb.aio_nbytes;
+    ++queued;
+    ++in_flight;
+
+    bytes_issued += r.io.aiocb.aio_nbytes;
+    if (bytes_issued > bytes_expected) {
+      // Scanned past the estimate, keep the estimate just ahead of the scan.
+      recovery_progress(stripe, bytes_issued - bytes_expected, 0);
+      bytes_expected = bytes_issued;
+    }
+    ink_assert(ink_aio_read(&r.io));
+  }
+}
+
+void
+StripeInitInfo::read_done(Stripe *stripe, AIOCallback *op)
+{
+  Read *r = reads;
+  while (&r->io != op) {
+    ++r;
+  }
+  ink_assert(r < reads + depth && !r->done);
+  r->done = true;
+  --in_flight;
+  if (!op->ok()) {
+    if (!read_failed) {
+      stripe->disk->incrErrors(op);
+    }
+    if (!read_failed || op->aiocb.aio_offset < fail_pos) {
+      fail_pos = op->aiocb.aio_offset;
+    }
+    read_failed = true;
+  }
+  recovery_progress(stripe, 0, op->aiocb.aio_nbytes);
+
+  if (dir_buf) {
+    // The directory is complete when all reads are done, in any order.
+    while (queued && reads[first].done) {
+      first = (first + 1) % depth;
+      --queued;
+    }
+    fill(stripe);
+  }
+}
+
+/** Get the Doc at disk offset @a pos.
+ *
+ * Reads before @a pos are released and the window is refilled. Positions must not decrease.
+ * A failed read only affects the positions from it on, see failed_at().
+ *
+ * @return The Doc header, or @c nullptr if the read for @a pos is not done or failed.
+ */
+Doc *
+StripeInitInfo::doc_at(Stripe *stripe, off_t pos)
+{
+  ink_assert(pos >= window_pos && pos < end_pos);
+  while (queued) {
+    Read &r = reads[first];
+    if (pos < window_pos + static_cast<off_t>(r.io.aiocb.aio_nbytes)) {
+      break;
+    }
+    if (!r.done) {
+      return nullptr;
+    }
+    window_pos += r.io.aiocb.aio_nbytes;
+    first       = (first + 1) % depth;
+    --queued;
+  }
+  fill(stripe);
+
+  Read &r = reads[first];
+  if (!queued || !r.done || failed_at(pos)) {
+    return nullptr;
+  }
+  // Docs are aligned to sectors, so a header is never split between reads.
+  ink_assert(pos - window_pos + static_cast<off_t>(sizeof(Doc)) <= static_cast<off_t>(r.io.aiocb.aio_nbytes));
+  return reinterpret_cast<Doc *>(static_cast<char *>(r.io.aiocb.aio_buf) + (pos - window_pos));
+}
+
 ////
 // Stripe
 //
@@ -197,8 +392,7 @@ Stripe::init(char *s, off_t blocks, off_t dir_skip, bool clear)
   path     = ats_strdup(s);
   len      = blocks * STORE_BLOCK_SIZE;
   ink_assert(len <= MAX_STRIPE_SIZE);
-  skip             = dir_skip;
-  prev_recover_pos = 0;
+  skip = dir_skip;
 
   // successive approximation, directory/meta data eats up some storage
   start = dir_skip;
@@ -226,12 +420,20 @@ Stripe::init(char *s, off_t blocks, off_t dir_skip, bool clear)
   header = reinterpret_cast<StripteHeaderFooter *>(raw_dir);
   footer = reinterpret_cast<StripteHeaderFooter *>(raw_dir + this->dirlen() - ROUND_TO_STORE_BLOCK(sizeof(StripteHeaderFooter)));
 
+  ink_hrtime now = 0;
+  recovery_start.compare_exchange_strong(now, ink_get_hrtime());
+  Metrics::Gauge::increment(cache_rsb.recovery_stripes);
+  if (cache_vol) {
+    Metrics::Gauge::increment(cache_vol->vol_rsb.recovery_stripes);
+  }
+
   if (clear) {
     Note("clearing cache directory '%s'", hash_text.get());
     return clear_dir_aio();
   }
 
   init_info           = new StripeInitInfo();
+  init_info->depth    = cache_config_recovery_queue_depth;
   int   footerlen     = ROUND_TO_STORE_BLOCK(sizeof(StripteHeaderFooter));
   off_t footer_offset = this->dirlen() - footerlen;
   // try A
@@ -292,11 +494,15 @@ Stripe::handle_dir_clear(int event, void *data)
 int
 Stripe::handle_dir_read(int event, void *data)
 {
-  AIOCallback *op = static_cast<AIOCallback *>(data);
-
   if (event == AIO_EVENT_DONE) {
-    if (!op->ok()) {
+    init_info->read_done(this, static_cast<AIOCallback *>(data));
+    if (init_info->in_flight) {
+      return EVENT_CONT;
+    }
+    if (init_info->read_failed) {
       Note("Directory read failed: clearing cache directory %s", this->hash_text.get());
+      delete init_info;
+      init_info = nullptr;
       clear_dir_aio();
       return EVENT_DONE;
     }
@@ -310,12 +516,15 @@ Stripe::handle_dir_read(int event, void *data)
          STRIPE_MAGIC, header->magic, footer->magic, CACHE_DB_MAJOR_VERSION_COMPATIBLE, header->version._major,
          CACHE_DB_MAJOR_VERSION);
     Note("clearing cache directory '%s'", hash_text.get());
+    delete init_info;
+    init_info = nullptr;
     clear_dir_aio();
     return EVENT_DONE;
   }
   CHECK_DIR(this);
 
-  sector_size = header->sector_size;
+  sector_size        = header->sector_size;
+  init_info->dir_buf = nullptr;
 
   return this->recover_data();
 }
@@ -364,188 +573,207 @@ Stripe::recover_data()
       */
 
 int
-Stripe::handle_recover_from_data(int event, void * /* data ATS_UNUSED */)
+Stripe::handle_recover_from_data(int event, void *data)
 {
-  uint32_t got_len         = 0;
-  uint32_t max_sync_serial = header->sync_serial;
-  char    *s, *e = nullptr;
+  using Recover = StripeInitInfo::Recover;
+  using Then    = StripeInitInfo::Then;
+
+  StripeInitInfo *ii = init_info;
+  Doc            *doc;
+
   if (event == EVENT_IMMEDIATE) {
     if (header->sync_serial == 0) {
-      io.aiocb.aio_buf = nullptr;
       SET_HANDLER(&Stripe::handle_recover_write_dir);
       return handle_recover_write_dir(EVENT_IMMEDIATE, nullptr);
     }
     // initialize
-    recover_wrapped   = false;
-    last_sync_serial  = 0;
-    last_write_serial = 0;
-    recover_pos       = header->last_write_pos;
+    recover_wrapped     = false;
+    last_sync_serial    = 0;
+    last_write_serial   = 0;
+    recover_pos         = header->last_write_pos;
+    ii->recover_state   = Recover::CheckLastWrite;
+    ii->max_sync_serial = header->sync_serial;
     if (recover_pos >= skip + len) {
-      recover_wrapped = true;
-      recover_pos     = start;
+      recover_wrapped   = true;
+      recover_pos       = start;
+      ii->recover_state = Recover::CheckWrapStart;
     }
-    io.aiocb.aio_buf    = static_cast<char *>(ats_memalign(ats_pagesize(), RECOVERY_SIZE));
-    io.aiocb.aio_nbytes = RECOVERY_SIZE;
-    if (static_cast<off_t>(recover_pos + io.aiocb.aio_nbytes) > static_cast<off_t>(skip + len)) {
-      io.aiocb.aio_nbytes = (skip + len) - recover_pos;
+
+    // Keep the same amount of data buffered as a single RECOVERY_SIZE read, split into depth reads
+    // so the scan overlaps with the reads.
+    ii->chunk    = std::max<off_t>(ROUND_TO_STORE_BLOCK(RECOVERY_SIZE / ii->depth - (STORE_BLOCK_SIZE - 1)), STORE_BLOCK_SIZE);
+    ii->data_buf = static_cast<char *>(ats_memalign(ats_pagesize(), ii->depth * ii->chunk));
+    ii->bytes_expected = ii->bytes_issued = 0;
+    if (header->write_pos > recover_pos) {
+      ii->bytes_expected = header->write_pos - recover_pos;
+      recovery_progress(this, ii->bytes_expected, 0);
     }
-  } else if (event == AIO_EVENT_DONE) {
-    if (!io.ok()) {
-      Warning("disk read error on recover '%s', clearing", hash_text.get());
-      disk->incrErrors(&io);
-      goto Lclear;
+    ii->start_reads(this, recover_pos, skip + len);
+    return EVENT_CONT;
+  }
+
+  if (event == AIO_EVENT_DONE) {
+    // A failed read ahead of the scan only matters if the scan gets to it, see below.
+    ii->read_done(this, static_cast<AIOCallback *>(data));
+    if (ii->then != Then::None) {
+      if (ii->in_flight) {
+        return EVENT_CONT;
+      }
+      switch (ii->then) {
+      case Then::Restart:
+        ii->then = Then::None;
+        ii->start_reads(this, recover_pos, skip + len);
+        return EVENT_CONT;
+      case Then::Done:
+        goto Ldone;
+      default:
+        goto Lclear;
+      }
     }
-    if (io.aiocb.aio_offset == header->last_write_pos) {
+  }
+
+  // examine the Docs as their reads complete
+  for (;;) {
+    if (recover_pos >= skip + len) {
+      goto Lwrap;
+    }
+    if (!(doc = ii->doc_at(this, recover_pos))) {
+      if (!ii->failed_at(recover_pos)) {
+        return EVENT_CONT;
+      }
+      // The scan cannot go past a read error, so it stops at the last good position. The docs written
+      // since the last directory sync cannot be checked without it though.
+      if (ii->recover_state == Recover::CheckLastWrite) {
+        Warning("disk read error on recover '%s', clearing", hash_text.get());
+        ii->then = Then::Clear;
+      } else {
+        Warning("disk read error on recover '%s' at %" PRId64 ", stopping", hash_text.get(), static_cast<int64_t>(recover_pos));
+        if (ii->recover_state == Recover::CheckWrapStart) {
+          recover_pos = skip + len - EVACUATION_SIZE;
+        }
+        ii->then = Then::Done;
+      }
+      goto Lfinish;
+    }
+    if (doc->magic == DOC_MAGIC && !round_to_approx_size(doc->len)) {
+      // this should never happen, but if it does break the loop
+      ii->then = Then::Clear;
+      goto Lfinish;
+    }
+
+    if (ii->recover_state == Recover::CheckLastWrite) {
       /* check that we haven't wrapped around without syncing
          the directory. Start from last_write_serial (write pos the documents
          were written to just before syncing the directory) and make sure
          that all documents have write_serial <= header->write_serial.
        */
-      uint32_t to_check = header->write_pos - header->last_write_pos;
-      ink_assert(to_check && to_check < (uint32_t)io.aiocb.aio_nbytes);
-      uint32_t done = 0;
-      s             = static_cast<char *>(io.aiocb.aio_buf);
-      while (done < to_check) {
-        Doc *doc = reinterpret_cast<Doc *>(s + done);
+      if (recover_pos < header->write_pos) {
         if (doc->magic != DOC_MAGIC || doc->write_serial > header->write_serial) {
           Warning("no valid directory found while recovering '%s', clearing", hash_text.get());
-          goto Lclear;
+          ii->then = Then::Clear;
+          goto Lfinish;
         }
-        done += round_to_approx_size(doc->len);
         if (doc->sync_serial > last_write_serial) {
           last_sync_serial = doc->sync_serial;
         }
+        recover_pos += round_to_approx_size(doc->len);
+        continue;
       }
-      ink_assert(done == to_check);
-
-      got_len      = io.aiocb.aio_nbytes - done;
-      recover_pos += io.aiocb.aio_nbytes;
-      s            = static_cast<char *>(io.aiocb.aio_buf) + done;
-      e            = s + got_len;
-    } else {
-      got_len      = io.aiocb.aio_nbytes;
-      recover_pos += io.aiocb.aio_nbytes;
-      s            = static_cast<char *>(io.aiocb.aio_buf);
-      e            = s + got_len;
-    }
-  }
-  // examine what we got
-  if (got_len) {
-    Doc *doc = nullptr;
-
-    if (recover_wrapped && start == io.aiocb.aio_offset) {
-      doc = reinterpret_cast<Doc *>(s);
+      ink_assert(recover_pos == header->write_pos);
+      ii->recover_state = Recover::Scan;
+    } else if (ii->recover_state == Recover::CheckWrapStart) {
+      ii->recover_state = Recover::Scan;
       if (doc->magic != DOC_MAGIC || doc->write_serial < last_write_serial) {
         recover_pos = skip + len - EVACUATION_SIZE;
-        goto Ldone;
+        ii->then    = Then::Done;
+        goto Lfinish;
       }
     }
 
-    // If execution reaches here, then @c got_len > 0 and e == s + got_len therefore s < e
-    // clang analyzer can't figure this out, so be explicit.
-    ink_assert(s < e);
-    while (s < e) {
-      doc = reinterpret_cast<Doc *>(s);
-
-      if (doc->magic != DOC_MAGIC || doc->sync_serial != last_sync_serial) {
-        if (doc->magic == DOC_MAGIC) {
-          if (doc->sync_serial > header->sync_serial) {
-            max_sync_serial = doc->sync_serial;
-          }
+    if (doc->magic != DOC_MAGIC || doc->sync_serial != last_sync_serial) {
+      if (doc->magic == DOC_MAGIC) {
+        if (doc->sync_serial > header->sync_serial) {
+          ii->max_sync_serial = std::max(ii->max_sync_serial, doc->sync_serial);
+        }
 
-          /*
-             doc->magic == DOC_MAGIC, but doc->sync_serial != last_sync_serial
-             This might happen in the following situations
-             1. We are starting off recovery. In this case the
-             last_sync_serial == header->sync_serial, but the doc->sync_serial
-             can be anywhere in the range (0, header->sync_serial + 1]
-             If this is the case, update last_sync_serial and continue;
-
-             2. A dir sync started between writing documents to the
-             aggregation buffer and hence the doc->sync_serial went up.
-             If the doc->sync_serial is greater than the last
-             sync serial and less than (header->sync_serial + 2) then
-             continue;
-
-             3. If the position we are recovering from is within AGG_SIZE
-             from the disk end, then we can't trust this document. The
-             aggregation buffer might have been larger than the remaining space
-             at the end and we decided to wrap around instead of writing
-             anything at that point. In this case, wrap around and start
-             from the beginning.
-
-             If neither of these 3 cases happen, then we are indeed done.
-
-           */
-
-          // case 1
-          // case 2
-          if (doc->sync_serial > last_sync_serial && doc->sync_serial <= header->sync_serial + 1) {
-            last_sync_serial  = doc->sync_serial;
-            s                += round_to_approx_size(doc->len);
-            continue;
-          }
-          // case 3 - we have already recovered some data and
-          // (doc->sync_serial < last_sync_serial) ||
-          // (doc->sync_serial > header->sync_serial + 1).
-          // if we are too close to the end, wrap around
-          else if (recover_pos - (e - s) > (skip + len) - AGG_SIZE) {
-            recover_wrapped     = true;
-            recover_pos         = start;
-            io.aiocb.aio_nbytes = RECOVERY_SIZE;
-
-            break;
-          }
-          // we are done. This doc was written in the earlier phase
-          recover_pos -= e - s;
-          goto Ldone;
-        } else {
-          // doc->magic != DOC_MAGIC
-          // If we are in the danger zone - recover_pos is within AGG_SIZE
-          // from the end, then wrap around
-          recover_pos -= e - s;
-          if (recover_pos > (skip + len) - AGG_SIZE) {
-            recover_wrapped     = true;
-            recover_pos         = start;
-            io.aiocb.aio_nbytes = RECOVERY_SIZE;
-
-            break;
-          }
-          // we ar not in the danger zone
-          goto Ldone;
+        /*
+           doc->magic == DOC_MAGIC, but doc->sync_serial != last_sync_serial
+           This might happen in the following situations
+           1. We are starting off recovery. In this case the
+           last_sync_serial == header->sync_serial, but the doc->sync_serial
+           can be anywhere in the range (0, header->sync_serial + 1]
+           If this is the case, update last_sync_serial and continue;
+
+           2. A dir sync started between writing documents to the
+           aggregation buffer and hence the doc->sync_serial went up.
+           If the doc->sync_serial is greater than the last
+           sync serial and less than (header->sync_serial + 2) then
+           continue;
+
+           3. If the position we are recovering from is within AGG_SIZE
+           from the disk end, then we can't trust this document. The
+           aggregation buffer might have been larger than the remaining space
+           at the end and we decided to wrap around instead of writing
+           anything at that point. In this case, wrap around and start
+           from the beginning.
+
+           If neither of these 3 cases happen, then we are indeed done.
+
+         */
+
+        // case 1
+        // case 2
+        if (doc->sync_serial > last_sync_serial && doc->sync_serial <= header->sync_serial + 1) {
+          last_sync_serial  = doc->sync_serial;
+          recover_pos      += round_to_approx_size(doc->len);
+          continue;
+        }
+        // case 3 - we have already recovered some data and
+        // (doc->sync_serial < last_sync_serial) ||
+        // (doc->sync_serial > header->sync_serial + 1).
+        // if we are too close to the end, wrap around
+        else if (recover_pos > (skip + len) - AGG_SIZE) {
+          goto Lwrap;
+        }
+        // we are done. This doc was written in the earlier phase
+        ii->then = Then::Done;
+        goto Lfinish;
+      } else {
+        // doc->magic != DOC_MAGIC
+        // If we are in the danger zone - recover_pos is within AGG_SIZE
+        // from the end, then wrap around
+        if (recover_pos > (skip + len) - AGG_SIZE) {
+          goto Lwrap;
         }
+        // we ar not in the danger zone
+        ii->then = Then::Done;
+        goto Lfinish;
       }
-      // doc->magic == DOC_MAGIC && doc->sync_serial == last_sync_serial
-      last_write_serial  = doc->write_serial;
-      s                 += round_to_approx_size(doc->len);
     }
+    // doc->magic == DOC_MAGIC && doc->sync_serial == last_sync_serial
+    last_write_serial  = doc->write_serial;
+    recover_pos       += round_to_approx_size(doc->len);
+  }
 
-    /* if (s > e) then we gone through RECOVERY_SIZE; we need to
-       read more data off disk and continue recovering */
-    if (s >= e) {
-      /* In the last iteration, we increment s by doc->len...need to undo
-         that change */
-      if (s > e) {
-        s -= round_to_approx_size(doc->len);
-      }
-      recover_pos -= e - s;
-      if (recover_pos >= skip + len) {
-        recover_wrapped = true;
-        recover_pos     = start;
-      }
-      io.aiocb.aio_nbytes = RECOVERY_SIZE;
-      if (static_cast<off_t>(recover_pos + io.aiocb.aio_nbytes) > static_cast<off_t>(skip + len)) {
-        io.aiocb.aio_nbytes = (skip + len) - recover_pos;
-      }
-    }
+Lwrap:
+  // Reads ahead of the scan are no longer needed, start again from the beginning once they are done.
+  recover_wrapped   = true;
+  recover_pos       = start;
+  ii->recover_state = Recover::CheckWrapStart;
+  ii->then          = Then::Restart;
+  if (!ii->in_flight) {
+    ii->then = Then::None;
+    ii->start_reads(this, recover_pos, skip + len);
   }
-  if (recover_pos == prev_recover_pos) { // this should never happen, but if it does break the loop
+  return EVENT_CONT;
+
+Lfinish:
+  if (ii->in_flight) {
+    return EVENT_CONT;
+  }
+  if (ii->then == Then::Clear) {
     goto Lclear;
   }
-  prev_recover_pos    = recover_pos;
-  io.aiocb.aio_offset = recover_pos;
-  ink_assert(ink_aio_read(&io));
-  return EVENT_CONT;
 
 Ldone: {
   /* if we come back to the starting position, then we don't have to recover anything */
@@ -569,7 +797,7 @@ Ldone: {
     recover_pos -= skip + len;
   }
   // bump sync number so it is different from that in the Doc structs
-  uint32_t next_sync_serial = max_sync_serial + 1;
+  uint32_t next_sync_serial = ii->max_sync_serial + 1;
   // make that the next sync does not overwrite our good copy!
   if (!(header->sync_serial & 1) == !(next_sync_serial & 1)) {
     next_sync_serial++;
@@ -617,7 +845,6 @@ Ldone: {
 }
 
 Lclear:
-  free(static_cast<char *>(io.aiocb.aio_buf));
   delete init_info;
   init_info = nullptr;
   clear_dir_aio();
@@ -627,9 +854,6 @@ Lclear:
 int
 Stripe::handle_recover_write_dir(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */)
 {
-  if (io.aiocb.aio_buf) {
-    free(static_cast<char *>(io.aiocb.aio_buf));
-  }
   delete init_info;
   init_info = nullptr;
   set_io_not_in_progress();
@@ -658,12 +882,11 @@ Stripe::handle_header_read(int event, void *data)
       op = op->then;
     }
 
-    io.aiocb.aio_fildes = fd;
-    io.aiocb.aio_nbytes = this->dirlen();
-    io.aiocb.aio_buf    = raw_dir;
-    io.action           = this;
-    io.thread           = AIO_CALLBACK_THREAD_ANY;
-    io.then             = nullptr;
+    // The directory is read in chunks, so a large directory keeps several reads in flight.
+    init_info->dir_buf        = raw_dir;
+    init_info->chunk          = RECOVERY_SIZE;
+    init_info->bytes_expected = this->dirlen();
+    recovery_progress(this, init_info->bytes_expected, 0);
 
     if (hf[0]->sync_serial == hf[1]->sync_serial &&
         (hf[0]->sync_serial >= hf[2]->sync_serial || hf[2]->sync_serial != hf[3]->sync_serial)) {
@@ -671,8 +894,8 @@ Stripe::handle_header_read(int event, void *data)
       if (dbg_ctl_cache_init.on()) {
         Note("using directory A for '%s'", hash_text.get());
       }
-      io.aiocb.aio_offset = skip;
-      ink_assert(ink_aio_read(&io));
+      init_info->dir_pos = skip;
+      init_info->start_reads(this, skip, skip + this->dirlen());
     }
     // try B
     else if (hf[2]->sync_serial == hf[3]->sync_serial) {
@@ -680,8 +903,8 @@ Stripe::handle_header_read(int event, void *data)
       if (dbg_ctl_cache_init.on()) {
         Note("using directory B for '%s'", hash_text.get());
       }
-      io.aiocb.aio_offset = skip + this->dirlen();
-      ink_assert(ink_aio_read(&io));
+      init_info->dir_pos = skip + this->dirlen();
+      init_info->start_reads(this, init_info->dir_pos, init_info->dir_pos + this->dirlen());
     } else {
       Note("no good directory, clearing '%s' since sync_serials on both A and B copies are invalid", hash_text.get());
       Note("Header A: %d\nFooter A: %d\n Header B: %d\n Footer B %d\n", hf[0]->sync_serial, hf[1]->sync_serial, hf[2]->sync_serial,
@@ -708,6 +931,13 @@ Stripe::dir_init_done(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */)
     ink_assert(!gstripes[i]);
     gstripes[i] = this;
     SET_HANDLER(&Stripe::aggWrite);
+    Metrics::Gauge::decrement(cache_rsb.recovery_stripes);
+    if (cache_vol) {
+      Metrics::Gauge::decrement(cache_vol->vol_rsb.recovery_stripes);
+    }
+    if (!Metrics::Gauge::load(cache_rsb.recovery_stripes)) {
+      Metrics::Gauge::store(cache_rsb.recovery_eta, 0);
+    }
     cache->vol_initialized(fd != -1);
     return EVENT_DONE;
   }
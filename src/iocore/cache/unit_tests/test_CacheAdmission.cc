@@ -0,0 +1,163 @@
+/** @file
+
+  Unit tests for cache write admission.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#include "../P_CacheAdmission.h"
+
+#include <memory>
+
+// Required by main.h
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+namespace
+{
+CryptoHash
+make_key(unsigned n)
+{
+  CryptoHash key;
+  key.u64[0] = n * 0x9E3779B97F4A7C15ULL;
+  key.u64[1] = ~key.u64[0] ^ (static_cast<uint64_t>(n) << 17);
+  return key;
+}
+
+struct AdmissionConfig {
+  AdmissionConfig(int min_hits, int write_rate, int defer_backlog, int defer_max)
+  {
+    cache_config_admission_min_hits      = min_hits;
+    cache_config_admission_write_rate    = write_rate;
+    cache_config_admission_defer_backlog = defer_backlog;
+    cache_config_admission_defer_max     = defer_max;
+  }
+  ~AdmissionConfig()
+  {
+    cache_config_admission_min_hits      = 0;
+    cache_config_admission_write_rate    = 0;
+    cache_config_admission_defer_backlog = 0;
+    cache_config_admission_defer_max     = 1000;
+  }
+};
+} // namespace
+
+TEST_CASE("CacheDoorkeeper", "[cache][admission]")
+{
+  CacheDoorkeeper doorkeeper(1 << 12);
+
+  for (unsigned n = 0; n < 100; ++n) {
+    CHECK(!doorkeeper.put(make_key(n)));
+  }
+  for (unsigned n = 0; n < 100; ++n) {
+    CHECK(doorkeeper.contains(make_key(n)));
+    CHECK(doorkeeper.put(make_key(n)));
+  }
+  doorkeeper.clear();
+  CHECK(!doorkeeper.contains(make_key(1)));
+}
+
+TEST_CASE("CacheWriteBudget", "[cache][admission]")
+{
+  CacheWriteBudget budget;
+  ink_hrtime       now = HRTIME_SECONDS(100);
+
+  // No rate, no limit.
+  REQUIRE(budget.available(now));
+  budget.charge(1 << 30, now);
+  REQUIRE(budget.available(now));
+
+  budget.set_rate(1000, now);
+  REQUIRE(budget.tokens() == 1000);
+  budget.charge(1500, now);
+  REQUIRE(!budget.available(now));
+  REQUIRE(!budget.available(now + HRTIME_MSECONDS(400)));
+  REQUIRE(budget.available(now + HRTIME_MSECONDS(600)));
+
+  // Refill is capped at one second of writes.
+  now += HRTIME_SECONDS(10);
+  REQUIRE(budget.available(now));
+  REQUIRE(budget.tokens() == 1000);
+
+  // Slow refill is not lost to rounding.
+  budget.charge(1000, now);
+  for (int i = 1; i <= 100; ++i) {
+    budget.available(now + HRTIME_USECONDS(500) * i);
+  }
+  REQUIRE(budget.tokens() == 50);
+}
+
+TEST_CASE("CacheAdmission frequency", "[cache][admission]")
+{
+  AdmissionConfig                 config(3, 0, 0, 0);
+  std::unique_ptr<CacheAdmission> admission(new_CacheAdmission());
+  ink_hrtime                      now = HRTIME_SECONDS(100);
+
+  CryptoHash key = make_key(1);
+  CHECK(admission->admit(key, 0, 0, now) == CacheAdmission::Result::RejectFrequency);
+  CHECK(admission->admit(key, 0, 0, now) == CacheAdmission::Result::RejectFrequency);
+  CHECK(admission->admit(key, 0, 0, now) == CacheAdmission::Result::Admit);
+  CHECK(admission->admit(key, 0, 0, now) == CacheAdmission::Result::Admit);
+  CHECK(admission->admit(make_key(2), 0, 0, now) == CacheAdmission::Result::RejectFrequency);
+}
+
+TEST_CASE("CacheAdmission retries", "[cache][admission]")
+{
+  AdmissionConfig                 config(2, 0, 0, 0);
+  std::unique_ptr<CacheAdmission> admission(new_CacheAdmission());
+  ink_hrtime                      now = HRTIME_SECONDS(100);
+
+  // Retries of a write are not more requests for the object.
+  CryptoHash key = make_key(1);
+  CHECK(admission->admit(key, 0, 0, now) == CacheAdmission::Result::RejectFrequency);
+  CHECK(admission->admit(key, 0, 0, now, true) == CacheAdmission::Result::RejectFrequency);
+  CHECK(admission->admit(key, 0, 0, now, true) == CacheAdmission::Result::RejectFrequency);
+  CHECK(admission->admit(key, 0, 0, now) == CacheAdmission::Result::Admit);
+  CHECK(admission->admit(key, 0, 0, now, true) == CacheAdmission::Result::Admit);
+  CHECK(admission->admit(make_key(2), 0, 0, now, true) == CacheAdmission::Result::RejectFrequency);
+}
+
+TEST_CASE("CacheAdmission budget", "[cache][admission]")
+{
+  AdmissionConfig                 config(0, 1 << 20, 0, 0);
+  std::unique_ptr<CacheAdmission> admission(new_CacheAdmission());
+  ink_hrtime                      now = HRTIME_SECONDS(100);
+
+  CHECK(admission->admit(make_key(1), 0, 0, now) == CacheAdmission::Result::Admit);
+  admission->wrote(4 << 20, now);
+  CHECK(admission->admit(make_key(2), 0, 0, now + HRTIME_SECONDS(1)) == CacheAdmission::Result::RejectBudget);
+  CHECK(admission->admit(make_key(3), 0, 0, now + HRTIME_SECONDS(4)) == CacheAdmission::Result::Admit);
+}
+
+TEST_CASE("CacheAdmission deferral", "[cache][admission]")
+{
+  AdmissionConfig                 config(2, 0, 1 << 20, 100);
+  std::unique_ptr<CacheAdmission> admission(new_CacheAdmission());
+  ink_hrtime                      now = HRTIME_SECONDS(100);
+
+  CryptoHash key = make_key(1);
+  CHECK(admission->admit(key, 0, 0, now) == CacheAdmission::Result::RejectFrequency);
+  // Deferred retries do not count as requests.
+  CHECK(admission->admit(key, 2 << 20, 0, now) == CacheAdmission::Result::Defer);
+  CHECK(admission->admit(key, 2 << 20, HRTIME_MSECONDS(50), now) == CacheAdmission::Result::Defer);
+  CHECK(admission->admit(make_key(2), 2 << 20, HRTIME_MSECONDS(100), now) == CacheAdmission::Result::RejectFrequency);
+  CHECK(admission->admit(key, 0, 0, now) == CacheAdmission::Result::Admit);
+}
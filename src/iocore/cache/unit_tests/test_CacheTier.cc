@@ -0,0 +1,329 @@
+/** @file
+
+  Unit tests for cache storage tiers.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "main.h"
+
+#include "../P_CacheHosting.h"
+#include "../P_CacheTier.h"
+
+#include <fstream>
+#include <functional>
+#include <string>
+
+// Required by main.h
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+namespace
+{
+CryptoHash
+make_key(unsigned n)
+{
+  CryptoHash key;
+  key.u64[0] = n * 0x9E3779B97F4A7C15ULL;
+  key.u64[1] = ~key.u64[0] ^ (static_cast<uint64_t>(n) << 17);
+  return key;
+}
+
+// Three promoted copies fill more than AGG_HIGH_WATER, so the fast stripe writes them to disk.
+constexpr size_t OBJECT_SIZE = 700 * 1024;
+constexpr size_t FLUSH_SIZE  = 10 * 1024 * 1024;
+
+const char *const URLS[] = {"http://tier1.example.com/", "http://tier2.example.com/", "http://tier3.example.com/"};
+
+CacheKey
+url_key(const char *url)
+{
+  HTTPInfo info;
+  info.create();
+  build_hdrs(info, url);
+  CacheKey key = generate_key(info).hash;
+  info.destroy();
+  return key;
+}
+
+// Delete all directory entries for @a key from @a stripe, the lock for which must be held.
+void
+delete_key(Stripe *stripe, const CacheKey *key)
+{
+  Dir dir, *last_collision = nullptr;
+  while (dir_probe(key, stripe, &dir, &last_collision) && dir_delete(key, stripe, &dir)) {
+    last_collision = nullptr;
+  }
+}
+
+// Only an object which is complete when its writer is closed is written as a single fragment, so
+// provide all of the data before the cache starts writing.
+class SingleFragmentWriteTest : public CacheWriteTest
+{
+public:
+  using CacheWriteTest::CacheWriteTest;
+
+  void
+  do_io_write(size_t /* size ATS_UNUSED */) override
+  {
+    CacheWriteTest::do_io_write(OBJECT_SIZE);
+    for (size_t n = 0; n < OBJECT_SIZE; n += WRITE_LIMIT) {
+      this->fill_data();
+    }
+  }
+};
+
+// Write an object as a single fragment and read it.
+class SingleFragmentHandler : public CacheTestHandler
+{
+public:
+  explicit SingleFragmentHandler(const char *url)
+  {
+    this->_wt        = new SingleFragmentWriteTest(OBJECT_SIZE, this, url);
+    this->_rt        = new CacheReadTest(OBJECT_SIZE, this, url);
+    this->_wt->mutex = this->mutex;
+    this->_rt->mutex = this->mutex;
+    SET_HANDLER(&SingleFragmentHandler::start_test);
+  }
+};
+
+// Read an object written by an earlier step.
+class CacheReadHandler : public CacheTestHandler
+{
+public:
+  CacheReadHandler(size_t size, const char *url)
+  {
+    this->_rt        = new CacheReadTest(size, this, url);
+    this->_rt->mutex = this->mutex;
+    SET_HANDLER(&CacheReadHandler::start_test);
+  }
+
+  int
+  start_test(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    this_ethread()->schedule_imm(this->_rt);
+    return 0;
+  }
+};
+
+// Run @a step with the lock for @a stripe, if any, every few milliseconds until it returns true.
+class TierStep : public TestContChain
+{
+public:
+  TierStep(Stripe *stripe, std::function<bool()> step) : _stripe(stripe), _step(std::move(step))
+  {
+    SET_HANDLER(&TierStep::run);
+  }
+
+  int
+  run(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    bool done = false;
+    if (_stripe == nullptr) {
+      done = _step();
+    } else {
+      MUTEX_TRY_LOCK(lock, _stripe->mutex, this_ethread());
+      done = lock.is_locked() && _step();
+    }
+    if (done) {
+      delete this;
+    } else if (++_attempts > 1000) {
+      CHECK(!"timed out");
+      delete this;
+    } else {
+      this_ethread()->schedule_in(this, HRTIME_MSECONDS(10));
+    }
+    return 0;
+  }
+
+private:
+  Stripe               *_stripe;
+  std::function<bool()> _step;
+  int                   _attempts = 0;
+};
+
+Stripe *home[3];
+Stripe *fast[3];
+
+class CacheTierInit : public CacheInit
+{
+public:
+  int
+  cache_init_success_callback(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */) override
+  {
+    for (int i = 0; i < 3; ++i) {
+      CacheKey key = url_key(URLS[i]);
+      home[i]      = caches[CACHE_FRAG_TYPE_HTTP]->key_to_stripe(&key, nullptr, 0, &fast[i]);
+      REQUIRE(fast[i] != nullptr);
+      REQUIRE(home[i]->cache_vol->tier == CacheTier::Capacity);
+      REQUIRE(fast[i]->cache_vol->tier == CacheTier::Fast);
+    }
+
+    // Write the objects and read each once, then push them out of the aggregation buffer.
+    TestContChain *h = new SingleFragmentHandler(URLS[0]);
+    h->add(new SingleFragmentHandler(URLS[1]));
+    h->add(new SingleFragmentHandler(URLS[2]));
+    h->add(new CacheTestHandler(FLUSH_SIZE, "http://flush.example.com/"));
+
+    // The second read of each object promotes it.
+    for (auto url : URLS) {
+      h->add(new CacheReadHandler(OBJECT_SIZE, url));
+    }
+    h->add(new TierStep(nullptr, [] { return Metrics::Counter::load(cache_tier_rsb.promotions) == 3; }));
+    h->add(new TierStep(fast[0], [] {
+      CHECK(Metrics::Counter::load(cache_tier_rsb.promotion_failures) == 0);
+      for (auto url : URLS) {
+        CacheKey key = url_key(url);
+        Dir      dir, *last_collision = nullptr;
+        REQUIRE(dir_probe(&key, fast[0], &dir, &last_collision));
+        if (dir_agg_buf_valid(fast[0], &dir)) {
+          return false;
+        }
+      }
+      return true;
+    }));
+
+    // Read the promoted copy.
+    h->add(new CacheReadHandler(OBJECT_SIZE, URLS[0]));
+    h->add(new TierStep(nullptr, [] {
+      CHECK(Metrics::Counter::load(cache_tier_rsb.tier[static_cast<int>(CacheTier::Fast)].read_hits) == 1);
+      return true;
+    }));
+
+    // Demote the copy after the capacity tier lost the object.
+    h->add(new TierStep(home[0], [] {
+      CacheKey key = url_key(URLS[0]);
+      delete_key(home[0], &key);
+      return true;
+    }));
+    h->add(new TierStep(fast[0], [] {
+      CacheKey key = url_key(URLS[0]);
+      Dir      dir, *last_collision = nullptr;
+      REQUIRE(dir_probe(&key, fast[0], &dir, &last_collision));
+      REQUIRE(cache_tier_demote(fast[0], &dir));
+      return true;
+    }));
+    h->add(new TierStep(nullptr, [] { return Metrics::Counter::load(cache_tier_rsb.demotions) == 1; }));
+    h->add(new TierStep(fast[0], [] {
+      CHECK(Metrics::Counter::load(cache_tier_rsb.demotion_failures) == 0);
+      CacheKey key = url_key(URLS[0]);
+      delete_key(fast[0], &key);
+      return true;
+    }));
+
+    // Read the demoted copy.
+    h->add(new CacheReadHandler(OBJECT_SIZE, URLS[0]));
+    h->add(new TerminalTest);
+
+    this_ethread()->schedule_imm(h);
+    delete this;
+    return 0;
+  }
+};
+} // namespace
+
+TEST_CASE("CacheFrequencySketch counts", "[cache][tier]")
+{
+  CacheFrequencySketch sketch(1024);
+  CryptoHash      key = make_key(1);
+
+  REQUIRE(sketch.estimate(key) == 0);
+  for (unsigned i = 1; i <= CacheFrequencySketch::MAX_COUNT; ++i) {
+    REQUIRE(sketch.increment(key) == i);
+  }
+  // Saturated.
+  REQUIRE(sketch.increment(key) == CacheFrequencySketch::MAX_COUNT);
+  REQUIRE(sketch.estimate(key) == CacheFrequencySketch::MAX_COUNT);
+  REQUIRE(sketch.estimate(make_key(2)) <= 1);
+
+  sketch.age();
+  REQUIRE(sketch.estimate(key) == CacheFrequencySketch::MAX_COUNT / 2);
+}
+
+TEST_CASE("CacheFrequencySketch never underestimates", "[cache][tier]")
+{
+  // A narrow sketch, so there are many collisions.
+  CacheFrequencySketch sketch(64);
+
+  for (unsigned n = 0; n < 200; ++n) {
+    for (unsigned i = 0; i <= n % 5; ++i) {
+      sketch.increment(make_key(n));
+    }
+  }
+  for (unsigned n = 0; n < 200; ++n) {
+    CHECK(sketch.estimate(make_key(n)) >= n % 5 + 1);
+  }
+}
+
+TEST_CASE("CacheFrequencySketch ages", "[cache][tier]")
+{
+  CacheFrequencySketch sketch(16);
+  CryptoHash      key = make_key(7);
+
+  sketch.increment(key);
+  sketch.increment(key);
+  // Other accesses up to the sample size halve the counters.
+  for (unsigned n = 100; n < 100 + 10 * 16; ++n) {
+    sketch.increment(make_key(n));
+  }
+  REQUIRE(sketch.estimate(key) < CacheFrequencySketch::MAX_COUNT);
+}
+
+TEST_CASE("volume.config tier", "[cache][tier]")
+{
+  ConfigVolumes config;
+  config.num_volumes      = 0;
+  config.num_http_volumes = 0;
+
+  std::string text = "volume=1 scheme=http size=50%\n"
+                     "volume=2 scheme=http size=10% tier=fast\n"
+                     "volume=3 scheme=http size=10% tier=capacity\n"
+                     "volume=4 scheme=http size=10% tier=slow\n";
+  char        path[] = "volume.config";
+  config.BuildListFromString(path, text.data());
+
+  REQUIRE(config.num_volumes == 3);
+  ConfigVol *vol = config.cp_queue.head;
+  REQUIRE(vol->number == 1);
+  CHECK(vol->tier == CacheTier::Capacity);
+  vol = vol->link.next;
+  REQUIRE(vol->number == 2);
+  CHECK(vol->tier == CacheTier::Fast);
+  vol = vol->link.next;
+  REQUIRE(vol->number == 3);
+  CHECK(vol->tier == CacheTier::Capacity);
+
+  config.clear_all();
+}
+
+TEST_CASE("cache tier promotion and demotion", "[cache][tier]")
+{
+  // A capacity volume and a fast volume on one span.
+  std::string etc = std::string(Layout::get()->prefix) + "/etc";
+  REQUIRE(mkdir(etc.c_str(), 0755) == 0);
+  std::ofstream(etc + "/storage.config") << "var/trafficserver 512M\n";
+  std::ofstream(etc + "/volume.config") << "volume=1 scheme=http size=256\n"
+                                           "volume=2 scheme=http size=128 tier=fast\n";
+  Layout::get()->sysconfdir = etc;
+
+  init_cache(512 * 1024 * 1024);
+  this_ethread()->schedule_imm(new CacheTierInit);
+  this_thread()->execute();
+}
+
@@ -28,6 +28,9 @@
 
 #include "main.h"
 
+#include <atomic>
+#include <thread>
+
 int  cache_vols           = 1;
 bool reuse_existing_cache = false;
 
@@ -392,6 +395,115 @@ private:
   bool _is_read_start = false;
 };
 
+// Start the reader before the writer has written anything, so that it waits for the writer.
+class CacheRWWWaitTest : public CacheRWWTest
+{
+public:
+  CacheRWWWaitTest(size_t size, const char *url = DEFAULT_URL)
+    : CacheRWWTest(size, url), _collapsed(Metrics::Counter::load(cache_rsb.rww_collapsed))
+  {
+  }
+
+  void
+  process_write_event(int event, CacheTestBase *base) override
+  {
+    if (event == VC_EVENT_WRITE_READY && !this->_wt->vc->fragment && !this->_read_event && !this->_is_read_start) {
+      this->_read_event = this_ethread()->schedule_imm(this->_rt);
+    }
+    CacheRWWTest::process_write_event(event, base);
+  }
+
+  void
+  process_read_event(int event, CacheTestBase *base) override
+  {
+    if (event == CACHE_EVENT_OPEN_READ) {
+      // Woken by the writer rather than a retry timer.
+      REQUIRE(this->_wt->vc->fragment > 0);
+      REQUIRE(Metrics::Counter::load(cache_rsb.rww_collapsed) > this->_collapsed);
+    }
+    CacheRWWTest::process_read_event(event, base);
+  }
+
+private:
+  int64_t _collapsed = 0;
+};
+
+// Hold a mutex on an event thread until released.
+struct MutexHolder : public Continuation {
+  std::atomic<bool> held{false};
+  std::atomic<bool> released{false};
+
+  explicit MutexHolder(Ptr<ProxyMutex> &m) : Continuation(m) { SET_HANDLER(&MutexHolder::hold); }
+
+  int
+  hold(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    held = true;
+    while (!released) {
+      std::this_thread::yield();
+    }
+    delete this;
+    return 0;
+  }
+};
+
+// Hold the mutex of the waiting reader while the writer wakes it, so that it must be retried.
+class CacheRWWBusyReaderTest : public CacheRWWWaitTest
+{
+public:
+  CacheRWWBusyReaderTest(size_t size, const char *url = DEFAULT_URL)
+    : CacheRWWWaitTest(size, url), _timeout(Metrics::Counter::load(cache_rsb.rww_timeout))
+  {
+    this->_rt->mutex = new_ProxyMutex();
+  }
+
+  void
+  process_write_event(int event, CacheTestBase *base) override
+  {
+    if (event == VC_EVENT_WRITE_READY) {
+      OpenDirEntry *od = this->_wt->vc->od;
+      if (!this->_holder && !this->_wt->vc->fragment && od && od->num_readers) {
+        this->_holder = new MutexHolder(this->_rt->mutex);
+        eventProcessor.schedule_imm(this->_holder, ET_CALL);
+        while (!this->_holder->held) {
+          std::this_thread::yield();
+        }
+      } else if (this->_holder && this->_wt->vc->fragment) {
+        // The writer signalled while the reader's mutex was held.
+        REQUIRE(!this->_is_read_start);
+        REQUIRE(od->num_readers == 0);
+        this->_holder->released = true;
+        this->_holder           = nullptr;
+        this->_signalled        = true;
+      }
+    }
+    CacheRWWWaitTest::process_write_event(event, base);
+  }
+
+  void
+  handle_cache_event(int event, CacheTestBase *base) override
+  {
+    // The reader has its own mutex, take the one the writer uses before driving it.
+    SCOPED_MUTEX_LOCK(lock, this->mutex, this_ethread());
+    CacheRWWWaitTest::handle_cache_event(event, base);
+  }
+
+  void
+  process_read_event(int event, CacheTestBase *base) override
+  {
+    if (event == CACHE_EVENT_OPEN_READ) {
+      REQUIRE(this->_signalled);
+      REQUIRE(Metrics::Counter::load(cache_rsb.rww_timeout) == this->_timeout);
+    }
+    CacheRWWWaitTest::process_read_event(event, base);
+  }
+
+private:
+  MutexHolder *_holder    = nullptr;
+  bool         _signalled = false;
+  int64_t      _timeout   = 0;
+};
+
 class CacheRWWCacheInit : public CacheInit
 {
 public:
@@ -399,13 +511,17 @@ public:
   int
   cache_init_success_callback(int event, void *e) override
   {
-    CacheRWWTest      *crww     = new CacheRWWTest(LARGE_FILE);
-    CacheRWWErrorTest *crww_l   = new CacheRWWErrorTest(LARGE_FILE, "http://www.scw22.com/");
-    CacheRWWEOSTest   *crww_eos = new CacheRWWEOSTest(LARGE_FILE, "ttp://www.scw44.com/");
-    TerminalTest      *tt       = new TerminalTest();
+    CacheRWWTest           *crww     = new CacheRWWTest(LARGE_FILE);
+    CacheRWWErrorTest      *crww_l   = new CacheRWWErrorTest(LARGE_FILE, "http://www.scw22.com/");
+    CacheRWWEOSTest        *crww_eos = new CacheRWWEOSTest(LARGE_FILE, "ttp://www.scw44.com/");
+    CacheRWWWaitTest       *crww_w   = new CacheRWWWaitTest(LARGE_FILE, "http://www.scw66.com/");
+    CacheRWWBusyReaderTest *crww_b   = new CacheRWWBusyReaderTest(LARGE_FILE, "http://www.scw88.com/");
+    TerminalTest           *tt       = new TerminalTest();
 
     crww->add(crww_l);
     crww->add(crww_eos);
+    crww->add(crww_w);
+    crww->add(crww_b);
     crww->add(tt);
     this_ethread()->schedule_imm(crww);
     delete this;
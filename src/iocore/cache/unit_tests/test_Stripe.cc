@@ -26,8 +26,14 @@
 #include "tscore/EventNotify.h"
 
 #include <array>
+#include <chrono>
+#include <climits>
 #include <cstdio>
+#include <functional>
 #include <ostream>
+#include <thread>
+
+#include <unistd.h>
 
 // Required by main.h
 int  cache_vols           = 1;
@@ -304,6 +310,223 @@ TEST_CASE("aggWrite behavior")
     CHECK(0 < header.agg_pos);
   }
 
+  // The callback is scheduled from aggWriteDone, which may still be using
+  // the stripe. Wait for it to release the stripe before freeing it.
+  {
+    SCOPED_MUTEX_LOCK(lock, stripe.mutex, this_ethread());
+  }
   ats_free(stripe.raw_dir);
   ats_free(stripe.evacuate);
 }
+
+/* Catch test helper to recover a Stripe from a tmpfile.
+ *
+ * A first stripe clears the directory on the file. Each recovery writes its
+ * directory back with a header from the test, then initializes a second
+ * stripe from the file, which recovers from the Docs the test wrote.
+ */
+class RecoveryTest
+{
+public:
+  static constexpr off_t    BLOCKS      = 8192; // 64MB
+  static constexpr uint32_t SYNC_SERIAL = 10;
+
+  RecoveryTest()
+  {
+    static bool initialized = [] {
+      ink_cache_init(ts::ModuleVersion(1, 0, ts::ModuleVersion::PRIVATE));
+      gstripes = static_cast<Stripe **>(ats_calloc(1024, sizeof(Stripe *)));
+      return true;
+    }();
+    REQUIRE(initialized);
+
+    disk.path           = ats_strdup("recovery test");
+    disk.hw_sector_size = 512;
+    // The stripes register as initialized, but never open the cache.
+    cache.cache_read_done = 1;
+    cache.total_nvol      = INT_MAX;
+    cache_vol.vol_rsb     = cache_rsb;
+    file                  = std::tmpfile();
+    REQUIRE(file != nullptr);
+    this->init(cleared, true);
+    REQUIRE(ftruncate(fileno(file), this->end()) == 0);
+  }
+
+  ~RecoveryTest()
+  {
+    for (Stripe *stripe : {&cleared, &recovered}) {
+      ats_free(stripe->path);
+      ats_free(stripe->raw_dir);
+      ats_free(stripe->evacuate);
+    }
+    ats_free(disk.path);
+    disk.path = nullptr;
+    std::fclose(file);
+  }
+
+  /// Disk offset of data block @a i.
+  off_t
+  block(int i) const
+  {
+    return cleared.start + i * STORE_BLOCK_SIZE;
+  }
+
+  off_t
+  end() const
+  {
+    return cleared.skip + cleared.len;
+  }
+
+  /// Size of the recovery reads, where a failed read starts.
+  static off_t
+  chunk()
+  {
+    return std::max<off_t>(ROUND_TO_STORE_BLOCK(RECOVERY_SIZE / cache_config_recovery_queue_depth - (STORE_BLOCK_SIZE - 1)),
+                           STORE_BLOCK_SIZE);
+  }
+
+  /// Write a block sized Doc at @a pos.
+  void
+  write_doc(off_t pos, uint32_t sync_serial = SYNC_SERIAL)
+  {
+    char buf[sizeof(Doc)] = {};
+    Doc *doc              = reinterpret_cast<Doc *>(buf);
+    doc->magic            = DOC_MAGIC;
+    doc->len              = STORE_BLOCK_SIZE;
+    doc->sync_serial      = sync_serial;
+    doc->write_serial     = ++write_serial;
+    REQUIRE(pwrite(fileno(file), buf, sizeof(buf), pos) == static_cast<ssize_t>(sizeof(buf)));
+  }
+
+  /// Read errors from @a pos on.
+  void
+  truncate(off_t pos)
+  {
+    REQUIRE(ftruncate(fileno(file), pos) == 0);
+  }
+
+  /// Write the directory with the header synced at @a last_write_pos up to @a write_pos, and recover from it.
+  Stripe &
+  recover(off_t last_write_pos, off_t write_pos)
+  {
+    StripteHeaderFooter *header = cleared.header;
+    header->sync_serial         = SYNC_SERIAL;
+    header->write_serial        = write_serial + 1000;
+    header->last_write_pos      = last_write_pos;
+    header->write_pos           = write_pos;
+    header->agg_pos             = write_pos;
+    *cleared.footer             = *header;
+    REQUIRE(pwrite(fileno(file), cleared.raw_dir, cleared.dirlen(), cleared.skip) == static_cast<ssize_t>(cleared.dirlen()));
+
+    this->init(recovered, false);
+    return recovered;
+  }
+
+  bool
+  was_cleared() const
+  {
+    return recovered.header->sync_serial == 0 && recovered.header->write_pos == recovered.start;
+  }
+
+private:
+  void
+  init(Stripe &stripe, bool clear)
+  {
+    int  n      = gnstripes + 1;
+    char path[] = "recovery test";
+
+    stripe.fd        = fileno(file);
+    stripe.disk      = &disk;
+    stripe.cache     = &cache;
+    stripe.cache_vol = &cache_vol;
+    {
+      SCOPED_MUTEX_LOCK(lock, stripe.mutex, this_ethread());
+      stripe.init(path, BLOCKS, 0, clear);
+    }
+    while (gnstripes < n) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  CacheDisk  disk;
+  Cache      cache;
+  CacheVol   cache_vol;
+  Stripe     cleared;
+  Stripe     recovered;
+  std::FILE *file         = nullptr;
+  uint32_t   write_serial = 0;
+};
+
+TEST_CASE("Stripe recovery")
+{
+  RecoveryTest test;
+
+  SECTION("The scan stops at the first Doc from before the sync.")
+  {
+    for (int i = 0; i < 5; ++i) {
+      test.write_doc(test.block(i));
+    }
+    Stripe &stripe = test.recover(test.block(0), test.block(2));
+    CHECK_FALSE(test.was_cleared());
+    CHECK(stripe.recover_pos == test.block(5) + EVACUATION_SIZE);
+    CHECK(stripe.header->sync_serial == RecoveryTest::SYNC_SERIAL + 1);
+    CHECK(stripe.header->write_pos == test.block(2));
+  }
+
+  SECTION("A missing Doc before the write position clears the directory.")
+  {
+    test.write_doc(test.block(0));
+    test.write_doc(test.block(2));
+    test.recover(test.block(0), test.block(3));
+    CHECK(test.was_cleared());
+  }
+
+  SECTION("The scan wraps around to the start.")
+  {
+    for (int i = 4; i > 1; --i) {
+      test.write_doc(test.end() - i * STORE_BLOCK_SIZE);
+    }
+    for (int i = 0; i < 3; ++i) {
+      test.write_doc(test.block(i));
+    }
+    Stripe &stripe = test.recover(test.end() - 4 * STORE_BLOCK_SIZE, test.end() - 3 * STORE_BLOCK_SIZE);
+    CHECK_FALSE(test.was_cleared());
+    CHECK(stripe.recover_wrapped);
+    CHECK(stripe.recover_pos == test.block(3) + EVACUATION_SIZE);
+    CHECK(stripe.header->sync_serial == RecoveryTest::SYNC_SERIAL + 1);
+  }
+
+  SECTION("A read error ahead of the end of the scan is ignored.")
+  {
+    for (int i = 0; i < 5; ++i) {
+      test.write_doc(test.block(i));
+    }
+    test.truncate(test.block(0) + RecoveryTest::chunk() + STORE_BLOCK_SIZE);
+    Stripe &stripe = test.recover(test.block(0), test.block(2));
+    CHECK_FALSE(test.was_cleared());
+    CHECK(stripe.recover_pos == test.block(5) + EVACUATION_SIZE);
+  }
+
+  SECTION("A read error stops the scan at the last good position.")
+  {
+    int blocks = RecoveryTest::chunk() / STORE_BLOCK_SIZE + 4;
+    for (int i = 0; i < blocks; ++i) {
+      test.write_doc(test.block(i));
+    }
+    test.truncate(test.block(0) + RecoveryTest::chunk() + STORE_BLOCK_SIZE);
+    Stripe &stripe = test.recover(test.block(0), test.block(2));
+    CHECK_FALSE(test.was_cleared());
+    CHECK(stripe.recover_pos == test.block(0) + RecoveryTest::chunk() + EVACUATION_SIZE);
+  }
+
+  SECTION("A read error before the write position clears the directory.")
+  {
+    int blocks = RecoveryTest::chunk() / STORE_BLOCK_SIZE + 4;
+    for (int i = 0; i < blocks; ++i) {
+      test.write_doc(test.block(i));
+    }
+    test.truncate(test.block(0) + RecoveryTest::chunk() + STORE_BLOCK_SIZE);
+    test.recover(test.block(0), test.block(blocks - 1));
+    CHECK(test.was_cleared());
+  }
+}
@@ -63,4 +63,6 @@ ink_event_system_init(ts::ModuleVersion v)
 #endif
 
   init_buffer_allocators(iobuffer_advice, chunk_sizes, use_hugepages);
+
+  LockProfiler::init();
 }
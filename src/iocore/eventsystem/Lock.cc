@@ -33,6 +33,51 @@
 
 ClassAllocator<ProxyMutex> mutexAllocator("mutexAllocator");
 
+Event *
+ProxyMutex::wait_for_release(Continuation *c, EThread *t, int callback_event)
+{
+  ink_assert(handoff);
+  ink_assert(t == this_ethread());
+
+  // The event is queued directly rather than through EThread::schedule, which
+  // reads the continuation, so that it can be cancelled and the continuation
+  // freed while it is waiting.
+  Event *e          = EVENT_ALLOC(eventAllocator, t);
+  e->callback_event = callback_event;
+  e->init(c, 0, 0);
+  e->ethread = t;
+  e->mutex   = c->mutex;
+
+  Event *head = waiters.load(std::memory_order_relaxed);
+  do {
+    e->link.next = head;
+  } while (!waiters.compare_exchange_weak(head, e, std::memory_order_seq_cst, std::memory_order_relaxed));
+
+  // The holder may have released the mutex before the push, and then not seen
+  // the waiter. If the mutex is free now, the waiters are scheduled here.
+  if (ink_mutex_try_acquire(&the_mutex)) {
+    ink_mutex_release(&the_mutex);
+    wake_waiters();
+  }
+  return e;
+}
+
+void
+ProxyMutex::schedule_waiters()
+{
+  Event *e = waiters.exchange(nullptr, std::memory_order_acquire);
+  while (e) {
+    Event *next  = e->link.next;
+    e->link.next = nullptr;
+    if (e->ethread == this_ethread()) {
+      e->ethread->EventQueueExternal.enqueue_local(e);
+    } else {
+      e->ethread->EventQueueExternal.enqueue(e);
+    }
+    e = next;
+  }
+}
+
 void
 lock_waiting(const SourceLocation &srcloc, const char *handler)
 {
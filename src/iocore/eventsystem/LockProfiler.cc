@@ -0,0 +1,264 @@
+/** @file
+
+  Contention profile of ProxyMutex acquisitions
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string_view>
+
+#include "iocore/eventsystem/Lock.h"
+#include "iocore/eventsystem/LockProfiler.h"
+#include "records/RecCore.h"
+
+std::atomic<bool> LockProfiler::enabled{false};
+std::atomic<int>  LockProfiler::sample_period{16};
+
+/* A slot is written only by the thread that owns its table, so the counters
+ * are updated with plain loads and stores rather than read-modify-write
+ * operations. They are atomic for the benefit of collect(), which reads them
+ * from another thread. The base counts are those at the last reset(), and are
+ * only touched with the control mutex held.
+ */
+struct LockProfiler::Slot {
+  std::atomic<const char *> file{nullptr};
+  std::atomic<const char *> func{nullptr};
+  std::atomic<int>          line{0};
+
+  std::atomic<uint64_t> acquires{0};
+  std::atomic<uint64_t> misses{0};
+  std::atomic<uint64_t> blocks{0};
+  std::atomic<uint64_t> wait_time{0};
+  std::atomic<uint64_t> holds{0};
+  std::atomic<uint64_t> hold_time{0};
+  std::atomic<uint64_t> max_hold_time{0};
+
+  Site base;
+};
+
+namespace
+{
+DbgCtl dbg_ctl_lock_profile{"lock_profile"};
+
+void
+bump(std::atomic<uint64_t> &counter, uint64_t n = 1)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+struct Table {
+  static constexpr size_t SIZE = 512; ///< Power of 2.
+
+  LockProfiler::Slot slots[SIZE];
+  LockProfiler::Slot overflow; ///< For the sites past SIZE.
+  unsigned           tick = 0;
+
+  LockProfiler::Slot *
+  find(const SourceLocation &location)
+  {
+    // The file names are literals, compare them by address.
+    size_t h = (reinterpret_cast<uintptr_t>(location.file) >> 3) ^ (static_cast<size_t>(location.line) * 0x9E3779B1);
+    for (size_t i = 0; i < SIZE; ++i) {
+      auto       &slot = slots[(h + i) & (SIZE - 1)];
+      const char *file = slot.file.load(std::memory_order_relaxed);
+      if (file == nullptr) {
+        slot.func.store(location.func, std::memory_order_relaxed);
+        slot.line.store(location.line, std::memory_order_relaxed);
+        slot.file.store(location.file, std::memory_order_release);
+        return &slot;
+      }
+      if (file == location.file && slot.line.load(std::memory_order_relaxed) == location.line) {
+        return &slot;
+      }
+    }
+    return &overflow;
+  }
+};
+
+// Tables are never freed, threads live for the life of the process.
+std::mutex           tables_mutex;
+std::vector<Table *> tables;
+thread_local Table  *this_table = nullptr;
+
+// Serializes collect() and reset().
+std::mutex control_mutex;
+
+Table *
+get_table()
+{
+  if (this_table == nullptr) {
+    this_table = new Table;
+    std::lock_guard<std::mutex> lock(tables_mutex);
+    tables.push_back(this_table);
+  }
+  return this_table;
+}
+
+LockProfiler::Site
+read_slot(LockProfiler::Slot const &slot)
+{
+  LockProfiler::Site site;
+  site.acquires      = slot.acquires.load(std::memory_order_relaxed);
+  site.misses        = slot.misses.load(std::memory_order_relaxed);
+  site.blocks        = slot.blocks.load(std::memory_order_relaxed);
+  site.wait_time     = slot.wait_time.load(std::memory_order_relaxed);
+  site.holds         = slot.holds.load(std::memory_order_relaxed);
+  site.hold_time     = slot.hold_time.load(std::memory_order_relaxed);
+  site.max_hold_time = slot.max_hold_time.load(std::memory_order_relaxed);
+  return site;
+}
+
+template <typename F>
+void
+for_each_slot(F &&f)
+{
+  std::vector<Table *> all;
+  {
+    std::lock_guard<std::mutex> lock(tables_mutex);
+    all = tables;
+  }
+  for (auto table : all) {
+    for (auto &slot : table->slots) {
+      if (slot.file.load(std::memory_order_acquire) != nullptr) {
+        f(slot);
+      }
+    }
+    f(table->overflow);
+  }
+}
+
+int
+update_lock_profiler_config(const char *name, RecDataT, RecData data, void *)
+{
+  std::string_view view{name};
+
+  if (view == "proxy.config.lock_profiling.enabled") {
+    LockProfiler::enabled = data.rec_int != 0;
+  } else if (view == "proxy.config.lock_profiling.sample_period") {
+    LockProfiler::sample_period = std::max<int>(1, data.rec_int);
+  }
+  Dbg(dbg_ctl_lock_profile, "%s updated to %" PRId64, name, data.rec_int);
+  return 0;
+}
+} // namespace
+
+void
+LockProfiler::acquired(ProxyMutex *m, const SourceLocation &location)
+{
+  Table *table = get_table();
+  Slot  *slot  = table->find(location);
+
+  bump(slot->acquires);
+  if (++table->tick >= static_cast<unsigned>(sample_period.load(std::memory_order_relaxed))) {
+    table->tick      = 0;
+    m->profile_slot  = slot;
+    m->profile_start = ink_get_hrtime();
+  }
+}
+
+void
+LockProfiler::missed(const SourceLocation &location)
+{
+  bump(get_table()->find(location)->misses);
+}
+
+void
+LockProfiler::blocked(const SourceLocation &location, ink_hrtime wait)
+{
+  Slot *slot = get_table()->find(location);
+  bump(slot->blocks);
+  bump(slot->wait_time, wait);
+}
+
+void
+LockProfiler::released(ProxyMutex *m)
+{
+  Slot    *slot = m->profile_slot;
+  uint64_t hold = ink_get_hrtime() - m->profile_start;
+
+  m->profile_slot = nullptr;
+  bump(slot->holds);
+  bump(slot->hold_time, hold);
+  if (hold > slot->max_hold_time.load(std::memory_order_relaxed)) {
+    slot->max_hold_time.store(hold, std::memory_order_relaxed);
+  }
+}
+
+std::vector<LockProfiler::Site>
+LockProfiler::collect()
+{
+  std::lock_guard<std::mutex> lock(control_mutex);
+
+  // The same site may have a different file name address in each translation unit.
+  std::map<std::pair<std::string_view, int>, Site> merged;
+  for_each_slot([&](Slot const &slot) {
+    Site site = read_slot(slot);
+    if (site.acquires == slot.base.acquires && site.misses == slot.base.misses && site.blocks == slot.base.blocks) {
+      return;
+    }
+    const char *file = slot.file.load(std::memory_order_relaxed);
+    auto       &m    = merged[{file ? file : "", slot.line.load(std::memory_order_relaxed)}];
+    if (m.location.file == nullptr) {
+      m.location = SourceLocation(file, slot.func.load(std::memory_order_relaxed), slot.line.load(std::memory_order_relaxed));
+    }
+    m.acquires      += site.acquires - slot.base.acquires;
+    m.misses        += site.misses - slot.base.misses;
+    m.blocks        += site.blocks - slot.base.blocks;
+    m.wait_time     += site.wait_time - slot.base.wait_time;
+    m.holds         += site.holds - slot.base.holds;
+    m.hold_time     += site.hold_time - slot.base.hold_time;
+    m.max_hold_time  = std::max(m.max_hold_time, site.max_hold_time);
+  });
+
+  std::vector<Site> sites;
+  sites.reserve(merged.size());
+  for (auto &[key, site] : merged) {
+    sites.push_back(site);
+  }
+  return sites;
+}
+
+void
+LockProfiler::reset()
+{
+  std::lock_guard<std::mutex> lock(control_mutex);
+
+  for_each_slot([](Slot &slot) {
+    slot.base = read_slot(slot);
+    slot.max_hold_time.store(0, std::memory_order_relaxed);
+  });
+}
+
+void
+LockProfiler::init()
+{
+  RecInt value = 0;
+
+  if (REC_ERR_OKAY == RecGetRecordInt("proxy.config.lock_profiling.sample_period", &value)) {
+    sample_period = std::max<int>(1, value);
+  }
+  if (REC_ERR_OKAY == RecGetRecordInt("proxy.config.lock_profiling.enabled", &value)) {
+    enabled = value != 0;
+  }
+  RecRegisterConfigUpdateCb("proxy.config.lock_profiling.enabled", update_lock_profiler_config, nullptr);
+  RecRegisterConfigUpdateCb("proxy.config.lock_profiling.sample_period", update_lock_profiler_config, nullptr);
+}
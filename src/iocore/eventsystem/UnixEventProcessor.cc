@@ -148,6 +148,34 @@ EventMetricStatSync(const char *, RecDataT, RecData *, RecRawStatBlock *rsb, int
   return REC_ERR_OKAY;
 }
 
+#if TS_USE_HWLOC
+/// Number of NUMA nodes with freelist statistics.
+int freelist_stat_nodes = 0;
+
+/// Update the per NUMA node freelist statistics, two for each node.
+int
+FreelistNodeStatSync(const char *, RecDataT, RecData *, RecRawStatBlock *rsb, int)
+{
+  ink_mutex_acquire(&(rsb->mutex));
+
+  for (int idx = 0; idx < freelist_stat_nodes; ++idx) {
+    hwloc_obj_t obj = hwloc_get_obj_by_type(ink_get_topology(), HWLOC_OBJ_NODE, idx);
+    uint64_t    allocated, free;
+
+    ink_freelists_node_stats(obj->os_index, &allocated, &free);
+    rsb->global[2 * idx]->sum       = allocated;
+    rsb->global[2 * idx]->count     = 1;
+    rsb->global[2 * idx + 1]->sum   = free;
+    rsb->global[2 * idx + 1]->count = 1;
+    RecRawStatUpdateSum(rsb, 2 * idx);
+    RecRawStatUpdateSum(rsb, 2 * idx + 1);
+  }
+
+  ink_mutex_release(&(rsb->mutex));
+  return REC_ERR_OKAY;
+}
+#endif
+
 /// This is a wrapper used to convert a static function into a continuation. The function pointer is
 /// passed in the cookie. For this reason the class is used as a singleton.
 /// @internal This is the implementation for @c schedule_spawn... overloads.
@@ -275,6 +303,15 @@ ThreadAffinityInitializer::set_affinity(int, Event *)
     Dbg(dbg_ctl_iocore_thread, "EThread: %d %s: %d", _name, obj->logical_index);
 #endif // HWLOC_API_VERSION
     hwloc_set_thread_cpubind(ink_get_topology(), t->tid, obj->cpuset, HWLOC_CPUBIND_STRICT);
+
+    // If the thread lives in a single NUMA node, use the freelists local to that node.
+    hwloc_nodeset_t nodeset = hwloc_bitmap_alloc();
+    hwloc_cpuset_to_nodeset(ink_get_topology(), obj->cpuset, nodeset);
+    if (hwloc_bitmap_weight(nodeset) == 1) {
+      ink_freelist_set_thread_node(hwloc_bitmap_first(nodeset));
+      Dbg(dbg_ctl_iocore_thread, "EThread: %p freelist NUMA node: %d", t, ink_freelist_thread_node());
+    }
+    hwloc_bitmap_free(nodeset);
   } else {
     Warning("hwloc returned an unexpected number of objects -- CPU affinity disabled");
   }
@@ -545,6 +582,23 @@ EventProcessor::start(int n_event_threads, size_t stacksize)
   // Name must be that of a stat, pick one at random since we do all of them in one pass/callback.
   RecRegisterRawStatSyncCb(name, EventMetricStatSync, rsb, 0);
 
+#if TS_USE_HWLOC
+  // Freelist memory per NUMA node, only interesting if there is more than one.
+  if (int n_nodes = hwloc_get_nbobjs_by_type(ink_get_topology(), HWLOC_OBJ_NODE); n_nodes > 1) {
+    RecRawStatBlock *node_rsb = RecAllocateRawStatBlock(2 * n_nodes);
+
+    freelist_stat_nodes = n_nodes;
+    for (int idx = 0; idx < n_nodes; ++idx) {
+      hwloc_obj_t obj = hwloc_get_obj_by_type(ink_get_topology(), HWLOC_OBJ_NODE, idx);
+      snprintf(name, sizeof(name), "proxy.process.allocator.numa.node_%u.allocated", obj->os_index);
+      RecRegisterRawStat(node_rsb, RECT_PROCESS, name, RECD_INT, RECP_NON_PERSISTENT, 2 * idx, NULL);
+      snprintf(name, sizeof(name), "proxy.process.allocator.numa.node_%u.free", obj->os_index);
+      RecRegisterRawStat(node_rsb, RECT_PROCESS, name, RECD_INT, RECP_NON_PERSISTENT, 2 * idx + 1, NULL);
+    }
+    RecRegisterRawStatSyncCb(name, FreelistNodeStatSync, node_rsb, 0);
+  }
+#endif
+
   this->spawn_event_threads(ET_CALL, n_event_threads, stacksize);
 
   Dbg(dbg_ctl_iocore_thread, "Created event thread group id %d with %d threads", ET_CALL, n_event_threads);
@@ -34,6 +34,163 @@
 #define TEST_TIME_SECOND 60
 #define TEST_THREADS     2
 
+TEST_CASE("ProxyMutex handoff", "[iocore][lock]")
+{
+  // Tries a contended mutex on an event thread, then waits for its release.
+  struct waiter : public Continuation {
+    waiter(ProxyMutex *m, ProxyMutex *c, bool cancel) : Continuation(m), contended(c), cancel(cancel)
+    {
+      SET_HANDLER(&waiter::try_lock);
+    }
+
+    int
+    try_lock(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+    {
+      MUTEX_TRY_LOCK(lock, contended, this_ethread());
+      if (lock.is_locked() && !wait_first) {
+        acquired_at = ink_get_hrtime();
+        return 0;
+      }
+      MUTEX_RELEASE(lock);
+      wait_first = false;
+      ++misses;
+      Event *e = contended->wait_for_release(this, this_ethread(), EVENT_INTERVAL);
+      if (cancel) {
+        e->cancel_action();
+      }
+      waiting = true;
+      return 0;
+    }
+
+    Ptr<ProxyMutex>         contended;
+    bool                    cancel;
+    bool                    wait_first = false;
+    std::atomic<bool>       waiting{false};
+    std::atomic<int>        misses{0};
+    std::atomic<ink_hrtime> acquired_at{0};
+  };
+
+  auto wait_for = [](auto &&done) {
+    for (int i = 0; i < 2000 && !done(); ++i) {
+      usleep(1000);
+    }
+    return done();
+  };
+
+  Ptr<ProxyMutex> contended{new_ProxyMutex()};
+  contended->handoff = true;
+
+  waiter w{new_ProxyMutex(), contended.get(), false};
+  waiter cancelled{new_ProxyMutex(), contended.get(), true};
+  ink_hrtime released_at = 0;
+  {
+    SCOPED_MUTEX_LOCK(lock, contended, this_ethread());
+    eventProcessor.schedule_imm(&w);
+    eventProcessor.schedule_imm(&cancelled);
+    REQUIRE(wait_for([&]() { return w.waiting && cancelled.waiting; }));
+    // Nothing retries while the lock is held.
+    usleep(50000);
+    CHECK(w.misses == 1);
+    CHECK(w.acquired_at == 0);
+    released_at = ink_get_hrtime();
+  }
+  REQUIRE(wait_for([&]() { return w.acquired_at != 0; }));
+  CHECK(w.misses == 1);
+  CHECK(w.acquired_at - released_at < HRTIME_MSECONDS(500));
+  usleep(20000);
+  CHECK(cancelled.acquired_at == 0);
+  CHECK(contended->waiters.load() == nullptr);
+
+  // Waiting on a free mutex schedules at once.
+  waiter early{new_ProxyMutex(), contended.get(), false};
+  early.wait_first = true;
+  eventProcessor.schedule_imm(&early);
+  REQUIRE(wait_for([&]() { return early.acquired_at != 0; }));
+  CHECK(early.misses == 1);
+}
+
+TEST_CASE("Lock profiler", "[iocore][lock]")
+{
+  // Holds a mutex on an event thread for a while.
+  struct holder : public Continuation {
+    holder(ProxyMutex *m, ProxyMutex *h) : Continuation(m), held_mutex(h) { SET_HANDLER(&holder::hold); }
+
+    int
+    hold(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+    {
+      SCOPED_MUTEX_LOCK(lock, held_mutex, this_ethread());
+      held = true;
+      usleep(50000);
+      return 0;
+    }
+
+    Ptr<ProxyMutex>   held_mutex;
+    std::atomic<bool> held{false};
+  };
+
+  auto find = [](std::vector<LockProfiler::Site> const &sites, int line) {
+    for (auto const &site : sites) {
+      if (site.location.line == line && std::string_view{site.location.file}.ends_with("test_EventSystem.cc")) {
+        return site;
+      }
+    }
+    return LockProfiler::Site{};
+  };
+
+  LockProfiler::sample_period = 1;
+  LockProfiler::enabled       = true;
+
+  Ptr<ProxyMutex> m{new_ProxyMutex()};
+  holder          h{new_ProxyMutex(), m.get()};
+  int             uncontended_line = __LINE__ + 2;
+  for (int i = 0; i < 3; ++i) {
+    SCOPED_MUTEX_LOCK(lock, m, this_ethread());
+  }
+
+  eventProcessor.schedule_imm(&h);
+  while (!h.held) {
+    usleep(1000);
+  }
+  int try_line = __LINE__ + 1;
+  MUTEX_TRY_LOCK(try_lock, m, this_ethread());
+  CHECK_FALSE(try_lock.is_locked());
+  int block_line = __LINE__ + 1;
+  SCOPED_MUTEX_LOCK(lock, m, this_ethread());
+  lock.release();
+  LockProfiler::enabled = false;
+
+  auto sites = LockProfiler::collect();
+  auto site  = find(sites, uncontended_line);
+  CHECK(site.acquires == 3);
+  CHECK(site.misses == 0);
+  CHECK(site.holds == 3);
+
+  site = find(sites, try_line);
+  CHECK(site.acquires == 0);
+  CHECK(site.misses == 1);
+
+  site = find(sites, block_line);
+  CHECK(site.acquires == 1);
+  CHECK(site.blocks == 1);
+  CHECK(site.wait_time > 0);
+
+  // The holder's site, on the event thread.
+  bool found = false;
+  for (auto const &s : sites) {
+    if (std::string_view{s.location.func} == "hold") {
+      found = true;
+      CHECK(s.acquires == 1);
+      CHECK(s.holds == 1);
+      CHECK(s.max_hold_time >= static_cast<uint64_t>(HRTIME_MSECONDS(50)));
+    }
+  }
+  CHECK(found);
+
+  LockProfiler::reset();
+  CHECK(find(LockProfiler::collect(), uncontended_line).acquires == 0);
+  LockProfiler::sample_period = 16;
+}
+
 TEST_CASE("EventSystem", "[iocore]")
 {
   static int count;
@@ -0,0 +1,252 @@
+/** @file
+
+  Steering of accepted connections to the ET_NET thread on the receiving CPU.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_AcceptSteering.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/socket.h>
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+#include "records/RecCore.h"
+#include "tscore/Diags.h"
+
+namespace accept_steering
+{
+namespace
+{
+  DbgCtl dbg_ctl_accept_steering{"accept_steering"};
+
+  // Classic BPF opcodes and the CPU ancillary load offset, see linux/filter.h.
+  constexpr uint16_t OP_LD_W_ABS = 0x20; // BPF_LD | BPF_W | BPF_ABS
+  constexpr uint16_t OP_JEQ_K    = 0x15; // BPF_JMP | BPF_JEQ | BPF_K
+  constexpr uint16_t OP_RET_K    = 0x06; // BPF_RET | BPF_K
+  constexpr uint32_t AD_CPU      = static_cast<uint32_t>(-0x1000 + 36); // SKF_AD_OFF + SKF_AD_CPU
+  constexpr size_t   MAX_INSNS   = 4096;                                // BPF_MAXINSNS
+
+#if defined(__linux__)
+  static_assert(OP_LD_W_ABS == (BPF_LD | BPF_W | BPF_ABS));
+  static_assert(OP_JEQ_K == (BPF_JMP | BPF_JEQ | BPF_K));
+  static_assert(OP_RET_K == (BPF_RET | BPF_K));
+  static_assert(AD_CPU == static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU));
+  static_assert(sizeof(Insn) == sizeof(sock_filter));
+#endif
+} // namespace
+
+Mode
+configured_mode()
+{
+  int listen_per_thread = 0;
+  int steering          = 0;
+
+  REC_ReadConfigInteger(listen_per_thread, "proxy.config.exec_thread.listen");
+  REC_ReadConfigInteger(steering, "proxy.config.exec_thread.listen.steering");
+
+  if (steering == 0) {
+    return Mode::NONE;
+  }
+  if (listen_per_thread != 1) {
+    Warning("proxy.config.exec_thread.listen.steering requires proxy.config.exec_thread.listen, steering disabled");
+    return Mode::NONE;
+  }
+
+  switch (static_cast<Mode>(steering)) {
+  case Mode::INCOMING_CPU:
+#if defined(SO_INCOMING_CPU)
+    return Mode::INCOMING_CPU;
+#else
+    break;
+#endif
+  case Mode::REUSEPORT_CBPF:
+#if defined(SO_ATTACH_REUSEPORT_CBPF)
+    return Mode::REUSEPORT_CBPF;
+#else
+    break;
+#endif
+  default:
+    break;
+  }
+
+  Warning("accept steering mode %d is not supported on this platform, steering disabled", steering);
+  return Mode::NONE;
+}
+
+std::vector<int>
+thread_cpus()
+{
+  std::vector<int> zret;
+#if defined(__linux__)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  if (sched_getaffinity(0, sizeof(cpus), &cpus) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpus)) {
+        zret.push_back(cpu);
+      }
+    }
+  }
+#endif
+  return zret;
+}
+
+std::vector<int>
+assign_cpus(std::vector<std::vector<int>> const &socket_cpus)
+{
+  int max_cpu = -1;
+  for (auto const &cpus : socket_cpus) {
+    for (int cpu : cpus) {
+      max_cpu = std::max(max_cpu, cpu);
+    }
+  }
+
+  std::vector<int>      zret(max_cpu + 1, -1);
+  std::vector<unsigned> load(socket_cpus.size(), 0);
+
+  // For each CPU, the candidate socket with the fewest CPUs so far, preferring the lowest index.
+  for (int cpu = 0; cpu <= max_cpu; ++cpu) {
+    for (unsigned idx = 0; idx < socket_cpus.size(); ++idx) {
+      auto const &cpus = socket_cpus[idx];
+      if (std::binary_search(cpus.begin(), cpus.end(), cpu) && (zret[cpu] < 0 || load[idx] < load[zret[cpu]])) {
+        zret[cpu] = idx;
+      }
+    }
+    if (zret[cpu] >= 0) {
+      ++load[zret[cpu]];
+    }
+  }
+
+  return zret;
+}
+
+std::vector<Insn>
+build_program(std::vector<int> const &cpu_socket, unsigned n_sockets)
+{
+  std::vector<Insn> zret;
+
+  zret.push_back({OP_LD_W_ABS, 0, 0, AD_CPU});
+  for (unsigned cpu = 0; cpu < cpu_socket.size(); ++cpu) {
+    if (cpu_socket[cpu] >= 0) {
+      zret.push_back({OP_JEQ_K, 0, 1, cpu});
+      zret.push_back({OP_RET_K, 0, 0, static_cast<uint32_t>(cpu_socket[cpu])});
+    }
+  }
+  zret.push_back({OP_RET_K, 0, 0, n_sockets});
+
+  return zret;
+}
+
+Group::Group(Mode mode, int n_sockets) : _mode(mode), _n_sockets(n_sockets) {}
+
+int
+Group::add(std::function<int()> const &listen, int const &fd)
+{
+  std::lock_guard lock(_mutex);
+
+  int res = listen();
+  if (res != 0) {
+    return res;
+  }
+
+  auto cpus = thread_cpus();
+
+#if defined(SO_INCOMING_CPU)
+  if (_mode == Mode::INCOMING_CPU && !cpus.empty()) {
+    // Prefer a CPU not already used by an earlier socket, to spread threads which share CPUs.
+    int cpu = cpus.front();
+    for (int c : cpus) {
+      if (std::none_of(_socket_cpus.begin(), _socket_cpus.end(),
+                       [=](auto const &prev) { return !prev.empty() && prev.front() == c; })) {
+        cpu = c;
+        break;
+      }
+    }
+    if (setsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu)) < 0) {
+      Warning("unable to set SO_INCOMING_CPU on listen socket: %s", strerror(errno));
+    } else {
+      Dbg(dbg_ctl_accept_steering, "listen fd %d incoming CPU %d", fd, cpu);
+    }
+    // Record the steered CPU first so later sockets avoid it.
+    cpus.erase(std::find(cpus.begin(), cpus.end(), cpu));
+    cpus.insert(cpus.begin(), cpu);
+  }
+#endif
+
+  _socket_cpus.push_back(std::move(cpus));
+
+  if (_mode == Mode::REUSEPORT_CBPF && static_cast<int>(_socket_cpus.size()) == _n_sockets) {
+    this->attach(fd);
+  }
+
+  return 0;
+}
+
+void
+Group::attach(int fd)
+{
+#if defined(SO_ATTACH_REUSEPORT_CBPF)
+  for (auto &cpus : _socket_cpus) {
+    std::sort(cpus.begin(), cpus.end());
+  }
+
+  auto program = build_program(assign_cpus(_socket_cpus), _socket_cpus.size());
+  if (program.size() > MAX_INSNS) {
+    Warning("too many CPUs for the accept steering program, steering disabled");
+    return;
+  }
+
+  sock_fprog prog;
+  prog.len    = program.size();
+  prog.filter = reinterpret_cast<sock_filter *>(program.data());
+  // The program applies to the whole reuseport group, so it only needs to be attached to one socket.
+  if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0) {
+    Warning("unable to attach accept steering program: %s", strerror(errno));
+  } else {
+    Dbg(dbg_ctl_accept_steering, "attached steering program with %zu instructions for %zu sockets", program.size(),
+        _socket_cpus.size());
+  }
+#else
+  (void)fd;
+#endif
+}
+
+bool
+is_remote_cpu(int fd, std::vector<int> const &cpus)
+{
+#if defined(SO_INCOMING_CPU)
+  int       cpu = -1;
+  socklen_t len = sizeof(cpu);
+  if (getsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &cpu, &len) == 0 && cpu >= 0) {
+    return !std::binary_search(cpus.begin(), cpus.end(), cpu);
+  }
+#else
+  (void)fd;
+  (void)cpus;
+#endif
+  return false;
+}
+
+} // namespace accept_steering
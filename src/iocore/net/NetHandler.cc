@@ -22,6 +22,7 @@
  */
 
 #include "iocore/net/NetHandler.h"
+#include <algorithm>
 #include <atomic>
 
 #if TS_USE_LINUX_IO_URING
@@ -278,6 +279,7 @@ NetHandler::process_ready_list()
       read_ready_list.remove(ne);
     }
   }
+  process_flush_list();
   while ((ne = write_ready_list.dequeue())) {
     set_cont_flags(ne->get_control_flags());
     if (ne->closed) {
@@ -298,6 +300,7 @@ NetHandler::process_ready_list()
     else if (!ne->read.enabled)
       ne->ep.modify(-EVENTIO_READ);
   }
+  process_flush_list();
   while ((ne = write_ready_list.dequeue())) {
     set_cont_flags(ne->get_control_flags());
     if (ne->closed)
@@ -310,6 +313,40 @@ NetHandler::process_ready_list()
 #endif /* !USE_EDGE_TRIGGER */
 }
 
+void
+NetHandler::defer_flush(Continuation *c)
+{
+  ink_assert(this->thread == this_ethread());
+  _flush_list.push_back(c);
+}
+
+void
+NetHandler::cancel_flush(Continuation *c)
+{
+  std::replace(_flush_list.begin(), _flush_list.end(), c, static_cast<Continuation *>(nullptr));
+  std::replace(_flushing.begin(), _flushing.end(), c, static_cast<Continuation *>(nullptr));
+}
+
+void
+NetHandler::process_flush_list()
+{
+  // A callback may defer another flush or cancel a later one, so work from a copy.
+  _flushing.swap(_flush_list);
+  for (size_t i = 0; i < _flushing.size(); ++i) {
+    Continuation *c = _flushing[i];
+    if (c == nullptr) {
+      continue;
+    }
+    MUTEX_TRY_LOCK(lock, c->mutex, this->thread);
+    if (lock.is_locked()) {
+      c->handleEvent(NET_EVENT_FLUSH, nullptr);
+    } else {
+      _flush_list.push_back(c);
+    }
+  }
+  _flushing.clear();
+}
+
 //
 // The main event for NetHandler
 int
@@ -0,0 +1,131 @@
+/** @file
+
+  Steering of accepted connections to the ET_NET thread on the receiving CPU.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <sched.h>
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/** Accept steering.
+ *
+ * With @c proxy.config.exec_thread.listen each ET_NET thread has its own listen socket in a
+ * @c SO_REUSEPORT group and by default the kernel picks the socket by a hash of the flow. The
+ * accepting thread is then rarely on the CPU that handled the packets for the connection. Steering
+ * selects instead the socket of a thread which is bound to the receiving CPU.
+ *
+ * Two mechanisms are supported, selected by @c proxy.config.exec_thread.listen.steering.
+ *
+ * - @c INCOMING_CPU sets @c SO_INCOMING_CPU on each listen socket to a CPU of the owning thread.
+ *   The kernel (6.2 and later) prefers the socket matching the receiving CPU. Only one CPU per
+ *   socket can be set, so this is most useful with threads bound to processing units or cores.
+ * - @c REUSEPORT_CBPF attaches a classic BPF program to the reuseport group which maps each CPU to
+ *   the index of a socket whose thread is bound to that CPU. This works for any thread affinity.
+ */
+namespace accept_steering
+{
+enum class Mode {
+  NONE           = 0, ///< Kernel flow hash.
+  INCOMING_CPU   = 1, ///< SO_INCOMING_CPU on each listen socket.
+  REUSEPORT_CBPF = 2, ///< Classic BPF program on the reuseport group.
+};
+
+/// @return The configured steering mode, @c NONE if it is not supported or not applicable.
+Mode configured_mode();
+
+/// CPUs the calling thread may run on.
+std::vector<int> thread_cpus();
+
+/** Assign each CPU to a socket.
+ *
+ * @param socket_cpus For each socket, in reuseport group order, the CPUs of the owning thread.
+ * @return For each CPU up to the largest in @a socket_cpus, the socket index or -1 if no thread
+ * runs on that CPU.
+ *
+ * If several threads run on a CPU, the CPUs are spread evenly across those threads.
+ */
+std::vector<int> assign_cpus(std::vector<std::vector<int>> const &socket_cpus);
+
+/// A classic BPF instruction, layout compatible with @c struct @c sock_filter.
+struct Insn {
+  uint16_t code;
+  uint8_t  jt;
+  uint8_t  jf;
+  uint32_t k;
+};
+
+/** Build the reuseport selection program for @a cpu_socket.
+ *
+ * @param cpu_socket The socket index for each CPU, as from @c assign_cpus.
+ * @param n_sockets Number of sockets in the group.
+ * @return The program, which returns @a n_sockets (out of range, so the kernel falls back to the
+ * flow hash) for CPUs without a socket.
+ */
+std::vector<Insn> build_program(std::vector<int> const &cpu_socket, unsigned n_sockets);
+
+/** The listen sockets for one proxy port, one for each ET_NET thread.
+ *
+ * Shared by the per thread @c NetAccept clones for the port.
+ */
+class Group
+{
+public:
+  /** Constructor.
+   *
+   * @param mode Steering mode.
+   * @param n_sockets Number of threads which will each add a socket.
+   */
+  Group(Mode mode, int n_sockets);
+
+  /** Create and add the listen socket for the calling thread.
+   *
+   * @param listen Function to create the listen socket, returns 0 on success.
+   * @param fd The socket created by @a listen.
+   * @return The result of @a listen.
+   *
+   * The group is locked while the socket is created so that the order of the sockets in the
+   * kernel reuseport group is the order recorded here.
+   */
+  int add(std::function<int()> const &listen, int const &fd);
+
+private:
+  Mode                          _mode;
+  int                           _n_sockets;
+  std::mutex                    _mutex;
+  std::vector<std::vector<int>> _socket_cpus;
+
+  void attach(int fd);
+};
+
+/** Check where a connection was received.
+ *
+ * @param fd An accepted socket.
+ * @param cpus CPUs of the accepting thread, sorted.
+ * @return @c true if the connection packets were last processed on a CPU other than one in @a cpus.
+ */
+bool is_remote_cpu(int fd, std::vector<int> const &cpus);
+
+} // namespace accept_steering
@@ -76,6 +76,7 @@ struct NetStatsBlock {
   Metrics::Counter::AtomicType *socks_connections_successful;
   Metrics::Counter::AtomicType *socks_connections_unsuccessful;
   Metrics::Counter::AtomicType *tcp_accept;
+  Metrics::Counter::AtomicType *udp_paced_packets_dropped;
   Metrics::Counter::AtomicType *write_bytes;
   Metrics::Counter::AtomicType *write_bytes_count;
   Metrics::Gauge::AtomicType   *connection_tracker_table_size;
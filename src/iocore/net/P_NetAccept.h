@@ -40,8 +40,11 @@
 
 #include "iocore/net/NetProcessor.h"
 #include "iocore/net/NetAcceptEventIO.h"
+#include <memory>
 #include <vector>
 #include "tscore/ink_platform.h"
+#include "tsutil/Metrics.h"
+#include "P_AcceptSteering.h"
 #include "P_Connection.h"
 
 struct NetAccept;
@@ -100,6 +103,17 @@ struct NetAccept : public Continuation {
   HttpProxyPort *proxyPort = nullptr;
   AcceptOptions  opt;
 
+  /// Listen sockets of all threads for this port, if accept steering is enabled.
+  std::shared_ptr<accept_steering::Group> steering;
+  /// CPUs of the thread accepting on this socket, if accept steering is enabled.
+  std::vector<int> thread_cpus;
+  /// Connections accepted by this thread.
+  ts::Metrics::Counter::AtomicType *thread_accepts = nullptr;
+  /// Connections accepted by this thread which were received on a CPU the thread does not run on.
+  ts::Metrics::Counter::AtomicType *thread_accepts_remote_cpu = nullptr;
+
+  void count_thread_accept(int fd);
+
   virtual NetProcessor *getNetProcessor() const;
 
   virtual void       init_accept(EThread *t = nullptr);
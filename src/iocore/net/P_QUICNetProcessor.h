@@ -78,7 +78,6 @@ private:
   QUICNetProcessor(const QUICNetProcessor &);
   QUICNetProcessor &operator=(const QUICNetProcessor &);
 
-  QUICConnectionTable *_ctable        = nullptr;
   quiche_config       *_quiche_config = nullptr;
 };
 
@@ -54,6 +54,7 @@
 #include "iocore/net/quic/QUICConnection.h"
 #include "iocore/net/quic/QUICConnectionTable.h"
 #include "iocore/net/quic/QUICContext.h"
+#include "iocore/net/quic/QUICStream.h"
 #include "iocore/net/quic/QUICStreamManager.h"
 
 #include <netinet/in.h>
@@ -202,6 +203,8 @@ private:
 
   void _handle_read_ready();
   void _handle_write_ready();
+  void _send_udp_payload(const Ptr<IOBufferBlock> &udp_payload, int64_t offset, int64_t len, size_t max_udp_payload_size,
+                         const timespec &at);
   void _handle_interval();
 
   void _propagate_event(int event);
@@ -214,6 +217,9 @@ private:
 
   QUICStreamManager  *_stream_manager  = nullptr;
   QUICApplicationMap *_application_map = nullptr;
+
+  /// Streams that quiche can take data for, by [RFC 9218] urgency
+  ExtensiblePriorityQueue<QUICStream> _writable_streams;
 };
 
 extern ClassAllocator<QUICNetVConnection> quicNetVCAllocator;
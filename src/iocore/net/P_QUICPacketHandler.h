@@ -28,10 +28,13 @@
 #include "tscore/ink_platform.h"
 #include "P_Connection.h"
 #include "P_NetAccept.h"
+#include "P_QUICSteering.h"
+#include "iocore/net/quic/QUICConnectionTable.h"
 #include <quiche.h>
 
+#include <memory>
+
 class QUICNetVConnection;
-class QUICConnectionTable;
 class QUICClosedConCollector;
 
 class QUICPacketHandler
@@ -40,7 +43,13 @@ public:
   QUICPacketHandler();
   virtual ~QUICPacketHandler();
 
-  void send_packet(UDPConnection *udp_con, IpEndpoint &addr, Ptr<IOBufferBlock> udp_payload, uint16_t segment_size = 0);
+  // Each handler owns its collector, a clone must not share it.
+  QUICPacketHandler(const QUICPacketHandler &)            = delete;
+  QUICPacketHandler &operator=(const QUICPacketHandler &) = delete;
+
+  /// @a departure is when the packet should leave by pacing, 0 to send it right away.
+  void send_packet(UDPConnection *udp_con, IpEndpoint &addr, Ptr<IOBufferBlock> udp_payload, uint16_t segment_size = 0,
+                   ink_hrtime departure = 0);
   void close_connection(QUICNetVConnection *conn);
 
 protected:
@@ -55,7 +64,8 @@ protected:
 class QUICPacketHandlerIn : public NetAccept, public QUICPacketHandler
 {
 public:
-  QUICPacketHandlerIn(const NetProcessor::AcceptOptions &opt, QUICConnectionTable &ctable, quiche_config &config);
+  QUICPacketHandlerIn(const NetProcessor::AcceptOptions &opt, quiche_config &config,
+                      std::shared_ptr<quic_steering::Group> steering = nullptr);
   ~QUICPacketHandlerIn();
 
   // NetAccept
@@ -69,10 +79,13 @@ protected:
   Continuation *_get_continuation() override;
 
 private:
-  QUICConnectionTable &_ctable;
-  quiche_config       &_quiche_config;
+  QUICConnectionTable                   _ctable;
+  quiche_config                        &_quiche_config;
+  std::shared_ptr<quic_steering::Group> _steering;
+  int                                   _owner_id = -1; ///< Owner id in the connection IDs this handler issues, -1 for none.
 
   void _recv_packet(int event, UDPPacket *udpPacket) override;
+  bool _steer(UDPPacket *udp_packet, const uint8_t *buf, size_t buf_len);
 };
 
 class QUICPacketHandlerOut : public Continuation, public QUICPacketHandler
@@ -0,0 +1,119 @@
+/** @file
+
+  Connection ID steering of QUIC datagrams
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "P_AcceptSteering.h"
+
+class Continuation;
+class EThread;
+
+/** Connection ID steering.
+ *
+ * Each ET_UDP thread has its own socket in the @c SO_REUSEPORT group of a QUIC port and the kernel
+ * picks the socket by a hash of the flow. A connection whose client address changes, by NAT
+ * rebinding or migration, would then arrive on another thread. Instead, the packet handler of each
+ * thread writes its owner id, the index of its socket in the reuseport group, in the first byte of
+ * the connection IDs it issues. A classic BPF program on the reuseport group selects the socket by
+ * that byte of the destination connection ID of short header packets, and a packet which still
+ * arrives on another thread is forwarded to the owner. Long header packets carry a connection ID
+ * the client chose during the handshake and are left to the flow hash.
+ *
+ * All packets of a connection are then handled by one thread, so the connection tables are per
+ * thread and need no locks.
+ */
+namespace quic_steering
+{
+/// Owner ids are a byte of the connection ID.
+constexpr int MAX_OWNERS = 256;
+
+/// Offset of the owner id in a short header packet, the first byte of the destination connection ID.
+constexpr uint32_t OWNER_OFFSET = 1;
+
+/** Build the reuseport selection program.
+ *
+ * @param n_sockets Number of sockets in the group.
+ * @return The program, which returns @a n_sockets (out of range, so the kernel falls back to the
+ * flow hash) for long header packets and owner ids without a socket.
+ */
+std::vector<accept_steering::Insn> build_program(unsigned n_sockets);
+
+/** The packet handlers for one QUIC port, one for each ET_UDP thread.
+ *
+ * Shared by the per thread @c QUICPacketHandlerIn clones for the port.
+ */
+class Group
+{
+public:
+  struct Owner {
+    Continuation *cont   = nullptr;
+    EThread      *thread = nullptr;
+  };
+
+  /** Constructor.
+   *
+   * @param n_sockets Number of threads which will each add a socket.
+   */
+  explicit Group(int n_sockets);
+
+  /** Bind the socket for the calling thread.
+   *
+   * @param bind Function to create the socket, which calls @c add for it.
+   *
+   * The group is locked while the socket is created so that the order of the owners is the order
+   * of the sockets in the kernel reuseport group.
+   */
+  void bind(std::function<void()> const &bind);
+
+  /** Add the socket of a packet handler, only from the function passed to @c bind.
+   *
+   * @param fd The socket.
+   * @param cont The packet handler.
+   * @param thread The thread of @a cont.
+   * @return The owner id for the connection IDs the handler issues, -1 if there are too many.
+   */
+  int add(int fd, Continuation *cont, EThread *thread);
+
+  /// @return The handler which issued connection IDs with owner id @a id, @c nullptr if there is none.
+  Owner const *
+  owner(uint8_t id) const
+  {
+    return id < _count.load(std::memory_order_acquire) ? &_owners[id] : nullptr;
+  }
+
+private:
+  int                _n_sockets;
+  std::mutex         _mutex;
+  std::vector<Owner> _owners;
+  std::atomic<int>   _count{0};
+
+  void attach(int fd);
+};
+
+} // namespace quic_steering
@@ -47,6 +47,7 @@ public:
   bool       binding_valid     = false;
   int        tobedestroyed     = 0;
   int        sendGenerationNum = 0;
+  int        txtime            = 0; // SO_TXTIME: 0 not tried yet, 1 enabled, -1 unavailable
 };
 
 TS_INLINE
@@ -67,6 +67,18 @@ extern UDPNetProcessorInternal udpNetInternal;
 #define SLOT_TIME      HRTIME_MSECONDS(SLOT_TIME_MSEC)
 #define N_SLOTS        2048
 
+// proxy.config.udp.pacing
+enum {
+  UDP_PACING_NONE   = 0, // Paced packets are sent right away
+  UDP_PACING_TIMER  = 1, // Paced packets are held by the UDP thread until they are due
+  UDP_PACING_TXTIME = 2, // Paced packets are handed to the kernel early with SO_TXTIME, falls back to the timer
+};
+
+// The resolution of the pacing timer, epoll_wait() has a millisecond resolution.
+constexpr ink_hrtime UDP_PACING_GRANULARITY = HRTIME_MSECONDS(1);
+// How early a paced packet is handed to the kernel with SO_TXTIME.
+constexpr ink_hrtime UDP_TXTIME_HORIZON = HRTIME_MSECONDS(10);
+
 constexpr int UDP_PERIOD    = 9;
 constexpr int UDP_NH_PERIOD = UDP_PERIOD + 1;
 
@@ -286,15 +298,20 @@ public:
 
 class UDPQueue
 {
-  PacketQueue pipeInfo{};
-  ink_hrtime  last_report  = 0;
-  ink_hrtime  last_service = 0;
-  int         packets      = 0;
-  int         added        = 0;
+  PacketQueue      pipeInfo{};
+  Queue<UDPPacket> pacedQueue;           // Paced packets by delivery time
+  ink_hrtime       paced_retry_time = 0; // No paced packet is sent before this, set when the socket buffer was full
+  ink_hrtime       last_report      = 0;
+  ink_hrtime       last_service     = 0;
+  int              packets          = 0;
+  int              added            = 0;
 #ifdef SOL_UDP
   bool use_udp_gso = false;
 #endif
 
+  void addPacedPacket(UDPPacket *p);
+  bool isPacedPacketDue(UDPPacket *p, ink_hrtime now);
+
 public:
   // Outgoing UDP Packet Queue
   ASLL(UDPPacket, alink) outQueue;
@@ -302,9 +319,13 @@ public:
   void service(UDPNetHandler *);
 
   void SendPackets();
+  void SendPacedPackets(ink_hrtime now);
   void SendUDPPacket(UDPPacket *p);
   int  SendMultipleUDPPackets(UDPPacket **p, uint16_t n);
 
+  // When the next paced packet is due, HRTIME_FOREVER if there is none.
+  ink_hrtime next_paced_departure() const;
+
   // Interface exported to the outside world
   void send(UDPPacket *p);
 
@@ -75,7 +75,8 @@ PollCont::do_poll(ink_hrtime timeout)
     /* checking to see whether there are connections on the ready_queue (either
      * read or write) that need processing [ebalsa] */
     if (likely(!net_handler->read_ready_list.empty() || !net_handler->write_ready_list.empty() ||
-               !net_handler->read_enable_list.empty() || !net_handler->write_enable_list.empty())) {
+               !net_handler->read_enable_list.empty() || !net_handler->write_enable_list.empty() ||
+               net_handler->has_deferred_flush())) {
       NetDbg(dbg_ctl_iocore_net_poll, "rrq: %d, wrq: %d, rel: %d, wel: %d", net_handler->read_ready_list.empty(),
              net_handler->write_ready_list.empty(), net_handler->read_enable_list.empty(), net_handler->write_enable_list.empty());
       poll_timeout = 0; // poll immediately returns -- we have triggered stuff
@@ -110,11 +110,7 @@ QUICNetProcessor::start(int, size_t stacksize)
 NetAccept *
 QUICNetProcessor::createNetAccept(const NetProcessor::AcceptOptions &opt)
 {
-  if (this->_ctable == nullptr) {
-    QUICConfig::scoped_config params;
-    this->_ctable = new QUICConnectionTable(params->connection_table_size());
-  }
-  return new QUICPacketHandlerIn(opt, *this->_ctable, *this->_quiche_config);
+  return new QUICPacketHandlerIn(opt, *this->_quiche_config);
 }
 
 NetVConnection *
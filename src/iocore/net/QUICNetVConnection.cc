@@ -86,7 +86,7 @@ QUICNetVConnection::free()
   this->free_thread(this_ethread());
 }
 
-// called by ET_UDP
+// called by the closed connection collector of the packet handler, on the thread that owns _ctable
 void
 QUICNetVConnection::remove_connection_ids()
 {
@@ -623,15 +623,23 @@ QUICNetVConnection::_handle_write_ready()
         this->_stream_manager->create_stream(s);
         stream = static_cast<QUICStream *>(this->_stream_manager->find_stream(s));
       }
-      stream->send_data(this->_quiche_con);
+      this->_writable_streams.push(stream->priority_entry);
     }
     quiche_stream_iter_free(writable);
+
+    // The most urgent streams are filled first, they get the connection level flow control credit
+    while (QUICStream *stream = this->_writable_streams.top()) {
+      this->_writable_streams.remove(stream->priority_entry);
+      stream->send_data(this->_quiche_con);
+    }
   }
 
   Ptr<IOBufferBlock> udp_payload;
   quiche_send_info   send_info;
   ssize_t            res;
-  ssize_t            written = 0;
+  ssize_t            written     = 0;
+  ssize_t            batch_start = 0;
+  timespec           batch_at{};
 
   size_t quantum              = quiche_conn_send_quantum(this->_quiche_con);
   size_t max_udp_payload_size = quiche_conn_max_send_udp_payload_size(this->_quiche_con);
@@ -643,24 +651,53 @@ QUICNetVConnection::_handle_write_ready()
   while (written + max_udp_payload_size <= quantum) {
     res = quiche_conn_send(this->_quiche_con, reinterpret_cast<uint8_t *>(udp_payload->end()) + written, max_udp_payload_size,
                            &send_info);
-    if (res > 0) {
-      written += res;
+    if (res <= 0) {
+      break;
+    }
+    // quiche paces by giving packets later departure times, a GSO batch only holds packets that leave together.
+    if (written > batch_start && (send_info.at.tv_sec != batch_at.tv_sec || send_info.at.tv_nsec != batch_at.tv_nsec)) {
+      this->_send_udp_payload(udp_payload, batch_start, written - batch_start, max_udp_payload_size, batch_at);
+      batch_start = written;
     }
+    if (written == batch_start) {
+      batch_at = send_info.at;
+    }
+    written += res;
     if (static_cast<size_t>(res) != max_udp_payload_size) {
       break;
     }
   }
+  if (written > batch_start) {
+    this->_send_udp_payload(udp_payload, batch_start, written - batch_start, max_udp_payload_size, batch_at);
+  }
   if (written > 0) {
-    udp_payload->fill(written);
-    int segment_size = 0;
-    if (static_cast<size_t>(written) > max_udp_payload_size) {
-      segment_size = max_udp_payload_size;
-    }
-    this->_packet_handler->send_packet(this->_udp_con, this->con.addr, udp_payload, segment_size);
     net_activity(this, this_ethread());
   }
 }
 
+void
+QUICNetVConnection::_send_udp_payload(const Ptr<IOBufferBlock> &udp_payload, int64_t offset, int64_t len,
+                                      size_t max_udp_payload_size, const timespec &at)
+{
+  Ptr<IOBufferBlock> block = make_ptr<IOBufferBlock>(udp_payload->clone());
+  block->_start            = udp_payload->start() + offset;
+  block->_end              = block->_start + len;
+  block->_buf_end          = block->_end;
+
+  int segment_size = 0;
+  if (static_cast<size_t>(len) > max_udp_payload_size) {
+    segment_size = max_udp_payload_size;
+  }
+
+  // quiche reports departure times on CLOCK_MONOTONIC, the UDP queue schedules on ink_get_hrtime().
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  ink_hrtime delay     = ink_hrtime_from_timespec(&at) - ink_hrtime_from_timespec(&now);
+  ink_hrtime departure = delay > 0 ? ink_get_hrtime() + delay : 0;
+
+  this->_packet_handler->send_packet(this->_udp_con, this->con.addr, block, segment_size, departure);
+}
+
 void
 QUICNetVConnection::_handle_interval()
 {
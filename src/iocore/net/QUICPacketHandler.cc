@@ -30,6 +30,7 @@
 #include "P_QUICClosedConCollector.h"
 #include "P_SSLCertLookup.h"
 #include "iocore/net/quic/QUICConnectionTable.h"
+#include "iocore/net/quic/QUICEvents.h"
 #include "iocore/net/QUICMultiCertConfigLoader.h"
 #include <quiche.h>
 
@@ -41,6 +42,11 @@ static constexpr char v_debug_tag[] = "v_quic_sec";
 #define QUICDebug(fmt, ...) Debug(debug_tag, fmt, ##__VA_ARGS__)
 #define QUICPHDebug(dcid, scid, fmt, ...) \
   Debug(debug_tag, "[%08" PRIx32 "-%08" PRIx32 "] " fmt, dcid.h32(), scid.h32(), ##__VA_ARGS__)
+namespace
+{
+DbgCtl dbg_ctl_quic_steering{"quic_steering"};
+} // namespace
+
 #define QUICVPHDebug(dcid, scid, fmt, ...) \
   Debug(v_debug_tag, "[%08" PRIx32 "-%08" PRIx32 "] " fmt, dcid.h32(), scid.h32(), ##__VA_ARGS__)
 
@@ -73,9 +79,13 @@ QUICPacketHandler::close_connection(QUICNetVConnection *conn)
 }
 
 void
-QUICPacketHandler::send_packet(UDPConnection *udp_con, IpEndpoint &addr, Ptr<IOBufferBlock> udp_payload, uint16_t segment_size)
+QUICPacketHandler::send_packet(UDPConnection *udp_con, IpEndpoint &addr, Ptr<IOBufferBlock> udp_payload, uint16_t segment_size,
+                               ink_hrtime departure)
 {
-  UDPPacket *udp_packet = UDPPacket::new_UDPPacket(addr, 0, udp_payload, segment_size);
+  UDPPacket *udp_packet = UDPPacket::new_UDPPacket(addr, departure, udp_payload, segment_size);
+  if (departure) {
+    udp_packet->set_paced(true);
+  }
 
   if (is_debug_tag_set(v_debug_tag)) {
     ip_port_text_buffer ipb;
@@ -103,8 +113,13 @@ QUICPacketHandler::send_packet(UDPConnection *udp_con, IpEndpoint &addr, Ptr<IOB
   get_UDPNetHandler(static_cast<UnixUDPConnection *>(udp_con)->ethread)->signalActivity();
 }
 
-QUICPacketHandlerIn::QUICPacketHandlerIn(const NetProcessor::AcceptOptions &opt, QUICConnectionTable &ctable, quiche_config &config)
-  : NetAccept(opt), QUICPacketHandler(), _ctable(ctable), _quiche_config(config)
+QUICPacketHandlerIn::QUICPacketHandlerIn(const NetProcessor::AcceptOptions &opt, quiche_config &config,
+                                         std::shared_ptr<quic_steering::Group> steering)
+  : NetAccept(opt),
+    QUICPacketHandler(),
+    _ctable(QUICConfigParams::connection_table_size()),
+    _quiche_config(config),
+    _steering(std::move(steering))
 {
   this->mutex = new_ProxyMutex();
 }
@@ -121,8 +136,9 @@ NetAccept *
 QUICPacketHandlerIn::clone() const
 {
   NetAccept *na;
-  na  = new QUICPacketHandlerIn(opt, this->_ctable, this->_quiche_config);
-  *na = *this;
+  na = new QUICPacketHandlerIn(opt, this->_quiche_config, this->_steering);
+  // Only the NetAccept part is copied, the clone keeps its own collector and connection table.
+  static_cast<NetAccept &>(*na) = static_cast<const NetAccept &>(*this);
   return na;
 }
 
@@ -131,16 +147,26 @@ QUICPacketHandlerIn::acceptEvent(int event, void *data)
 {
   // NetVConnection *netvc;
   ink_release_assert(event == EVENT_IMMEDIATE || event == NET_EVENT_DATAGRAM_OPEN || event == NET_EVENT_DATAGRAM_READ_READY ||
-                     event == NET_EVENT_DATAGRAM_ERROR);
+                     event == NET_EVENT_DATAGRAM_ERROR || event == QUIC_EVENT_PACKET_STEERED);
   ink_release_assert((event == NET_EVENT_DATAGRAM_OPEN) ? (data != nullptr) : (1));
   ink_release_assert((event == NET_EVENT_DATAGRAM_READ_READY) ? (data != nullptr) : (1));
 
   if (event == NET_EVENT_DATAGRAM_OPEN) {
-    // Nothing to do.
+    // Called from UDPBind, with the steering group locked.
+    UDPConnection *udp_con = static_cast<UDPConnection *>(data);
+    this->_owner_id        = this->_steering->add(udp_con->getFd(), this, this_ethread());
     return EVENT_CONT;
-  } else if (event == NET_EVENT_DATAGRAM_READ_READY) {
+  } else if (event == NET_EVENT_DATAGRAM_READ_READY || event == QUIC_EVENT_PACKET_STEERED) {
     if (this->_collector_event == nullptr) {
-      this->_collector_event = this_ethread()->schedule_every(this->_closed_con_collector, HRTIME_MSECONDS(100));
+      // The collector erases connection IDs from _ctable, which has no lock. Run it on this thread, under the mutex of
+      // this handler.
+      this->_closed_con_collector->mutex = this->mutex;
+      this->_collector_event             = this_ethread()->schedule_every(this->_closed_con_collector, HRTIME_MSECONDS(100));
+    }
+
+    if (event == QUIC_EVENT_PACKET_STEERED) {
+      this->_recv_packet(event, static_cast<UDPPacket *>(static_cast<Event *>(data)->cookie));
+      return EVENT_CONT;
     }
 
     Queue<UDPPacket> *queue = static_cast<Queue<UDPPacket> *>(data);
@@ -152,7 +178,7 @@ QUICPacketHandlerIn::acceptEvent(int event, void *data)
   } else if (event == EVENT_IMMEDIATE) {
     this->setThreadAffinity(this_ethread());
     SCOPED_MUTEX_LOCK(lock, this->mutex, this_ethread());
-    udpNet.UDPBind((Continuation *)this, &this->server.accept_addr.sa, -1, 1048576, 1048576);
+    this->_steering->bind([this]() { udpNet.UDPBind((Continuation *)this, &this->server.accept_addr.sa, -1, 1048576, 1048576); });
     return EVENT_CONT;
   }
 
@@ -172,7 +198,8 @@ QUICPacketHandlerIn::init_accept(EThread *t = nullptr)
 
   SET_HANDLER(&QUICPacketHandlerIn::acceptEvent);
 
-  n = eventProcessor.thread_group[ET_UDP]._count;
+  n               = eventProcessor.thread_group[ET_UDP]._count;
+  this->_steering = std::make_shared<quic_steering::Group>(n);
   for (i = 0; i < n; i++) {
     NetAccept *a = (i < n - 1) ? clone() : this;
     EThread   *t = eventProcessor.thread_group[ET_UDP]._thread[i];
@@ -193,6 +220,10 @@ QUICPacketHandlerIn::_recv_packet(int event, UDPPacket *udp_packet)
   size_t   buf_len{0};
   uint8_t *buf = udp_packet->get_entire_chain_buffer(&buf_len);
 
+  if (event != QUIC_EVENT_PACKET_STEERED && this->_steer(udp_packet, buf, buf_len)) {
+    return;
+  }
+
   constexpr int MAX_TOKEN_LEN             = 1200;
   constexpr int DEFAULT_MAX_DATAGRAM_SIZE = 1350;
   uint8_t       type;
@@ -237,7 +268,9 @@ QUICPacketHandlerIn::_recv_packet(int event, UDPPacket *udp_packet)
     QUICConfig::scoped_config params;
     if (params->stateless_retry() && token_len == 0) {
       QUICConnectionId new_cid;
-      new_cid.randomize();
+      if (this->_owner_id >= 0) {
+        new_cid.randomize(this->_owner_id);
+      }
       QUICRetryToken retry_token = {
         udp_packet->from,
         {dcid, static_cast<uint8_t>(dcid_len)},
@@ -275,6 +308,9 @@ QUICPacketHandlerIn::_recv_packet(int event, UDPPacket *udp_packet)
     }
 
     QUICConnectionId new_cid;
+    if (this->_owner_id >= 0) {
+      new_cid.randomize(this->_owner_id);
+    }
 
     QUICCertConfig::scoped_config server_cert;
     SSL                          *ssl = SSL_new(server_cert->defaultContext());
@@ -331,6 +367,32 @@ QUICPacketHandlerIn::_recv_packet(int event, UDPPacket *udp_packet)
   return;
 }
 
+/** Forward a short header packet to the handler which issued its connection ID, if the kernel did not steer it there.
+ *
+ * @return @c true if the packet was forwarded.
+ */
+bool
+QUICPacketHandlerIn::_steer(UDPPacket *udp_packet, const uint8_t *buf, size_t buf_len)
+{
+  if (this->_owner_id < 0 || QUICConnectionId::SCID_LEN == 0 || buf_len <= quic_steering::OWNER_OFFSET ||
+      QUICInvariants::is_long_header(buf)) {
+    return false;
+  }
+
+  uint8_t id = buf[quic_steering::OWNER_OFFSET];
+  if (id == this->_owner_id) {
+    return false;
+  }
+  auto owner = this->_steering->owner(id);
+  if (owner == nullptr) {
+    return false;
+  }
+
+  Dbg(dbg_ctl_quic_steering, "forward packet for owner id %u from owner id %d", id, this->_owner_id);
+  owner->thread->schedule_imm(owner->cont, QUIC_EVENT_PACKET_STEERED, udp_packet);
+  return true;
+}
+
 void
 QUICPacketHandlerOut::init(QUICNetVConnection *vc)
 {
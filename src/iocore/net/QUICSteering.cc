@@ -0,0 +1,125 @@
+/** @file
+
+  Connection ID steering of QUIC datagrams
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_QUICSteering.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/socket.h>
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+#include "tscore/Diags.h"
+
+namespace quic_steering
+{
+namespace
+{
+  DbgCtl dbg_ctl_quic_steering{"quic_steering"};
+
+  // Classic BPF opcodes, see linux/filter.h.
+  constexpr uint16_t OP_LD_B_ABS = 0x30; // BPF_LD | BPF_B | BPF_ABS
+  constexpr uint16_t OP_JSET_K   = 0x45; // BPF_JMP | BPF_JSET | BPF_K
+  constexpr uint16_t OP_JGE_K    = 0x35; // BPF_JMP | BPF_JGE | BPF_K
+  constexpr uint16_t OP_RET_A    = 0x16; // BPF_RET | BPF_A
+  constexpr uint16_t OP_RET_K    = 0x06; // BPF_RET | BPF_K
+
+  // The header form bit of the first byte, set for long header packets.
+  constexpr uint32_t HEADER_FORM_LONG = 0x80;
+
+#if defined(__linux__)
+  static_assert(OP_LD_B_ABS == (BPF_LD | BPF_B | BPF_ABS));
+  static_assert(OP_JSET_K == (BPF_JMP | BPF_JSET | BPF_K));
+  static_assert(OP_JGE_K == (BPF_JMP | BPF_JGE | BPF_K));
+  static_assert(OP_RET_A == (BPF_RET | BPF_A));
+  static_assert(OP_RET_K == (BPF_RET | BPF_K));
+#endif
+} // namespace
+
+std::vector<accept_steering::Insn>
+build_program(unsigned n_sockets)
+{
+  // For UDP the kernel runs the program with the data starting at the UDP payload.
+  return {
+    {OP_LD_B_ABS, 0, 0, 0               },
+    {OP_JSET_K,   3, 0, HEADER_FORM_LONG},
+    {OP_LD_B_ABS, 0, 0, OWNER_OFFSET    },
+    {OP_JGE_K,    1, 0, n_sockets       },
+    {OP_RET_A,    0, 0, 0               },
+    {OP_RET_K,    0, 0, n_sockets       },
+  };
+}
+
+Group::Group(int n_sockets) : _n_sockets(n_sockets), _owners(std::min(n_sockets, MAX_OWNERS)) {}
+
+void
+Group::bind(std::function<void()> const &bind)
+{
+  std::lock_guard lock(_mutex);
+  bind();
+}
+
+int
+Group::add(int fd, Continuation *cont, EThread *thread)
+{
+  int id = _count.load(std::memory_order_relaxed);
+  if (id >= static_cast<int>(_owners.size())) {
+    Warning("more than %d UDP threads, connection ID steering is limited to the first %d", MAX_OWNERS, MAX_OWNERS);
+    return -1;
+  }
+
+  _owners[id] = {cont, thread};
+  _count.store(id + 1, std::memory_order_release);
+  Dbg(dbg_ctl_quic_steering, "socket fd %d owner id %d", fd, id);
+
+  if (id + 1 == _n_sockets) {
+    this->attach(fd);
+  }
+
+  return id;
+}
+
+void
+Group::attach(int fd)
+{
+#if defined(SO_ATTACH_REUSEPORT_CBPF)
+  auto program = build_program(_n_sockets);
+
+  sock_fprog prog;
+  prog.len    = program.size();
+  prog.filter = reinterpret_cast<sock_filter *>(program.data());
+  // The program applies to the whole reuseport group, so it only needs to be attached to one socket.
+  if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0) {
+    Warning("unable to attach connection ID steering program, packets are forwarded between threads: %s", strerror(errno));
+  } else {
+    Dbg(dbg_ctl_quic_steering, "attached steering program for %d sockets", _n_sockets);
+  }
+#else
+  (void)fd;
+#endif
+}
+
+} // namespace quic_steering
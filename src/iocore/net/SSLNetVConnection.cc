@@ -92,6 +92,9 @@ DbgCtl dbg_ctl_ssl_alpn{"ssl_alpn"};
 DbgCtl dbg_ctl_ssl_origin_session_cache{"ssl.origin_session_cache"};
 DbgCtl dbg_ctl_proxyprotocol{"proxyprotocol"};
 
+/// Staging area for TLS records assembled from several buffer blocks.
+thread_local char ssl_coalesce_buffer[SSL_MAX_TLS_RECORD_SIZE];
+
 /// Callback to get two locks.
 /// The lock for this continuation, and for the target continuation.
 class ContWrapper : public Continuation
@@ -849,12 +852,32 @@ SSLNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &buf
           l = dynamic_tls_record_size;
         }
       }
+
+      // A short block, such as the header of an HTTP/2 DATA frame whose payload is a reference to
+      // another block, is coalesced with the blocks after it so it does not become a small record.
+      // Larger blocks are written as they are, without the copy.
+      if (l < SSL_DEF_TLS_RECORD_SIZE && l < wavail) {
+        int64_t record_size = SSL_MAX_TLS_RECORD_SIZE;
+        if (dynamic_tls_record_size) {
+          record_size = dynamic_tls_record_size;
+        } else if (SSLConfigParams::ssl_maxrecord > 0 && SSLConfigParams::ssl_maxrecord < record_size) {
+          record_size = SSLConfigParams::ssl_maxrecord;
+        }
+        l = std::min(wavail, record_size);
+      }
     }
 
     if (!l) {
       break;
     }
 
+    // A retry after SSL_ERROR_WANT_WRITE coalesces the same bytes again, into the same buffer.
+    if (l > buf.reader()->block_read_avail()) {
+      buf.reader()->memcpy(ssl_coalesce_buffer, l);
+      current_block = ssl_coalesce_buffer;
+      Metrics::Counter::increment(ssl_rsb.total_coalesced_tls_record_count);
+    }
+
     try_to_write       = l;
     num_really_written = 0;
     Dbg(dbg_ctl_v_ssl, "b=%p l=%" PRId64, current_block, l);
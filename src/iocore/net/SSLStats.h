@@ -65,6 +65,7 @@ struct SSLStatsBlock {
   Metrics::Counter::AtomicType *sni_name_set_failure               = nullptr;
   Metrics::Counter::AtomicType *total_attempts_handshake_count_in  = nullptr;
   Metrics::Counter::AtomicType *total_attempts_handshake_count_out = nullptr;
+  Metrics::Counter::AtomicType *total_coalesced_tls_record_count   = nullptr;
   Metrics::Counter::AtomicType *total_dyn_def_tls_record_count     = nullptr;
   Metrics::Counter::AtomicType *total_dyn_max_tls_record_count     = nullptr;
   Metrics::Counter::AtomicType *total_dyn_redo_tls_record_count    = nullptr;
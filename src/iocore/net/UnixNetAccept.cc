@@ -112,6 +112,7 @@ net_accept(NetAccept *na, void *ep, bool blockable)
       goto Ldone;
     }
     Metrics::Counter::increment(net_rsb.tcp_accept);
+    na->count_thread_accept(con.fd);
 
     std::shared_ptr<ConnectionTracker::Group> conn_track_group;
     if (!handle_max_client_connections(con.addr, conn_track_group)) {
@@ -256,10 +257,14 @@ NetAccept::accept_per_thread(int event, void *ep)
   REC_ReadConfigInteger(listen_per_thread, "proxy.config.exec_thread.listen");
 
   if (listen_per_thread == 1) {
-    if (do_listen(NON_BLOCKING)) {
+    int res = steering ? steering->add([this]() { return do_listen(NON_BLOCKING); }, server.fd) : do_listen(NON_BLOCKING);
+    if (res) {
       Fatal("[NetAccept::accept_per_thread]:error listenting on ports");
       return -1;
     }
+    if (steering) {
+      thread_cpus = accept_steering::thread_cpus();
+    }
   }
 
   if (accept_fn == net_accept) {
@@ -293,10 +298,20 @@ NetAccept::init_accept_per_thread()
   SET_HANDLER(&NetAccept::accept_per_thread);
   n = eventProcessor.thread_group[ET_NET]._count;
 
+  if (auto mode = accept_steering::configured_mode(); mode != accept_steering::Mode::NONE) {
+    steering = std::make_shared<accept_steering::Group>(mode, n);
+  }
+
   for (i = 0; i < n; i++) {
     NetAccept *a = (i < n - 1) ? clone() : this;
     EThread   *t = eventProcessor.thread_group[ET_NET]._thread[i];
     a->mutex     = get_NetHandler(t)->mutex;
+
+    // Shared by all ports, these are created by the first port.
+    std::string name = "proxy.process.net.thread_" + std::to_string(i);
+    a->thread_accepts            = Metrics::Counter::createPtr(name + ".accepts");
+    a->thread_accepts_remote_cpu = Metrics::Counter::createPtr(name + ".accepts_remote_cpu");
+
     t->schedule_imm(a);
   }
 }
@@ -512,6 +527,7 @@ NetAccept::acceptFastEvent(int event, void *ep)
       }
       Dbg(dbg_ctl_iocore_net, "accepted a new socket: %d", fd);
       Metrics::Counter::increment(net_rsb.tcp_accept);
+      count_thread_accept(fd);
       if (opt.send_bufsize > 0) {
         if (unlikely(SocketManager::set_sndbuf_size(fd, opt.send_bufsize))) {
           bufsz = ROUNDUP(opt.send_bufsize, 1024);
@@ -650,6 +666,18 @@ NetAccept::cancel()
   server.close();
 }
 
+void
+NetAccept::count_thread_accept(int fd)
+{
+  if (thread_accepts) {
+    Metrics::Counter::increment(thread_accepts);
+    // Only with steering, which gives this thread its own socket selected by CPU. This costs a getsockopt.
+    if (!thread_cpus.empty() && accept_steering::is_remote_cpu(fd, thread_cpus)) {
+      Metrics::Counter::increment(thread_accepts_remote_cpu);
+    }
+  }
+}
+
 NetAccept *
 NetAccept::clone() const
 {
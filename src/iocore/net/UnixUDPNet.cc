@@ -46,6 +46,8 @@
 #include <netinet/udp.h>
 #include "P_UnixNet.h"
 
+#include <algorithm>
+
 #ifndef UDP_SEGMENT
 // This is needed because old glibc may not have the constant even if Kernel supports it.
 #define UDP_SEGMENT 103
@@ -55,6 +57,10 @@
 #define UDP_GRO 104
 #endif
 
+#ifdef SO_TXTIME
+#include <linux/net_tstamp.h>
+#endif
+
 using UDPNetContHandler = int (UDPNetHandler::*)(int, void *);
 
 ClassAllocator<UDPPacket> udpPacketAllocator("udpPacketAllocator");
@@ -71,6 +77,48 @@ DbgCtl dbg_ctl_udp_read{"udp-read"};
 DbgCtl dbg_ctl_udp_send{"udp-send"};
 DbgCtl dbg_ctl_iocore_udp_main{"iocore_udp_main-send"};
 
+union udp_cmsg_buf {
+  char           buf[CMSG_SPACE(sizeof(uint16_t)) + CMSG_SPACE(sizeof(uint64_t))];
+  struct cmsghdr align;
+};
+
+// Set the control messages of @a msg, the GSO segment size unless @a segment_size is 0 and the SO_TXTIME departure time unless
+// @a txtime is 0. @a u must live until the message is sent.
+void
+set_udp_cmsgs(struct msghdr *msg, udp_cmsg_buf *u, uint16_t segment_size, uint64_t txtime)
+{
+  memset(u, 0, sizeof(*u));
+  msg->msg_control    = u->buf;
+  msg->msg_controllen = sizeof(u->buf);
+
+  struct cmsghdr *cm   = CMSG_FIRSTHDR(msg);
+  size_t          used = 0;
+#ifdef SOL_UDP
+  if (segment_size > 0) {
+    cm->cmsg_level = SOL_UDP;
+    cm->cmsg_type  = UDP_SEGMENT;
+    cm->cmsg_len   = CMSG_LEN(sizeof(uint16_t));
+    memcpy(CMSG_DATA(cm), &segment_size, sizeof(uint16_t));
+    used += CMSG_SPACE(sizeof(uint16_t));
+    cm    = CMSG_NXTHDR(msg, cm);
+  }
+#endif
+#ifdef SO_TXTIME
+  if (txtime > 0) {
+    cm->cmsg_level = SOL_SOCKET;
+    cm->cmsg_type  = SCM_TXTIME;
+    cm->cmsg_len   = CMSG_LEN(sizeof(uint64_t));
+    memcpy(CMSG_DATA(cm), &txtime, sizeof(uint64_t));
+    used += CMSG_SPACE(sizeof(uint64_t));
+  }
+#endif
+
+  msg->msg_controllen = used;
+  if (used == 0) {
+    msg->msg_control = nullptr;
+  }
+}
+
 } // end anonymous namespace
 
 UDPPacket *
@@ -87,6 +135,7 @@ UDPPacket::new_UDPPacket(struct sockaddr const *to, ink_hrtime when, Ptr<IOBuffe
   p->p.in_the_priority_queue = 0;
   p->p.in_heap               = 0;
   p->p.delivery_time         = when;
+  p->p.paced                 = false;
   if (to)
     ats_ip_copy(&p->to, to);
   p->p.chain        = buf;
@@ -102,6 +151,7 @@ UDPPacket::new_incoming_UDPPacket(struct sockaddr *from, struct sockaddr *to, Pt
   p->p.in_the_priority_queue = 0;
   p->p.in_heap               = 0;
   p->p.delivery_time         = 0;
+  p->p.paced                 = false;
   ats_ip_copy(&p->from, from);
   ats_ip_copy(&p->to, to);
   p->p.chain = block;
@@ -202,6 +252,7 @@ int     g_udp_pollTimeout;
 int32_t g_udp_periodicCleanupSlots;
 int32_t g_udp_periodicFreeCancelledPkts;
 int32_t g_udp_numSendRetries;
+int32_t g_udp_pacing;
 
 namespace
 {
@@ -262,6 +313,15 @@ initialize_thread_for_udp_net(EThread *thread)
   REC_ReadConfigInt32(g_udp_numSendRetries, "proxy.config.udp.send_retries");
   g_udp_numSendRetries = g_udp_numSendRetries < 0 ? 0 : g_udp_numSendRetries;
 
+  // How packets that carry a pacing deadline, like QUIC packets, are held until they are due.
+  REC_ReadConfigInt32(g_udp_pacing, "proxy.config.udp.pacing");
+#ifndef SO_TXTIME
+  if (g_udp_pacing == UDP_PACING_TXTIME) {
+    Warning("Attempted to use SO_TXTIME for UDP pacing per configuration, but it is unavailable");
+    g_udp_pacing = UDP_PACING_TIMER;
+  }
+#endif
+
   thread->set_tail_handler(nh);
 #if HAVE_EVENTFD
 #if TS_USE_LINUX_IO_URING
@@ -1312,6 +1372,14 @@ UDPQueue::service(UDPNetHandler *nh)
     ink_assert(p->link.next == nullptr);
     // insert into our queue.
     Dbg(dbg_ctl_udp_send, "Adding %p", p);
+    if (p->p.paced) {
+      if (g_udp_pacing != UDP_PACING_NONE) {
+        addPacedPacket(p);
+        continue;
+      }
+      p->p.paced         = false;
+      p->p.delivery_time = 0;
+    }
     if (p->p.conn->lastPktStartTime == 0) {
       pktSendStartTime = std::max(now, p->p.delivery_time);
     } else {
@@ -1326,6 +1394,7 @@ UDPQueue::service(UDPNetHandler *nh)
 
   pipeInfo.advanceNow(now);
   SendPackets();
+  SendPacedPackets(ink_get_hrtime());
 
   timeSpent = ink_hrtime_to_msec(now - last_report);
   if (timeSpent > 10000) {
@@ -1407,6 +1476,115 @@ sendPackets:
   }
 }
 
+void
+UDPQueue::addPacedPacket(UDPPacket *p)
+{
+  // Packets mostly arrive in departure order, look for the place from the tail.
+  UDPPacket *after = pacedQueue.tail;
+  while (after && after->p.delivery_time > p->p.delivery_time) {
+    after = after->link.prev;
+  }
+  if (after) {
+    pacedQueue.insert(p, after);
+  } else {
+    pacedQueue.push(p);
+  }
+}
+
+bool
+UDPQueue::isPacedPacketDue(UDPPacket *p, ink_hrtime now)
+{
+  if (p->p.delivery_time <= now) {
+    return true;
+  }
+  if (g_udp_pacing != UDP_PACING_TXTIME || p->p.delivery_time > now + UDP_TXTIME_HORIZON) {
+    return false;
+  }
+
+#ifdef SO_TXTIME
+  UDPConnectionInternal *conn = static_cast<UDPConnectionInternal *>(p->p.conn);
+  if (conn->txtime == 0) {
+    // The departure time is honored by the fq or etf qdisc on the interface.
+    struct sock_txtime cfg = {CLOCK_MONOTONIC, 0};
+    if (setsockopt(conn->fd, SOL_SOCKET, SO_TXTIME, &cfg, sizeof(cfg)) == 0) {
+      conn->txtime = 1;
+    } else {
+      Dbg(dbg_ctl_udpnet, "SO_TXTIME is unavailable on fd %d, pacing with the timer: %s", conn->fd, strerror(errno));
+      conn->txtime = -1;
+    }
+  }
+  return conn->txtime > 0;
+#else
+  return false;
+#endif
+}
+
+void
+UDPQueue::SendPacedPackets(ink_hrtime now)
+{
+#ifdef UIO_MAXIOV
+  constexpr int N_MAX_PACKETS = UIO_MAXIOV; // The limit comes from sendmmsg
+#else
+  constexpr int N_MAX_PACKETS = 1024;
+#endif
+  UDPPacket *packets[N_MAX_PACKETS];
+  int        npackets = 0;
+  bool       blocked  = now < paced_retry_time; // backing off after the socket buffer was full
+  UDPPacket *p;
+
+  // The queue is in departure order, the packets of a batch are sent with a single sendmmsg() on one socket.
+  auto flush = [&]() {
+    if (npackets > 0) {
+      int nsent = SendMultipleUDPPackets(packets, npackets);
+      if (nsent < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOBUFS) {
+          for (int i = 0; i < npackets; ++i) {
+            Dbg(dbg_ctl_udp_send, "Dropping paced packet %p", packets[i]);
+            Metrics::Counter::increment(net_rsb.udp_paced_packets_dropped);
+            packets[i]->free();
+          }
+          npackets = 0;
+          return;
+        }
+        nsent = 0;
+      }
+      for (int i = 0; i < nsent; ++i) {
+        packets[i]->free();
+      }
+      if (nsent < npackets) {
+        // The socket buffer is full, put the unsent packets back in front of the queue in order and retry after a
+        // pacing interval instead of polling the socket again at once.
+        Dbg(dbg_ctl_udp_send, "Deferring %d paced packets", npackets - nsent);
+        for (int i = npackets - 1; i >= nsent; --i) {
+          pacedQueue.push(packets[i]);
+        }
+        blocked          = true;
+        paced_retry_time = now + UDP_PACING_GRANULARITY;
+      }
+      npackets = 0;
+    }
+  };
+
+  while (!blocked && (p = pacedQueue.head) && isPacedPacketDue(p, now)) {
+    pacedQueue.remove(p);
+    if (p->p.conn->shouldDestroy() || p->p.conn->GetSendGenerationNumber() != p->p.reqGenerationNum) {
+      p->free();
+      continue;
+    }
+    if (npackets == N_MAX_PACKETS || (npackets > 0 && packets[0]->p.conn->getFd() != p->p.conn->getFd())) {
+      flush();
+    }
+    packets[npackets++] = p;
+  }
+  flush();
+}
+
+ink_hrtime
+UDPQueue::next_paced_departure() const
+{
+  return pacedQueue.head ? std::max(pacedQueue.head->p.delivery_time, paced_retry_time) : HRTIME_FOREVER;
+}
+
 void
 UDPQueue::SendUDPPacket(UDPPacket *p)
 {
@@ -1432,18 +1610,8 @@ UDPQueue::SendUDPPacket(UDPPacket *p)
       iov[0].iov_base = p->p.chain.get()->start();
       iov[0].iov_len  = p->p.chain.get()->size();
 
-      union udp_segment_hdr {
-        char           buf[CMSG_SPACE(sizeof(uint16_t))];
-        struct cmsghdr align;
-      } u;
-      msg.msg_control    = u.buf;
-      msg.msg_controllen = sizeof(u.buf);
-
-      struct cmsghdr *cm           = CMSG_FIRSTHDR(&msg);
-      cm->cmsg_level               = SOL_UDP;
-      cm->cmsg_type                = UDP_SEGMENT;
-      cm->cmsg_len                 = CMSG_LEN(sizeof(uint16_t));
-      *((uint16_t *)CMSG_DATA(cm)) = p->p.segment_size;
+      udp_cmsg_buf u;
+      set_udp_cmsgs(&msg, &u, p->p.segment_size, 0);
 
       count = 0;
       while (true) {
@@ -1555,10 +1723,6 @@ UDPQueue::SendMultipleUDPPackets(UDPPacket **p, uint16_t n)
   int             msgvec_size;
 
 #ifdef SOL_UDP
-  union udp_segment_hdr {
-    char           buf[CMSG_SPACE(sizeof(uint16_t))];
-    struct cmsghdr align;
-  };
   if (use_udp_gso) {
     msgvec_size = sizeof(struct mmsghdr) * n;
   } else {
@@ -1581,6 +1745,11 @@ UDPQueue::SendMultipleUDPPackets(UDPPacket **p, uint16_t n)
   memset(iovec, 0, iovec_size);
   int iovec_used = 0;
 
+  // SO_TXTIME departure times are on CLOCK_MONOTONIC.
+  ink_hrtime now = ink_get_hrtime();
+  timespec   mono_now;
+  clock_gettime(CLOCK_MONOTONIC, &mono_now);
+
   int vlen = 0;
   int fd   = p[0]->p.conn->getFd();
   for (int i = 0; i < n; ++i) {
@@ -1588,10 +1757,14 @@ UDPQueue::SendMultipleUDPPackets(UDPPacket **p, uint16_t n)
     struct msghdr *msg;
     struct iovec  *iov;
     int            iov_len;
+    uint64_t       txtime = 0;
 
     packet                               = p[i];
     packet->p.conn->lastSentPktStartTime = packet->p.delivery_time;
     ink_assert(packet->p.conn->getFd() == fd);
+    if (packet->p.paced && static_cast<UDPConnectionInternal *>(packet->p.conn)->txtime > 0 && packet->p.delivery_time > now) {
+      txtime = ink_hrtime_from_timespec(&mono_now) + (packet->p.delivery_time - now);
+    }
     if (packet->p.segment_size > 0) {
       // Presumes one big super buffer is given
       ink_assert(packet->p.chain->next == nullptr);
@@ -1601,22 +1774,14 @@ UDPQueue::SendMultipleUDPPackets(UDPPacket **p, uint16_t n)
         msg->msg_name    = reinterpret_cast<caddr_t>(&packet->to.sa);
         msg->msg_namelen = ats_ip_size(packet->to);
 
-        union udp_segment_hdr *u;
-        u                   = static_cast<union udp_segment_hdr *>(alloca(sizeof(union udp_segment_hdr)));
-        msg->msg_control    = u->buf;
-        msg->msg_controllen = sizeof(u->buf);
-        iov                 = &iovec[iovec_used++];
-        iov_len             = 1;
-        iov->iov_base       = packet->p.chain.get()->start();
-        iov->iov_len        = packet->p.chain.get()->size();
-        msg->msg_iov        = iov;
-        msg->msg_iovlen     = iov_len;
-
-        struct cmsghdr *cm           = CMSG_FIRSTHDR(msg);
-        cm->cmsg_level               = SOL_UDP;
-        cm->cmsg_type                = UDP_SEGMENT;
-        cm->cmsg_len                 = CMSG_LEN(sizeof(uint16_t));
-        *((uint16_t *)CMSG_DATA(cm)) = packet->p.segment_size;
+        iov             = &iovec[iovec_used++];
+        iov_len         = 1;
+        iov->iov_base   = packet->p.chain.get()->start();
+        iov->iov_len    = packet->p.chain.get()->size();
+        msg->msg_iov    = iov;
+        msg->msg_iovlen = iov_len;
+
+        set_udp_cmsgs(msg, static_cast<udp_cmsg_buf *>(alloca(sizeof(udp_cmsg_buf))), packet->p.segment_size, txtime);
         vlen++;
       } else {
 #endif
@@ -1635,6 +1800,9 @@ UDPQueue::SendMultipleUDPPackets(UDPPacket **p, uint16_t n)
           msg->msg_iov      = iov;
           msg->msg_iovlen   = iov_len;
           offset           += iov->iov_len;
+          if (txtime) {
+            set_udp_cmsgs(msg, static_cast<udp_cmsg_buf *>(alloca(sizeof(udp_cmsg_buf))), 0, txtime);
+          }
           vlen++;
         }
         ink_assert(offset == packet->p.chain.get()->size());
@@ -1655,6 +1823,9 @@ UDPQueue::SendMultipleUDPPackets(UDPPacket **p, uint16_t n)
       }
       msg->msg_iov    = iov;
       msg->msg_iovlen = iov_len;
+      if (txtime) {
+        set_udp_cmsgs(msg, static_cast<udp_cmsg_buf *>(alloca(sizeof(udp_cmsg_buf))), 0, txtime);
+      }
       vlen++;
     }
   }
@@ -1672,11 +1843,15 @@ UDPQueue::SendMultipleUDPPackets(UDPPacket **p, uint16_t n)
       use_udp_gso = false;
       return SendMultipleUDPPackets(p, n);
     } else {
-      Dbg(dbg_ctl_udp_send, "udp_gso=%d res=%d errno=%d", use_udp_gso, res, errno);
+      int err = errno;
+      Dbg(dbg_ctl_udp_send, "udp_gso=%d res=%d errno=%d", use_udp_gso, res, err);
+      errno = err;
       return res;
     }
 #else
-    Dbg(dbg_ctl_udp_send, "res=%d errno=%d", res, errno);
+    int err = errno;
+    Dbg(dbg_ctl_udp_send, "res=%d errno=%d", res, err);
+    errno = err;
     return res;
 #endif
   }
@@ -1757,6 +1932,15 @@ UDPNetHandler::waitForActivity(ink_hrtime timeout)
 {
   UnixUDPConnection *uc;
   PollCont          *pc = get_UDPPollCont(this->thread);
+
+  // Wake up in time for the next paced packet.
+  if (ink_hrtime departure = udpOutQueue.next_paced_departure(); departure != HRTIME_FOREVER) {
+    // Round up, a paced packet must not leave before its departure time.
+    ink_hrtime wait  = departure - ink_get_hrtime() + UDP_PACING_GRANULARITY - 1;
+    pc->poll_timeout = std::clamp<ink_hrtime>(wait / UDP_PACING_GRANULARITY, 0, g_udp_pollTimeout);
+  } else {
+    pc->poll_timeout = g_udp_pollTimeout;
+  }
   pc->do_poll(timeout);
 
   /* Notice: the race between traversal of newconn_list and UDPBind()
@@ -31,19 +31,18 @@ QUICConnectionTable::~QUICConnectionTable()
 QUICConnection *
 QUICConnectionTable::insert(QUICConnectionId cid, QUICConnection *connection)
 {
-  Ptr<ProxyMutex> m = _connections.lock_for_key(cid);
-  SCOPED_MUTEX_LOCK(lock, m, this_ethread());
   // To check whether the return value is nullptr by caller in case memory leak.
   // The return value isn't nullptr, the new value will take up the slot and return old value.
-  return _connections.insert_entry(cid, connection);
+  QUICConnection *&slot = _connections[cid];
+  QUICConnection  *old  = slot;
+  slot                  = connection;
+  return old;
 }
 
 void
 QUICConnectionTable::erase(QUICConnectionId cid, QUICConnection *connection)
 {
-  Ptr<ProxyMutex> m = _connections.lock_for_key(cid);
-  SCOPED_MUTEX_LOCK(lock, m, this_ethread());
-  QUICConnection *ret_connection = _connections.remove_entry(cid);
+  QUICConnection *ret_connection = this->erase(cid);
   if (ret_connection) {
     ink_assert(ret_connection == connection);
   }
@@ -52,15 +51,18 @@ QUICConnectionTable::erase(QUICConnectionId cid, QUICConnection *connection)
 QUICConnection *
 QUICConnectionTable::erase(QUICConnectionId cid)
 {
-  Ptr<ProxyMutex> m = _connections.lock_for_key(cid);
-  SCOPED_MUTEX_LOCK(lock, m, this_ethread());
-  return _connections.remove_entry(cid);
+  auto it = _connections.find(cid);
+  if (it == _connections.end()) {
+    return nullptr;
+  }
+  QUICConnection *connection = it->second;
+  _connections.erase(it);
+  return connection;
 }
 
 QUICConnection *
 QUICConnectionTable::lookup(QUICConnectionId cid)
 {
-  Ptr<ProxyMutex> m = _connections.lock_for_key(cid);
-  SCOPED_MUTEX_LOCK(lock, m, this_ethread());
-  return _connections.lookup_entry(cid);
+  auto it = _connections.find(cid);
+  return it == _connections.end() ? nullptr : it->second;
 }
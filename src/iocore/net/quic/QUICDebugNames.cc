@@ -174,6 +174,8 @@ QUICDebugNames::quic_event(int event)
     return "QUIC_EVENT_LD_SHUTDOWN";
   case QUIC_EVENT_ACK_PERIODIC:
     return "QUIC_EVENT_ACK_PERIODIC";
+  case QUIC_EVENT_PACKET_STEERED:
+    return "QUIC_EVENT_PACKET_STEERED";
   default:
     return "UNKNOWN";
   }
@@ -109,12 +109,33 @@ QUICStream::receive_data(quiche_conn *quiche_con)
   this->_adapter->encourge_read();
 }
 
+void
+QUICStream::set_priority(const ExtensiblePriority &priority)
+{
+  if (priority != this->priority_entry.priority()) {
+    this->priority_entry.set_priority(priority);
+    this->_priority_changed = true;
+  }
+}
+
+const ExtensiblePriority &
+QUICStream::priority() const
+{
+  return this->priority_entry.priority();
+}
+
 void
 QUICStream::send_data(quiche_conn *quiche_con)
 {
   bool    fin = false;
   ssize_t len = 0;
 
+  if (this->_priority_changed) {
+    const ExtensiblePriority &priority = this->priority();
+    quiche_conn_stream_priority(quiche_con, this->_id, priority.urgency, priority.incremental);
+    this->_priority_changed = false;
+  }
+
   len = quiche_conn_stream_capacity(quiche_con, this->_id);
   if (len <= 0) {
     return;
@@ -0,0 +1,96 @@
+/** @file
+
+  Catch based unit tests for accept steering
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "catch.hpp"
+
+#include "../P_AcceptSteering.h"
+
+using namespace accept_steering;
+
+namespace
+{
+// Run the steering program for a packet received on @a cpu. Only the instructions the program uses are supported.
+uint32_t
+run(std::vector<Insn> const &program, uint32_t cpu)
+{
+  uint32_t a = 0;
+  for (size_t pc = 0; pc < program.size(); ++pc) {
+    auto const &insn = program[pc];
+    switch (insn.code) {
+    case 0x20: // ld cpu
+      REQUIRE(insn.k == static_cast<uint32_t>(-0x1000 + 36));
+      a = cpu;
+      break;
+    case 0x15: // jeq #k
+      pc += (a == insn.k) ? insn.jt : insn.jf;
+      break;
+    case 0x06: // ret #k
+      return insn.k;
+    default:
+      FAIL("unexpected instruction " << insn.code);
+    }
+  }
+  FAIL("program did not return");
+  return 0;
+}
+} // namespace
+
+TEST_CASE("Accept steering CPU assignment", "[net][steering]")
+{
+  SECTION("one thread per CPU")
+  {
+    auto map = assign_cpus({{2}, {0}, {1}, {3}});
+    REQUIRE(map == std::vector<int>{1, 2, 0, 3});
+  }
+
+  SECTION("threads per NUMA node")
+  {
+    // Two nodes of four CPUs, two threads on each node.
+    auto map = assign_cpus({
+      {0, 1, 2, 3},
+      {4, 5, 6, 7},
+      {0, 1, 2, 3},
+      {4, 5, 6, 7}
+    });
+    REQUIRE(map == std::vector<int>{0, 2, 0, 2, 1, 3, 1, 3});
+  }
+
+  SECTION("CPUs without a thread")
+  {
+    auto map = assign_cpus({{1}, {3}});
+    REQUIRE(map == std::vector<int>{-1, 0, -1, 1});
+  }
+}
+
+TEST_CASE("Accept steering program", "[net][steering]")
+{
+  std::vector<int> map = {1, 2, -1, 0};
+  auto             program = build_program(map, 3);
+
+  REQUIRE(run(program, 0) == 1);
+  REQUIRE(run(program, 1) == 2);
+  REQUIRE(run(program, 3) == 0);
+  // No socket for the CPU, out of range so the kernel uses the flow hash.
+  REQUIRE(run(program, 2) == 3);
+  REQUIRE(run(program, 17) == 3);
+}
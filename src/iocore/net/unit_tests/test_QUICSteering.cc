@@ -0,0 +1,95 @@
+/** @file
+
+  Unit tests for QUIC connection ID steering
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "catch.hpp"
+
+#include "../P_QUICSteering.h"
+
+using namespace quic_steering;
+
+namespace
+{
+// Run the steering program for a UDP payload. Only the instructions the program uses are supported.
+uint32_t
+run(std::vector<accept_steering::Insn> const &program, std::vector<uint8_t> const &payload)
+{
+  uint32_t a = 0;
+  for (size_t pc = 0; pc < program.size(); ++pc) {
+    auto const &insn = program[pc];
+    switch (insn.code) {
+    case 0x30: // ldb [k]
+      if (insn.k >= payload.size()) {
+        return 0; // The kernel aborts the program.
+      }
+      a = payload[insn.k];
+      break;
+    case 0x45: // jset #k
+      pc += (a & insn.k) ? insn.jt : insn.jf;
+      break;
+    case 0x35: // jge #k
+      pc += (a >= insn.k) ? insn.jt : insn.jf;
+      break;
+    case 0x16: // ret a
+      return a;
+    case 0x06: // ret #k
+      return insn.k;
+    default:
+      FAIL("unexpected instruction " << insn.code);
+    }
+  }
+  FAIL("program did not return");
+  return 0;
+}
+} // namespace
+
+TEST_CASE("QUIC steering program", "[net][steering]")
+{
+  auto program = build_program(4);
+
+  // Short header, the first byte of the destination connection ID is the owner.
+  REQUIRE(run(program, {0x40, 0, 0x11, 0x22}) == 0);
+  REQUIRE(run(program, {0x41, 3, 0x11, 0x22}) == 3);
+  // Owner ids without a socket and long header packets use the flow hash.
+  REQUIRE(run(program, {0x40, 4, 0x11, 0x22}) == 4);
+  REQUIRE(run(program, {0x40, 200, 0x11, 0x22}) == 4);
+  REQUIRE(run(program, {0xc0, 0, 0, 0, 1, 8, 2}) == 4);
+  REQUIRE(run(program, {0xc3, 0, 0, 0, 1, 8, 1}) == 4);
+}
+
+TEST_CASE("QUIC steering owners", "[net][steering]")
+{
+  Group group(2);
+  int   ids[3];
+
+  REQUIRE(group.owner(0) == nullptr);
+  group.bind([&]() { ids[0] = group.add(-1, nullptr, nullptr); });
+  group.bind([&]() { ids[1] = group.add(-1, nullptr, nullptr); });
+  group.bind([&]() { ids[2] = group.add(-1, nullptr, nullptr); });
+
+  REQUIRE(ids[0] == 0);
+  REQUIRE(ids[1] == 1);
+  REQUIRE(ids[2] == -1);
+  REQUIRE(group.owner(0) != nullptr);
+  REQUIRE(group.owner(1) != nullptr);
+  REQUIRE(group.owner(2) == nullptr);
+}
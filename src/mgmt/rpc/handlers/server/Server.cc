@@ -21,6 +21,7 @@
 #include "mgmt/rpc/handlers/server/Server.h"
 
 #include "../../../../iocore/cache/P_Cache.h"
+#include "iocore/eventsystem/LockProfiler.h"
 #include <tscore/TSSystemState.h>
 #include "mgmt/rpc/handlers/common/ErrorUtils.h"
 #include "mgmt/rpc/handlers/common/Utils.h"
@@ -30,6 +31,7 @@ namespace rpc::handlers::server
 namespace field_names
 {
   static constexpr auto NEW_CONNECTIONS{"no_new_connections"};
+  static constexpr auto RESET{"reset"};
 } // namespace field_names
 
 struct DrainInfo {
@@ -115,6 +117,43 @@ server_stop_drain(std::string_view const &id, [[maybe_unused]] YAML::Node const
   return resp;
 }
 
+swoc::Rv<YAML::Node>
+server_get_lock_profile(std::string_view const &id, YAML::Node const &params)
+{
+  namespace field = field_names;
+  swoc::Rv<YAML::Node> resp;
+
+  auto sites = LockProfiler::collect();
+  // Most contended first.
+  std::sort(sites.begin(), sites.end(), [](auto const &lhs, auto const &rhs) {
+    return lhs.misses + lhs.blocks != rhs.misses + rhs.blocks ? lhs.misses + lhs.blocks > rhs.misses + rhs.blocks :
+                                                                lhs.acquires > rhs.acquires;
+  });
+
+  YAML::Node list{YAML::NodeType::Sequence};
+  for (auto const &site : sites) {
+    char       buf[256];
+    YAML::Node n;
+    n["location"]         = site.location.valid() ? site.location.str(buf, sizeof(buf)) : "(other)";
+    n["acquires"]         = site.acquires;
+    n["misses"]           = site.misses;
+    n["blocks"]           = site.blocks;
+    n["wait_time_ns"]     = site.wait_time;
+    n["holds"]            = site.holds;
+    n["hold_time_ns"]     = site.hold_time;
+    n["max_hold_time_ns"] = site.max_hold_time;
+    list.push_back(std::move(n));
+  }
+  resp.result()["enabled"]       = LockProfiler::is_enabled() ? "true" : "false";
+  resp.result()["sample_period"] = LockProfiler::sample_period.load();
+  resp.result()["sites"]         = list;
+
+  if (params.IsMap() && utils::is_true_flag(params[field::RESET])) {
+    LockProfiler::reset();
+  }
+  return resp;
+}
+
 void
 server_shutdown(YAML::Node const &)
 {
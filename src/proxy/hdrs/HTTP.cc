@@ -2330,6 +2330,50 @@ HTTPInfo::unmarshal_v24_1(char *buf, int len, RefCountObj *block_ref)
   return alt->m_unmarshal_len;
 }
 
+// int HTTPInfo::unmarshal_length(char* buf, int len)
+//
+//    Returns the length of the alternate at @a buf, which is what
+//     unmarshal() would return, without unmarshalling it. This
+//     lets the cache walk a vector of alternates and unmarshal only
+//     the ones it uses. Returns -1 if the alternate is not sane.
+//
+int
+HTTPInfo::unmarshal_length(char *buf, int len)
+{
+  HTTPCacheAlt *alt = reinterpret_cast<HTTPCacheAlt *>(buf);
+
+  if (len < HTTP_ALT_MARSHAL_SIZE) {
+    return -1;
+  }
+  if (alt->m_magic == CACHE_ALT_MAGIC_ALIVE) {
+    return (alt->m_unmarshal_len > 0 && alt->m_unmarshal_len <= len) ? alt->m_unmarshal_len : -1;
+  } else if (alt->m_magic != CACHE_ALT_MAGIC_MARSHALED || alt->m_frag_offset_count < 0) {
+    return -1;
+  }
+
+  int used = HTTP_ALT_MARSHAL_SIZE;
+  if (alt->m_frag_offset_count > HTTPCacheAlt::N_INTEGRAL_FRAG_OFFSETS) {
+    used += sizeof(FragOffset) * alt->m_frag_offset_count;
+  }
+
+  for (HTTPHdr *hdr : {&alt->m_request_hdr, &alt->m_response_hdr}) {
+    intptr_t offset = reinterpret_cast<intptr_t>(hdr->m_heap);
+    if (offset == 0) {
+      continue;
+    }
+    if (offset < HTTP_ALT_MARSHAL_SIZE || offset > len - static_cast<intptr_t>(HDR_HEAP_HDR_SIZE)) {
+      return -1;
+    }
+    HdrHeap *heap = reinterpret_cast<HdrHeap *>(buf + offset);
+    if (heap->m_magic != HDR_BUF_MAGIC_MARSHALED) {
+      return -1;
+    }
+    used += HdrHeapMarshalBlocks(swoc::round_up(heap->unmarshal_size()));
+  }
+
+  return used <= len ? used : -1;
+}
+
 // bool HTTPInfo::check_marshalled(char* buf, int len)
 //  Checks a marhshalled HTTPInfo buffer to make
 //    sure it's sane.  Returns true if sane, false otherwise
@@ -2357,9 +2357,11 @@ MIMEScanner::append(TextView text)
 }
 
 ParseResult
-MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, bool eof_p, ScanType scan_type)
+MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, bool eof_p, ScanType scan_type,
+                 mime_scan::Index *index)
 {
-  ParseResult zret = PARSE_RESULT_CONT;
+  ParseResult zret  = PARSE_RESULT_CONT;
+  bool        nul_p = false; // Found a null character in the scanned text.
   // Need this for handling dangling CR.
   static const char RAW_CR{ParseRules::CHAR_CR};
 
@@ -2398,7 +2400,9 @@ MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, b
       }
       break;
     case MIME_PARSE_INSIDE: {
-      auto lf_off = text.find(ParseRules::CHAR_LF);
+      // Every byte not handled in another state is scanned here, so null characters can be
+      // detected in the same pass as the line end.
+      auto lf_off = index ? index->find_eol(text, nul_p) : mime_scan::find_eol(text, nul_p);
       if (lf_off != TextView::npos) {
         text.remove_prefix(lf_off + 1); // drop up to and including LF
         if (LINE == scan_type) {
@@ -2417,9 +2421,15 @@ MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, b
       // pretend it's the same line.
       if (ParseRules::is_ws(*text)) { // folded line.
         char *unfold = const_cast<char *>(text.data() - 1);
-        *unfold--    = ' ';
-        if (ParseRules::is_cr(*unfold)) {
+        *unfold      = ' ';
+        if (index) {
+          index->erase(unfold);
+        }
+        if (ParseRules::is_cr(*--unfold)) {
           *unfold = ' ';
+          if (index) {
+            index->erase(unfold);
+          }
         }
         m_state = MIME_PARSE_INSIDE; // back inside the field.
       } else {
@@ -2487,7 +2497,7 @@ MIMEScanner::get(TextView &input, TextView &output, bool &output_shares_input, b
   }
 
   // Make sure there are no null characters in the input scanned so far
-  if (zret != PARSE_RESULT_ERROR && TextView::npos != parsed_text.find('\0')) {
+  if (zret != PARSE_RESULT_ERROR && nul_p) {
     zret = PARSE_RESULT_ERROR;
   }
 
@@ -2529,6 +2539,9 @@ mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char
 
   MIMEScanner *scanner = &parser->m_scanner;
 
+  // Classification of the input block, shared by all the lines parsed in this call.
+  mime_scan::Index index;
+
   while (true) {
     ////////////////////////////////////////////////////////////////////////////
     // get a name:value line, with all continuation lines glued into one line //
@@ -2536,7 +2549,7 @@ mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char
 
     TextView text{*real_s, real_e};
     TextView parsed;
-    err     = scanner->get(text, parsed, line_is_real, eof, MIMEScanner::FIELD);
+    err     = scanner->get(text, parsed, line_is_real, eof, MIMEScanner::FIELD, &index);
     *real_s = text.data();
     if (err != PARSE_RESULT_OK) {
       return err;
@@ -2570,7 +2583,7 @@ mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char
 
     // find name last
     auto field_value = parsed; // need parsed as is later on.
-    auto field_name  = field_value.split_prefix_at(':');
+    auto field_name  = field_value.split_prefix(index.find_colon(field_value));
     if (field_name.empty()) {
       continue; // toss away garbage line
     }
@@ -2606,35 +2619,31 @@ mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char
 
     //    int total_line_length = (int)(field_line_last - field_line_first + 1);
 
-    //////////////////////////////////////////////////////////////////////
-    // if we can't leave the name & value in the real buffer, copy them //
-    //////////////////////////////////////////////////////////////////////
-
-    if (must_copy_strings || (!line_is_real)) {
-      char     *dup   = heap->duplicate_str(parsed.data(), parsed.size());
-      ptrdiff_t delta = dup - parsed.data();
-      field_name.assign(field_name.data() + delta, field_name.size());
-      field_value.assign(field_value.data() + delta, field_value.size());
-    }
     ///////////////////////
     // tokenize the name //
     ///////////////////////
 
     int field_name_wks_idx = hdrtoken_tokenize(field_name.data(), field_name.size());
 
-    if (field_name_wks_idx < 0) {
-      for (auto i : field_name) {
-        if (ParseRules::is_control(i)) {
-          return PARSE_RESULT_ERROR;
-        }
-      }
+    // Validate while the text is still in the indexed block, before any copy.
+    if (field_name_wks_idx < 0 && index.has_control(field_name)) {
+      return PARSE_RESULT_ERROR;
     }
 
     // RFC 9110 Section 5.5. Field Values
-    for (char i : field_value) {
-      if (ParseRules::is_control(i)) {
-        return PARSE_RESULT_ERROR;
-      }
+    if (index.has_control(field_value)) {
+      return PARSE_RESULT_ERROR;
+    }
+
+    //////////////////////////////////////////////////////////////////////
+    // if we can't leave the name & value in the real buffer, copy them //
+    //////////////////////////////////////////////////////////////////////
+
+    if (must_copy_strings || (!line_is_real)) {
+      char     *dup   = heap->duplicate_str(parsed.data(), parsed.size());
+      ptrdiff_t delta = dup - parsed.data();
+      field_name.assign(field_name.data() + delta, field_name.size());
+      field_value.assign(field_value.data() + delta, field_value.size());
     }
 
     ///////////////////////////////////////////
@@ -0,0 +1,440 @@
+/** @file
+
+  Vectorized character class scanning for MIME / HTTP/1.x header blocks.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "proxy/hdrs/MIMEScan.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MIME_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+using swoc::TextView;
+
+namespace mime_scan
+{
+namespace
+{
+  /// Classification of a 64 byte chunk, one bit per byte.
+  struct Masks {
+    uint64_t lf    = 0;
+    uint64_t colon = 0;
+    uint64_t nul   = 0;
+    uint64_t ctl   = 0;
+  };
+
+  /// The set of scanning functions for an implementation.
+  struct Ops {
+    Impl impl;
+    /// Classify exactly 64 bytes at the argument.
+    void (*classify)(const char *, Masks &);
+    size_t (*find_eol)(const char *, size_t, bool &);
+    size_t (*find_control)(const char *, size_t);
+  };
+
+  inline bool
+  is_control(uint8_t c)
+  {
+    return (c < 0x20 && c != '\t') || c == 0x7f;
+  }
+
+  // --- Scalar
+
+  void
+  classify_scalar(const char *s, Masks &m)
+  {
+    m = Masks{};
+    for (unsigned i = 0; i < 64; ++i) {
+      uint8_t  c   = s[i];
+      uint64_t bit = uint64_t(1) << i;
+      if (c == '\n') {
+        m.lf |= bit;
+      } else if (c == ':') {
+        m.colon |= bit;
+      } else if (c == 0) {
+        m.nul |= bit;
+      }
+      if (is_control(c)) {
+        m.ctl |= bit;
+      }
+    }
+  }
+
+  size_t
+  find_eol_scalar(const char *s, size_t n, bool &nul_p)
+  {
+    for (size_t i = 0; i < n; ++i) {
+      if (s[i] == '\n') {
+        return i;
+      } else if (s[i] == 0) {
+        nul_p = true;
+      }
+    }
+    return npos;
+  }
+
+  size_t
+  find_control_scalar(const char *s, size_t n)
+  {
+    for (size_t i = 0; i < n; ++i) {
+      if (is_control(s[i])) {
+        return i;
+      }
+    }
+    return npos;
+  }
+
+#if MIME_SCAN_X86
+  // --- SSE2, which is always available on x86_64.
+
+  inline uint32_t
+  ctl_mask_sse2(__m128i v)
+  {
+    // Unsigned compare for <= 0x1f done as min(v, 0x1f) == v.
+    __m128i low = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1f)), v);
+    __m128i ht  = _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'));
+    __m128i del = _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7f));
+    return _mm_movemask_epi8(_mm_or_si128(_mm_andnot_si128(ht, low), del));
+  }
+
+  void
+  classify_sse2(const char *s, Masks &m)
+  {
+    const __m128i LF    = _mm_set1_epi8('\n');
+    const __m128i COLON = _mm_set1_epi8(':');
+    const __m128i ZERO  = _mm_setzero_si128();
+
+    m = Masks{};
+    for (unsigned i = 0; i < 64; i += 16) {
+      __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+      m.lf      |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, LF)))) << i;
+      m.colon   |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, COLON)))) << i;
+      m.nul     |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(v, ZERO)))) << i;
+      m.ctl     |= uint64_t(ctl_mask_sse2(v)) << i;
+    }
+  }
+
+  size_t
+  find_eol_sse2(const char *s, size_t n, bool &nul_p)
+  {
+    const __m128i LF   = _mm_set1_epi8('\n');
+    const __m128i ZERO = _mm_setzero_si128();
+    size_t        i    = 0;
+
+    for (; i + 16 <= n; i += 16) {
+      __m128i  v   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+      uint32_t lf  = _mm_movemask_epi8(_mm_cmpeq_epi8(v, LF));
+      uint32_t nul = _mm_movemask_epi8(_mm_cmpeq_epi8(v, ZERO));
+      if (lf) {
+        unsigned idx = __builtin_ctz(lf);
+        if (nul & ((1U << idx) - 1)) {
+          nul_p = true;
+        }
+        return i + idx;
+      } else if (nul) {
+        nul_p = true;
+      }
+    }
+    size_t zret = find_eol_scalar(s + i, n - i, nul_p);
+    return zret == npos ? npos : i + zret;
+  }
+
+  size_t
+  find_control_sse2(const char *s, size_t n)
+  {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+      uint32_t ctl = ctl_mask_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)));
+      if (ctl) {
+        return i + __builtin_ctz(ctl);
+      }
+    }
+    size_t zret = find_control_scalar(s + i, n - i);
+    return zret == npos ? npos : i + zret;
+  }
+
+  // --- AVX2, selected at run time.
+
+  __attribute__((target("avx2"))) inline uint32_t
+  ctl_mask_avx2(__m256i v)
+  {
+    __m256i low = _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8(0x1f)), v);
+    __m256i ht  = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'));
+    __m256i del = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7f));
+    return _mm256_movemask_epi8(_mm256_or_si256(_mm256_andnot_si256(ht, low), del));
+  }
+
+  __attribute__((target("avx2"))) void
+  classify_avx2(const char *s, Masks &m)
+  {
+    const __m256i LF    = _mm256_set1_epi8('\n');
+    const __m256i COLON = _mm256_set1_epi8(':');
+    const __m256i ZERO  = _mm256_setzero_si256();
+
+    m = Masks{};
+    for (unsigned i = 0; i < 64; i += 32) {
+      __m256i v  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+      m.lf      |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, LF)))) << i;
+      m.colon   |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, COLON)))) << i;
+      m.nul     |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, ZERO)))) << i;
+      m.ctl     |= uint64_t(ctl_mask_avx2(v)) << i;
+    }
+  }
+
+  __attribute__((target("avx2"))) size_t
+  find_eol_avx2(const char *s, size_t n, bool &nul_p)
+  {
+    const __m256i LF   = _mm256_set1_epi8('\n');
+    const __m256i ZERO = _mm256_setzero_si256();
+    size_t        i    = 0;
+
+    for (; i + 32 <= n; i += 32) {
+      __m256i  v   = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+      uint32_t lf  = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, LF));
+      uint32_t nul = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, ZERO));
+      if (lf) {
+        unsigned idx = __builtin_ctz(lf);
+        if (nul & ((uint64_t(1) << idx) - 1)) {
+          nul_p = true;
+        }
+        return i + idx;
+      } else if (nul) {
+        nul_p = true;
+      }
+    }
+    size_t zret = find_eol_sse2(s + i, n - i, nul_p);
+    return zret == npos ? npos : i + zret;
+  }
+
+  __attribute__((target("avx2"))) size_t
+  find_control_avx2(const char *s, size_t n)
+  {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+      uint32_t ctl = ctl_mask_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i)));
+      if (ctl) {
+        return i + __builtin_ctz(ctl);
+      }
+    }
+    size_t zret = find_control_sse2(s + i, n - i);
+    return zret == npos ? npos : i + zret;
+  }
+#endif
+
+  const Ops SCALAR_OPS{Impl::SCALAR, &classify_scalar, &find_eol_scalar, &find_control_scalar};
+#if MIME_SCAN_X86
+  const Ops SSE2_OPS{Impl::SSE2, &classify_sse2, &find_eol_sse2, &find_control_sse2};
+  const Ops AVX2_OPS{Impl::AVX2, &classify_avx2, &find_eol_avx2, &find_control_avx2};
+#endif
+
+  const Ops *
+  detect()
+  {
+#if MIME_SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return &AVX2_OPS;
+    }
+    return &SSE2_OPS;
+#else
+    return &SCALAR_OPS;
+#endif
+  }
+
+  /// The active implementation.
+  const Ops *&
+  ops()
+  {
+    static const Ops *current = detect();
+    return current;
+  }
+
+} // namespace
+
+Impl
+impl()
+{
+  return ops()->impl;
+}
+
+const char *
+impl_name(Impl impl)
+{
+  switch (impl) {
+  case Impl::SCALAR:
+    return "scalar";
+  case Impl::SSE2:
+    return "sse2";
+  case Impl::AVX2:
+    return "avx2";
+  }
+  return "unknown";
+}
+
+bool
+set_impl(Impl impl)
+{
+  switch (impl) {
+  case Impl::SCALAR:
+    ops() = &SCALAR_OPS;
+    return true;
+#if MIME_SCAN_X86
+  case Impl::SSE2:
+    ops() = &SSE2_OPS;
+    return true;
+  case Impl::AVX2:
+    if (__builtin_cpu_supports("avx2")) {
+      ops() = &AVX2_OPS;
+      return true;
+    }
+    break;
+#endif
+  default:
+    break;
+  }
+  return false;
+}
+
+size_t
+find_eol(TextView text, bool &nul_p)
+{
+  return ops()->find_eol(text.data(), text.size(), nul_p);
+}
+
+size_t
+find_control(TextView text)
+{
+  return ops()->find_control(text.data(), text.size());
+}
+
+void
+Index::load(TextView text)
+{
+  auto classify = ops()->classify;
+
+  _base = text.data();
+  _size = std::min(text.size(), WINDOW_SIZE);
+
+  for (size_t w = 0; w < N_WORDS; ++w) {
+    size_t offset = w * 64;
+    Masks  m;
+    if (offset + 64 <= _size) {
+      classify(_base + offset, m);
+    } else if (offset < _size) {
+      // Partial chunk - classify a padded copy so the scan never reads past the end of the text.
+      char   chunk[64] = {};
+      size_t n         = _size - offset;
+      memcpy(chunk, _base + offset, n);
+      classify(chunk, m);
+      uint64_t valid  = (uint64_t(1) << n) - 1;
+      m.lf           &= valid;
+      m.colon        &= valid;
+      m.nul          &= valid;
+      m.ctl          &= valid;
+    }
+    _bits.lf[w]    = m.lf;
+    _bits.colon[w] = m.colon;
+    _bits.nul[w]   = m.nul;
+    _bits.ctl[w]   = m.ctl;
+  }
+}
+
+size_t
+Index::search(uint64_t const *map, size_t start, size_t end) const
+{
+  while (start < end) {
+    size_t   w    = start / 64;
+    uint64_t bits = map[w] >> (start % 64);
+    if (bits) {
+      size_t idx = start + __builtin_ctzll(bits);
+      return idx < end ? idx : npos;
+    }
+    start = (w + 1) * 64;
+  }
+  return npos;
+}
+
+size_t
+Index::find_eol(TextView text, bool &nul_p)
+{
+  size_t consumed = 0;
+  while (consumed < text.size()) {
+    const char *p = text.data() + consumed;
+    if (!this->contains(p)) {
+      this->load(text.substr(consumed));
+    }
+    size_t start = p - _base;
+    size_t end   = std::min(_size, start + (text.size() - consumed));
+    size_t lf    = this->search(_bits.lf, start, end);
+    if (!nul_p && this->search(_bits.nul, start, lf == npos ? end : lf) != npos) {
+      nul_p = true;
+    }
+    if (lf != npos) {
+      return consumed + (lf - start);
+    }
+    consumed += end - start;
+  }
+  return npos;
+}
+
+size_t
+Index::find_colon(TextView line)
+{
+  if (line.empty() || !this->contains(line.data()) || !this->contains(line.data() + line.size() - 1)) {
+    return line.find(':');
+  }
+  size_t start = line.data() - _base;
+  size_t idx   = this->search(_bits.colon, start, start + line.size());
+  return idx == npos ? npos : idx - start;
+}
+
+bool
+Index::has_control(TextView text)
+{
+  if (text.empty()) {
+    return false;
+  }
+  if (!this->contains(text.data()) || !this->contains(text.data() + text.size() - 1)) {
+    return mime_scan::find_control(text) != npos;
+  }
+  size_t start = text.data() - _base;
+  return this->search(_bits.ctl, start, start + text.size()) != npos;
+}
+
+void
+Index::erase(const char *p)
+{
+  if (this->contains(p)) {
+    size_t   offset = p - _base;
+    uint64_t mask   = ~(uint64_t(1) << (offset % 64));
+
+    _bits.lf[offset / 64]    &= mask;
+    _bits.colon[offset / 64] &= mask;
+    _bits.nul[offset / 64]   &= mask;
+    _bits.ctl[offset / 64]   &= mask;
+  }
+}
+
+} // namespace mime_scan
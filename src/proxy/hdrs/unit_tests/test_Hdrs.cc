@@ -2086,3 +2086,53 @@ TEST_CASE("HdrTest", "[proxy][hdrtest]")
     }
   }
 }
+
+TEST_CASE("HTTPInfo unmarshal_length", "[proxy][hdrtest]")
+{
+  const char *request  = "GET http://www.example.com/ HTTP/1.1\r\nHost: www.example.com\r\nAccept: text/html\r\n\r\n";
+  const char *response = "HTTP/1.1 200 OK\r\nContent-Length: 10\r\nVary: Accept\r\n\r\n";
+  HTTPHdr     req_hdr, resp_hdr;
+  HTTPParser  parser;
+  const char *start;
+
+  req_hdr.create(HTTP_TYPE_REQUEST);
+  start = request;
+  http_parser_init(&parser);
+  REQUIRE(req_hdr.parse_req(&parser, &start, request + strlen(request), true) == PARSE_RESULT_DONE);
+  resp_hdr.create(HTTP_TYPE_RESPONSE);
+  start = response;
+  http_parser_clear(&parser);
+  http_parser_init(&parser);
+  REQUIRE(resp_hdr.parse_resp(&parser, &start, response + strlen(response), true) == PARSE_RESULT_DONE);
+
+  HTTPInfo info;
+  info.create();
+  info.request_set(&req_hdr);
+  info.response_set(&resp_hdr);
+
+  int                         len = info.marshal_length();
+  std::unique_ptr<uint64_t[]> storage(new uint64_t[len / sizeof(uint64_t) + 1]);
+  char                       *buf = reinterpret_cast<char *>(storage.get());
+  REQUIRE(info.marshal(buf, len) == len);
+
+  REQUIRE(HTTPInfo::unmarshal_length(buf, len) == len);
+  // Truncated.
+  REQUIRE(HTTPInfo::unmarshal_length(buf, len - 8) == -1);
+  REQUIRE(HTTPInfo::unmarshal_length(buf, 8) == -1);
+
+  // The length is the same once it is unmarshalled.
+  TestRefCountObj ref;
+  ref.refcount_inc();
+  REQUIRE(HTTPInfo::unmarshal(buf, len, &ref) == len);
+  REQUIRE(HTTPInfo::unmarshal_length(buf, len) == len);
+
+  HTTPInfo copy;
+  REQUIRE(copy.get_handle(buf, len) == len);
+  REQUIRE(copy.response_get()->get_content_length() == 10);
+
+  info.destroy();
+  copy.clear();
+  req_hdr.destroy();
+  resp_hdr.destroy();
+  http_parser_clear(&parser);
+}
@@ -0,0 +1,200 @@
+/** @file
+
+  Unit tests for the vectorized header block scanner.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <array>
+#include <random>
+#include <string>
+
+#include "catch.hpp"
+
+#include "tscore/ParseRules.h"
+#include "proxy/hdrs/HTTP.h"
+#include "proxy/hdrs/MIMEScan.h"
+
+using swoc::TextView;
+
+namespace
+{
+constexpr std::array<mime_scan::Impl, 3> IMPLS = {mime_scan::Impl::SCALAR, mime_scan::Impl::SSE2, mime_scan::Impl::AVX2};
+
+// Reference results computed a byte at a time with ParseRules.
+size_t
+ref_find_control(TextView text)
+{
+  for (size_t i = 0; i < text.size(); ++i) {
+    if (ParseRules::is_control(text[i])) {
+      return i;
+    }
+  }
+  return mime_scan::npos;
+}
+
+size_t
+ref_find_eol(TextView text, bool &nul_p)
+{
+  auto lf = text.find('\n');
+  nul_p   = text.prefix(lf).find('\0') != TextView::npos;
+  return lf;
+}
+
+std::string
+random_text(std::mt19937 &rng, size_t n)
+{
+  // Mostly printable, with a sprinkling of the interesting characters.
+  static constexpr char SPECIAL[] = {'\n', '\r', ':', '\t', '\0', '\x7f', '\x01', '\x80', '\xff'};
+  std::string           text(n, ' ');
+  for (auto &c : text) {
+    auto r = rng() % 64;
+    c      = r < sizeof(SPECIAL) ? SPECIAL[r] : static_cast<char>(' ' + rng() % 95);
+  }
+  return text;
+}
+} // namespace
+
+TEST_CASE("MIMEScan character classes", "[proxy][mimescan]")
+{
+  auto         saved = mime_scan::impl();
+  std::mt19937 rng(13);
+
+  for (auto impl : IMPLS) {
+    if (!mime_scan::set_impl(impl)) {
+      continue;
+    }
+    INFO("impl " << mime_scan::impl_name(impl));
+
+    // Every single byte value, at every position in a vector width.
+    for (int c = 0; c < 256; ++c) {
+      for (size_t pos = 0; pos < 40; ++pos) {
+        std::string text(48, 'a');
+        text[pos] = static_cast<char>(c);
+        bool nul_p = false, ref_nul_p = false;
+        REQUIRE(mime_scan::find_control(text) == ref_find_control(text));
+        REQUIRE(mime_scan::find_eol(text, nul_p) == ref_find_eol(text, ref_nul_p));
+        REQUIRE(nul_p == ref_nul_p);
+      }
+    }
+
+    for (int i = 0; i < 2000; ++i) {
+      auto text  = random_text(rng, rng() % 300);
+      bool nul_p = false, ref_nul_p = false;
+      REQUIRE(mime_scan::find_control(text) == ref_find_control(text));
+      REQUIRE(mime_scan::find_eol(text, nul_p) == ref_find_eol(text, ref_nul_p));
+      REQUIRE(nul_p == ref_nul_p);
+    }
+  }
+
+  mime_scan::set_impl(saved);
+}
+
+TEST_CASE("MIMEScan index", "[proxy][mimescan]")
+{
+  auto         saved = mime_scan::impl();
+  std::mt19937 rng(17);
+
+  for (auto impl : IMPLS) {
+    if (!mime_scan::set_impl(impl)) {
+      continue;
+    }
+    INFO("impl " << mime_scan::impl_name(impl));
+
+    for (int i = 0; i < 200; ++i) {
+      // Longer than several windows to exercise sliding.
+      auto             block = random_text(rng, 1 + rng() % (3 * mime_scan::Index::WINDOW_SIZE));
+      TextView         text{block};
+      mime_scan::Index index;
+
+      while (!text.empty()) {
+        bool nul_p = false, ref_nul_p = false;
+        auto lf    = index.find_eol(text, nul_p);
+        REQUIRE(lf == ref_find_eol(text, ref_nul_p));
+        REQUIRE(nul_p == ref_nul_p);
+
+        auto line = text.prefix(lf);
+        REQUIRE(index.find_colon(line) == line.find(':'));
+        REQUIRE(index.has_control(line) == (ref_find_control(line) != mime_scan::npos));
+
+        text.remove_prefix(lf == mime_scan::npos ? text.size() : lf + 1);
+      }
+    }
+  }
+
+  mime_scan::set_impl(saved);
+}
+
+TEST_CASE("MIMEScan header parse", "[proxy][mimescan]")
+{
+  struct Test {
+    TextView    msg;
+    ParseResult expected_result;
+    int         expected_fields;
+  };
+  static const std::array<Test, 10> tests = {
+    {
+     {"GET / HTTP/1.1\r\nHost: example.com\r\nAccept: */*\r\n\r\n", PARSE_RESULT_DONE, 2},
+     {"GET / HTTP/1.1\r\nHost: example.com\r\nX-Folded: one\r\n two\r\n\r\n", PARSE_RESULT_DONE, 2},
+     {"GET / HTTP/1.1\r\nHost: example.com\r\nX-Bad: a\x01z\r\n\r\n", PARSE_RESULT_ERROR, 0},
+     {"GET / HTTP/1.1\r\nHost: example.com\r\nX-Bad\x7f: az\r\n\r\n", PARSE_RESULT_ERROR, 0},
+     {"GET / HTTP/1.1\r\nHost: exa\0mple.com\r\n\r\n", PARSE_RESULT_ERROR, 0},
+     {"GET / HTTP/1.1\r\nHost: example.com\r\nX-Tab: a\tz\r\n\r\n", PARSE_RESULT_DONE, 2},
+     // Folds with a bare LF, which leave the byte before the LF in place.
+     {"GET / HTTP/1.1\r\nHost: example.com\r\nX-Folded: one\n two\r\n\r\n", PARSE_RESULT_DONE, 2},
+     {"GET / HTTP/1.1\r\nHost: example.com\r\nX-Folded:\n two\r\n\r\n", PARSE_RESULT_DONE, 2},
+     {"GET / HTTP/1.1\r\nHost: example.com\r\nX-Bad: a\x01\n z\r\n\r\n", PARSE_RESULT_ERROR, 0},
+     {"GET / HTTP/1.1\r\nHost: example.com\r\nX-Bad: a\x01\r\n z\r\n\r\n", PARSE_RESULT_ERROR, 0},
+     }
+  };
+
+  auto saved = mime_scan::impl();
+
+  for (auto impl : IMPLS) {
+    if (!mime_scan::set_impl(impl)) {
+      continue;
+    }
+    INFO("impl " << mime_scan::impl_name(impl));
+
+    for (auto const &test : tests) {
+      HTTPParser parser;
+      HTTPHdr    req_hdr;
+      // Copy, the parser modifies folded lines in place.
+      std::string msg{test.msg};
+      const char *start = msg.data();
+
+      http_parser_init(&parser);
+      req_hdr.create(HTTP_TYPE_REQUEST);
+
+      auto ret = req_hdr.parse_req(&parser, &start, msg.data() + msg.size(), true);
+      REQUIRE(ret == test.expected_result);
+      if (ret == PARSE_RESULT_DONE) {
+        REQUIRE(req_hdr.fields_count() == test.expected_fields);
+        if (auto field = req_hdr.field_find("X-Folded", 8); field != nullptr) {
+          CHECK(field->value_get().find("two") != std::string_view::npos);
+        }
+      }
+
+      req_hdr.destroy();
+      http_parser_clear(&parser);
+    }
+  }
+
+  mime_scan::set_impl(saved);
+}
@@ -204,6 +204,14 @@ HttpCacheSM::state_cache_open_write(int event, void *data)
     break;
 
   case CACHE_EVENT_OPEN_WRITE_FAILED: {
+    if (reinterpret_cast<intptr_t>(data) == -ECACHE_NOT_ADMITTED) {
+      // The cache declined to store the object, retrying would not change that.
+      Dbg(dbg_ctl_http_cache, "[%" PRId64 "] [state_cache_open_write] cache open write not admitted", master_sm->sm_id);
+      open_write_cb = true;
+      err_code      = reinterpret_cast<intptr_t>(data);
+      master_sm->handleEvent(event, &captive_action);
+      break;
+    }
     if (master_sm->t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY) {
       // fall back to open_read_tries
       // Note that when CACHE_WL_FAIL_ACTION_READ_RETRY is configured, max_cache_open_write_retries
@@ -401,10 +409,12 @@ HttpCacheSM::open_write(const HttpCacheKey *key, URL *url, HTTPHdr *request, Cac
     return ACTION_RESULT_DONE;
   }
 
+  // Later tries are for the same request, so cache admission does not count them again.
   Action *action_handle =
     cacheProcessor.open_write(this, 0, key, request,
                               // INKqa11166
-                              allow_multiple ? (CacheHTTPInfo *)CACHE_ALLOW_MULTIPLE_WRITES : old_info, pin_in_cache);
+                              allow_multiple ? (CacheHTTPInfo *)CACHE_ALLOW_MULTIPLE_WRITES : old_info, pin_in_cache,
+                              CACHE_FRAG_TYPE_HTTP, open_write_tries > 1 ? CACHE_WRITE_OPT_RETRY : 0);
 
   if (action_handle != ACTION_RESULT_DONE) {
     pending_action = action_handle;
@@ -382,6 +382,10 @@ register_stat_callbacks()
     Metrics::Counter::createPtr("proxy.process.http.origin_shutdown.tunnel_server_plugin_tunnel");
   http_rsb.origin_shutdown_tunnel_transform_read =
     Metrics::Counter::createPtr("proxy.process.http.origin_shutdown.tunnel_transform_read");
+  http_rsb.origin_steal_attempts             = Metrics::Counter::createPtr("proxy.process.http.origin.steal.attempts");
+  http_rsb.origin_steal_probes               = Metrics::Counter::createPtr("proxy.process.http.origin.steal.probes");
+  http_rsb.origin_steal_success              = Metrics::Counter::createPtr("proxy.process.http.origin.steal.success");
+  http_rsb.origin_steal_time                 = Metrics::Counter::createPtr("proxy.process.http.origin.steal.time");
   http_rsb.outgoing_requests                 = Metrics::Counter::createPtr("proxy.process.http.outgoing_requests");
   http_rsb.parent_count                      = Metrics::Counter::createPtr("proxy.process.http_parent_count");
   http_rsb.parent_proxy_request_total_bytes  = Metrics::Counter::createPtr("proxy.process.http.parent_proxy_request_total_bytes");
@@ -493,6 +497,11 @@ register_stat_callbacks()
   http_rsb.total_transactions_time           = Metrics::Counter::createPtr("proxy.process.http.total_transactions_time");
   http_rsb.total_x_redirect                  = Metrics::Counter::createPtr("proxy.process.http.total_x_redirect_count");
   http_rsb.trace_requests                    = Metrics::Counter::createPtr("proxy.process.http.trace_requests");
+  http_rsb.txn_arena_allocations             = Metrics::Counter::createPtr("proxy.process.http.transaction_arena.allocations");
+  http_rsb.txn_arena_blocks                  = Metrics::Counter::createPtr("proxy.process.http.transaction_arena.blocks");
+  http_rsb.txn_arena_blocks_reused           = Metrics::Counter::createPtr("proxy.process.http.transaction_arena.blocks_reused");
+  http_rsb.txn_arena_bytes                   = Metrics::Counter::createPtr("proxy.process.http.transaction_arena.bytes");
+  http_rsb.txn_arena_release_time            = Metrics::Counter::createPtr("proxy.process.http.transaction_arena.release_time");
   http_rsb.tunnel_current_active_connections = Metrics::Gauge::createPtr("proxy.process.tunnel.current_active_connections");
   http_rsb.tunnels                           = Metrics::Counter::createPtr("proxy.process.http.tunnels");
   http_rsb.ua_begin_time                     = Metrics::Counter::createPtr("proxy.process.http.milestone.ua_begin");
@@ -752,6 +761,9 @@ HttpConfig::startup()
   HttpEstablishStaticConfigStringAlloc(c.oride.server_session_sharing_match_str, "proxy.config.http.server_session_sharing.match");
   http_config_enum_read("proxy.config.http.server_session_sharing.pool", SessionSharingPoolStrings, c.server_session_sharing_pool);
   httpSessionManager.set_pool_type(c.server_session_sharing_pool);
+  HttpEstablishStaticConfigLongLong(c.server_session_sharing_steal_max_probes,
+                                    "proxy.config.http.server_session_sharing.steal_max_probes");
+  httpSessionManager.set_steal_max_probes(c.server_session_sharing_steal_max_probes);
 
   RecRegisterConfigUpdateCb("proxy.config.http.insert_forwarded", &http_insert_forwarded_cb, &c);
   {
@@ -0,0 +1,292 @@
+/** @file
+
+  Latency histograms for pairs of transaction milestones.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <cctype>
+#include <strings.h>
+
+#include "swoc/TextView.h"
+
+#include "proxy/http/HttpMilestoneHistograms.h"
+#include "iocore/eventsystem/EventProcessor.h"
+#include "iocore/net/Net.h"
+#include "records/RecCore.h"
+#include "records/RecProcess.h"
+#include "tscore/Diags.h"
+
+std::vector<HttpMilestoneHistograms::Pair> HttpMilestoneHistograms::pairs;
+
+namespace
+{
+DbgCtl dbg_ctl_http_milestone{"http_milestone"};
+
+constexpr std::string_view MILESTONE_PREFIX{"TS_MILESTONE_"};
+
+struct MilestoneName {
+  std::string_view name;
+  TSMilestonesType type;
+};
+
+// Names as for the ms and msdms log fields, without the prefix.
+constexpr MilestoneName MILESTONE_NAMES[] = {
+  {"UA_BEGIN",                TS_MILESTONE_UA_BEGIN               },
+  {"UA_FIRST_READ",           TS_MILESTONE_UA_FIRST_READ          },
+  {"UA_READ_HEADER_DONE",     TS_MILESTONE_UA_READ_HEADER_DONE    },
+  {"UA_BEGIN_WRITE",          TS_MILESTONE_UA_BEGIN_WRITE         },
+  {"UA_CLOSE",                TS_MILESTONE_UA_CLOSE               },
+  {"SERVER_FIRST_CONNECT",    TS_MILESTONE_SERVER_FIRST_CONNECT   },
+  {"SERVER_CONNECT",          TS_MILESTONE_SERVER_CONNECT         },
+  {"SERVER_CONNECT_END",      TS_MILESTONE_SERVER_CONNECT_END     },
+  {"SERVER_BEGIN_WRITE",      TS_MILESTONE_SERVER_BEGIN_WRITE     },
+  {"SERVER_FIRST_READ",       TS_MILESTONE_SERVER_FIRST_READ      },
+  {"SERVER_READ_HEADER_DONE", TS_MILESTONE_SERVER_READ_HEADER_DONE},
+  {"SERVER_CLOSE",            TS_MILESTONE_SERVER_CLOSE           },
+  {"CACHE_OPEN_READ_BEGIN",   TS_MILESTONE_CACHE_OPEN_READ_BEGIN  },
+  {"CACHE_OPEN_READ_END",     TS_MILESTONE_CACHE_OPEN_READ_END    },
+  {"CACHE_OPEN_WRITE_BEGIN",  TS_MILESTONE_CACHE_OPEN_WRITE_BEGIN },
+  {"CACHE_OPEN_WRITE_END",    TS_MILESTONE_CACHE_OPEN_WRITE_END   },
+  {"DNS_LOOKUP_BEGIN",        TS_MILESTONE_DNS_LOOKUP_BEGIN       },
+  {"DNS_LOOKUP_END",          TS_MILESTONE_DNS_LOOKUP_END         },
+  {"SM_START",                TS_MILESTONE_SM_START               },
+  {"SM_FINISH",               TS_MILESTONE_SM_FINISH              },
+  {"PLUGIN_ACTIVE",           TS_MILESTONE_PLUGIN_ACTIVE          },
+  {"PLUGIN_TOTAL",            TS_MILESTONE_PLUGIN_TOTAL           },
+  {"TLS_HANDSHAKE_START",     TS_MILESTONE_TLS_HANDSHAKE_START    },
+  {"TLS_HANDSHAKE_END",       TS_MILESTONE_TLS_HANDSHAKE_END      },
+};
+
+MilestoneName const *
+find_milestone(swoc::TextView name)
+{
+  if (name.starts_with_nocase(MILESTONE_PREFIX)) {
+    name.remove_prefix(MILESTONE_PREFIX.size());
+  }
+  for (auto const &ms : MILESTONE_NAMES) {
+    if (name.size() == ms.name.size() && 0 == strncasecmp(name.data(), ms.name.data(), name.size())) {
+      return &ms;
+    }
+  }
+  return nullptr;
+}
+
+std::string
+lower(std::string_view s)
+{
+  std::string result(s);
+  for (auto &c : result) {
+    c = tolower(c);
+  }
+  return result;
+}
+
+// Statistics of a pair: the count, then the percentiles.
+constexpr int N_PAIR_STATS = 1 + HttpMilestoneHistograms::PERCENTILES.size();
+
+/* The percentiles are of the samples since the start of the previous window, so they cover between one and two windows of
+ * the most recent traffic. The counts at the start of the windows are kept per pair; they are only touched by the stat
+ * sync callback.
+ */
+struct Window {
+  HttpMilestoneHistograms::Counts prev{};
+  HttpMilestoneHistograms::Counts cur{};
+};
+
+std::vector<Window> windows;
+ink_hrtime          window_start  = 0;
+ink_hrtime          window_length = HRTIME_SECONDS(60);
+
+void
+initialize_thread_for_milestone_histograms(EThread *thread)
+{
+  thread->milestone_histograms = new HttpMilestoneHistograms(HttpMilestoneHistograms::pairs.size());
+}
+
+int
+MilestoneHistogramStatSync(const char *, RecDataT, RecData *, RecRawStatBlock *rsb, int)
+{
+  using Counts   = HttpMilestoneHistograms::Counts;
+  using raw_type = HttpMilestoneHistograms::Graph::raw_type;
+
+  auto      &pairs = HttpMilestoneHistograms::pairs;
+  ink_hrtime now   = ink_get_hrtime();
+  bool       roll  = now - window_start >= window_length;
+
+  if (roll) {
+    window_start = now;
+  }
+
+  ink_mutex_acquire(&(rsb->mutex));
+
+  auto stat_update = [=](int idx, int64_t value) {
+    rsb->global[idx]->sum   = value;
+    rsb->global[idx]->count = 1;
+    RecRawStatUpdateSum(rsb, idx);
+  };
+
+  for (size_t idx = 0; idx < pairs.size(); ++idx) {
+    Counts merged{};
+    for (EThread *t : eventProcessor.active_group_threads(ET_NET)) {
+      if (t->milestone_histograms) {
+        t->milestone_histograms->add_to(idx, merged);
+      }
+    }
+
+    Window &w = windows[idx];
+    if (roll) {
+      w.prev = w.cur;
+      w.cur  = merged;
+    }
+
+    Counts   recent;
+    raw_type count = 0;
+    for (size_t b = 0; b < recent.size(); ++b) {
+      recent[b]  = merged[b] - w.prev[b];
+      count     += merged[b];
+    }
+
+    int id = idx * N_PAIR_STATS;
+    stat_update(id++, count);
+    for (auto permille : HttpMilestoneHistograms::PERCENTILES) {
+      stat_update(id++, HttpMilestoneHistograms::percentile(recent, permille));
+    }
+  }
+
+  ink_mutex_release(&(rsb->mutex));
+  return REC_ERR_OKAY;
+}
+} // namespace
+
+void
+HttpMilestoneHistograms::record(std::vector<Pair> const &pairs, TransactionMilestones const &milestones)
+{
+  for (size_t idx = 0; idx < pairs.size(); ++idx) {
+    auto const &pair  = pairs[idx];
+    ink_hrtime  start = milestones[pair.start];
+    ink_hrtime  end   = milestones[pair.end];
+    if (start != 0 && end >= start) {
+      _graphs[idx](ink_hrtime_to_usec(end - start));
+    }
+  }
+}
+
+void
+HttpMilestoneHistograms::add_to(size_t idx, Counts &counts)
+{
+  auto &graph = _graphs[idx];
+  for (unsigned b = 0; b < counts.size(); ++b) {
+    counts[b] += graph[b];
+  }
+}
+
+bool
+HttpMilestoneHistograms::parse(std::string_view spec, std::vector<Pair> &pairs, std::string &error)
+{
+  swoc::TextView text{spec};
+
+  pairs.clear();
+  while (text.ltrim_if([](char c) { return c == ',' || isspace(c); })) {
+    swoc::TextView token  = text.take_prefix_if([](char c) { return c == ',' || isspace(c); });
+    swoc::TextView second = token;
+    // Milestone names contain '_' but not '-'.
+    swoc::TextView first = second.split_prefix_at('-');
+
+    auto start = first.empty() ? nullptr : find_milestone(first);
+    auto end   = start ? find_milestone(second) : nullptr;
+    if (!end) {
+      error.assign(token.data(), token.size());
+      return false;
+    }
+    pairs.push_back({start->type, end->type, lower(start->name) + "_to_" + lower(end->name)});
+  }
+  return true;
+}
+
+auto
+HttpMilestoneHistograms::percentile(Counts const &counts, unsigned permille) -> Graph::raw_type
+{
+  Graph::raw_type total = 0;
+  for (auto n : counts) {
+    total += n;
+  }
+  if (total == 0) {
+    return 0;
+  }
+
+  // The rank of the sample, counting from 1.
+  Graph::raw_type rank = (total * permille + 999) / 1000;
+  Graph::raw_type seen = 0;
+  for (unsigned b = 0; b < counts.size(); ++b) {
+    if (seen + counts[b] >= rank) {
+      auto low = Graph::min_for_bucket(b);
+      if (b == counts.size() - 1) {
+        return low; // overflow, no upper bound.
+      }
+      auto high = Graph::min_for_bucket(b + 1);
+      return low + (high - low) * (rank - seen - 1) / counts[b];
+    }
+    seen += counts[b];
+  }
+  return Graph::min_for_bucket(counts.size() - 1);
+}
+
+void
+HttpMilestoneHistograms::init()
+{
+  char        spec[1024] = "";
+  RecInt      window     = 0;
+  std::string error;
+
+  RecGetRecordString("proxy.config.http.milestone_histograms.pairs", spec, sizeof(spec));
+  if (!parse(spec, pairs, error)) {
+    Warning("invalid milestone pair '%s' in proxy.config.http.milestone_histograms.pairs, milestone histograms disabled",
+            error.c_str());
+    pairs.clear();
+  }
+  if (pairs.empty()) {
+    return;
+  }
+
+  if (REC_ERR_OKAY == RecGetRecordInt("proxy.config.http.milestone_histograms.window", &window) && window > 0) {
+    window_length = HRTIME_SECONDS(window);
+  }
+  window_start = ink_get_hrtime();
+  windows.resize(pairs.size());
+
+  RecRawStatBlock *rsb = RecAllocateRawStatBlock(pairs.size() * N_PAIR_STATS);
+  int              id  = 0;
+  char             name[256];
+
+  for (auto const &pair : pairs) {
+    Dbg(dbg_ctl_http_milestone, "histogram for %s", pair.name.c_str());
+    snprintf(name, sizeof(name), "proxy.process.http.milestone.%s.count", pair.name.c_str());
+    RecRegisterRawStat(rsb, RECT_PROCESS, name, RECD_INT, RECP_NON_PERSISTENT, id++, nullptr);
+    for (auto suffix : PERCENTILE_NAMES) {
+      snprintf(name, sizeof(name), "proxy.process.http.milestone.%s.%.*s", pair.name.c_str(), static_cast<int>(suffix.size()),
+               suffix.data());
+      RecRegisterRawStat(rsb, RECT_PROCESS, name, RECD_INT, RECP_NON_PERSISTENT, id++, nullptr);
+    }
+  }
+  // Name must be that of a stat, the last one will do since all of them are done in one pass.
+  RecRegisterRawStatSyncCb(name, MilestoneHistogramStatSync, rsb, 0);
+
+  eventProcessor.schedule_spawn(&initialize_thread_for_milestone_histograms, ET_NET);
+}
@@ -28,6 +28,7 @@
 #include "proxy/http/HttpSessionAccept.h"
 #include "proxy/ReverseProxy.h"
 #include "proxy/http/HttpSessionManager.h"
+#include "proxy/http/HttpMilestoneHistograms.h"
 #ifdef USE_HTTP_DEBUG_LISTS
 #include "proxy/http/Http1ClientSession.h"
 #endif
@@ -254,6 +255,7 @@ void
 prep_HttpProxyServer()
 {
   httpSessionManager.init();
+  HttpMilestoneHistograms::init();
 }
 
 /** Set up all the accepts and sockets.
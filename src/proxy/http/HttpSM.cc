@@ -33,6 +33,7 @@
 #include "proxy/http/Http1ServerSession.h"
 #include "proxy/http2/Http2ServerSession.h"
 #include "proxy/http/HttpDebugNames.h"
+#include "proxy/http/HttpMilestoneHistograms.h"
 #include "proxy/http/HttpSessionManager.h"
 #include "proxy/http/HttpVCTable.h"
 #include "../../iocore/cache/P_Cache.h"
@@ -246,6 +247,20 @@ HttpSM::HttpSM() : Continuation(nullptr), vc_table(this) {}
 void
 HttpSM::cleanup()
 {
+  // Release the transaction arena in one step, recording what it served in place of individual
+  // heap allocations.
+  Arena::Stats const &arena_stats = t_state.arena.stats();
+  if (arena_stats.allocs > 0) {
+    Metrics::Counter::increment(http_rsb.txn_arena_allocations, arena_stats.allocs);
+    Metrics::Counter::increment(http_rsb.txn_arena_bytes, arena_stats.bytes);
+    Metrics::Counter::increment(http_rsb.txn_arena_blocks, arena_stats.blocks);
+    Metrics::Counter::increment(http_rsb.txn_arena_blocks_reused, arena_stats.blocks_reused);
+
+    ink_hrtime release_start = ink_get_hrtime();
+    t_state.arena.reset();
+    Metrics::Counter::increment(http_rsb.txn_arena_release_time, ink_get_hrtime() - release_start);
+  }
+
   t_state.destroy();
   api_hooks.clear();
   http_parser_clear(&http_parser);
@@ -2436,6 +2451,11 @@ HttpSM::state_cache_open_write(int event, void *data)
     break;
 
   case CACHE_EVENT_OPEN_WRITE_FAILED:
+    if (cache_sm.get_last_error() == -ECACHE_NOT_ADMITTED) {
+      // Not an error, the object is not written and the request goes to the origin.
+      t_state.cache_info.write_lock_state = HttpTransact::CACHE_WL_NOT_ADMITTED;
+      break;
+    }
     // Failed on the write lock and retrying the vector
     //  for reading
     if (t_state.redirect_info.redirect_in_process) {
@@ -7583,6 +7603,10 @@ HttpSM::update_stats()
     os_read_time = -1;
   }
 
+  if (auto histograms = this_ethread()->milestone_histograms; histograms) {
+    histograms->record(HttpMilestoneHistograms::pairs, milestones);
+  }
+
   HttpTransact::update_size_and_time_stats(
     &t_state, total_time, ua_write_time, os_read_time, client_request_hdr_bytes, client_request_body_bytes,
     client_response_hdr_bytes, client_response_body_bytes, server_request_hdr_bytes, server_request_body_bytes,
@@ -66,6 +66,39 @@ ServerSessionPool::purge()
   m_ip_pool.apply([](PoolableSession *ssn) -> void { ssn->do_io_close(); });
   m_ip_pool.clear();
   m_fqdn_pool.clear();
+  for (auto &n : m_ip_summary) {
+    n.store(0, std::memory_order_relaxed);
+  }
+  for (auto &n : m_fqdn_summary) {
+    n.store(0, std::memory_order_relaxed);
+  }
+}
+
+void
+ServerSessionPool::summarize(PoolableSession *ssn, int delta)
+{
+  using IPLinkage   = PoolableSession::IPLinkage;
+  using FQDNLinkage = PoolableSession::FQDNLinkage;
+
+  auto &ip   = m_ip_summary[IPLinkage::hash_of(IPLinkage::key_of(ssn)) & (SUMMARY_SIZE - 1)];
+  auto &fqdn = m_fqdn_summary[FQDNLinkage::hash_of(FQDNLinkage::key_of(ssn)) & (SUMMARY_SIZE - 1)];
+  // Only changed with the pool locked, so there is no need for a read-modify-write.
+  ip.store(ip.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+  fqdn.store(fqdn.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+bool
+ServerSessionPool::may_contain(sockaddr const *addr, CryptoHash const &host_hash, TSServerSessionSharingMatchMask match_style) const
+{
+  std::atomic<uint32_t> const *bucket = nullptr;
+
+  // Same choice of table as acquireSession.
+  if ((TS_SERVER_SESSION_SHARING_MATCH_MASK_HOSTONLY & match_style) && !(TS_SERVER_SESSION_SHARING_MATCH_MASK_IP & match_style)) {
+    bucket = &m_fqdn_summary[PoolableSession::FQDNLinkage::hash_of(host_hash) & (SUMMARY_SIZE - 1)];
+  } else if (TS_SERVER_SESSION_SHARING_MATCH_MASK_IP & match_style) {
+    bucket = &m_ip_summary[PoolableSession::IPLinkage::hash_of(addr) & (SUMMARY_SIZE - 1)];
+  }
+  return bucket != nullptr && bucket->load(std::memory_order_relaxed) != 0;
 }
 
 bool
@@ -387,6 +420,10 @@ HttpSessionManager::acquire_session(HttpSM *sm, sockaddr const *ip, const char *
   if (this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_THREAD ||
       this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_HYBRID) {
     retval = _acquire_session(ip, hostname_hash, sm, match_style, TS_SERVER_SESSION_SHARING_POOL_THREAD);
+    // Before making a new connection, look for an idle one in the pools of the other threads.
+    if (retval == HSM_NOT_FOUND && m_steal_max_probes > 0) {
+      retval = _steal_session(ip, hostname_hash, sm, match_style);
+    }
   }
 
   //  If you didn't get a match, and the global pool is an option go there.
@@ -423,6 +460,38 @@ lockSessionPool(Ptr<ProxyMutex> &mutex, EThread *const ethread, TSServerSessionS
   return locked;
 }
 
+// Move the connection of @a ssn, just taken out of the locked @a pool, to @a ethread.
+// If that fails @a ssn is closed and @c false is returned.
+bool
+migrateSession(PoolableSession *ssn, ServerSessionPool *pool, HttpSM *sm, EThread *const ethread)
+{
+  UnixNetVConnection *server_vc = dynamic_cast<UnixNetVConnection *>(ssn->get_netvc());
+  if (server_vc) {
+    // Disable i/o on this vc now, but, hold onto the pool cont
+    // and the mutex to stop any stray events from getting in
+    server_vc->do_io_read(pool, 0, nullptr);
+    server_vc->do_io_write(pool, 0, nullptr);
+    UnixNetVConnection *new_vc = server_vc->migrateToCurrentThread(sm, ethread);
+    // The VC moved, free up the original one
+    if (new_vc != server_vc) {
+      ink_assert(new_vc == nullptr || new_vc->nh != nullptr);
+      if (!new_vc) {
+        // Close out the session, we were't able to get a connection
+        Metrics::Counter::increment(http_rsb.origin_shutdown_migration_failure);
+        ssn->do_io_close();
+        return false;
+      }
+      // Keep things from timing out on us
+      new_vc->set_inactivity_timeout(new_vc->get_inactivity_timeout());
+      ssn->set_netvc(new_vc);
+    } else {
+      // Keep things from timing out on us
+      server_vc->set_inactivity_timeout(server_vc->get_inactivity_timeout());
+    }
+  }
+  return true;
+}
+
 } // namespace
 
 HSMresult_t
@@ -457,33 +526,9 @@ HttpSessionManager::_acquire_session(sockaddr const *ip, CryptoHash const &hostn
         Dbg(dbg_ctl_http_ss, "[acquire session] global pool search %s", to_return ? "successful" : "failed");
         // At this point to_return has been removed from the pool. Do we need to move it
         // to the same thread?
-        if (to_return) {
-          UnixNetVConnection *server_vc = dynamic_cast<UnixNetVConnection *>(to_return->get_netvc());
-          if (server_vc) {
-            // Disable i/o on this vc now, but, hold onto the g_pool cont
-            // and the mutex to stop any stray events from getting in
-            server_vc->do_io_read(m_g_pool, 0, nullptr);
-            server_vc->do_io_write(m_g_pool, 0, nullptr);
-            UnixNetVConnection *new_vc = server_vc->migrateToCurrentThread(sm, ethread);
-            // The VC moved, free up the original one
-            if (new_vc != server_vc) {
-              ink_assert(new_vc == nullptr || new_vc->nh != nullptr);
-              if (!new_vc) {
-                // Close out to_return, we were't able to get a connection
-                Metrics::Counter::increment(http_rsb.origin_shutdown_migration_failure);
-                to_return->do_io_close();
-                to_return = nullptr;
-                retval    = HSM_NOT_FOUND;
-              } else {
-                // Keep things from timing out on us
-                new_vc->set_inactivity_timeout(new_vc->get_inactivity_timeout());
-                to_return->set_netvc(new_vc);
-              }
-            } else {
-              // Keep things from timing out on us
-              server_vc->set_inactivity_timeout(server_vc->get_inactivity_timeout());
-            }
-          }
+        if (to_return && !migrateSession(to_return, m_g_pool, sm, ethread)) {
+          to_return = nullptr;
+          retval    = HSM_NOT_FOUND;
         }
       }
     } else { // Didn't get the lock.  to_return is still NULL
@@ -514,6 +559,67 @@ HttpSessionManager::_acquire_session(sockaddr const *ip, CryptoHash const &hostn
   return retval;
 }
 
+HSMresult_t
+HttpSessionManager::_steal_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
+                                   TSServerSessionSharingMatchMask match_style)
+{
+  static thread_local unsigned cursor = 0;
+
+  EThread         *ethread   = this_ethread();
+  PoolableSession *to_return = nullptr;
+  HSMresult_t      retval    = HSM_NOT_FOUND;
+  int              probes    = 0;
+  ink_hrtime const start     = ink_get_hrtime();
+  auto const       threads   = eventProcessor.active_group_threads(ET_NET);
+  unsigned const   n_threads = threads.end() - threads.begin();
+
+  Metrics::Counter::increment(http_rsb.origin_steal_attempts);
+
+  // Start at a different thread each time so that the victims are spread out. Only the pools that
+  // may have a match are locked, and only with a try lock, so this never waits on another thread.
+  ++cursor;
+  for (unsigned i = 0; i < n_threads && probes < m_steal_max_probes && retval == HSM_NOT_FOUND; ++i) {
+    EThread           *thread = threads.begin()[(cursor + i) % n_threads];
+    ServerSessionPool *pool   = thread->server_session_pool;
+
+    if (thread == ethread || pool == nullptr || !pool->may_contain(ip, hostname_hash, match_style)) {
+      continue;
+    }
+    ++probes;
+
+    MUTEX_TRY_LOCK(lock, pool->mutex, ethread);
+    if (!lock.is_locked() || HSM_DONE != pool->acquireSession(ip, hostname_hash, match_style, sm, to_return)) {
+      continue;
+    }
+    // A multiplexed session stays in its pool and is shared by the transactions of its thread.
+    if (to_return->is_multiplexing()) {
+      continue;
+    }
+    Metrics::Gauge::decrement(http_rsb.pooled_server_connections);
+    if (!migrateSession(to_return, pool, sm, ethread)) {
+      continue;
+    }
+
+    // As in _acquire_session, hold the pool lock until the session is attached to the SM.
+    if (sm->create_server_txn(to_return)) {
+      Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] stole session from thread %p", to_return->connection_id(), thread);
+      to_return->state = PoolableSession::SSN_IN_USE;
+      retval           = HSM_DONE;
+      Metrics::Counter::increment(http_rsb.origin_steal_success);
+    } else {
+      Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] failed to get transaction on stolen session",
+          to_return->connection_id());
+      to_return->do_io_close();
+      retval = HSM_RETRY;
+    }
+  }
+
+  Metrics::Counter::increment(http_rsb.origin_steal_probes, probes);
+  Metrics::Counter::increment(http_rsb.origin_steal_time, ink_hrtime_to_usec(ink_get_hrtime() - start));
+
+  return retval;
+}
+
 HSMresult_t
 HttpSessionManager::release_session(PoolableSession *to_release)
 {
@@ -561,7 +667,9 @@ ServerSessionPool::removeSession(PoolableSession *to_remove)
         m_ip_pool.count());
   }
   m_fqdn_pool.erase(to_remove);
-  m_ip_pool.erase(to_remove);
+  if (m_ip_pool.erase(to_remove)) {
+    this->summarize(to_remove, -1);
+  }
   if (dbg_ctl_http_ss.on()) {
     Dbg(dbg_ctl_http_ss, "After Remove session %p m_fqdn_pool size=%zu m_ip_pool_size=%zu", to_remove, m_fqdn_pool.count(),
         m_ip_pool.count());
@@ -576,6 +684,7 @@ ServerSessionPool::addSession(PoolableSession *ss)
   // put it in the pools.
   m_ip_pool.insert(ss);
   m_fqdn_pool.insert(ss);
+  this->summarize(ss, 1);
 
   if (dbg_ctl_http_ss.on()) {
     char peer_ip[INET6_ADDRPORTSTRLEN];
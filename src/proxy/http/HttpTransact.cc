@@ -1097,7 +1097,6 @@ HttpTransact::EndRemapRequest(State *s)
       error_body_type = "redirect#moved_temporarily";
     }
     build_error_response(s, s->http_return_code, "Redirect", error_body_type);
-    ats_free(s->remap_redirect);
     s->reverse_proxy = false;
     goto done;
   }
@@ -2307,6 +2306,7 @@ HttpTransact::HandlePushCacheWrite(State *s)
 
   case CACHE_WL_FAIL:
   case CACHE_WL_READ_RETRY:
+  case CACHE_WL_NOT_ADMITTED:
     // No write lock, can not complete request so bail
     HandlePushError(s, "Cache Write Failed");
     break;
@@ -3176,6 +3176,13 @@ HttpTransact::handle_cache_write_lock(State *s)
       break;
     }
     break;
+  case CACHE_WL_NOT_ADMITTED:
+    // The cache declined the object, proxy only. This is not a write failure, so the
+    // cache_open_write_fail_action does not apply.
+    s->cache_info.action       = CACHE_DO_NO_ACTION;
+    s->cache_info.write_status = NO_CACHE_WRITE;
+    remove_ims                 = true;
+    break;
   case CACHE_WL_READ_RETRY:
     s->request_sent_time      = UNDEFINED_TIME;
     s->response_received_time = UNDEFINED_TIME;
@@ -4820,6 +4827,7 @@ HttpTransact::handle_transform_cache_write(State *s)
     s->cache_info.transform_action = CACHE_DO_WRITE;
     break;
   case CACHE_WL_FAIL:
+  case CACHE_WL_NOT_ADMITTED:
     // No write lock, ignore the cache
     s->cache_info.transform_action       = CACHE_DO_NO_ACTION;
     s->cache_info.transform_write_status = CACHE_WRITE_LOCK_MISS;
@@ -35,6 +35,7 @@ PreWarmConfigParams::PreWarmConfigParams()
   // RECU_DYNAMIC
   REC_ReadConfigInteger(event_period, "proxy.config.tunnel.prewarm.event_period");
   REC_ReadConfigInteger(algorithm, "proxy.config.tunnel.prewarm.algorithm");
+  REC_ReadConfigInteger(max_connections, "proxy.config.tunnel.prewarm.max_connections");
 }
 
 ////
@@ -48,6 +49,7 @@ PreWarmConfig::startup()
   // dynamic configs
   _config_update_handler->attach("proxy.config.tunnel.prewarm.event_period");
   _config_update_handler->attach("proxy.config.tunnel.prewarm.algorithm");
+  _config_update_handler->attach("proxy.config.tunnel.prewarm.max_connections");
 
   reconfigure();
 }
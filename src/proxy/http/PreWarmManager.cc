@@ -703,6 +703,10 @@ PreWarmQueue::state_running(int event, void *data)
 {
   switch (event) {
   case EVENT_INTERVAL: {
+    if (_algorithm == PreWarm::Algorithm::V3) {
+      _update_targets();
+    }
+
     for (auto &[dst, info] : _map) {
       // mentain queues
       _delete_closed_sm(info.init_list);
@@ -845,6 +849,7 @@ PreWarmQueue::_delete_prewarm_sm(PreWarmSM *sm)
 
    V1: Expand the pool size to requested size
    V2: Expand the pool size to current size + miss * rate
+   V3: Expand the pool size to the forecast demand, within the budget
  */
 void
 PreWarmQueue::_prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const Info &info)
@@ -853,6 +858,10 @@ PreWarmQueue::_prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const
   uint32_t       n            = 0;
 
   switch (_algorithm) {
+  case PreWarm::Algorithm::V3: {
+    n = PreWarm::prewarm_size_v3_on_event_interval(info.target, current_size);
+    break;
+  }
   case PreWarm::Algorithm::V2: {
     n = PreWarm::prewarm_size_v2_on_event_interval(info.stat.hit, info.stat.miss, current_size, info.conf->min, info.conf->max,
                                                    info.conf->rate);
@@ -877,11 +886,19 @@ PreWarmQueue::_prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const
 
    V1: Do nothing
    V2: Start pre-warming a new netvc
+   V3: Start pre-warming a new netvc, if the pool is below its target
  */
 void
 PreWarmQueue::_prewarm_on_dequeue(const PreWarm::SPtrConstDst &dst, const Info &info)
 {
   switch (_algorithm) {
+  case PreWarm::Algorithm::V3: {
+    const uint32_t current_size = info.init_list->size() + info.open_list->size();
+    if (current_size < info.target) {
+      _new_prewarm_sm(dst, info.conf, info.stats_ids);
+    }
+    break;
+  }
   case PreWarm::Algorithm::V2: {
     const int32_t current_size = info.init_list->size() + info.open_list->size();
     if (current_size < info.conf->max) {
@@ -897,6 +914,35 @@ PreWarmQueue::_prewarm_on_dequeue(const PreWarm::SPtrConstDst &dst, const Info &
   }
 }
 
+/**
+   Update the demand of each pool with the requests of the last period, and set the target size of the pools for the next
+   one (algorithm v3)
+ */
+void
+PreWarmQueue::_update_targets()
+{
+  uint64_t sum_min    = 0;
+  uint64_t sum_target = 0;
+
+  for (auto &[dst, info] : _map) {
+    info.demand.update(info.stat.hit + info.stat.miss);
+    info.target  = PreWarm::prewarm_target_v3(info.demand, info.conf->min, info.conf->max, info.conf->rate);
+    sum_min     += std::min<uint32_t>(info.conf->min, info.target);
+    sum_target  += info.target;
+  }
+
+  const double scale = PreWarm::prewarm_budget_scale_v3(sum_min, sum_target, _budget);
+  if (scale < 1.0) {
+    for (auto &[dst, info] : _map) {
+      const uint32_t min = std::min<uint32_t>(info.conf->min, info.target);
+      info.target        = min + static_cast<uint32_t>((info.target - min) * scale);
+    }
+  }
+
+  Dbg(dbg_ctl_v_prewarm_q, "budget=%" PRIu32 " sum_min=%" PRIu64 " sum_target=%" PRIu64 " scale=%f", _budget, sum_min, sum_target,
+      scale);
+}
+
 /**
    Reconfigure _map based on new SNIConfig
  */
@@ -908,6 +954,10 @@ PreWarmQueue::_reconfigure()
 
     _event_period = HRTIME_MSECONDS(prewarm_conf->event_period);
     _algorithm    = PreWarm::algorithm_version(prewarm_conf->algorithm);
+
+    // The budget is for all the threads, share it evenly as the connections are.
+    const int n_threads = std::max(1, eventProcessor.thread_group[ET_NET]._count);
+    _budget             = (prewarm_conf->max_connections + n_threads - 1) / n_threads;
   }
 
   // build new map based on new SNIConfig
@@ -923,7 +973,8 @@ PreWarmQueue::_reconfigure()
       // copy from old info
       const Info &old_info = res->second;
 
-      new_map[dst] = Info{old_info.init_list, old_info.open_list, conf, old_info.stats_ids, old_info.stat};
+      new_map[dst] =
+        Info{old_info.init_list, old_info.open_list, conf, old_info.stats_ids, old_info.stat, old_info.demand, old_info.target};
     } else {
       // make new info
       PreWarm::SPtrConstStatsIds stats_ids;
@@ -936,7 +987,7 @@ PreWarmQueue::_reconfigure()
 
       Queue *init_list = new Queue();
       Queue *open_list = new Queue();
-      new_map[dst]     = Info{init_list, open_list, conf, stats_ids, {}};
+      new_map[dst]     = Info{init_list, open_list, conf, stats_ids, {}, {}, 0};
     }
   }
 
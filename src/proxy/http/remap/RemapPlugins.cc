@@ -70,7 +70,7 @@ RemapPlugins::run_plugin(RemapPluginInst *plugin)
 
   // First step after plugin remap must be "redirect url" check
   if ((TSREMAP_DID_REMAP == plugin_retcode || TSREMAP_DID_REMAP_STOP == plugin_retcode) && rri.redirect) {
-    _s->remap_redirect = _request_url->string_get(nullptr);
+    _s->remap_redirect = _request_url->string_get(&_s->arena);
   }
 
   return plugin_retcode;
@@ -29,6 +29,13 @@ namespace
 {
 DbgCtl dbg_ctl_url_rewrite{"url_rewrite"};
 
+// Redirect targets live for the transaction, so they are stored in the transaction arena.
+char *
+redirect_store(HttpTransact::State *s, const char *url)
+{
+  return url ? s->arena.str_store(url, strlen(url)) : nullptr;
+}
+
 } // end anonymous namespace
 /**
   Most of this comes from UrlRewrite::Remap(). Generally, all this does
@@ -217,14 +224,14 @@ RemapProcessor::finish_remap(HttpTransact::State *s, UrlRewrite *table)
             }
           }
           tmp_redirect_buf[sizeof(tmp_redirect_buf) - 1] = 0;
-          *redirect_url                                  = ats_strdup(tmp_redirect_buf);
+          *redirect_url                                  = redirect_store(s, tmp_redirect_buf);
         }
       } else {
-        *redirect_url = ats_strdup(table->http_default_redirect_url);
+        *redirect_url = redirect_store(s, table->http_default_redirect_url);
       }
 
       if (*redirect_url == nullptr) {
-        *redirect_url = ats_strdup(map->filter_redirect_url ? map->filter_redirect_url : table->http_default_redirect_url);
+        *redirect_url = redirect_store(s, map->filter_redirect_url ? map->filter_redirect_url : table->http_default_redirect_url);
       }
       if (HTTP_STATUS_NONE == s->http_return_code) {
         s->http_return_code = HTTP_STATUS_MOVED_TEMPORARILY;
@@ -0,0 +1,120 @@
+/** @file
+
+  Unit Tests for milestone latency histograms
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/http/HttpMilestoneHistograms.h"
+
+#include "catch.hpp"
+
+using Pair = HttpMilestoneHistograms::Pair;
+
+TEST_CASE("Milestone histogram configuration", "[http][milestone]")
+{
+  std::vector<Pair> pairs;
+  std::string       error;
+
+  REQUIRE(HttpMilestoneHistograms::parse("", pairs, error));
+  CHECK(pairs.empty());
+
+  REQUIRE(HttpMilestoneHistograms::parse(" TS_MILESTONE_UA_BEGIN-TS_MILESTONE_SERVER_FIRST_READ, "
+                                         "cache_open_read_begin-CACHE_OPEN_READ_END tls_handshake_start-tls_handshake_end",
+                                         pairs, error));
+  REQUIRE(pairs.size() == 3);
+  CHECK(pairs[0].start == TS_MILESTONE_UA_BEGIN);
+  CHECK(pairs[0].end == TS_MILESTONE_SERVER_FIRST_READ);
+  CHECK(pairs[0].name == "ua_begin_to_server_first_read");
+  CHECK(pairs[1].start == TS_MILESTONE_CACHE_OPEN_READ_BEGIN);
+  CHECK(pairs[1].name == "cache_open_read_begin_to_cache_open_read_end");
+  CHECK(pairs[2].end == TS_MILESTONE_TLS_HANDSHAKE_END);
+
+  CHECK_FALSE(HttpMilestoneHistograms::parse("UA_BEGIN-UA_CLOSE UA_BEGIN", pairs, error));
+  CHECK(error == "UA_BEGIN");
+  CHECK_FALSE(HttpMilestoneHistograms::parse("UA_BEGIN-UA_SHUT", pairs, error));
+  CHECK(error == "UA_BEGIN-UA_SHUT");
+  CHECK_FALSE(HttpMilestoneHistograms::parse("-UA_CLOSE", pairs, error));
+}
+
+TEST_CASE("Milestone histogram recording", "[http][milestone]")
+{
+  std::vector<Pair> pairs;
+  std::string       error;
+  REQUIRE(HttpMilestoneHistograms::parse("UA_BEGIN-SERVER_FIRST_READ CACHE_OPEN_READ_BEGIN-CACHE_OPEN_READ_END", pairs, error));
+
+  // Two threads, merged as on a stat sync.
+  HttpMilestoneHistograms t1(pairs.size()), t2(pairs.size());
+  TransactionMilestones   ms;
+
+  // 1000 transactions of 1..1000 milliseconds, none of them reading the cache.
+  for (int i = 1; i <= 1000; ++i) {
+    ms[TS_MILESTONE_UA_BEGIN]          = HRTIME_SECONDS(100);
+    ms[TS_MILESTONE_SERVER_FIRST_READ] = HRTIME_SECONDS(100) + HRTIME_MSECONDS(i);
+    (i % 2 ? t1 : t2).record(pairs, ms);
+  }
+  // A transaction that never reached the origin.
+  ms[TS_MILESTONE_SERVER_FIRST_READ] = 0;
+  t1.record(pairs, ms);
+
+  HttpMilestoneHistograms::Counts merged{};
+  t1.add_to(0, merged);
+  t2.add_to(0, merged);
+
+  uint64_t count = 0;
+  for (auto n : merged) {
+    count += n;
+  }
+  CHECK(count == 1000);
+
+  // The buckets are an eighth of a power of 2 wide, so the estimates are within 12.5%.
+  auto p50  = HttpMilestoneHistograms::percentile(merged, 500);
+  auto p99  = HttpMilestoneHistograms::percentile(merged, 990);
+  auto p999 = HttpMilestoneHistograms::percentile(merged, 999);
+  CHECK(p50 >= 500000 * 7 / 8);
+  CHECK(p50 <= 500000 * 9 / 8);
+  CHECK(p99 >= 990000 * 7 / 8);
+  CHECK(p99 <= 990000 * 9 / 8);
+  CHECK(p999 >= 999000 * 7 / 8);
+  CHECK(p999 <= 999000 * 9 / 8);
+  CHECK(p50 < p99);
+  CHECK(p99 <= p999);
+
+  HttpMilestoneHistograms::Counts cache{};
+  t1.add_to(1, cache);
+  t2.add_to(1, cache);
+  CHECK(HttpMilestoneHistograms::percentile(cache, 500) == 0);
+}
+
+TEST_CASE("Milestone histogram percentiles", "[http][milestone]")
+{
+  using Graph = HttpMilestoneHistograms::Graph;
+
+  HttpMilestoneHistograms::Counts counts{};
+
+  // Exact in the underflow range.
+  counts[3] = 10;
+  CHECK(HttpMilestoneHistograms::percentile(counts, 500) == 3);
+  CHECK(HttpMilestoneHistograms::percentile(counts, 999) == 3);
+
+  // Overflow is reported as the bound.
+  counts[Graph::N_BUCKETS - 1] = 990;
+  CHECK(HttpMilestoneHistograms::percentile(counts, 5) == 3);
+  CHECK(HttpMilestoneHistograms::percentile(counts, 999) == Graph::OVERFLOW_BOUND);
+}
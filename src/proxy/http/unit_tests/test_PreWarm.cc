@@ -219,4 +219,70 @@ TEST_CASE("PreWarm Algorithm", "[prewarm]")
       }
     }
   }
+
+  SECTION("prewarm_target_v3")
+  {
+    SECTION("steady demand")
+    {
+      PreWarm::Demand demand;
+
+      for (int i = 0; i < 10; ++i) {
+        demand.update(10);
+      }
+      CHECK(demand.forecast() == Approx(10.0));
+      CHECK(PreWarm::prewarm_target_v3(demand, 0, -1, 1.0) == 10);
+      CHECK(PreWarm::prewarm_target_v3(demand, 0, -1, 1.5) == 15);
+      CHECK(PreWarm::prewarm_target_v3(demand, 20, -1, 1.0) == 20);
+      CHECK(PreWarm::prewarm_target_v3(demand, 0, 5, 1.0) == 5);
+    }
+
+    SECTION("ramp up")
+    {
+      PreWarm::Demand demand;
+
+      demand.update(10);
+      CHECK(demand.forecast() == Approx(10.0));
+      demand.update(20);
+      CHECK(demand.forecast() == Approx(16.5));
+      demand.update(30);
+      CHECK(demand.forecast() == Approx(26.775));
+
+      CHECK(PreWarm::prewarm_target_v3(demand, 10, 100, 1.0) == 27);
+      CHECK(PreWarm::prewarm_target_v3(demand, 10, 100, 1.5) == 41);
+      CHECK(PreWarm::prewarm_target_v3(demand, 10, 20, 1.0) == 20);
+      CHECK(PreWarm::prewarm_target_v3(demand, 30, 100, 1.0) == 30);
+    }
+
+    SECTION("ramp down")
+    {
+      PreWarm::Demand demand;
+
+      demand.update(100);
+      demand.update(0);
+      CHECK(demand.forecast() == Approx(35.0));
+      demand.update(0);
+      CHECK(demand.forecast() == 0.0);
+
+      CHECK(PreWarm::prewarm_target_v3(demand, 10, 100, 1.0) == 10);
+      CHECK(PreWarm::prewarm_target_v3(demand, 0, 100, 1.0) == 0);
+    }
+  }
+
+  SECTION("prewarm_budget_scale_v3")
+  {
+    CHECK(PreWarm::prewarm_budget_scale_v3(10, 100, 0) == 1.0);
+    CHECK(PreWarm::prewarm_budget_scale_v3(10, 100, 200) == 1.0);
+    CHECK(PreWarm::prewarm_budget_scale_v3(10, 100, 100) == 1.0);
+    CHECK(PreWarm::prewarm_budget_scale_v3(10, 100, 55) == Approx(0.5));
+    CHECK(PreWarm::prewarm_budget_scale_v3(10, 100, 10) == 0.0);
+    CHECK(PreWarm::prewarm_budget_scale_v3(10, 100, 5) == 0.0);
+  }
+
+  SECTION("prewarm_size_v3_on_event_interval")
+  {
+    CHECK(PreWarm::prewarm_size_v3_on_event_interval(17, 10) == 7);
+    CHECK(PreWarm::prewarm_size_v3_on_event_interval(10, 17) == 0);
+    CHECK(PreWarm::prewarm_size_v3_on_event_interval(10, 10) == 0);
+    CHECK(PreWarm::prewarm_size_v3_on_event_interval(0, 0) == 0);
+  }
 }
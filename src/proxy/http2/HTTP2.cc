@@ -383,6 +383,20 @@ http2_parse_window_update(IOVec iov, uint32_t &size)
   return true;
 }
 
+bool
+http2_parse_priority_update(IOVec iov, Http2StreamId &prioritized_stream_id)
+{
+  byte_pointer                     ptr(iov.iov_base);
+  byte_addressable_value<uint32_t> sid;
+
+  memcpy_and_advance(sid.bytes, ptr);
+
+  sid.bytes[0]          &= 0x7f; // Clear the reserved bit
+  prioritized_stream_id  = ntohl(sid.value);
+
+  return true;
+}
+
 ParseResult
 http2_convert_header_from_2_to_1_1(HTTPHdr *headers)
 {
@@ -498,6 +512,7 @@ uint32_t Http2::header_table_size_limit            = 65536;
 uint32_t Http2::write_buffer_block_size            = 262144;
 float    Http2::write_size_threshold               = 0.5;
 uint32_t Http2::write_time_threshold               = 100;
+uint32_t Http2::write_coalescing                   = 1;
 uint32_t Http2::buffer_water_mark                  = 0;
 
 void
@@ -554,6 +569,7 @@ Http2::init()
   REC_EstablishStaticConfigInt32U(write_buffer_block_size, "proxy.config.http2.write_buffer_block_size");
   REC_EstablishStaticConfigFloat(write_size_threshold, "proxy.config.http2.write_size_threshold");
   REC_EstablishStaticConfigInt32U(write_time_threshold, "proxy.config.http2.write_time_threshold");
+  REC_EstablishStaticConfigInt32U(write_coalescing, "proxy.config.http2.write_coalescing");
   REC_EstablishStaticConfigInt32U(buffer_water_mark, "proxy.config.http2.default_buffer_water_mark");
 
   // If any settings is broken, ATS should not start
@@ -630,9 +646,72 @@ Http2::init()
   http2_frame_metrics_in[9]  = http2_rsb.continuation_frames_in;
   http2_frame_metrics_in[10] = http2_rsb.unknown_frames_in;
 
+  static const char *frame_buckets[] = {"1", "2", "4", "8", "16", "32", "64", "inf"};
+  static const char *byte_buckets[]  = {"256", "1k", "4k", "16k", "64k", "256k", "inf"};
+  for (int i = 0; i < Http2WriteStats::FRAME_BUCKETS; ++i) {
+    http2_rsb.write_frames[i] = Metrics::Counter::createPtr(std::string("proxy.process.http2.write_frames_le_") + frame_buckets[i]);
+  }
+  for (int i = 0; i < Http2WriteStats::BYTE_BUCKETS; ++i) {
+    http2_rsb.write_bytes[i] = Metrics::Counter::createPtr(std::string("proxy.process.http2.write_bytes_le_") + byte_buckets[i]);
+  }
+
   http2_init();
 }
 
+int
+Http2WriteStats::frame_bucket(uint32_t n_frames)
+{
+  if (n_frames <= 1) {
+    return 0;
+  }
+  // ceil(log2(n_frames))
+  return std::min(FRAME_BUCKETS - 1, 32 - __builtin_clz(n_frames - 1));
+}
+
+int
+Http2WriteStats::byte_bucket(uint64_t n_bytes)
+{
+  if (n_bytes <= 256) {
+    return 0;
+  }
+  // ceil(log4(n_bytes / 256))
+  int log2 = 64 - __builtin_clzll(n_bytes - 1);
+  return std::min(BYTE_BUCKETS - 1, (log2 - 8 + 1) / 2);
+}
+
+void
+Http2WriteStats::publish() const
+{
+  for (int i = 0; i < FRAME_BUCKETS; ++i) {
+    if (frames[i]) {
+      Metrics::Counter::increment(http2_rsb.write_frames[i], frames[i]);
+    }
+  }
+  for (int i = 0; i < BYTE_BUCKETS; ++i) {
+    if (bytes[i]) {
+      Metrics::Counter::increment(http2_rsb.write_bytes[i], bytes[i]);
+    }
+  }
+}
+
+void
+http2_adapt_write_thresholds(uint32_t &size, ink_hrtime &time, uint32_t size_limit, ink_hrtime time_limit, uint64_t cwnd,
+                             ink_hrtime rtt)
+{
+  // Never less than a full DATA frame of the default size.
+  constexpr uint32_t min_size = HTTP2_FRAME_HEADER_LEN + 16384;
+  constexpr ink_hrtime min_time = HRTIME_MSECOND;
+
+  size = size_limit;
+  if (cwnd > 0) {
+    size = std::min<uint64_t>(size_limit, std::max<uint64_t>(cwnd, min_size));
+  }
+  time = time_limit;
+  if (rtt > 0) {
+    time = std::min(time_limit, std::max(rtt / 4, min_time));
+  }
+}
+
 void
 http2_init()
 {
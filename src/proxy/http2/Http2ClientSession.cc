@@ -127,7 +127,7 @@ Http2ClientSession::new_connection(NetVConnection *new_vc, MIOBuffer *iobuf, IOB
   this->write_buffer->water_mark = buffer_water_mark;
 
   this->_write_buffer_reader  = this->write_buffer->alloc_reader();
-  this->_write_size_threshold = index_to_buffer_size(buffer_block_size_index) * Http2::write_size_threshold;
+  this->_init_write_thresholds(index_to_buffer_size(buffer_block_size_index));
 
   this->_handle_if_ssl(new_vc);
 
@@ -204,12 +204,17 @@ Http2ClientSession::main_event_handler(int event, void *edata)
   case VC_EVENT_WRITE_READY:
   case VC_EVENT_WRITE_COMPLETE:
     this->connection_state.restart_streams();
-    if ((ink_get_hrtime() >= this->_write_buffer_last_flush + HRTIME_MSECONDS(this->_write_time_threshold))) {
+    if ((ink_get_hrtime() >= this->_write_buffer_last_flush + this->_write_time_threshold)) {
       this->flush();
     }
     retval = 0;
     break;
 
+  case NET_EVENT_FLUSH:
+    this->flush_deferred();
+    retval = 0;
+    break;
+
   case HTTP2_SESSION_EVENT_PRIO:
   default:
     Http2SsnDebug("unexpected event=%d edata=%p", event, edata);
@@ -23,6 +23,7 @@
 
 #include "proxy/http2/Http2CommonSession.h"
 #include "proxy/http/HttpDebugNames.h"
+#include "../../iocore/net/P_Net.h"
 
 #define REMEMBER(e, r)                          \
   {                                             \
@@ -79,6 +80,12 @@ Http2CommonSession::common_free(ProxySession *ssn)
   REMEMBER(NO_EVENT, this->recursion)
   Http2SsnDebug("session free");
 
+  if (this->_deferred_flush) {
+    this->_deferred_flush->cancel_flush(ssn);
+    this->_deferred_flush = nullptr;
+  }
+  this->_write_stats.publish();
+
   // Don't free active ProxySession
   ink_release_assert(ssn->is_active() == false);
 
@@ -153,15 +160,16 @@ Http2CommonSession::xmit(const Http2TxFrame &frame, bool flush)
 {
   int64_t len                       = frame.write_to(this->write_buffer);
   this->_pending_sending_data_size += len;
+  ++this->_pending_sending_frames;
   if (!flush) {
     // Flush if we already use half of the buffer to avoid adding a new block to the chain.
     // A frame size can be 16MB at maximum so blocks can be added, but that's fine.
     if (this->_pending_sending_data_size >= this->_write_size_threshold) {
       flush = true;
-    } else {
+    } else if (this->_deferred_flush == nullptr) {
       // Observe that schedule_transmit will only schedule the first time we
       // don't flush because the threshold is not met.
-      this->connection_state.schedule_retransmit(HRTIME_MSECONDS(Http2::write_time_threshold));
+      this->connection_state.schedule_retransmit(this->_write_time_threshold);
     }
   }
   if (flush) {
@@ -175,13 +183,81 @@ void
 Http2CommonSession::flush()
 {
   this->connection_state.cancel_retransmit();
+  if (this->_pending_sending_data_size == 0 || this->_deferred_flush != nullptr) {
+    return;
+  }
+
+  // Write at the loop tail, together with the frames the other streams produce in this loop.
+  if (Http2::write_coalescing) {
+    EThread        *t     = this_ethread();
+    NetVConnection *netvc = this->get_netvc();
+    if (netvc != nullptr && netvc->thread == t && t->is_event_type(ET_NET)) {
+      this->_deferred_flush = get_NetHandler(t);
+      this->_deferred_flush->defer_flush(this->get_proxy_session());
+      return;
+    }
+  }
+
+  this->_write_pending_frames();
+}
+
+void
+Http2CommonSession::flush_deferred()
+{
+  this->_deferred_flush = nullptr;
+  this->connection_state.cancel_retransmit();
+  this->_write_pending_frames();
+}
+
+void
+Http2CommonSession::_write_pending_frames()
+{
   if (this->_pending_sending_data_size > 0) {
+    this->_write_stats.record(this->_pending_sending_frames, this->_pending_sending_data_size);
     this->_pending_sending_data_size = 0;
+    this->_pending_sending_frames    = 0;
     this->_write_buffer_last_flush   = ink_get_hrtime();
+    this->_adapt_write_thresholds();
     write_reenable();
   }
 }
 
+void
+Http2CommonSession::_init_write_thresholds(int64_t buffer_size)
+{
+  this->_write_size_limit     = buffer_size * Http2::write_size_threshold;
+  this->_write_time_limit     = HRTIME_MSECONDS(Http2::write_time_threshold);
+  this->_write_size_threshold = this->_write_size_limit;
+  this->_write_time_threshold = this->_write_time_limit;
+}
+
+void
+Http2CommonSession::_adapt_write_thresholds()
+{
+  static constexpr ink_hrtime interval = HRTIME_MSECONDS(100);
+
+  if (!Http2::write_coalescing || this->_write_buffer_last_flush < this->_write_thresholds_time + interval) {
+    return;
+  }
+  this->_write_thresholds_time = this->_write_buffer_last_flush;
+
+  uint64_t   cwnd = 0;
+  ink_hrtime rtt  = 0;
+#if defined(TCP_INFO) && defined(HAVE_STRUCT_TCP_INFO)
+  if (NetVConnection *netvc = this->get_netvc(); netvc != nullptr) {
+    struct tcp_info info;
+    socklen_t       info_len = sizeof(info);
+    if (getsockopt(netvc->get_socket(), IPPROTO_TCP, TCP_INFO, &info, &info_len) == 0) {
+      cwnd = static_cast<uint64_t>(info.tcpi_snd_cwnd) * info.tcpi_snd_mss;
+      rtt  = HRTIME_USECONDS(info.tcpi_rtt);
+    }
+  }
+#endif
+
+  http2_adapt_write_thresholds(this->_write_size_threshold, this->_write_time_threshold, this->_write_size_limit,
+                               this->_write_time_limit, cwnd, rtt);
+}
+
 int
 Http2CommonSession::state_read_connection_preface(int event, void *edata)
 {
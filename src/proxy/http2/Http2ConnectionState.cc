@@ -34,6 +34,7 @@
 #include "proxy/http/HttpSM.h"
 
 #include "iocore/net/TLSSNISupport.h"
+#include "iocore/net/TLSBasicSupport.h"
 
 #include "tscore/ink_assert.h"
 #include "tscore/ink_memory.h"
@@ -398,7 +399,7 @@ Http2ConnectionState::rcv_headers_frame(const Http2Frame &frame)
     header_block_fragment_length -= HTTP2_PRIORITY_LEN;
   }
 
-  if (new_stream && Http2::stream_priority_enabled) {
+  if (new_stream && Http2::stream_priority_enabled == HTTP2_STREAM_PRIORITY_DEPENDENCY_TREE) {
     Http2DependencyTree::Node *node = this->dependency_tree->find(stream_id);
     if (node != nullptr) {
       stream->priority_node = node;
@@ -557,7 +558,7 @@ Http2ConnectionState::rcv_priority_frame(const Http2Frame &frame)
                       "PRIORITY frame depends on itself");
   }
 
-  if (!Http2::stream_priority_enabled) {
+  if (Http2::stream_priority_enabled != HTTP2_STREAM_PRIORITY_DEPENDENCY_TREE) {
     return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
   }
 
@@ -600,6 +601,76 @@ Http2ConnectionState::rcv_priority_frame(const Http2Frame &frame)
   return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
 }
 
+/*
+ * [RFC 9218] 7.1 The PRIORITY_UPDATE Frame
+ *
+ */
+Http2Error
+Http2ConnectionState::rcv_priority_update_frame(const Http2Frame &frame)
+{
+  const Http2StreamId stream_id      = frame.header().streamid;
+  const uint32_t      payload_length = frame.header().length;
+
+  Http2StreamDebug(this->session, stream_id, "Received PRIORITY_UPDATE frame");
+
+  // Without extensible priorities the frame type is not supported, and is discarded as an unknown type would be.
+  if (Http2::stream_priority_enabled != HTTP2_STREAM_PRIORITY_EXTENSIBLE) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
+  }
+
+  // If a PRIORITY_UPDATE frame is received with a stream identifier other than 0x00, the recipient MUST respond with a
+  // connection error of type PROTOCOL_ERROR.
+  if (stream_id != HTTP2_CONNECTION_CONTROL_STREAM) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_PROTOCOL_ERROR,
+                      "priority update non-zero stream_id");
+  }
+
+  if (payload_length < HTTP2_PRIORITY_UPDATE_LEN) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_FRAME_SIZE_ERROR,
+                      "priority update bad length");
+  }
+
+  uint8_t buf[HTTP2_PRIORITY_UPDATE_LEN] = {0};
+  frame.reader()->memcpy(buf, HTTP2_PRIORITY_UPDATE_LEN, 0);
+
+  Http2StreamId prioritized_stream_id = 0;
+  if (!http2_parse_priority_update(make_iovec(buf, HTTP2_PRIORITY_UPDATE_LEN), prioritized_stream_id)) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_PROTOCOL_ERROR,
+                      "priority update parse error");
+  }
+
+  // A PRIORITY_UPDATE frame with a Prioritized Stream ID of 0x00 MUST be treated as a connection error of type PROTOCOL_ERROR.
+  if (prioritized_stream_id == HTTP2_CONNECTION_CONTROL_STREAM) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_PROTOCOL_ERROR,
+                      "priority update 0 prioritized stream_id");
+  }
+
+  // PRIORITY_UPDATE frames share the limit of PRIORITY frames
+  this->increment_received_priority_frame_count();
+  if (configured_max_priority_frames_per_minute != 0 &&
+      this->get_received_priority_frame_count() > configured_max_priority_frames_per_minute) {
+    Metrics::Counter::increment(http2_rsb.max_priority_frames_per_minute_exceeded);
+    Http2StreamDebug(this->session, prioritized_stream_id,
+                     "Observed too frequent priority changes: %u priority changes within a last minute",
+                     this->get_received_priority_frame_count());
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_ENHANCE_YOUR_CALM,
+                      "recv priority update too frequent priority changes");
+  }
+
+  // A stream that is not open yet or already closed keeps its priority, servers are not required to buffer updates.
+  Http2Stream *stream = this->find_stream(prioritized_stream_id);
+  if (stream == nullptr) {
+    Http2StreamDebug(this->session, prioritized_stream_id, "PRIORITY_UPDATE for a stream that is not open, ignored");
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
+  }
+
+  std::string value(payload_length - HTTP2_PRIORITY_UPDATE_LEN, '\0');
+  frame.reader()->memcpy(value.data(), value.size(), HTTP2_PRIORITY_UPDATE_LEN);
+  this->reprioritize_stream(stream, ExtensiblePriority::parse(value));
+
+  return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
+}
+
 Http2Error
 Http2ConnectionState::rcv_rst_stream_frame(const Http2Frame &frame)
 {
@@ -1254,7 +1325,7 @@ Http2ConnectionState::init(Http2CommonSession *ssn)
 
   local_hpack_handle = new HpackHandle(HTTP2_HEADER_TABLE_SIZE);
   peer_hpack_handle  = new HpackHandle(HTTP2_HEADER_TABLE_SIZE);
-  if (Http2::stream_priority_enabled) {
+  if (Http2::stream_priority_enabled == HTTP2_STREAM_PRIORITY_DEPENDENCY_TREE) {
     dependency_tree = new DependencyTree(this->_get_configured_max_concurrent_streams());
   }
 
@@ -1402,7 +1473,7 @@ Http2ConnectionState::rcv_frame(const Http2Frame *frame)
 
   // [RFC 7540] 5.5. Extending HTTP/2
   //   Implementations MUST discard frames that have unknown or unsupported types.
-  if (frame->header().type >= HTTP2_FRAME_TYPE_MAX) {
+  if (frame->header().type >= HTTP2_FRAME_TYPE_MAX && frame->header().type != HTTP2_FRAME_TYPE_PRIORITY_UPDATE) {
     Http2StreamDebug(session, stream_id, "Discard a frame which has unknown type, type=%x", frame->header().type);
     return;
   }
@@ -1425,7 +1496,9 @@ Http2ConnectionState::rcv_frame(const Http2Frame *frame)
     return;
   }
 
-  if (this->_frame_handlers[frame->header().type]) {
+  if (frame->header().type == HTTP2_FRAME_TYPE_PRIORITY_UPDATE) {
+    error = this->rcv_priority_update_frame(*frame);
+  } else if (this->_frame_handlers[frame->header().type]) {
     error = (this->*_frame_handlers[frame->header().type])(*frame);
   } else {
     error = Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_CONNECTION, Http2ErrorCode::HTTP2_ERROR_INTERNAL_ERROR, "no handler");
@@ -1958,7 +2031,8 @@ Http2ConnectionState::delete_stream(Http2Stream *stream)
   Http2StreamDebug(session, stream->get_id(), "Delete stream");
   REMEMBER(NO_EVENT, this->recursion);
 
-  if (Http2::stream_priority_enabled) {
+  urgency_queue.remove(stream->urgency_entry);
+  if (Http2::stream_priority_enabled == HTTP2_STREAM_PRIORITY_DEPENDENCY_TREE) {
     Http2DependencyTree::Node *node       = stream->priority_node;
     Http2DependencyTree::Node *node_by_id = this->dependency_tree->find(stream->get_id());
     ink_assert(node == node_by_id);
@@ -2087,11 +2161,14 @@ Http2ConnectionState::schedule_stream_to_send_priority_frames(Http2Stream *strea
 {
   Http2StreamDebug(session, stream->get_id(), "Scheduling sending priority frames");
 
-  Http2DependencyTree::Node *node = stream->priority_node;
-  ink_release_assert(node != nullptr);
-
   SCOPED_MUTEX_LOCK(lock, this->mutex, this_ethread());
-  dependency_tree->activate(node);
+  if (Http2::stream_priority_enabled == HTTP2_STREAM_PRIORITY_EXTENSIBLE) {
+    urgency_queue.push(stream->urgency_entry);
+  } else {
+    Http2DependencyTree::Node *node = stream->priority_node;
+    ink_release_assert(node != nullptr);
+    dependency_tree->activate(node);
+  }
 
   if (_priority_event == nullptr) {
     SET_HANDLER(&Http2ConnectionState::main_event_handler);
@@ -2138,6 +2215,11 @@ Http2ConnectionState::cancel_retransmit()
 void
 Http2ConnectionState::send_data_frames_depends_on_priority()
 {
+  if (Http2::stream_priority_enabled == HTTP2_STREAM_PRIORITY_EXTENSIBLE) {
+    _send_data_frames_by_urgency();
+    return;
+  }
+
   Http2DependencyTree::Node *node = dependency_tree->top();
 
   // No node to send or no connection level window left
@@ -2184,6 +2266,59 @@ Http2ConnectionState::send_data_frames_depends_on_priority()
   return;
 }
 
+void
+Http2ConnectionState::_send_data_frames_by_urgency()
+{
+  Http2Stream *stream = urgency_queue.top();
+
+  // No stream to send or no connection level window left
+  if (stream == nullptr || _peer_rwnd <= 0) {
+    return;
+  }
+
+  Http2StreamDebug(session, stream->get_id(), "most urgent stream, urgency=%u incremental=%d",
+                   stream->urgency_entry.priority().urgency, stream->urgency_entry.priority().incremental);
+
+  size_t                   len    = 0;
+  Http2SendDataFrameResult result = send_a_data_frame(stream, len);
+
+  switch (result) {
+  case Http2SendDataFrameResult::NO_ERROR: {
+    // No response body to send
+    if (len == 0 && !stream->is_write_vio_done()) {
+      urgency_queue.remove(stream->urgency_entry);
+    } else {
+      urgency_queue.sent(stream->urgency_entry);
+      SCOPED_MUTEX_LOCK(stream_lock, stream->mutex, this_ethread());
+      stream->signal_write_event(stream->is_write_vio_done() ? VC_EVENT_WRITE_COMPLETE : VC_EVENT_WRITE_READY);
+    }
+    break;
+  }
+  case Http2SendDataFrameResult::DONE: {
+    urgency_queue.remove(stream->urgency_entry);
+    stream->initiating_close();
+    break;
+  }
+  default:
+    // When no stream level window left, wait for a WINDOW_UPDATE frame to schedule the stream again
+    urgency_queue.remove(stream->urgency_entry);
+    break;
+  }
+
+  if (!urgency_queue.empty() && _priority_event == nullptr) {
+    _priority_event = this_ethread()->schedule_imm_local(static_cast<Continuation *>(this), HTTP2_SESSION_EVENT_PRIO);
+  }
+}
+
+void
+Http2ConnectionState::reprioritize_stream(Http2Stream *stream, const ExtensiblePriority &priority)
+{
+  Http2StreamDebug(session, stream->get_id(), "PRIORITY - urgency: %u, incremental: %d", priority.urgency, priority.incremental);
+
+  SCOPED_MUTEX_LOCK(lock, this->mutex, this_ethread());
+  urgency_queue.reprioritize(stream->urgency_entry, priority);
+}
+
 Http2SendDataFrameResult
 Http2ConnectionState::send_a_data_frame(Http2Stream *stream, size_t &payload_length)
 {
@@ -2266,7 +2401,9 @@ Http2ConnectionState::send_a_data_frame(Http2Stream *stream, size_t &payload_len
   Http2StreamDebug(session, stream->get_id(), "Send a DATA frame - peer window con: %5zd stream: %5zd payload: %5zd flags: 0x%x",
                    _peer_rwnd, stream->get_peer_rwnd(), payload_length, flags);
 
-  Http2DataFrame data(stream->get_id(), flags, resp_reader, payload_length);
+  // A TLS connection copies the frames into records anyway, only a cleartext one can send the payload blocks as they are.
+  bool           reference = this->session->get_netvc() && !this->session->get_netvc()->get_service<TLSBasicSupport>();
+  Http2DataFrame data(stream->get_id(), flags, resp_reader, payload_length, reference);
   this->session->xmit(data, stream->is_tunneling() || flags & HTTP2_FLAGS_DATA_END_STREAM);
 
   if (flags & HTTP2_FLAGS_DATA_END_STREAM) {
@@ -2530,7 +2667,7 @@ Http2ConnectionState::send_push_promise_frame(Http2Stream *stream, URL &url, con
   }
 
   SCOPED_MUTEX_LOCK(stream_lock, stream->mutex, this_ethread());
-  if (Http2::stream_priority_enabled) {
+  if (Http2::stream_priority_enabled == HTTP2_STREAM_PRIORITY_DEPENDENCY_TREE) {
     Http2DependencyTree::Node *node = this->dependency_tree->find(id);
     if (node != nullptr) {
       stream->priority_node = node;
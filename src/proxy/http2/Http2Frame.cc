@@ -47,6 +47,13 @@ Http2Frame::is_from_early_data() const
 //
 // DATA Frame
 //
+
+namespace
+{
+// Payloads smaller than this are copied, a block reference costs more than copying a few bytes.
+constexpr int64_t DATA_PAYLOAD_REFERENCE_LEN = 1024;
+} // namespace
+
 int64_t
 Http2DataFrame::write_to(MIOBuffer *iobuffer) const
 {
@@ -58,11 +65,20 @@ Http2DataFrame::write_to(MIOBuffer *iobuffer) const
   // Write frame payload
   if (this->_reader && this->_payload_len > 0) {
     int64_t written = 0;
-    // Fill current IOBufferBlock as much as possible to reduce SSL_write() calls
-    while (written < this->_payload_len) {
-      int64_t read_len  = std::min(this->_payload_len - written, this->_reader->block_read_avail());
-      written          += iobuffer->write(this->_reader->start(), read_len);
-      this->_reader->consume(read_len);
+    if (this->_reference && this->_payload_len >= DATA_PAYLOAD_REFERENCE_LEN) {
+      // Append references to the payload blocks instead of copying them, only the header is new.
+      written = iobuffer->write(this->_reader, this->_payload_len);
+      this->_reader->consume(written);
+      // The payload blocks can't be written to, give the next frame a small block rather than a
+      // new block of the buffer size.
+      iobuffer->append_block(BUFFER_SIZE_INDEX_1K);
+    } else {
+      // Fill current IOBufferBlock as much as possible to reduce SSL_write() calls
+      while (written < this->_payload_len) {
+        int64_t read_len  = std::min(this->_payload_len - written, this->_reader->block_read_avail());
+        written          += iobuffer->write(this->_reader->start(), read_len);
+        this->_reader->consume(read_len);
+      }
     }
     len += written;
   }
@@ -126,7 +126,7 @@ Http2ServerSession::new_connection(NetVConnection *new_vc, MIOBuffer *iobuf, IOB
   auto buffer_block_size_index = iobuffer_size_to_index(Http2::write_buffer_block_size, MAX_BUFFER_SIZE_INDEX);
   this->write_buffer           = new_MIOBuffer(buffer_block_size_index);
   this->_write_buffer_reader   = this->write_buffer->alloc_reader();
-  this->_write_size_threshold  = index_to_buffer_size(buffer_block_size_index) * Http2::write_size_threshold;
+  this->_init_write_thresholds(index_to_buffer_size(buffer_block_size_index));
 
   uint32_t buffer_water_mark;
   if (auto snis = this->_vc->get_service<TLSSNISupport>(); snis && snis->hints_from_sni.http2_buffer_water_mark.has_value()) {
@@ -208,13 +208,18 @@ Http2ServerSession::main_event_handler(int event, void *edata)
   case VC_EVENT_WRITE_READY:
   case VC_EVENT_WRITE_COMPLETE:
     this->connection_state.restart_streams();
-    if ((ink_get_hrtime() >= this->_write_buffer_last_flush + HRTIME_MSECONDS(this->_write_time_threshold))) {
+    if ((ink_get_hrtime() >= this->_write_buffer_last_flush + this->_write_time_threshold)) {
       this->flush();
     }
 
     retval = 0;
     break;
 
+  case NET_EVENT_FLUSH:
+    this->flush_deferred();
+    retval = 0;
+    break;
+
   case HTTP2_SESSION_EVENT_PRIO:
   default:
     Http2SsnDebug("unexpected event=%d edata=%p", event, edata);
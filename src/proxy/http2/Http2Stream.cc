@@ -288,6 +288,13 @@ Http2Stream::send_headers(Http2ConnectionState &cstate)
       if (method_len == HTTP_LEN_CONNECT && strncmp(method, HTTP_METHOD_CONNECT, HTTP_LEN_CONNECT) == 0) {
         this->_is_tunneling = true;
       }
+
+      // [RFC 9218] 5. The Priority HTTP Header Field
+      if (Http2::stream_priority_enabled == HTTP2_STREAM_PRIORITY_EXTENSIBLE) {
+        if (auto priority = _receive_header.value_get(std::string_view{"Priority"}); !priority.empty()) {
+          cstate.reprioritize_stream(this, ExtensiblePriority::parse(priority));
+        }
+      }
     }
     ink_release_assert(this->_sm != nullptr);
     this->_http_sm_id = this->_sm->sm_id;
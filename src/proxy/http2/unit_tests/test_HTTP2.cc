@@ -194,3 +194,65 @@ TEST_CASE("Convert HTTPHdr", "[HTTP2]")
     CHECK_THAT(buf, Catch::StartsWith("HTTP/1.1 200 OK\r\n\r\n"));
   }
 }
+
+TEST_CASE("HTTP/2 write histograms", "[HTTP2]")
+{
+  CHECK(Http2WriteStats::frame_bucket(0) == 0);
+  CHECK(Http2WriteStats::frame_bucket(1) == 0);
+  CHECK(Http2WriteStats::frame_bucket(2) == 1);
+  CHECK(Http2WriteStats::frame_bucket(3) == 2);
+  CHECK(Http2WriteStats::frame_bucket(4) == 2);
+  CHECK(Http2WriteStats::frame_bucket(64) == 6);
+  CHECK(Http2WriteStats::frame_bucket(65) == 7);
+  CHECK(Http2WriteStats::frame_bucket(100000) == 7);
+
+  CHECK(Http2WriteStats::byte_bucket(9) == 0);
+  CHECK(Http2WriteStats::byte_bucket(256) == 0);
+  CHECK(Http2WriteStats::byte_bucket(257) == 1);
+  CHECK(Http2WriteStats::byte_bucket(1024) == 1);
+  CHECK(Http2WriteStats::byte_bucket(1025) == 2);
+  CHECK(Http2WriteStats::byte_bucket(16393) == 4);
+  CHECK(Http2WriteStats::byte_bucket(262144) == 5);
+  CHECK(Http2WriteStats::byte_bucket(262145) == 6);
+  CHECK(Http2WriteStats::byte_bucket(uint64_t(1) << 40) == 6);
+
+  Http2WriteStats stats;
+  stats.record(3, 300);
+  stats.record(4, 1000);
+  CHECK(stats.frames[2] == 2);
+  CHECK(stats.bytes[1] == 2);
+}
+
+TEST_CASE("HTTP/2 write thresholds", "[HTTP2]")
+{
+  uint32_t   size = 0;
+  ink_hrtime time = 0;
+
+  SECTION("Unknown connection")
+  {
+    http2_adapt_write_thresholds(size, time, 131072, HRTIME_MSECONDS(100), 0, 0);
+    CHECK(size == 131072);
+    CHECK(time == HRTIME_MSECONDS(100));
+  }
+
+  SECTION("Small congestion window")
+  {
+    http2_adapt_write_thresholds(size, time, 131072, HRTIME_MSECONDS(100), 10 * 1448, HRTIME_MSECONDS(40));
+    CHECK(size == 16384 + 9);
+    CHECK(time == HRTIME_MSECONDS(10));
+  }
+
+  SECTION("Large congestion window")
+  {
+    http2_adapt_write_thresholds(size, time, 131072, HRTIME_MSECONDS(100), 60 * 1448, HRTIME_MSECONDS(2));
+    CHECK(size == 60 * 1448);
+    CHECK(time == HRTIME_MSECOND);
+  }
+
+  SECTION("Bounded by the configuration")
+  {
+    http2_adapt_write_thresholds(size, time, 131072, HRTIME_MSECONDS(100), 1000 * 1448, HRTIME_SECONDS(1));
+    CHECK(size == 131072);
+    CHECK(time == HRTIME_MSECONDS(100));
+  }
+}
@@ -25,6 +25,8 @@
 
 #include "proxy/http2/Http2Frame.h"
 
+#include <string>
+
 TEST_CASE("Http2Frame", "[http2][Http2Frame]")
 {
   MIOBuffer      *miob   = new_MIOBuffer(BUFFER_SIZE_INDEX_32K);
@@ -60,6 +62,43 @@ TEST_CASE("Http2Frame", "[http2][Http2Frame]")
     CHECK(memcmp(buf, expected, written) == 0);
   }
 
+  SECTION("DATA")
+  {
+    MIOBuffer      *src   = new_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+    IOBufferReader *src_r = src->alloc_reader();
+
+    std::string payload(20000, 'x');
+    for (size_t i = 0; i < payload.size(); ++i) {
+      payload[i] = static_cast<char>('a' + i % 26);
+    }
+    src->write(payload.data(), payload.size());
+
+    // A small payload is always copied, a large one is referenced if requested.
+    for (auto [len, reference] : {std::pair{100U, true}, std::pair{2000U, false}, std::pair{16384U, true}}) {
+      IOBufferData  *data = src_r->block->data.get();
+      Http2DataFrame frame(3, HTTP2_FLAGS_DATA_END_STREAM, src_r, len, reference);
+      int64_t        written = frame.write_to(miob);
+
+      CHECK(written == static_cast<int64_t>(HTTP2_FRAME_HEADER_LEN + len));
+      CHECK(written == miob_r->read_avail());
+
+      bool shared = false;
+      for (IOBufferBlock *b = miob_r->get_current_block(); b; b = b->next.get()) {
+        shared = shared || b->data.get() == data;
+      }
+      CHECK(shared == (reference && len >= 1024));
+
+      std::string out(written, '\0');
+      CHECK(miob_r->read(out.data(), written) == written);
+      CHECK(static_cast<uint8_t>(out[3]) == HTTP2_FRAME_TYPE_DATA);
+      uint32_t length = (static_cast<uint8_t>(out[0]) << 16) | (static_cast<uint8_t>(out[1]) << 8) | static_cast<uint8_t>(out[2]);
+      CHECK(length == len);
+      CHECK(out.substr(HTTP2_FRAME_HEADER_LEN) == payload.substr(payload.size() - src_r->read_avail() - len, len));
+    }
+
+    free_MIOBuffer(src);
+  }
+
   free_MIOBuffer(miob);
 }
 
@@ -39,6 +39,7 @@
 #include "proxy/http3/Http3Transaction.h"
 #include "proxy/http3/Http3ProtocolEnforcer.h"
 #include "proxy/http3/Http3SettingsHandler.h"
+#include "proxy/http3/Http3PriorityUpdateHandler.h"
 #include "proxy/http3/Http3SettingsFramer.h"
 
 static constexpr char debug_tag[]   = "http3";
@@ -63,6 +64,9 @@ Http3App::Http3App(NetVConnection *client_vc, QUICConnection *qc, IpAllow::ACL &
   this->_settings_handler = new Http3SettingsHandler(this->_ssn);
   this->_control_stream_dispatcher.add_handler(this->_settings_handler);
 
+  this->_priority_update_handler = new Http3PriorityUpdateHandler(qc);
+  this->_control_stream_dispatcher.add_handler(this->_priority_update_handler);
+
   this->_settings_framer = new Http3SettingsFramer(client_vc->get_context());
   this->_control_stream_collector.add_generator(this->_settings_framer);
 
@@ -73,6 +77,7 @@ Http3App::~Http3App()
 {
   delete this->_ssn;
   delete this->_settings_handler;
+  delete this->_priority_update_handler;
   delete this->_settings_framer;
 }
 
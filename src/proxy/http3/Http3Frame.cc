@@ -26,10 +26,11 @@
 #include "proxy/http3/Http3Frame.h"
 #include "proxy/http3/Http3Config.h"
 
-ClassAllocator<Http3Frame>         http3FrameAllocator("http3FrameAllocator");
-ClassAllocator<Http3DataFrame>     http3DataFrameAllocator("http3DataFrameAllocator");
-ClassAllocator<Http3HeadersFrame>  http3HeadersFrameAllocator("http3HeadersFrameAllocator");
-ClassAllocator<Http3SettingsFrame> http3SettingsFrameAllocator("http3SettingsFrameAllocator");
+ClassAllocator<Http3Frame>               http3FrameAllocator("http3FrameAllocator");
+ClassAllocator<Http3DataFrame>           http3DataFrameAllocator("http3DataFrameAllocator");
+ClassAllocator<Http3HeadersFrame>        http3HeadersFrameAllocator("http3HeadersFrameAllocator");
+ClassAllocator<Http3SettingsFrame>       http3SettingsFrameAllocator("http3SettingsFrameAllocator");
+ClassAllocator<Http3PriorityUpdateFrame> http3PriorityUpdateFrameAllocator("http3PriorityUpdateFrameAllocator");
 
 constexpr int HEADER_OVERHEAD = 10; // This should work as long as a payload length is less than 64 bits
 
@@ -53,6 +54,8 @@ Http3Frame::type(const uint8_t *buf, size_t buf_len)
   ink_assert(ret != 1);
   if (type <= static_cast<uint64_t>(Http3FrameType::X_MAX_DEFINED)) {
     return static_cast<Http3FrameType>(type);
+  } else if (type == HTTP3_PRIORITY_UPDATE_FRAME_TYPE) {
+    return Http3FrameType::PRIORITY_UPDATE;
   } else {
     return Http3FrameType::UNKNOWN;
   }
@@ -70,7 +73,7 @@ Http3Frame::Http3Frame(const uint8_t *buf, size_t buf_len)
   // Ideally we'd simply pass this->_type to decode, but arm compilers complain with:
   // error: dereferencing type-punned pointer will break strict-aliasing rules
   int ret     = QUICVariableInt::decode(type, type_field_length, buf, buf_len);
-  this->_type = static_cast<Http3FrameType>(type);
+  this->_type = type == HTTP3_PRIORITY_UPDATE_FRAME_TYPE ? Http3FrameType::PRIORITY_UPDATE : static_cast<Http3FrameType>(type);
   ink_assert(ret != 1);
 
   // Length
@@ -99,7 +102,8 @@ Http3Frame::length() const
 Http3FrameType
 Http3Frame::type() const
 {
-  if (static_cast<uint64_t>(this->_type) <= static_cast<uint64_t>(Http3FrameType::X_MAX_DEFINED)) {
+  if (static_cast<uint64_t>(this->_type) <= static_cast<uint64_t>(Http3FrameType::X_MAX_DEFINED) ||
+      this->_type == Http3FrameType::PRIORITY_UPDATE) {
     return this->_type;
   } else {
     return Http3FrameType::UNKNOWN;
@@ -388,6 +392,53 @@ Http3SettingsFrame::set(Http3SettingsId id, uint64_t value)
   this->_settings[id] = value;
 }
 
+//
+// PRIORITY_UPDATE Frame
+//
+
+Http3PriorityUpdateFrame::Http3PriorityUpdateFrame(const uint8_t *buf, size_t buf_len) : Http3Frame(buf, buf_len)
+{
+  size_t end = this->_payload_offset + this->_length;
+  if (end > buf_len) {
+    return;
+  }
+
+  size_t id_len = 0;
+  if (QUICVariableInt::decode(this->_prioritized_element_id, id_len, buf + this->_payload_offset, this->_length) != 0) {
+    return;
+  }
+
+  // The frame may be built over a temporary buffer, keep a copy of the value.
+  size_t value_offset = this->_payload_offset + id_len;
+  this->_priority_field_value.assign(reinterpret_cast<const char *>(buf + value_offset), end - value_offset);
+  this->_valid = true;
+}
+
+void
+Http3PriorityUpdateFrame::reset(const uint8_t *buf, size_t len)
+{
+  this->~Http3PriorityUpdateFrame();
+  new (this) Http3PriorityUpdateFrame(buf, len);
+}
+
+bool
+Http3PriorityUpdateFrame::is_valid() const
+{
+  return this->_valid;
+}
+
+uint64_t
+Http3PriorityUpdateFrame::prioritized_element_id() const
+{
+  return this->_prioritized_element_id;
+}
+
+std::string_view
+Http3PriorityUpdateFrame::priority_field_value() const
+{
+  return this->_priority_field_value;
+}
+
 //
 // Http3FrameFactory
 //
@@ -417,6 +468,10 @@ Http3FrameFactory::create(const uint8_t *buf, size_t len)
     frame = http3SettingsFrameAllocator.alloc();
     new (frame) Http3SettingsFrame(buf, len, params->max_settings());
     return Http3FrameUPtr(frame, &Http3FrameDeleter::delete_settings_frame);
+  case Http3FrameType::PRIORITY_UPDATE:
+    frame = http3PriorityUpdateFrameAllocator.alloc();
+    new (frame) Http3PriorityUpdateFrame(buf, len);
+    return Http3FrameUPtr(frame, &Http3FrameDeleter::delete_priority_update_frame);
   default:
     // Unknown frame
     Debug("http3_frame_factory", "Unknown frame type %hhx", static_cast<uint8_t>(type));
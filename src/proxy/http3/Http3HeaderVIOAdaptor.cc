@@ -26,9 +26,11 @@
 
 #include "iocore/eventsystem/VIO.h"
 #include "proxy/hdrs/HTTP.h"
+#include "iocore/net/quic/QUICStream.h"
+#include "tscore/ExtensiblePriority.h"
 
-Http3HeaderVIOAdaptor::Http3HeaderVIOAdaptor(VIO *sink, HTTPType http_type, QPACK *qpack, uint64_t stream_id)
-  : _sink_vio(sink), _qpack(qpack), _stream_id(stream_id)
+Http3HeaderVIOAdaptor::Http3HeaderVIOAdaptor(VIO *sink, HTTPType http_type, QPACK *qpack, QUICStream &stream)
+  : _sink_vio(sink), _qpack(qpack), _stream(stream), _stream_id(stream.id())
 {
   SET_HANDLER(&Http3HeaderVIOAdaptor::event_handler);
 
@@ -115,6 +117,11 @@ Http3HeaderVIOAdaptor::_on_qpack_decode_complete()
     return 0;
   }
 
+  // [RFC 9218] 5, the initial priority of the response. A PRIORITY_UPDATE frame may override it later.
+  if (auto priority = this->_header.value_get(std::string_view{"Priority"}); !priority.empty()) {
+    this->_stream.set_priority(ExtensiblePriority::parse(priority));
+  }
+
   SCOPED_MUTEX_LOCK(lock, this->_sink_vio->mutex, this_ethread());
   MIOBuffer *writer = this->_sink_vio->get_writer();
 
@@ -0,0 +1,74 @@
+/** @file
+ *
+ *  PRIORITY_UPDATE Frame Handler for Http3
+ *
+ *  @section license License
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include "proxy/http3/Http3PriorityUpdateHandler.h"
+#include "proxy/http3/Http3Frame.h"
+#include "iocore/net/quic/QUICStreamManager.h"
+#include "tscore/ExtensiblePriority.h"
+
+//
+// PRIORITY_UPDATE frame handler, [RFC 9218] 7.2
+//
+std::vector<Http3FrameType>
+Http3PriorityUpdateHandler::interests()
+{
+  return {Http3FrameType::PRIORITY_UPDATE};
+}
+
+Http3ErrorUPtr
+Http3PriorityUpdateHandler::handle_frame(std::shared_ptr<const Http3Frame> frame, int32_t /* frame_seq */,
+                                         Http3StreamType /* s_type */)
+{
+  ink_assert(frame->type() == Http3FrameType::PRIORITY_UPDATE);
+
+  const Http3PriorityUpdateFrame *update_frame = dynamic_cast<const Http3PriorityUpdateFrame *>(frame.get());
+
+  if (!update_frame) {
+    return Http3ErrorUPtr(nullptr);
+  }
+
+  if (!update_frame->is_valid()) {
+    return std::make_unique<Http3Error>(Http3ErrorClass::CONNECTION, Http3ErrorCode::H3_FRAME_ERROR, "malformed PRIORITY_UPDATE");
+  }
+
+  // The prioritized element must be a client-initiated bidirectional stream.
+  QUICStreamId stream_id = update_frame->prioritized_element_id();
+  if (stream_id % 4 != 0) {
+    return std::make_unique<Http3Error>(Http3ErrorClass::CONNECTION, Http3ErrorCode::H3_ID_ERROR,
+                                        "PRIORITY_UPDATE for a non-request stream");
+  }
+
+  // An update for a stream that is not open yet or already closed is ignored.
+  QUICStream *stream = this->_qc->stream_manager()->find_stream(stream_id);
+  if (stream == nullptr) {
+    Debug("http3", "PRIORITY_UPDATE for unknown stream %" PRIu64 " is ignored", stream_id);
+    return Http3ErrorUPtr(nullptr);
+  }
+
+  ExtensiblePriority priority = ExtensiblePriority::parse(update_frame->priority_field_value());
+  stream->set_priority(priority);
+
+  Debug("http3", "PRIORITY_UPDATE stream %" PRIu64 ": u=%u i=%d", stream_id, priority.urgency, priority.incremental);
+
+  return Http3ErrorUPtr(nullptr);
+}
@@ -30,7 +30,7 @@ Http3ProtocolEnforcer::interests()
   return {Http3FrameType::DATA,         Http3FrameType::HEADERS,      Http3FrameType::X_RESERVED_1, Http3FrameType::CANCEL_PUSH,
           Http3FrameType::SETTINGS,     Http3FrameType::PUSH_PROMISE, Http3FrameType::X_RESERVED_2, Http3FrameType::GOAWAY,
           Http3FrameType::X_RESERVED_3, Http3FrameType::X_RESERVED_4, Http3FrameType::MAX_PUSH_ID,  Http3FrameType::X_MAX_DEFINED,
-          Http3FrameType::UNKNOWN};
+          Http3FrameType::UNKNOWN,      Http3FrameType::PRIORITY_UPDATE};
 }
 
 Http3ErrorUPtr
@@ -57,6 +57,10 @@ Http3ProtocolEnforcer::handle_frame(std::shared_ptr<const Http3Frame> frame, int
       std::string error_msg = Http3DebugNames::frame_type(f_type);
       error_msg.append(" frame is not allowed on any stream");
       error = std::make_unique<Http3Error>(Http3ErrorClass::CONNECTION, Http3ErrorCode::H3_FRAME_UNEXPECTED, error_msg.c_str());
+    } else if (f_type == Http3FrameType::PRIORITY_UPDATE) {
+      // [RFC 9218] 7.2. PRIORITY_UPDATE is only allowed on the client control stream.
+      error = std::make_unique<Http3Error>(Http3ErrorClass::CONNECTION, Http3ErrorCode::H3_FRAME_UNEXPECTED,
+                                           "PRIORITY_UPDATE frame is only allowed on control stream");
     }
   }
 
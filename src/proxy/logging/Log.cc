@@ -1325,9 +1325,9 @@ Log::flush_thread_main(void * /* args ATS_UNUSED */)
     // process each flush data
     //
     while ((fdata = invert_link.pop())) {
-      char    *buf           = nullptr;
-      int      bytes_written = 0;
-      LogFile *logfile       = fdata->m_logfile.get();
+      const char *buf           = nullptr;
+      int         bytes_written = 0;
+      LogFile    *logfile       = fdata->m_logfile.get();
 
       if (logfile->m_file_format == LOG_FILE_BINARY) {
         logbuffer                      = static_cast<LogBuffer *>(fdata->m_data);
@@ -1336,7 +1336,8 @@ Log::flush_thread_main(void * /* args ATS_UNUSED */)
         buf         = reinterpret_cast<char *>(buffer_header);
         total_bytes = buffer_header->byte_count;
 
-      } else if (logfile->m_file_format == LOG_FILE_ASCII || logfile->m_file_format == LOG_FILE_PIPE) {
+      } else if (logfile->m_file_format == LOG_FILE_ASCII || logfile->m_file_format == LOG_FILE_PIPE ||
+                 logfile->m_file_format == LOG_FILE_COLUMNAR) {
         buf         = static_cast<char *>(fdata->m_data);
         total_bytes = fdata->m_len;
 
@@ -1358,6 +1359,16 @@ Log::flush_thread_main(void * /* args ATS_UNUSED */)
       // This should always be true because we just checked it.
       ink_assert(logfilefd >= 0);
 
+      // Compress after the file is opened, reopening it starts a new frame.
+      if (logfile->is_compressed()) {
+        std::string_view compressed = logfile->compress(buf, total_bytes);
+        if (compressed.empty() && total_bytes > 0) {
+          Metrics::Counter::increment(log_rsb.bytes_lost_before_written_to_disk, total_bytes);
+        }
+        buf         = compressed.data();
+        total_bytes = compressed.size();
+      }
+
       // write *all* data to target file as much as possible
       //
       while (total_bytes - bytes_written) {
@@ -0,0 +1,631 @@
+/** @file
+
+  Columnar segments of log entries
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/logging/LogColumnar.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tscore/ink_align.h"
+#include "proxy/logging/LogBuffer.h"
+
+namespace
+{
+constexpr int64_t USEC_PER_SEC = 1000000;
+
+// Name of the timestamp column.
+constexpr std::string_view TIMESTAMP_NAME = "timestamp";
+
+void
+pad(std::string &out, size_t start)
+{
+  out.resize(start + INK_ALIGN_DEFAULT(out.size() - start));
+}
+
+void
+put_varint(std::string &out, uint64_t v)
+{
+  char buf[10];
+  int  n = 0;
+  while (v >= 0x80) {
+    buf[n++]   = static_cast<char>(v | 0x80);
+    v        >>= 7;
+  }
+  buf[n++] = static_cast<char>(v);
+  out.append(buf, n);
+}
+
+bool
+get_varint(const uint8_t *&p, const uint8_t *end, uint64_t &v)
+{
+  v = 0;
+  for (int shift = 0; p < end && shift < 64; shift += 7) {
+    uint8_t b  = *p++;
+    v         |= static_cast<uint64_t>(b & 0x7f) << shift;
+    if (!(b & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t
+zigzag(int64_t v)
+{
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+int64_t
+unzigzag(uint64_t v)
+{
+  return static_cast<int64_t>((v >> 1) ^ -(v & 1));
+}
+
+bool
+is_int(uint8_t type)
+{
+  return type == LogField::sINT || type == LogField::dINT || type == LOG_COLUMN_TIMESTAMP;
+}
+
+void
+encode_ints(const std::vector<int64_t> &values, std::string &out)
+{
+  uint64_t prev = 0;
+  for (int64_t v : values) {
+    // Differences wrap, as the decoder sums them the same way.
+    put_varint(out, zigzag(static_cast<int64_t>(static_cast<uint64_t>(v) - prev)));
+    prev = v;
+  }
+}
+
+// Encode strings with a dictionary if the values repeat, on average, at least twice.
+LogColumnEncoding
+encode_strings(const std::vector<std::string_view> &values, std::string &out, uint32_t &dict_count)
+{
+  std::unordered_map<std::string_view, uint32_t> dict;
+  std::vector<std::string_view>                  order;
+  size_t                                         limit = values.size() / 2;
+
+  for (auto v : values) {
+    if (dict.emplace(v, order.size()).second) {
+      order.push_back(v);
+      if (order.size() > limit) {
+        break;
+      }
+    }
+  }
+
+  if (order.size() > limit) {
+    for (auto v : values) {
+      put_varint(out, v.size());
+      out.append(v);
+    }
+    dict_count = 0;
+    return LOG_COLUMN_PLAIN;
+  }
+
+  for (auto v : order) {
+    put_varint(out, v.size());
+    out.append(v);
+  }
+  for (auto v : values) {
+    put_varint(out, dict[v]);
+  }
+  dict_count = order.size();
+  return LOG_COLUMN_DICT;
+}
+} // namespace
+
+/*-------------------------------------------------------------------------
+  LogColumnarSchema
+  -------------------------------------------------------------------------*/
+
+LogColumnarSchema::LogColumnarSchema(const char *symbol_str, const char *printf_str, std::vector<Column> columns)
+  : _symbol_str(symbol_str ? symbol_str : ""), _printf_str(printf_str ? printf_str : ""), _columns(std::move(columns))
+{
+}
+
+LogColumnarSchema::LogColumnarSchema(const char *symbol_str, const char *printf_str, const LogFieldList &fields)
+  : _symbol_str(symbol_str ? symbol_str : ""), _printf_str(printf_str ? printf_str : "")
+{
+  for (LogField *f = fields.first(); f; f = fields.next(f)) {
+    std::string name;
+    if (f->m_container != LogField::NO_CONTAINER) {
+      name = std::string("{") + f->name() + "}" + f->symbol();
+    } else {
+      name = f->symbol();
+    }
+    _columns.push_back({std::move(name), f->type()});
+  }
+}
+
+bool
+LogColumnarSchema::matches(const char *symbol_str, const char *printf_str) const
+{
+  return symbol_str && printf_str && _symbol_str == symbol_str && _printf_str == printf_str;
+}
+
+/*-------------------------------------------------------------------------
+  LogColumnarWriter
+  -------------------------------------------------------------------------*/
+
+LogColumnarWriter::LogColumnarWriter(const LogColumnarSchema &schema) : _schema(schema), _values(schema.columns().size() + 1) {}
+
+bool
+LogColumnarWriter::add(const LogEntryHeader *entry)
+{
+  const char *p   = reinterpret_cast<const char *>(entry) + sizeof(LogEntryHeader);
+  const char *end = reinterpret_cast<const char *>(entry) + entry->entry_len;
+  size_t      col = 1;
+
+  if (_rows >= LOG_COLUMNAR_MAX_ROWS) {
+    return false;
+  }
+
+  for (const auto &column : _schema.columns()) {
+    Values &values = _values[col++];
+    size_t  len    = 0;
+
+    switch (column.type) {
+    case LogField::sINT:
+    case LogField::dINT: {
+      int64_t v;
+      if (end - p < static_cast<ptrdiff_t>(sizeof(v))) {
+        goto overrun;
+      }
+      memcpy(&v, p, sizeof(v));
+      values.ints.push_back(v);
+      len = INK_MIN_ALIGN;
+      break;
+    }
+    case LogField::STRING: {
+      auto nul = static_cast<const char *>(memchr(p, 0, end - p));
+      if (nul == nullptr) {
+        goto overrun;
+      }
+      values.views.emplace_back(p, nul - p);
+      len = INK_ALIGN_DEFAULT(nul - p + 1);
+      break;
+    }
+    case LogField::IP: {
+      LogFieldIp ip;
+      if (end - p < static_cast<ptrdiff_t>(sizeof(ip))) {
+        goto overrun;
+      }
+      memcpy(&ip, p, sizeof(ip));
+      if (ip._family == AF_INET) {
+        len = sizeof(LogFieldIp4);
+        values.views.emplace_back(p + offsetof(LogFieldIp4, _addr), sizeof(in_addr_t));
+      } else if (ip._family == AF_INET6) {
+        len = sizeof(LogFieldIp6);
+        values.views.emplace_back(p + offsetof(LogFieldIp6, _addr), sizeof(in6_addr));
+      } else {
+        len = sizeof(LogFieldIp);
+        values.views.emplace_back();
+      }
+      len = INK_ALIGN_DEFAULT(len);
+      break;
+    }
+    default:
+      goto overrun;
+    }
+
+    if (end - p < static_cast<ptrdiff_t>(len)) {
+      goto overrun;
+    }
+    p += len;
+  }
+
+  _values[0].ints.push_back(entry->timestamp * USEC_PER_SEC + entry->timestamp_usec);
+  ++_rows;
+  return true;
+
+overrun:
+  // Drop the values of this entry from the columns before the one that overran.
+  for (size_t i = 1; i < col; ++i) {
+    _values[i].ints.resize(std::min<size_t>(_values[i].ints.size(), _rows));
+    _values[i].views.resize(std::min<size_t>(_values[i].views.size(), _rows));
+  }
+  return false;
+}
+
+void
+LogColumnarWriter::finish(std::string &out)
+{
+  const auto &columns = _schema.columns();
+  size_t      start   = out.size();
+  size_t      ncols   = columns.size() + 1;
+
+  LogColumnarSegmentHeader             header{};
+  std::vector<LogColumnarColumnHeader> column_headers(ncols);
+
+  header.magic        = LOG_COLUMNAR_MAGIC;
+  header.version      = LOG_COLUMNAR_VERSION;
+  header.column_count = ncols;
+  header.row_count    = _rows;
+  header.symbol_len   = _schema.symbol_str().size() + 1;
+  header.printf_len   = _schema.printf_str().size() + 1;
+  if (_rows > 0) {
+    header.low_timestamp = header.high_timestamp = _values[0].ints[0] / USEC_PER_SEC;
+    for (int64_t ts : _values[0].ints) {
+      header.low_timestamp  = std::min(header.low_timestamp, ts / USEC_PER_SEC);
+      header.high_timestamp = std::max(header.high_timestamp, ts / USEC_PER_SEC);
+    }
+  }
+
+  // The headers are copied in last, the output may move as it grows.
+  out.resize(start + sizeof(header) + ncols * sizeof(LogColumnarColumnHeader));
+  out.append(_schema.symbol_str().c_str(), header.symbol_len);
+  out.append(_schema.printf_str().c_str(), header.printf_len);
+  pad(out, start);
+
+  column_headers[0].type     = LOG_COLUMN_TIMESTAMP;
+  column_headers[0].name_len = TIMESTAMP_NAME.size();
+  out.append(TIMESTAMP_NAME);
+  for (size_t i = 1; i < ncols; ++i) {
+    column_headers[i].type     = columns[i - 1].type;
+    column_headers[i].name_len = columns[i - 1].name.size();
+    out.append(columns[i - 1].name);
+  }
+  pad(out, start);
+
+  for (size_t i = 0; i < ncols; ++i) {
+    LogColumnarColumnHeader &ch = column_headers[i];
+    ch.offset                   = out.size() - start;
+    if (is_int(ch.type)) {
+      ch.encoding = LOG_COLUMN_DELTA;
+      encode_ints(_values[i].ints, out);
+    } else if (ch.type == LogField::STRING) {
+      ch.encoding = encode_strings(_values[i].views, out, ch.dict_count);
+    } else {
+      ch.encoding = LOG_COLUMN_PLAIN;
+      for (auto v : _values[i].views) {
+        put_varint(out, v.size());
+        out.append(v);
+      }
+    }
+    ch.length = out.size() - start - ch.offset;
+    pad(out, start);
+  }
+
+  header.length = out.size() - start;
+  memcpy(out.data() + start, &header, sizeof(header));
+  memcpy(out.data() + start + sizeof(header), column_headers.data(), ncols * sizeof(LogColumnarColumnHeader));
+
+  for (auto &values : _values) {
+    values.ints.clear();
+    values.views.clear();
+  }
+  _rows = 0;
+}
+
+/*-------------------------------------------------------------------------
+  LogColumnarSegment
+  -------------------------------------------------------------------------*/
+
+bool
+LogColumnarSegment::is_columnar(const char *data, size_t len)
+{
+  uint32_t magic;
+  if (len < sizeof(magic)) {
+    return false;
+  }
+  memcpy(&magic, data, sizeof(magic));
+  return magic == LOG_COLUMNAR_MAGIC;
+}
+
+bool
+LogColumnarSegment::parse(const char *data, size_t len)
+{
+  _header = nullptr;
+  _names.clear();
+
+  if (!is_columnar(data, len) || len < sizeof(LogColumnarSegmentHeader)) {
+    return false;
+  }
+  auto header = reinterpret_cast<const LogColumnarSegmentHeader *>(data);
+  if (header->version != LOG_COLUMNAR_VERSION || header->length > len || header->column_count == 0 ||
+      header->row_count > LOG_COLUMNAR_MAX_ROWS) {
+    return false;
+  }
+
+  size_t length = header->length;
+  size_t pos    = sizeof(LogColumnarSegmentHeader) + header->column_count * sizeof(LogColumnarColumnHeader);
+  if (pos + size_t(header->symbol_len) + header->printf_len > length || header->symbol_len == 0 || header->printf_len == 0) {
+    return false;
+  }
+
+  auto columns = reinterpret_cast<const LogColumnarColumnHeader *>(data + sizeof(LogColumnarSegmentHeader));
+  _symbol_str  = data + pos;
+  _printf_str  = _symbol_str + header->symbol_len;
+  if (_symbol_str[header->symbol_len - 1] != '\0' || _printf_str[header->printf_len - 1] != '\0') {
+    return false;
+  }
+  pos = INK_ALIGN_DEFAULT(pos + header->symbol_len + header->printf_len);
+
+  for (int i = 0; i < header->column_count; ++i) {
+    const auto &ch = columns[i];
+    // Every row, and every dictionary entry, takes at least a byte of the column. The readers size
+    // their output by these counts, so they must be checked against the data.
+    if (pos + ch.name_len > length || size_t(ch.offset) + ch.length > length || ch.length < header->row_count ||
+        ch.dict_count > ch.length) {
+      _names.clear();
+      return false;
+    }
+    _names.emplace_back(data + pos, ch.name_len);
+    pos += ch.name_len;
+  }
+
+  _data    = data;
+  _header  = header;
+  _columns = columns;
+  return true;
+}
+
+int
+LogColumnarSegment::find(std::string_view name) const
+{
+  for (size_t i = 0; i < _names.size(); ++i) {
+    if (_names[i] == name) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool
+LogColumnarSegment::read_ints(int col, std::vector<int64_t> &out) const
+{
+  const auto &ch = _columns[col];
+  if (!is_int(ch.type) || ch.encoding != LOG_COLUMN_DELTA) {
+    return false;
+  }
+
+  auto     p    = reinterpret_cast<const uint8_t *>(_data + ch.offset);
+  auto     end  = p + ch.length;
+  uint64_t prev = 0;
+
+  out.resize(_header->row_count);
+  for (auto &v : out) {
+    uint64_t delta;
+    if (!get_varint(p, end, delta)) {
+      return false;
+    }
+    prev += static_cast<uint64_t>(unzigzag(delta));
+    v     = static_cast<int64_t>(prev);
+  }
+  return true;
+}
+
+bool
+LogColumnarSegment::read_dictionary(int col, std::vector<std::string_view> &dict, std::vector<uint32_t> &index) const
+{
+  const auto &ch = _columns[col];
+  if (ch.encoding != LOG_COLUMN_DICT) {
+    return false;
+  }
+
+  auto p   = reinterpret_cast<const uint8_t *>(_data + ch.offset);
+  auto end = p + ch.length;
+
+  dict.resize(ch.dict_count);
+  for (auto &v : dict) {
+    uint64_t len;
+    if (!get_varint(p, end, len) || len > static_cast<uint64_t>(end - p)) {
+      return false;
+    }
+    v  = {reinterpret_cast<const char *>(p), len};
+    p += len;
+  }
+
+  index.resize(_header->row_count);
+  for (auto &i : index) {
+    uint64_t v;
+    if (!get_varint(p, end, v) || v >= dict.size()) {
+      return false;
+    }
+    i = v;
+  }
+  return true;
+}
+
+bool
+LogColumnarSegment::read_strings(int col, std::vector<std::string_view> &out) const
+{
+  const auto &ch = _columns[col];
+
+  if (ch.encoding == LOG_COLUMN_DICT) {
+    std::vector<std::string_view> dict;
+    std::vector<uint32_t>         index;
+    if (!this->read_dictionary(col, dict, index)) {
+      return false;
+    }
+    out.resize(index.size());
+    for (size_t i = 0; i < index.size(); ++i) {
+      out[i] = dict[index[i]];
+    }
+    return true;
+  }
+
+  if (is_int(ch.type) || ch.encoding != LOG_COLUMN_PLAIN) {
+    return false;
+  }
+
+  auto p   = reinterpret_cast<const uint8_t *>(_data + ch.offset);
+  auto end = p + ch.length;
+
+  out.resize(_header->row_count);
+  for (auto &v : out) {
+    uint64_t len;
+    if (!get_varint(p, end, len) || len > static_cast<uint64_t>(end - p)) {
+      return false;
+    }
+    v  = {reinterpret_cast<const char *>(p), len};
+    p += len;
+  }
+  return true;
+}
+
+bool
+LogColumnarSegment::for_each_entry(const std::function<bool(const LogEntryHeader *)> &fn) const
+{
+  int                                        ncols = _header->column_count;
+  std::vector<std::vector<int64_t>>          ints(ncols);
+  std::vector<std::vector<std::string_view>> views(ncols);
+
+  for (int i = 0; i < ncols; ++i) {
+    if (!(is_int(_columns[i].type) ? this->read_ints(i, ints[i]) : this->read_strings(i, views[i]))) {
+      return false;
+    }
+  }
+  if (_columns[0].type != LOG_COLUMN_TIMESTAMP) {
+    return false;
+  }
+
+  // Entries are marshalled into 8 byte words, for the alignment of the fields.
+  std::vector<int64_t> entry;
+  for (uint32_t row = 0; row < _header->row_count; ++row) {
+    size_t len = sizeof(LogEntryHeader);
+    for (int i = 1; i < ncols; ++i) {
+      switch (_columns[i].type) {
+      case LogField::sINT:
+      case LogField::dINT:
+        len += INK_MIN_ALIGN;
+        break;
+      case LogField::STRING:
+        len += INK_ALIGN_DEFAULT(views[i][row].size() + 1);
+        break;
+      default:
+        len += INK_ALIGN_DEFAULT(sizeof(LogFieldIpStorage));
+        break;
+      }
+    }
+    entry.assign(len / sizeof(int64_t) + 1, 0);
+
+    char *base = reinterpret_cast<char *>(entry.data());
+    char *p    = base + sizeof(LogEntryHeader);
+    for (int i = 1; i < ncols; ++i) {
+      switch (_columns[i].type) {
+      case LogField::sINT:
+      case LogField::dINT:
+        memcpy(p, &ints[i][row], sizeof(int64_t));
+        p += INK_MIN_ALIGN;
+        break;
+      case LogField::STRING: {
+        auto v = views[i][row];
+        memcpy(p, v.data(), v.size());
+        p += INK_ALIGN_DEFAULT(v.size() + 1);
+        break;
+      }
+      default: {
+        auto              v = views[i][row];
+        LogFieldIpStorage ip{};
+        size_t            ip_len = sizeof(LogFieldIp);
+        if (v.size() == sizeof(in_addr_t)) {
+          ip._ip4._family = AF_INET;
+          memcpy(&ip._ip4._addr, v.data(), v.size());
+          ip_len = sizeof(LogFieldIp4);
+        } else if (v.size() == sizeof(in6_addr)) {
+          ip._ip6._family = AF_INET6;
+          memcpy(&ip._ip6._addr, v.data(), v.size());
+          ip_len = sizeof(LogFieldIp6);
+        } else {
+          ip._ip._family = AF_UNSPEC;
+        }
+        memcpy(p, &ip, ip_len);
+        p += INK_ALIGN_DEFAULT(ip_len);
+        break;
+      }
+      }
+    }
+
+    auto header            = reinterpret_cast<LogEntryHeader *>(base);
+    header->timestamp      = ints[0][row] / USEC_PER_SEC;
+    header->timestamp_usec = ints[0][row] % USEC_PER_SEC;
+    header->entry_len      = p - base;
+    if (!fn(header)) {
+      break;
+    }
+  }
+  return true;
+}
+
+/*-------------------------------------------------------------------------
+  LogColumnarFile
+  -------------------------------------------------------------------------*/
+
+LogColumnarFile::~LogColumnarFile()
+{
+  if (_data) {
+    munmap(const_cast<char *>(_data), _size);
+  }
+}
+
+bool
+LogColumnarFile::open(const char *path)
+{
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) < 0) {
+    int err = errno;
+    ::close(fd);
+    errno = err;
+    return false;
+  }
+
+  if (st.st_size > 0) {
+    void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      int err = errno;
+      ::close(fd);
+      errno = err;
+      return false;
+    }
+    _data = static_cast<const char *>(addr);
+    _size = st.st_size;
+  }
+  ::close(fd);
+  return true;
+}
+
+bool
+LogColumnarFile::next(LogColumnarSegment &segment)
+{
+  if (_offset >= _size || !segment.parse(_data + _offset, _size - _offset)) {
+    return false;
+  }
+  _offset += segment.length();
+  return true;
+}
@@ -0,0 +1,252 @@
+/** @file
+
+  Streaming compression of ASCII log files
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "tscore/ink_config.h"
+#include "proxy/logging/LogCompressor.h"
+
+#include <strings.h>
+#include <zlib.h>
+
+#if HAVE_ZSTD_H
+#include <zstd.h>
+#endif
+
+namespace
+{
+// Output is produced in chunks of this size.
+constexpr size_t OUT_CHUNK = 64 * 1024;
+
+class GzipLogCompressor : public LogCompressor
+{
+public:
+  explicit GzipLogCompressor(int level) : _level(level ? level : Z_DEFAULT_COMPRESSION) {}
+
+  ~GzipLogCompressor() override
+  {
+    if (_initialized) {
+      deflateEnd(&_zs);
+    }
+  }
+
+  bool
+  write(std::string_view data, std::string &out) override
+  {
+    if (!_in_frame) {
+      if (!this->start()) {
+        return false;
+      }
+    }
+    return this->deflate_all(data, Z_SYNC_FLUSH, out);
+  }
+
+  bool
+  finish(std::string &out) override
+  {
+    if (!_in_frame) {
+      return true;
+    }
+    _in_frame = false;
+    return this->deflate_all({}, Z_FINISH, out);
+  }
+
+private:
+  int      _level;
+  bool     _initialized = false;
+  z_stream _zs{};
+
+  bool
+  start()
+  {
+    if (!_initialized) {
+      // 16 + MAX_WBITS selects the gzip wrapper.
+      if (deflateInit2(&_zs, _level, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+      }
+      _initialized = true;
+    } else if (deflateReset(&_zs) != Z_OK) {
+      return false;
+    }
+    _in_frame = true;
+    return true;
+  }
+
+  bool
+  deflate_all(std::string_view data, int flush, std::string &out)
+  {
+    _zs.next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+    _zs.avail_in = data.size();
+    int ret;
+    do {
+      size_t used = out.size();
+      out.resize(used + OUT_CHUNK);
+      _zs.next_out  = reinterpret_cast<Bytef *>(out.data() + used);
+      _zs.avail_out = OUT_CHUNK;
+      ret           = deflate(&_zs, flush);
+      out.resize(out.size() - _zs.avail_out);
+      if (ret == Z_STREAM_ERROR) {
+        _in_frame = false;
+        return false;
+      }
+      // All output is done once deflate leaves room in the output buffer.
+    } while (_zs.avail_out == 0);
+    return flush != Z_FINISH || ret == Z_STREAM_END;
+  }
+};
+
+#if HAVE_ZSTD_H
+class ZstdLogCompressor : public LogCompressor
+{
+public:
+  explicit ZstdLogCompressor(int level) : _level(level ? level : ZSTD_CLEVEL_DEFAULT) {}
+
+  ~ZstdLogCompressor() override { ZSTD_freeCCtx(_cctx); }
+
+  bool
+  write(std::string_view data, std::string &out) override
+  {
+    if (!_in_frame) {
+      if (!this->start()) {
+        return false;
+      }
+    }
+    return this->compress_all(data, ZSTD_e_flush, out);
+  }
+
+  bool
+  finish(std::string &out) override
+  {
+    if (!_in_frame) {
+      return true;
+    }
+    _in_frame = false;
+    return this->compress_all({}, ZSTD_e_end, out);
+  }
+
+private:
+  int        _level;
+  ZSTD_CCtx *_cctx = nullptr;
+
+  bool
+  start()
+  {
+    if (_cctx == nullptr) {
+      if ((_cctx = ZSTD_createCCtx()) == nullptr) {
+        return false;
+      }
+      if (ZSTD_isError(ZSTD_CCtx_setParameter(_cctx, ZSTD_c_compressionLevel, _level)) ||
+          ZSTD_isError(ZSTD_CCtx_setParameter(_cctx, ZSTD_c_checksumFlag, 1))) {
+        return false;
+      }
+    } else {
+      ZSTD_CCtx_reset(_cctx, ZSTD_reset_session_only);
+    }
+    _in_frame = true;
+    return true;
+  }
+
+  bool
+  compress_all(std::string_view data, ZSTD_EndDirective mode, std::string &out)
+  {
+    ZSTD_inBuffer in{data.data(), data.size(), 0};
+    size_t        remaining;
+    do {
+      size_t used = out.size();
+      out.resize(used + OUT_CHUNK);
+      ZSTD_outBuffer zout{out.data() + used, OUT_CHUNK, 0};
+      remaining = ZSTD_compressStream2(_cctx, &zout, &in, mode);
+      out.resize(used + zout.pos);
+      if (ZSTD_isError(remaining)) {
+        _in_frame = false;
+        return false;
+      }
+      // With a flush or end directive the call returns 0 once everything is written out.
+    } while (remaining != 0);
+    return true;
+  }
+};
+#endif
+
+} // namespace
+
+std::unique_ptr<LogCompressor>
+LogCompressor::create(LogCompressionType type, int level)
+{
+  switch (type) {
+  case LOG_COMPRESSION_GZIP:
+    return std::make_unique<GzipLogCompressor>(level);
+  case LOG_COMPRESSION_ZSTD:
+#if HAVE_ZSTD_H
+    return std::make_unique<ZstdLogCompressor>(level);
+#else
+    return nullptr;
+#endif
+  case LOG_COMPRESSION_NONE:
+    break;
+  }
+  return nullptr;
+}
+
+bool
+LogCompressor::parse(std::string_view name, LogCompressionType &type)
+{
+  for (auto t : {LOG_COMPRESSION_NONE, LOG_COMPRESSION_GZIP, LOG_COMPRESSION_ZSTD}) {
+    std::string_view n = LogCompressor::name(t);
+    if (name.size() == n.size() && strncasecmp(name.data(), n.data(), n.size()) == 0) {
+      type = t;
+      return true;
+    }
+  }
+  return false;
+}
+
+const char *
+LogCompressor::name(LogCompressionType type)
+{
+  switch (type) {
+  case LOG_COMPRESSION_GZIP:
+    return "gzip";
+  case LOG_COMPRESSION_ZSTD:
+    return "zstd";
+  case LOG_COMPRESSION_NONE:
+    break;
+  }
+  return "none";
+}
+
+const char *
+LogCompressor::extension(LogCompressionType type)
+{
+  switch (type) {
+  case LOG_COMPRESSION_GZIP:
+    return ".gz";
+  case LOG_COMPRESSION_ZSTD:
+#if HAVE_ZSTD_H
+    return ".zst";
+#else
+    break;
+#endif
+  case LOG_COMPRESSION_NONE:
+    break;
+  }
+  return nullptr;
+}
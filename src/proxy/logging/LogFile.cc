@@ -49,10 +49,12 @@
 #include "proxy/logging/LogFilter.h"
 #include "proxy/logging/LogFormat.h"
 #include "proxy/logging/LogBuffer.h"
+#include "proxy/logging/LogColumnar.h"
 #include "proxy/logging/LogFile.h"
 #include "proxy/logging/LogObject.h"
 #include "proxy/logging/LogUtils.h"
 #include "proxy/logging/LogConfig.h"
+#include "proxy/logging/LogRenderPlan.h"
 #include "proxy/logging/Log.h"
 
 /*-------------------------------------------------------------------------
@@ -137,6 +139,84 @@ LogFile::change_header(const char *header)
   m_header = ats_strdup(header);
 }
 
+/*-------------------------------------------------------------------------
+  LogFile::set_compression
+  -------------------------------------------------------------------------*/
+
+bool
+LogFile::set_compression(LogCompressionType type, int level)
+{
+  ink_assert(!is_open());
+
+  m_compressor.reset();
+  if (type == LOG_COMPRESSION_NONE) {
+    return true;
+  }
+  if (m_file_format != LOG_FILE_ASCII) {
+    Warning("Compression is only supported for ascii logs, %s will not be compressed", m_name);
+    return false;
+  }
+  m_compressor = LogCompressor::create(type, level);
+  if (!m_compressor) {
+    Warning("Compression %s is not supported by this build, %s will not be compressed", LogCompressor::name(type), m_name);
+    return false;
+  }
+  Debug("log-file", "LogFile %s is compressed with %s", m_name, LogCompressor::name(type));
+  return true;
+}
+
+/*-------------------------------------------------------------------------
+  LogFile::compress
+
+  Compress data for the file. The output of each call is flushed so that the
+  file can be read up to the last write while the frame is still open.
+  -------------------------------------------------------------------------*/
+
+std::string_view
+LogFile::compress(const char *data, int len)
+{
+  ink_assert(m_compressor);
+
+  m_compressed.clear();
+  if (!m_compressor->write({data, static_cast<size_t>(len)}, m_compressed)) {
+    SiteThrottledError("Failed to compress %d bytes for %s", len, m_name);
+    m_compressed.clear();
+  }
+  return m_compressed;
+}
+
+/*-------------------------------------------------------------------------
+  LogFile::finish_compressed_frame
+
+  Write the end of the current compressed frame, when the file is rolled or
+  closed. The next write after the file is reopened starts a new frame.
+  -------------------------------------------------------------------------*/
+
+void
+LogFile::finish_compressed_frame()
+{
+  if (!m_compressor || !m_compressor->in_frame()) {
+    return;
+  }
+
+  m_compressed.clear();
+  if (!m_compressor->finish(m_compressed)) {
+    SiteThrottledError("Failed to end the compressed frame of %s", m_name);
+  }
+
+  int fd = get_fd();
+  if (fd >= 0 && !m_compressed.empty()) {
+    ssize_t len = ::write(fd, m_compressed.data(), m_compressed.size());
+    if (len < 0) {
+      SiteThrottledError("Failed to write log to %s: %s", m_name, strerror(errno));
+    } else {
+      Metrics::Counter::increment(log_rsb.bytes_written_to_disk, len);
+      ink_atomic_increment(&m_log->m_bytes_written, static_cast<uint64_t>(len));
+    }
+  }
+  m_compressed.clear();
+}
+
 /*-------------------------------------------------------------------------
   LogFile::open
 
@@ -205,6 +285,17 @@ LogFile::open_file()
       if (status == BaseLogFile::LOG_FILE_COULD_NOT_OPEN_FILE) {
         return LOG_FILE_COULD_NOT_OPEN_FILE;
       }
+      // The last frame of an existing compressed file is not ended if the process that wrote it
+      // did not close it, and decompressors stop there. Roll the file instead of appending to it.
+      if (m_compressor && file_exists && m_log->get_size_bytes() > 0 && m_log->roll()) {
+        Note("Rolled the existing compressed log file %s before writing to it", m_name);
+        m_log->close_file();
+        status = m_log->open_file(Log::config->logfile_perm);
+        if (status == BaseLogFile::LOG_FILE_COULD_NOT_OPEN_FILE) {
+          return LOG_FILE_COULD_NOT_OPEN_FILE;
+        }
+        file_exists = false;
+      }
     } else {
       return LOG_FILE_COULD_NOT_OPEN_FILE;
     }
@@ -217,9 +308,20 @@ LogFile::open_file()
   // file.
   //
   if (!file_exists) {
-    if (m_file_format != LOG_FILE_BINARY && m_header && m_log) {
+    if (m_file_format != LOG_FILE_BINARY && m_file_format != LOG_FILE_COLUMNAR && m_header && m_log) {
       Debug("log-file", "writing header to LogFile %s", m_name);
-      writeln(m_header, strlen(m_header), fileno(m_log->m_fp), m_name);
+      if (m_compressor) {
+        std::string header(m_header);
+        if (header.empty() || header.back() != '\n') {
+          header += '\n';
+        }
+        std::string_view data = compress(header.data(), header.size());
+        if (::write(fileno(m_log->m_fp), data.data(), data.size()) < 0) {
+          SiteThrottledWarning("An error was encountered in writing to %s: %s.", m_name, strerror(errno));
+        }
+      } else {
+        writeln(m_header, strlen(m_header), fileno(m_log->m_fp), m_name);
+      }
     }
   }
 
@@ -248,6 +350,7 @@ LogFile::close_file()
       }
       m_fd = -1;
     } else if (m_log) {
+      finish_compressed_frame();
       if (m_log->close_file()) {
         Error("Error closing LogFile %s: %s.", m_log->get_name(), strerror(errno));
       } else {
@@ -365,6 +468,8 @@ LogFile::roll(long interval_start, long interval_end, bool reopen_after_rolling)
     // Since these two methods of using BaseLogFile are not compatible, we perform the logging log file specific
     // close file operation here within the containing LogFile object.
     if (m_log->roll(interval_start, interval_end)) {
+      // The file was renamed but is still open, end the frame so that the rolled file is complete.
+      finish_compressed_frame();
       if (m_log->close_file()) {
         Error("Error closing LogFile %s: %s.", m_log->get_name(), strerror(errno));
       }
@@ -476,6 +581,9 @@ LogFile::preproc_and_try_delete(LogBuffer *lb)
   } else if (m_file_format == LOG_FILE_ASCII || m_file_format == LOG_FILE_PIPE) {
     write_ascii_logbuffer3(buffer_header);
     ret = 0;
+  } else if (m_file_format == LOG_FILE_COLUMNAR) {
+    write_columnar_logbuffer(buffer_header);
+    ret = 0;
   } else {
     Note("Cannot write LogBuffer to LogFile %s; invalid file format: %d", m_name, m_file_format);
   }
@@ -502,7 +610,6 @@ LogFile::write_ascii_logbuffer(LogBufferHeader *buffer_header, int fd, const cha
   ink_assert(fd >= 0);
 
   char              fmt_buf[LOG_MAX_FORMATTED_BUFFER];
-  char              fmt_line[LOG_MAX_FORMATTED_LINE];
   LogBufferIterator iter(buffer_header);
   LogEntryHeader   *entry_header;
   int               fmt_buf_bytes  = 0;
@@ -529,20 +636,18 @@ LogFile::write_ascii_logbuffer(LogBufferHeader *buffer_header, int fd, const cha
   }
 
   while ((entry_header = iter.next())) {
-    fmt_line_bytes = LogBuffer::to_ascii(entry_header, format_type, &fmt_line[0], LOG_MAX_FORMATTED_LINE, fieldlist_str, printf_str,
-                                         buffer_header->version, alt_format);
+    // Render in place, after writing out the buffer if a line of the maximum size might not fit.
+    if (fmt_buf_bytes + LOG_MAX_FORMATTED_LINE >= LOG_MAX_FORMATTED_BUFFER) {
+      if (!Log::config->logging_space_exhausted) {
+        bytes += writeln(fmt_buf, fmt_buf_bytes, fd, path);
+      }
+      fmt_buf_bytes = 0;
+    }
+    fmt_line_bytes = LogBuffer::to_ascii(entry_header, format_type, &fmt_buf[fmt_buf_bytes], LOG_MAX_FORMATTED_LINE, fieldlist_str,
+                                         printf_str, buffer_header->version, alt_format);
     ink_assert(fmt_line_bytes > 0);
 
     if (fmt_line_bytes > 0) {
-      if ((fmt_line_bytes + fmt_buf_bytes) >= LOG_MAX_FORMATTED_BUFFER) {
-        if (!Log::config->logging_space_exhausted) {
-          bytes += writeln(fmt_buf, fmt_buf_bytes, fd, path);
-        }
-        fmt_buf_bytes = 0;
-      }
-      ink_assert(fmt_buf_bytes < LOG_MAX_FORMATTED_BUFFER);
-      ink_assert(fmt_line_bytes < LOG_MAX_FORMATTED_BUFFER - fmt_buf_bytes);
-      memcpy(&fmt_buf[fmt_buf_bytes], fmt_line, fmt_line_bytes);
       fmt_buf_bytes += fmt_line_bytes;
       ink_assert(fmt_buf_bytes < LOG_MAX_FORMATTED_BUFFER);
       fmt_buf[fmt_buf_bytes]  = '\n'; // keep entries separate
@@ -574,10 +679,11 @@ LogFile::write_ascii_logbuffer3(LogBufferHeader *buffer_header, const char *alt_
   int               fmt_buf_bytes   = 0;
   int               total_bytes     = 0;
 
-  LogFormatType format_type;
-  char         *fieldlist_str;
-  char         *printf_str;
-  char         *ascii_buffer;
+  LogFormatType        format_type;
+  char                *fieldlist_str;
+  char                *printf_str;
+  char                *ascii_buffer;
+  const LogRenderPlan *plan = nullptr;
 
   switch (buffer_header->version) {
   case LOG_SEGMENT_VERSION:
@@ -593,6 +699,12 @@ LogFile::write_ascii_logbuffer3(LogBufferHeader *buffer_header, const char *alt_
     return 0;
   }
 
+  // Buffers of the format of the log object are rendered with its compiled plan.
+  if (m_render_plan && format_type == LOG_FORMAT_CUSTOM && alt_format == nullptr &&
+      m_render_plan->matches(fieldlist_str, printf_str)) {
+    plan = m_render_plan.get();
+  }
+
   while ((entry_header = iter.next())) {
     fmt_entry_count = 0;
     fmt_buf_bytes   = 0;
@@ -610,8 +722,9 @@ LogFile::write_ascii_logbuffer3(LogBufferHeader *buffer_header, const char *alt_
         Warning("Log is too long(%" PRIu32 "), it would be truncated. max_len:%zu", entry_header->entry_len, m_max_line_size);
       }
 
-      int bytes = LogBuffer::to_ascii(entry_header, format_type, &ascii_buffer[fmt_buf_bytes], m_max_line_size - 1, fieldlist_str,
-                                      printf_str, buffer_header->version, alt_format, get_escape_type());
+      int bytes = plan ? plan->render(entry_header, &ascii_buffer[fmt_buf_bytes], m_max_line_size - 1) :
+                         LogBuffer::to_ascii(entry_header, format_type, &ascii_buffer[fmt_buf_bytes], m_max_line_size - 1,
+                                             fieldlist_str, printf_str, buffer_header->version, alt_format, get_escape_type());
 
       if (bytes > 0) {
         fmt_buf_bytes               += bytes;
@@ -654,6 +767,67 @@ LogFile::write_ascii_logbuffer3(LogBufferHeader *buffer_header, const char *alt_
   return total_bytes;
 }
 
+/*-------------------------------------------------------------------------
+  LogFile::write_columnar_logbuffer
+
+  Encode the entries of the buffer as one columnar segment and send it to
+  the flush thread.
+  -------------------------------------------------------------------------*/
+
+int
+LogFile::write_columnar_logbuffer(LogBufferHeader *buffer_header)
+{
+  ink_assert(buffer_header != nullptr);
+
+  if (buffer_header->version != LOG_SEGMENT_VERSION) {
+    Note("Invalid LogBuffer version %d in write_columnar_logbuffer; "
+         "current version is %d",
+         buffer_header->version, LOG_SEGMENT_VERSION);
+    return 0;
+  }
+
+  if (!m_columnar_schema || !m_columnar_schema->matches(buffer_header->fmt_fieldlist(), buffer_header->fmt_printf())) {
+    SiteThrottledNote("LogBuffer for %s is not of the format of the log, have dropped (%" PRIu32 ") entries.", m_name,
+                      buffer_header->entry_count);
+    Metrics::Counter::increment(log_rsb.num_lost_before_flush_to_disk, buffer_header->entry_count);
+    return 0;
+  }
+
+  LogColumnarWriter writer(*m_columnar_schema);
+  LogBufferIterator iter(buffer_header);
+  LogEntryHeader   *entry_header;
+  int               dropped = 0;
+
+  while ((entry_header = iter.next())) {
+    if (!writer.add(entry_header)) {
+      ++dropped;
+    }
+  }
+  if (dropped > 0) {
+    Note("Failed to encode %d malformed entries of a LogBuffer for %s, have dropped them.", dropped, m_name);
+    Metrics::Counter::increment(log_rsb.num_lost_before_flush_to_disk, dropped);
+  }
+  if (writer.rows() == 0) {
+    return 0;
+  }
+
+  std::string segment;
+  writer.finish(segment);
+
+  char *data = static_cast<char *>(ats_malloc(segment.size()));
+  memcpy(data, segment.data(), segment.size());
+  LogFlushData *flush_data = new LogFlushData(this, data, segment.size());
+
+  Metrics::Counter::increment(log_rsb.num_flush_to_disk, writer.rows());
+  Metrics::Counter::increment(log_rsb.bytes_flush_to_disk, segment.size());
+
+  ink_atomiclist_push(Log::flush_data_list, flush_data);
+
+  Log::flush_notify->signal();
+
+  return segment.size();
+}
+
 bool
 LogFile::rolled_logfile(char *file)
 {
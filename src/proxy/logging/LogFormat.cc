@@ -43,6 +43,7 @@
 #include "proxy/logging/LogBuffer.h"
 #include "proxy/logging/LogObject.h"
 #include "proxy/logging/LogConfig.h"
+#include "proxy/logging/LogRenderPlan.h"
 #include "proxy/logging/Log.h"
 
 // class variables
@@ -164,6 +165,14 @@ LogFormat::init_variables(const char *name, const char *fieldlist_str, const cha
     m_interval_sec  = interval_sec;
     m_interval_next = LogUtils::timestamp();
 
+    // Compile the format once here, rather than walk the printf string for each entry.
+    if (m_fieldlist_str && m_printf_str) {
+      auto plan = std::make_shared<LogRenderPlan>(m_fieldlist_str, m_printf_str, m_escape_type);
+      if (plan->valid()) {
+        m_render_plan = std::move(plan);
+      }
+    }
+
     m_valid = true;
   }
 }
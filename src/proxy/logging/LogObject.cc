@@ -30,6 +30,7 @@
 #include "tscore/CryptoHash.h"
 #include "../../iocore/eventsystem/P_EventSystem.h"
 #include "proxy/logging/LogUtils.h"
+#include "proxy/logging/LogColumnar.h"
 #include "proxy/logging/LogField.h"
 #include "proxy/logging/LogObject.h"
 #include "proxy/logging/LogConfig.h"
@@ -92,7 +93,8 @@ LogBufferManager::preproc_buffers(LogBufferSink *sink)
 LogObject::LogObject(LogConfig *cfg, const LogFormat *format, const char *log_dir, const char *basename, LogFileFormat file_format,
                      const char *header, Log::RollingEnabledValues rolling_enabled, int flush_threads, int rolling_interval_sec,
                      int rolling_offset_hr, int rolling_size_mb, bool auto_created, int rolling_max_count, int rolling_min_count,
-                     bool reopen_after_rolling, int pipe_buffer_size, bool fast)
+                     bool reopen_after_rolling, int pipe_buffer_size, bool fast, LogCompressionType compression,
+                     int compression_level)
   : m_alt_filename(nullptr),
     m_flags(0),
     m_signature(0),
@@ -116,15 +118,23 @@ LogObject::LogObject(LogConfig *cfg, const LogFormat *format, const char *log_di
     m_flags |= BINARY;
   } else if (file_format == LOG_FILE_PIPE) {
     m_flags |= WRITES_TO_PIPE;
+  } else if (file_format == LOG_FILE_COLUMNAR) {
+    m_flags |= COLUMNAR;
   }
 
-  generate_filenames(log_dir, basename, file_format);
+  generate_filenames(log_dir, basename, file_format, compression);
 
   // compute_signature is a static function
   m_signature = compute_signature(m_format, m_basename, m_flags);
 
   m_logFile = new LogFile(m_filename, header, file_format, m_signature, cfg->ascii_buffer_size, cfg->max_line_size,
                           m_pipe_buffer_size, format->escape_type());
+  m_logFile->set_compression(compression, compression_level);
+  m_logFile->set_render_plan(m_format->render_plan());
+  if (file_format == LOG_FILE_COLUMNAR) {
+    m_logFile->set_columnar_schema(
+      std::make_shared<const LogColumnarSchema>(m_format->fieldlist(), m_format->printf_str(), m_format->m_field_list));
+  }
 
   if (m_reopen_after_rolling) {
     m_logFile->open_file();
@@ -162,7 +172,7 @@ LogObject::~LogObject()
 // 1.- 'stdout' and 'stderr' are treated as special strings indicating file
 //     descriptors for the stdout and stderr streams.
 // 2.- if no extension is given, add .log for ascii logs, and .blog for
-//     binary logs
+//     binary logs. Compressed ascii logs get .log.gz or .log.zst
 // 3.- if an extension is given, then do not modify filename and use that
 //     extension regardless of type of log
 // 4.- if there is a '.' at the end of the name, then do not add an extension
@@ -170,7 +180,7 @@ LogObject::~LogObject()
 //     two ('..').
 //
 void
-LogObject::generate_filenames(const char *log_dir, const char *basename, LogFileFormat file_format)
+LogObject::generate_filenames(const char *log_dir, const char *basename, LogFileFormat file_format, LogCompressionType compression)
 {
   ink_assert(log_dir && basename);
 
@@ -200,11 +210,18 @@ LogObject::generate_filenames(const char *log_dir, const char *basename, LogFile
 
   const char *ext     = nullptr;
   int         ext_len = 0;
+  std::string compressed_ext;
   if (i < 0) { // no extension, add one
     switch (file_format) {
     case LOG_FILE_ASCII:
       ext     = LOG_FILE_ASCII_OBJECT_FILENAME_EXTENSION;
       ext_len = 4;
+      if (const char *cext = LogCompressor::extension(compression); cext) {
+        compressed_ext  = LOG_FILE_ASCII_OBJECT_FILENAME_EXTENSION;
+        compressed_ext += cext;
+        ext             = compressed_ext.c_str();
+        ext_len         = compressed_ext.size();
+      }
       break;
     case LOG_FILE_BINARY:
       ext     = LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION;
@@ -214,6 +231,10 @@ LogObject::generate_filenames(const char *log_dir, const char *basename, LogFile
       ext     = LOG_FILE_PIPE_OBJECT_FILENAME_EXTENSION;
       ext_len = 5;
       break;
+    case LOG_FILE_COLUMNAR:
+      ext     = LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION;
+      ext_len = 5;
+      break;
     default:
       ink_assert(!"unknown file format");
     }
@@ -276,11 +297,18 @@ LogObject::compute_signature(LogFormat *format, char *filename, unsigned int fla
   uint64_t signature = 0;
 
   if (fl && ps && filename) {
-    int   buf_size = strlen(fl) + strlen(ps) + strlen(filename) + 2;
-    char *buffer   = static_cast<char *>(ats_malloc(buf_size));
-
-    ink_string_concatenate_strings(buffer, fl, ps, filename,
-                                   flags & LogObject::BINARY ? "B" : (flags & LogObject::WRITES_TO_PIPE ? "P" : "A"), NULL);
+    int         buf_size = strlen(fl) + strlen(ps) + strlen(filename) + 2;
+    char       *buffer   = static_cast<char *>(ats_malloc(buf_size));
+    const char *mode     = "A";
+
+    if (flags & LogObject::BINARY) {
+      mode = "B";
+    } else if (flags & LogObject::WRITES_TO_PIPE) {
+      mode = "P";
+    } else if (flags & LogObject::COLUMNAR) {
+      mode = "C";
+    }
+    ink_string_concatenate_strings(buffer, fl, ps, filename, mode, NULL);
 
     CryptoHash hash;
     CryptoContext().hash_immediate(hash, buffer, buf_size - 1);
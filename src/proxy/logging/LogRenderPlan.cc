@@ -0,0 +1,138 @@
+/** @file
+
+  A log format compiled for rendering entries as ASCII
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/logging/LogRenderPlan.h"
+
+#include <cstring>
+
+#include "tscore/Diags.h"
+#include "proxy/logging/LogBuffer.h"
+#include "proxy/logging/LogFormat.h"
+
+LogRenderPlan::LogRenderPlan(const char *symbol_str, const char *printf_str, LogEscapeType escape_type)
+  : _symbol_str(symbol_str ? symbol_str : ""), _printf_str(printf_str ? printf_str : ""), _escape_type(escape_type)
+{
+  if (symbol_str == nullptr || printf_str == nullptr) {
+    return;
+  }
+
+  bool contains_aggregates = false;
+  LogFormat::parse_symbol_string(symbol_str, &_fields, &contains_aggregates);
+
+  // Split the printf string at the field markers, each op is the literal before a marker and its field.
+  LogField *field = _fields.first();
+  Op        op;
+  op.literal_offset = 0;
+  for (const char *p = printf_str; *p; ++p) {
+    if (*p != LOG_FIELD_MARKER) {
+      _literals.push_back(*p);
+      ++op.literal_len;
+      continue;
+    }
+    if (field == nullptr) {
+      // More markers than fields, leave it to LogBuffer::to_ascii to report.
+      return;
+    }
+
+    op.field = field;
+    if (auto f = std::get_if<LogField::UnmarshalFunc>(&field->m_unmarshal_func)) {
+      op.kind  = Op::PLAIN;
+      op.plain = *f;
+    } else if (auto f = std::get_if<LogField::UnmarshalFuncWithSlice>(&field->m_unmarshal_func)) {
+      op.kind  = Op::SLICE;
+      op.slice = *f;
+    } else if (auto f = std::get_if<LogField::UnmarshalFuncWithMap>(&field->m_unmarshal_func)) {
+      op.kind = Op::MAP;
+      op.map  = *f;
+    } else {
+      return;
+    }
+    _ops.push_back(op);
+
+    op                = Op{};
+    op.literal_offset = _literals.size();
+    field             = _fields.next(field);
+  }
+  if (op.literal_len > 0) {
+    _ops.push_back(op);
+  }
+
+  _valid = true;
+}
+
+bool
+LogRenderPlan::matches(const char *symbol_str, const char *printf_str) const
+{
+  return symbol_str && printf_str && _symbol_str == symbol_str && _printf_str == printf_str;
+}
+
+int
+LogRenderPlan::overflow() const
+{
+  SiteThrottledNote("Traffic Server is skipping the current log entry because its size "
+                    "exceeds the maximum line (entry) size for an ascii log buffer");
+  return 0;
+}
+
+int
+LogRenderPlan::render(const LogEntryHeader *entry, char *buf, int len) const
+{
+  ink_assert(_valid);
+
+  // The unmarshal functions take a non-const cursor but only read through it.
+  char       *read_from = const_cast<char *>(reinterpret_cast<const char *>(entry)) + sizeof(LogEntryHeader);
+  const char *literals  = _literals.data();
+  int         written   = 0;
+
+  for (const Op &op : _ops) {
+    if (op.literal_len > 0) {
+      // Keep a byte for the line terminator, as LogBuffer::resolve_custom_entry does.
+      if (written + static_cast<int>(op.literal_len) >= len) {
+        return this->overflow();
+      }
+      memcpy(buf + written, literals + op.literal_offset, op.literal_len);
+      written += op.literal_len;
+    }
+
+    int res = 0;
+    switch (op.kind) {
+    case Op::LITERAL:
+      continue;
+    case Op::PLAIN:
+      res = op.plain(&read_from, buf + written, len - written);
+      break;
+    case Op::SLICE:
+      res = op.slice(&read_from, buf + written, len - written, &op.field->m_slice, _escape_type);
+      break;
+    case Op::MAP:
+      res = op.map(&read_from, buf + written, len - written, op.field->m_alias_map);
+      break;
+    }
+    if (res < 0) {
+      return this->overflow();
+    }
+    written += res;
+  }
+
+  return written;
+}
@@ -125,7 +125,9 @@ std::set<std::string> valid_log_object_keys = {"filename",
                                                "rolling_max_count",
                                                "rolling_allow_empty",
                                                "pipe_buffer_size",
-                                               "fast"};
+                                               "fast",
+                                               "compression",
+                                               "compression_level"};
 
 LogObject *
 YamlLogConfig::decodeLogObject(const YAML::Node &node)
@@ -167,9 +169,13 @@ YamlLogConfig::decodeLogObject(const YAML::Node &node)
   LogFileFormat file_type = LOG_FILE_ASCII; // default value
   if (node["mode"]) {
     std::string mode = node["mode"].as<std::string>();
-    file_type        = (0 == strncasecmp(mode.c_str(), "bin", 3) || (1 == mode.size() && mode[0] == 'b') ?
-                          LOG_FILE_BINARY :
-                          (0 == strcasecmp(mode.c_str(), "ascii_pipe") ? LOG_FILE_PIPE : LOG_FILE_ASCII));
+    if (0 == strncasecmp(mode.c_str(), "bin", 3) || (1 == mode.size() && mode[0] == 'b')) {
+      file_type = LOG_FILE_BINARY;
+    } else if (0 == strcasecmp(mode.c_str(), "ascii_pipe")) {
+      file_type = LOG_FILE_PIPE;
+    } else if (0 == strcasecmp(mode.c_str(), "columnar")) {
+      file_type = LOG_FILE_COLUMNAR;
+    }
   }
 
   int obj_rolling_enabled      = cfg->rolling_enabled;
@@ -225,11 +231,29 @@ YamlLogConfig::decodeLogObject(const YAML::Node &node)
     }
   }
 
+  // compression of ascii logs
+  LogCompressionType compression       = LOG_COMPRESSION_NONE;
+  int                compression_level = 0;
+  if (node["compression"]) {
+    auto value = node["compression"].as<std::string>();
+    if (!LogCompressor::parse(value, compression)) {
+      throw YAML::ParserException(node["compression"].Mark(), "unknown compression " + value);
+    }
+    if (compression != LOG_COMPRESSION_NONE && file_type != LOG_FILE_ASCII) {
+      Warning("Compression should only be set for ascii log objects, %s will not be compressed.", filename.c_str());
+      compression = LOG_COMPRESSION_NONE;
+    }
+  }
+  if (node["compression_level"]) {
+    compression_level = node["compression_level"].as<int>();
+  }
+
   auto logObject = new LogObject(cfg, fmt, cfg->logfile_dir, filename.c_str(), file_type, header.c_str(),
                                  static_cast<Log::RollingEnabledValues>(obj_rolling_enabled), cfg->preproc_threads,
                                  obj_rolling_interval_sec, obj_rolling_offset_hr, obj_rolling_size_mb, /* auto_created */ false,
                                  /* rolling_max_count */ obj_rolling_max_count, /* rolling_min_count */ obj_rolling_min_count,
-                                 /* reopen_after_rolling */ obj_rolling_allow_empty > 0, pipe_buffer_size, fast);
+                                 /* reopen_after_rolling */ obj_rolling_allow_empty > 0, pipe_buffer_size, fast, compression,
+                                 compression_level);
 
   // Generate LogDeletingInfo entry for later use
   std::string ext;
@@ -243,6 +267,9 @@ YamlLogConfig::decodeLogObject(const YAML::Node &node)
   case LOG_FILE_BINARY:
     ext = LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION;
     break;
+  case LOG_FILE_COLUMNAR:
+    ext = LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION;
+    break;
   default:
     break;
   }
@@ -0,0 +1,281 @@
+/** @file
+
+  Unit tests for LogColumnar
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include "tscore/ink_align.h"
+#include "proxy/logging/LogBuffer.h"
+#include "proxy/logging/LogColumnar.h"
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+namespace
+{
+LogColumnarSchema schema("chi,pssc,cqu,{Host}cqh", "%<chi> %<pssc> %<cqu> %<{Host}cqh>",
+                         {
+                           {"chi",       LogField::IP    },
+                           {"pssc",      LogField::sINT  },
+                           {"cqu",       LogField::STRING},
+                           {"{Host}cqh", LogField::STRING},
+});
+
+// An entry marshalled as by LogAccess, with zeroed padding.
+class Entry
+{
+public:
+  Entry(int64_t timestamp, int32_t usec) : _words(sizeof(LogEntryHeader) / sizeof(int64_t))
+  {
+    auto h            = header();
+    h->timestamp      = timestamp;
+    h->timestamp_usec = usec;
+  }
+
+  Entry &
+  ip(const char *addr)
+  {
+    LogFieldIpStorage ip{};
+    size_t            len = sizeof(LogFieldIp);
+    if (addr && inet_pton(AF_INET, addr, &ip._ip4._addr) == 1) {
+      ip._ip4._family = AF_INET;
+      len             = sizeof(LogFieldIp4);
+    } else if (addr && inet_pton(AF_INET6, addr, &ip._ip6._addr) == 1) {
+      ip._ip6._family = AF_INET6;
+      len             = sizeof(LogFieldIp6);
+    } else {
+      ip._ip._family = AF_UNSPEC;
+    }
+    memcpy(append(len), &ip, len);
+    return *this;
+  }
+
+  Entry &
+  integer(int64_t v)
+  {
+    memcpy(append(sizeof(v)), &v, sizeof(v));
+    return *this;
+  }
+
+  Entry &
+  str(const std::string &s)
+  {
+    memcpy(append(s.size() + 1), s.c_str(), s.size() + 1);
+    return *this;
+  }
+
+  LogEntryHeader *
+  header()
+  {
+    return reinterpret_cast<LogEntryHeader *>(_words.data());
+  }
+
+  std::string
+  bytes()
+  {
+    return {reinterpret_cast<char *>(_words.data()), header()->entry_len};
+  }
+
+private:
+  std::vector<int64_t> _words;
+
+  char *
+  append(size_t len)
+  {
+    size_t used = header()->entry_len ? header()->entry_len : sizeof(LogEntryHeader);
+    size_t size = used + INK_ALIGN_DEFAULT(len);
+    _words.resize(size / sizeof(int64_t));
+    header()->entry_len = size;
+    return reinterpret_cast<char *>(_words.data()) + used;
+  }
+};
+
+Entry
+make_entry(int i)
+{
+  const char *ips[] = {"10.0.0.1", "2001:db8::1", nullptr};
+  Entry       e(1700000000 + i / 10, (i * 7919) % 1000000);
+  e.ip(ips[i % 3])
+    .integer(i % 5 ? 200 : 404)
+    .str("http://example.com/" + std::to_string(i))
+    .str(i % 2 ? "example.com" : "www.example.com");
+  return e;
+}
+} // namespace
+
+TEST_CASE("LogColumnar round trip", "[logging]")
+{
+  LogColumnarWriter  writer(schema);
+  std::vector<Entry> entries;
+  for (int i = 0; i < 100; ++i) {
+    entries.push_back(make_entry(i));
+    REQUIRE(writer.add(entries.back().header()));
+  }
+  CHECK(writer.rows() == 100);
+
+  std::string out;
+  writer.finish(out);
+  CHECK(writer.rows() == 0);
+  CHECK(out.size() % 8 == 0);
+
+  LogColumnarSegment seg;
+  REQUIRE(LogColumnarSegment::is_columnar(out.data(), out.size()));
+  REQUIRE(seg.parse(out.data(), out.size()));
+  CHECK(seg.length() == out.size());
+  CHECK(seg.rows() == 100);
+  CHECK(seg.columns() == 5);
+  CHECK(std::string(seg.symbol_str()) == schema.symbol_str());
+  CHECK(std::string(seg.printf_str()) == schema.printf_str());
+  CHECK(seg.low_timestamp() == 1700000000);
+  CHECK(seg.high_timestamp() == 1700000009);
+
+  CHECK(seg.name(0) == "timestamp");
+  CHECK(seg.find("{Host}cqh") == 4);
+  CHECK(seg.find("cqu") == 3);
+  CHECK(seg.find("crc") == -1);
+  CHECK(seg.type(2) == LogField::sINT);
+  CHECK(seg.encoding(3) == LOG_COLUMN_PLAIN);
+  CHECK(seg.encoding(4) == LOG_COLUMN_DICT);
+
+  std::vector<int64_t> ints;
+  REQUIRE(seg.read_ints(2, ints));
+  REQUIRE(ints.size() == 100);
+  CHECK(ints[0] == 404);
+  CHECK(ints[1] == 200);
+  REQUIRE(seg.read_ints(0, ints));
+  CHECK(ints[99] == (1700000009LL * 1000000 + (99 * 7919) % 1000000));
+  CHECK_FALSE(seg.read_ints(3, ints));
+
+  std::vector<std::string_view> strs;
+  REQUIRE(seg.read_strings(3, strs));
+  CHECK(strs[42] == "http://example.com/42");
+  REQUIRE(seg.read_strings(4, strs));
+  CHECK(strs[0] == "www.example.com");
+  CHECK(strs[1] == "example.com");
+  REQUIRE(seg.read_strings(1, strs));
+  CHECK(strs[0].size() == 4);
+  CHECK(strs[1].size() == 16);
+  CHECK(strs[2].empty());
+
+  std::vector<std::string_view> dict;
+  std::vector<uint32_t>         index;
+  REQUIRE(seg.read_dictionary(4, dict, index));
+  CHECK(dict.size() == 2);
+  CHECK_FALSE(seg.read_dictionary(3, dict, index));
+
+  SECTION("Entries are marshalled back as they were written")
+  {
+    int row = 0;
+    REQUIRE(seg.for_each_entry([&](const LogEntryHeader *entry) {
+      CHECK(std::string(reinterpret_cast<const char *>(entry), entry->entry_len) == entries[row].bytes());
+      return ++row < 100;
+    }));
+    CHECK(row == 100);
+  }
+
+  SECTION("Truncated segments are rejected")
+  {
+    CHECK_FALSE(seg.parse(out.data(), out.size() - 8));
+    CHECK_FALSE(LogColumnarSegment::is_columnar("1.2.3.4 GET", 11));
+  }
+
+  SECTION("Counts beyond the data are rejected")
+  {
+    auto header = reinterpret_cast<LogColumnarSegmentHeader *>(out.data());
+    auto column = reinterpret_cast<LogColumnarColumnHeader *>(out.data() + sizeof(LogColumnarSegmentHeader));
+
+    header->row_count = 0xffffffff;
+    CHECK_FALSE(seg.parse(out.data(), out.size()));
+    header->row_count = LOG_COLUMNAR_MAX_ROWS - 1;
+    CHECK_FALSE(seg.parse(out.data(), out.size()));
+    header->row_count = 100;
+
+    column[4].dict_count = column[4].length + 1;
+    CHECK_FALSE(seg.parse(out.data(), out.size()));
+  }
+}
+
+TEST_CASE("LogColumnar malformed entries", "[logging]")
+{
+  LogColumnarWriter writer(schema);
+  Entry             good = make_entry(1);
+  Entry             bad(1700000000, 0);
+  bad.ip("10.0.0.1").integer(200);
+
+  CHECK_FALSE(writer.add(bad.header()));
+  CHECK(writer.add(good.header()));
+  CHECK(writer.rows() == 1);
+
+  std::string        out;
+  LogColumnarSegment seg;
+  writer.finish(out);
+  REQUIRE(seg.parse(out.data(), out.size()));
+  REQUIRE(seg.for_each_entry([&](const LogEntryHeader *entry) {
+    CHECK(std::string(reinterpret_cast<const char *>(entry), entry->entry_len) == good.bytes());
+    return true;
+  }));
+}
+
+TEST_CASE("LogColumnar files", "[logging]")
+{
+  LogColumnarWriter  writer(schema);
+  std::vector<Entry> entries;
+  std::string        out;
+  for (int i = 0; i < 30; ++i) {
+    entries.push_back(make_entry(i));
+    writer.add(entries.back().header());
+    if (i % 10 == 9) {
+      writer.finish(out);
+    }
+  }
+
+  char path[] = "/tmp/test_LogColumnar.XXXXXX";
+  int  fd     = mkstemp(path);
+  REQUIRE(fd >= 0);
+  // A trailing partial segment, as while the file is written, ends the iteration.
+  REQUIRE(write(fd, out.data(), out.size()) == static_cast<ssize_t>(out.size()));
+  REQUIRE(write(fd, out.data(), 16) == 16);
+  close(fd);
+
+  LogColumnarFile file;
+  REQUIRE(file.open(path));
+  unlink(path);
+
+  LogColumnarSegment seg;
+  int                segments = 0;
+  uint32_t           rows     = 0;
+  while (file.next(seg)) {
+    ++segments;
+    rows += seg.rows();
+  }
+  CHECK(segments == 3);
+  CHECK(rows == 30);
+
+  LogColumnarFile missing;
+  CHECK_FALSE(missing.open("/nonexistent/test_LogColumnar"));
+}
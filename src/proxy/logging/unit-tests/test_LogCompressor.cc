@@ -0,0 +1,191 @@
+/** @file
+
+  Unit tests for LogCompressor
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <string>
+#include <zlib.h>
+
+#include "tscore/ink_config.h"
+#include "proxy/logging/LogCompressor.h"
+
+#if HAVE_ZSTD_H
+#include <zstd.h>
+#endif
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+namespace
+{
+// Inflate a sequence of gzip members, as gunzip does. @a complete is cleared if the last member has no trailer.
+std::string
+gunzip(std::string const &in, bool &complete)
+{
+  std::string out;
+  size_t      pos = 0;
+  complete        = true;
+  while (pos < in.size()) {
+    z_stream zs{};
+    REQUIRE(inflateInit2(&zs, 16 + MAX_WBITS) == Z_OK);
+    zs.next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(in.data() + pos));
+    zs.avail_in = in.size() - pos;
+    int ret;
+    do {
+      char buf[4096];
+      zs.next_out  = reinterpret_cast<Bytef *>(buf);
+      zs.avail_out = sizeof(buf);
+      ret          = inflate(&zs, Z_NO_FLUSH);
+      REQUIRE((ret == Z_OK || ret == Z_STREAM_END || ret == Z_BUF_ERROR));
+      out.append(buf, sizeof(buf) - zs.avail_out);
+    } while (ret == Z_OK && zs.avail_in > 0);
+    if (ret != Z_STREAM_END) {
+      complete = false;
+    }
+    pos = in.size() - zs.avail_in;
+    inflateEnd(&zs);
+    if (ret != Z_STREAM_END) {
+      break;
+    }
+  }
+  return out;
+}
+
+std::string
+lines(int first, int count)
+{
+  std::string s;
+  for (int i = first; i < first + count; ++i) {
+    s += "127.0.0.1 GET http://example.com/" + std::to_string(i) + " 200 1234\n";
+  }
+  return s;
+}
+} // namespace
+
+TEST_CASE("LogCompressor names", "[logging]")
+{
+  LogCompressionType type = LOG_COMPRESSION_NONE;
+
+  CHECK(LogCompressor::parse("gzip", type));
+  CHECK(type == LOG_COMPRESSION_GZIP);
+  CHECK(LogCompressor::parse("ZSTD", type));
+  CHECK(type == LOG_COMPRESSION_ZSTD);
+  CHECK(LogCompressor::parse("none", type));
+  CHECK(type == LOG_COMPRESSION_NONE);
+  CHECK_FALSE(LogCompressor::parse("lz4", type));
+  CHECK(std::string(LogCompressor::name(LOG_COMPRESSION_GZIP)) == "gzip");
+  CHECK(LogCompressor::create(LOG_COMPRESSION_NONE) == nullptr);
+
+  CHECK(LogCompressor::extension(LOG_COMPRESSION_NONE) == nullptr);
+  CHECK(std::string(LogCompressor::extension(LOG_COMPRESSION_GZIP)) == ".gz");
+#if HAVE_ZSTD_H
+  CHECK(std::string(LogCompressor::extension(LOG_COMPRESSION_ZSTD)) == ".zst");
+#else
+  CHECK(LogCompressor::extension(LOG_COMPRESSION_ZSTD) == nullptr);
+#endif
+}
+
+TEST_CASE("LogCompressor gzip", "[logging]")
+{
+  auto gz = LogCompressor::create(LOG_COMPRESSION_GZIP);
+  REQUIRE(gz != nullptr);
+
+  std::string out;
+  bool        complete = false;
+
+  SECTION("An empty frame writes nothing")
+  {
+    CHECK(gz->finish(out));
+    CHECK(out.empty());
+  }
+
+  SECTION("Each write can be read before the frame ends")
+  {
+    REQUIRE(gz->write(lines(0, 100), out));
+    CHECK(gz->in_frame());
+    CHECK(gunzip(out, complete) == lines(0, 100));
+    CHECK_FALSE(complete);
+
+    REQUIRE(gz->write(lines(100, 100), out));
+    CHECK(gunzip(out, complete) == lines(0, 200));
+
+    REQUIRE(gz->finish(out));
+    CHECK_FALSE(gz->in_frame());
+    CHECK(gunzip(out, complete) == lines(0, 200));
+    CHECK(complete);
+    CHECK(out.size() < lines(0, 200).size() / 4);
+  }
+
+  SECTION("Frames after a roll are separate members")
+  {
+    std::string rolled;
+    REQUIRE(gz->write(lines(0, 10), rolled));
+    REQUIRE(gz->finish(rolled));
+
+    REQUIRE(gz->write(lines(10, 10), out));
+    REQUIRE(gz->finish(out));
+    CHECK(gunzip(out, complete) == lines(10, 10));
+    CHECK(complete);
+    CHECK(gunzip(rolled + out, complete) == lines(0, 20));
+  }
+
+  SECTION("Large writes")
+  {
+    auto data = lines(0, 20000);
+    REQUIRE(gz->write(data, out));
+    REQUIRE(gz->finish(out));
+    CHECK(gunzip(out, complete) == data);
+  }
+}
+
+#if HAVE_ZSTD_H
+TEST_CASE("LogCompressor zstd", "[logging]")
+{
+  auto zs = LogCompressor::create(LOG_COMPRESSION_ZSTD);
+  REQUIRE(zs != nullptr);
+
+  std::string out;
+  REQUIRE(zs->write(lines(0, 100), out));
+  REQUIRE(zs->finish(out));
+  REQUIRE(zs->write(lines(100, 100), out));
+  REQUIRE(zs->finish(out));
+
+  std::string    decoded;
+  ZSTD_DCtx     *dctx = ZSTD_createDCtx();
+  ZSTD_inBuffer  in{out.data(), out.size(), 0};
+  char           buf[4096];
+  size_t         ret = 0;
+  while (in.pos < in.size) {
+    ZSTD_outBuffer zout{buf, sizeof(buf), 0};
+    ret = ZSTD_decompressStream(dctx, &zout, &in);
+    REQUIRE_FALSE(ZSTD_isError(ret));
+    decoded.append(buf, zout.pos);
+  }
+  ZSTD_freeDCtx(dctx);
+  CHECK(ret == 0);
+  CHECK(decoded == lines(0, 200));
+}
+#else
+TEST_CASE("LogCompressor zstd", "[logging]")
+{
+  CHECK(LogCompressor::create(LOG_COMPRESSION_ZSTD) == nullptr);
+}
+#endif
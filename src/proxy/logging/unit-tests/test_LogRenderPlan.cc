@@ -0,0 +1,157 @@
+/** @file
+
+  Unit tests for LogRenderPlan
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include "tscore/Layout.h"
+#include "tscore/ink_align.h"
+#include "iocore/eventsystem/EventSystem.h"
+#include "proxy/logging/Log.h"
+#include "proxy/logging/LogAccess.h"
+#include "proxy/logging/LogBuffer.h"
+#include "proxy/logging/LogFormat.h"
+#include "proxy/logging/LogRenderPlan.h"
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "iocore/utils/diags.i"
+
+namespace
+{
+struct LogFieldsListener : Catch::TestEventListenerBase {
+  using TestEventListenerBase::TestEventListenerBase;
+
+  void
+  testRunStarting(Catch::TestRunInfo const & /* testRunInfo ATS_UNUSED */) override
+  {
+    Layout::create();
+    init_diags("", nullptr);
+    Log::init_fields();
+  }
+};
+
+CATCH_REGISTER_LISTENER(LogFieldsListener);
+
+// Marshal an entry for @a fields, the string fields take the @a strings in order.
+std::vector<char>
+make_entry(LogFieldList &fields, const std::vector<std::string> &strings)
+{
+  std::vector<char> entry(sizeof(LogEntryHeader));
+  int               i = 0;
+  size_t            s = 0;
+  for (LogField *f = fields.first(); f; f = fields.next(f), ++i) {
+    size_t pos = entry.size();
+    switch (f->type()) {
+    case LogField::sINT:
+    case LogField::dINT:
+      entry.resize(pos + INK_MIN_ALIGN);
+      LogAccess::marshal_int(entry.data() + pos, f->is_time_field() ? 1700000000 : 1000 + 37 * i);
+      break;
+    case LogField::STRING: {
+      REQUIRE(s < strings.size());
+      const std::string &value = strings[s++];
+      int                len   = INK_ALIGN_DEFAULT(value.size() + 1);
+      entry.resize(pos + len);
+      // Empty strings are marshalled as "-", like the LogAccess accessors do.
+      LogAccess::marshal_str(entry.data() + pos, value.empty() ? nullptr : value.c_str(), len);
+      break;
+    }
+    case LogField::IP: {
+      sockaddr_in sin{};
+      sin.sin_family      = AF_INET;
+      sin.sin_addr.s_addr = htonl(0x0a000001 + i);
+      entry.resize(pos + LogAccess::marshal_ip(nullptr, reinterpret_cast<sockaddr *>(&sin)));
+      LogAccess::marshal_ip(entry.data() + pos, reinterpret_cast<sockaddr *>(&sin));
+      break;
+    }
+    default:
+      FAIL("unexpected field type");
+    }
+  }
+  auto header            = reinterpret_cast<LogEntryHeader *>(entry.data());
+  header->timestamp      = 1700000000;
+  header->timestamp_usec = 123456;
+  header->entry_len      = entry.size();
+  return entry;
+}
+
+// Render the entry with to_ascii and with a plan of @a format, and check they are the same.
+void
+check_render(LogFormat &format, const std::vector<std::string> &strings, LogEscapeType escape_type)
+{
+  REQUIRE(format.valid());
+
+  std::vector<char> entry  = make_entry(format.m_field_list, strings);
+  auto              header = reinterpret_cast<LogEntryHeader *>(entry.data());
+  LogRenderPlan     plan(format.fieldlist(), format.printf_str(), escape_type);
+  REQUIRE(plan.valid());
+  REQUIRE(plan.matches(format.fieldlist(), format.printf_str()));
+
+  char expected[LOG_MAX_FORMATTED_LINE];
+  char actual[LOG_MAX_FORMATTED_LINE];
+  int  expected_len = LogBuffer::to_ascii(header, LOG_FORMAT_CUSTOM, expected, sizeof(expected), format.fieldlist(),
+                                          format.printf_str(), LOG_SEGMENT_VERSION, nullptr, escape_type);
+  int  actual_len   = plan.render(header, actual, sizeof(actual));
+
+  REQUIRE(expected_len > 0);
+  CHECK(std::string(actual, actual_len) == std::string(expected, expected_len));
+}
+} // namespace
+
+TEST_CASE("LogRenderPlan renders as to_ascii", "[logging]")
+{
+  // Quotes, backslashes and control characters, a slice, and empty strings.
+  const std::vector<std::string> strings = {
+    "GET",
+    "Mozilla/5.0 \"X11\" C:\\path\\ \x01\x1f\t end",
+    "",
+    "/some/long/path/to/an/object",
+    "www.example.com",
+  };
+
+  for (auto escape_type : {LOG_ESCAPE_NONE, LOG_ESCAPE_JSON}) {
+    SECTION(escape_type == LOG_ESCAPE_JSON ? "json escapes" : "no escapes")
+    {
+      SECTION("fields")
+      {
+        LogFormat format("fields", "{\"time\":\"%<cqtq>\",\"client\":\"%<chi>\",\"result\":\"%<crc>/%<pssc>\","
+                                   "\"method\":\"%<cqhm>\",\"agent\":\"%<{User-Agent}cqh>\",\"referer\":\"%<{Referer}cqh>\","
+                                   "\"path\":\"%<cqup[0:8]>\",\"host\":\"%<{Host}cqh[4:]>\",\"ms\":%<ttms>}",
+                         0, escape_type);
+        check_render(format, strings, escape_type);
+      }
+
+      SECTION("aggregates")
+      {
+        LogFormat format("aggregates", "%<LAST(cqtq)> %<COUNT(*)> %<SUM(psql)> %<AVG(ttms)> %<FIRST(pssc)> %<LAST(pssc)>", 60,
+                         escape_type);
+        check_render(format, strings, escape_type);
+      }
+    }
+  }
+}
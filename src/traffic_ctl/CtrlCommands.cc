@@ -581,6 +581,9 @@ ServerCommand::ServerCommand(ts::Arguments *args) : CtrlCommand(args)
   if (get_parsed_arguments()->get(DRAIN_STR)) {
     _printer      = std::make_unique<GenericPrinter>(printOpts);
     _invoked_func = [&]() { server_drain(); };
+  } else if (get_parsed_arguments()->get(LOCK_PROFILE_STR)) {
+    _printer      = std::make_unique<LockProfilePrinter>(printOpts);
+    _invoked_func = [&]() { server_lock_profile(); };
   }
 }
 
@@ -600,6 +603,13 @@ ServerCommand::server_drain()
 
   _printer->write_output(response);
 }
+
+void
+ServerCommand::server_lock_profile()
+{
+  ServerGetLockProfileRequest request{{get_parsed_arguments()->get(RESET_STR)}};
+  _printer->write_output(invoke_rpc(request));
+}
 // //------------------------------------------------------------------------------------------------------------------------------------
 StorageCommand::StorageCommand(ts::Arguments *args) : CtrlCommand(args)
 {
@@ -217,8 +217,11 @@ private:
   static inline const std::string DRAIN_STR{"drain"};
   static inline const std::string UNDO_STR{"undo"};
   static inline const std::string NO_NEW_CONN_STR{"no-new-connection"};
+  static inline const std::string LOCK_PROFILE_STR{"lock-profile"};
+  static inline const std::string RESET_STR{"reset"};
 
   void server_drain();
+  void server_lock_profile();
 };
 //
 // -----------------------------------------------------------------------------------------------------------------------------------
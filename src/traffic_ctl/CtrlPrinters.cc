@@ -298,6 +298,34 @@ SetHostStatusPrinter::write_output(YAML::Node const &result)
   // do nothing.
 }
 //------------------------------------------------------------------------------------------------------------------------------------
+void
+LockProfilePrinter::write_output(YAML::Node const &result)
+{
+  std::string text;
+
+  if (helper::try_extract<std::string>(result, "enabled") != "true") {
+    std::cout << "Lock profiling is disabled, see proxy.config.lock_profiling.enabled\n";
+  }
+
+  auto const &sites = result["sites"];
+  if (!sites || sites.size() == 0) {
+    return;
+  }
+  // Times are in nanoseconds on the wire, shown in microseconds.
+  constexpr std::string_view fmt{"{:>12} {:>10} {:>10} {:>12} {:>12} {:>12}  {}\n"};
+  std::cout << swoc::bwprint(text, fmt, "acquires", "misses", "blocks", "wait(us)", "avg hold(us)", "max hold(us)", "location");
+  for (auto &&site : sites) {
+    auto holds     = helper::try_extract<uint64_t>(site, "holds");
+    auto hold_time = helper::try_extract<uint64_t>(site, "hold_time_ns");
+    auto wait_time = helper::try_extract<uint64_t>(site, "wait_time_ns");
+    auto max_hold  = helper::try_extract<uint64_t>(site, "max_hold_time_ns");
+    std::cout << swoc::bwprint(text, fmt, helper::try_extract<uint64_t>(site, "acquires"),
+                               helper::try_extract<uint64_t>(site, "misses"), helper::try_extract<uint64_t>(site, "blocks"),
+                               wait_time / 1000, holds ? hold_time / holds / 1000 : 0, max_hold / 1000,
+                               helper::try_extract<std::string>(site, "location"));
+  }
+}
+//------------------------------------------------------------------------------------------------------------------------------------
 
 void
 CacheDiskStoragePrinter::write_output(YAML::Node const &result)
@@ -235,6 +235,14 @@ public:
   SetHostStatusPrinter(BasePrinter::Options opt) : BasePrinter(opt) {}
 };
 //------------------------------------------------------------------------------------------------------------------------------------
+class LockProfilePrinter : public BasePrinter
+{
+  void write_output(YAML::Node const &result) override;
+
+public:
+  LockProfilePrinter(BasePrinter::Options opt) : BasePrinter(opt) {}
+};
+//------------------------------------------------------------------------------------------------------------------------------------
 class CacheDiskStoragePrinter : public BasePrinter
 {
   void write_output(YAML::Node const &result) override;
@@ -187,6 +187,19 @@ struct ServerStopDrainRequest : shared::rpc::ClientRequest {
   }
 };
 //------------------------------------------------------------------------------------------------------------------------------------
+struct ServerGetLockProfileRequest : shared::rpc::ClientRequest {
+  using super = shared::rpc::ClientRequest;
+  struct Params {
+    bool reset{false};
+  };
+  ServerGetLockProfileRequest(Params p) { super::params = p; }
+  std::string
+  get_method() const override
+  {
+    return "admin_server_get_lock_profile";
+  }
+};
+//------------------------------------------------------------------------------------------------------------------------------------
 struct SetStorageDeviceOfflineRequest : shared::rpc::ClientRequest {
   using super = shared::rpc::ClientRequest;
   struct Params {
@@ -106,6 +106,16 @@ template <> struct convert<ServerStartDrainRequest::Params> {
   }
 };
 //------------------------------------------------------------------------------------------------------------------------------------
+template <> struct convert<ServerGetLockProfileRequest::Params> {
+  static Node
+  encode(ServerGetLockProfileRequest::Params const &params)
+  {
+    Node node;
+    node["reset"] = params.reset;
+    return node;
+  }
+};
+//------------------------------------------------------------------------------------------------------------------------------------
 template <> struct convert<SetStorageDeviceOfflineRequest::Params> {
   static Node
   encode(SetStorageDeviceOfflineRequest::Params const &params)
@@ -185,6 +185,10 @@ main(int argc, const char **argv)
     .add_example_usage("traffic_ctl server drain [OPTIONS]")
     .add_option("--no-new-connection", "-N", "Wait for new connections down to threshold before starting draining")
     .add_option("--undo", "-U", "Recover server from the drain mode");
+  server_command
+    .add_command("lock-profile", "Show the lock contention profile, most contended first", [&]() { command->execute(); })
+    .add_example_usage("traffic_ctl server lock-profile [OPTIONS]")
+    .add_option("--reset", "-r", "Start the profile again from zero after showing it");
 
   // storage commands
   storage_command
@@ -32,6 +32,14 @@
 
 #include <poll.h>
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+
 #include "../proxy/logging/LogStandalone.cc"
 
 #include "proxy/logging/LogAccess.h"
@@ -42,6 +50,8 @@
 #include "proxy/logging/LogObject.h"
 #include "proxy/logging/LogConfig.h"
 #include "proxy/logging/LogBuffer.h"
+#include "proxy/logging/LogColumnar.h"
+#include "proxy/logging/LogRenderPlan.h"
 #include "proxy/logging/LogUtils.h"
 #include "proxy/logging/Log.h"
 
@@ -54,6 +64,7 @@ static int  elf2_flag               = 0;
 static int  auto_filenames          = 0;
 static int  overwrite_existing_file = 0;
 static char output_file[1024];
+static char count_by[256];
 int         auto_clear_cache_flag = 0;
 
 static const ArgumentDescription argument_descriptions[] = {
@@ -67,6 +78,7 @@ static const ArgumentDescription argument_descriptions[] = {
   {"debug_tags",       'T', "Colon-Separated Debug Tags",          "S1023", error_tags,               NULL, NULL},
   {"overwrite_output", 'w', "Overwrite existing output file(s)",   "T",     &overwrite_existing_file, NULL, NULL},
   {"elf2",             '2', "Convert to Extended2 Logging Format", "T",     &elf2_flag,               NULL, NULL},
+  {"count_by",         'c', "Count columnar log entries by field", "S255",  &count_by,                NULL, NULL},
   HELP_ARGUMENT_DESCRIPTION(),
   VERSION_ARGUMENT_DESCRIPTION(),
   RUNROOT_ARGUMENT_DESCRIPTION()
@@ -208,6 +220,149 @@ process_file(int in_fd, int out_fd)
   }
 }
 
+/*
+ * Checks whether a file is a columnar log
+ *
+ * @param input_file name of the log file
+ * @returns true if the file starts with a columnar segment
+ */
+static bool
+is_columnar_file(const char *input_file)
+{
+  char magic[sizeof(uint32_t)];
+  int  fd = open(input_file, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  ssize_t nread = read(fd, magic, sizeof(magic));
+  close(fd);
+  return nread == sizeof(magic) && LogColumnarSegment::is_columnar(magic, sizeof(magic));
+}
+
+static void
+write_output(int out_fd, std::string &out)
+{
+  if (!out.empty()) {
+    LogFile::writeln(out.data(), out.size(), out_fd, ".");
+    out.clear();
+  }
+}
+
+/*
+ * Converts a columnar log to ASCII, each segment in the format it was written with
+ */
+static int
+process_columnar_file(const char *input_file, int out_fd)
+{
+  LogColumnarFile file;
+  if (!file.open(input_file)) {
+    fprintf(stderr, "Error mapping input file %s: %s\n", input_file, strerror(errno));
+    return 1;
+  }
+
+  LogColumnarSegment             segment;
+  std::unique_ptr<LogRenderPlan> plan;
+  std::string                    out;
+  char                           line[LOG_MAX_FORMATTED_LINE];
+
+  while (file.next(segment)) {
+    if (!plan || !plan->matches(segment.symbol_str(), segment.printf_str())) {
+      plan = std::make_unique<LogRenderPlan>(segment.symbol_str(), segment.printf_str(), LOG_ESCAPE_NONE);
+      if (!plan->valid()) {
+        fprintf(stderr, "Bad format in columnar segment!\n");
+        return 1;
+      }
+    }
+    bool ok = segment.for_each_entry([&](const LogEntryHeader *entry) {
+      int len = plan->render(entry, line, sizeof(line));
+      if (len > 0) {
+        out.append(line, len);
+        out.push_back('\n');
+      }
+      return true;
+    });
+    if (!ok) {
+      fprintf(stderr, "Bad columnar segment!\n");
+      return 1;
+    }
+    if (out.size() >= MAX_LOGBUFFER_SIZE) {
+      write_output(out_fd, out);
+    }
+  }
+  write_output(out_fd, out);
+  return 0;
+}
+
+/*
+ * Counts the entries of a columnar log by the values of a field, reading only its column
+ */
+static int
+count_columnar_file(const char *input_file, const char *field, int out_fd)
+{
+  LogColumnarFile file;
+  if (!file.open(input_file)) {
+    fprintf(stderr, "Error mapping input file %s: %s\n", input_file, strerror(errno));
+    return 1;
+  }
+
+  LogColumnarSegment            segment;
+  std::map<std::string, size_t> counts;
+  std::vector<std::string_view> dict, values;
+  std::vector<uint32_t>         index;
+  std::vector<int64_t>          ints;
+
+  while (file.next(segment)) {
+    int col = segment.find(field);
+    if (col < 0) {
+      continue;
+    }
+    uint8_t type = segment.type(col);
+    if (type == LogField::sINT || type == LogField::dINT || type == LOG_COLUMN_TIMESTAMP) {
+      if (!segment.read_ints(col, ints)) {
+        fprintf(stderr, "Bad columnar segment!\n");
+        return 1;
+      }
+      for (int64_t v : ints) {
+        ++counts[std::to_string(v)];
+      }
+    } else if (segment.read_dictionary(col, dict, index)) {
+      // Count by index, the dictionary is resolved once per segment.
+      std::vector<size_t> n(dict.size());
+      for (uint32_t i : index) {
+        ++n[i];
+      }
+      for (size_t i = 0; i < dict.size(); ++i) {
+        counts[std::string(dict[i])] += n[i];
+      }
+    } else if (segment.read_strings(col, values)) {
+      for (auto v : values) {
+        if (type == LogField::IP) {
+          char buf[INET6_ADDRSTRLEN] = "0";
+          if (v.size() == sizeof(in_addr_t) || v.size() == sizeof(in6_addr)) {
+            inet_ntop(v.size() == sizeof(in_addr_t) ? AF_INET : AF_INET6, v.data(), buf, sizeof(buf));
+          }
+          ++counts[buf];
+        } else {
+          ++counts[std::string(v)];
+        }
+      }
+    } else {
+      fprintf(stderr, "Bad columnar segment!\n");
+      return 1;
+    }
+  }
+
+  std::vector<std::pair<std::string, size_t>> sorted(counts.begin(), counts.end());
+  std::stable_sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) { return a.second > b.second; });
+
+  std::string out;
+  for (const auto &[value, count] : sorted) {
+    out += std::to_string(count) + " " + value + "\n";
+  }
+  write_output(out_fd, out);
+  return 0;
+}
+
 static int
 open_output_file(char *output_file_p)
 {
@@ -264,6 +419,7 @@ main(int /* argc ATS_UNUSED */, const char *argv[])
   // process command-line arguments
   //
   output_file[0] = 0;
+  count_by[0]    = 0;
   process_args(&version, argument_descriptions, countof(argument_descriptions), argv);
 
   // check that only one of the -o and -a options was specified
@@ -295,8 +451,9 @@ main(int /* argc ATS_UNUSED */, const char *argv[])
   int error = NO_ERROR;
 
   if (n_file_arguments) {
-    int bin_ext_len   = strlen(LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION);
-    int ascii_ext_len = strlen(LOG_FILE_ASCII_OBJECT_FILENAME_EXTENSION);
+    int bin_ext_len      = strlen(LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION);
+    int ascii_ext_len    = strlen(LOG_FILE_ASCII_OBJECT_FILENAME_EXTENSION);
+    int columnar_ext_len = strlen(LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION);
 
     for (unsigned i = 0; i < n_file_arguments; ++i) {
       int in_fd = open(file_arguments[i], O_RDONLY);
@@ -321,13 +478,16 @@ main(int /* argc ATS_UNUSED */, const char *argv[])
         }
 #endif
         if (auto_filenames) {
-          // change .blog to .log
+          // change .blog or .clog to .log
           //
-          int n = strlen(file_arguments[i]);
-          int copy_len =
-            (n >= bin_ext_len ?
-               (strcmp(&file_arguments[i][n - bin_ext_len], LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION) == 0 ? n - bin_ext_len : n) :
-               n);
+          int n        = strlen(file_arguments[i]);
+          int copy_len = n;
+          if (n >= bin_ext_len && strcmp(&file_arguments[i][n - bin_ext_len], LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION) == 0) {
+            copy_len = n - bin_ext_len;
+          } else if (n >= columnar_ext_len &&
+                     strcmp(&file_arguments[i][n - columnar_ext_len], LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION) == 0) {
+            copy_len = n - columnar_ext_len;
+          }
 
           char *out_filename = (char *)ats_malloc(copy_len + ascii_ext_len + 1);
 
@@ -343,6 +503,16 @@ main(int /* argc ATS_UNUSED */, const char *argv[])
             continue;
           }
         }
+        if (is_columnar_file(file_arguments[i])) {
+          // Columnar logs are mapped and read whole, they can not be followed.
+          int rc = count_by[0] ? count_columnar_file(file_arguments[i], count_by, out_fd) :
+                                 process_columnar_file(file_arguments[i], out_fd);
+          if (rc != 0) {
+            error = DATA_PROCESSING_ERROR;
+          }
+          close(in_fd);
+          continue;
+        }
         if (follow_flag) {
           lseek(in_fd, 0, SEEK_END);
         }
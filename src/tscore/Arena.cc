@@ -31,18 +31,49 @@
 #define DEFAULT_ALLOC_SIZE 1024
 #define DEFAULT_BLOCK_SIZE (DEFAULT_ALLOC_SIZE - (sizeof(ArenaBlock) - 8))
 
+// Maximum number of default size blocks kept in each thread's cache.
+#define BLOCK_CACHE_MAX 64
+
 static Allocator defaultSizeArenaBlock("ArenaBlock", DEFAULT_ALLOC_SIZE);
 
+namespace
+{
+/// Per thread cache of default size blocks.
+struct BlockCache {
+  ArenaBlock *head  = nullptr;
+  int         count = 0;
+
+  ~BlockCache()
+  {
+    while (head) {
+      ArenaBlock *next = head->next;
+      defaultSizeArenaBlock.free_void(head);
+      head = next;
+    }
+  }
+};
+
+thread_local BlockCache blockCache;
+} // namespace
+
 /*-------------------------------------------------------------------------
   -------------------------------------------------------------------------*/
 
 static inline ArenaBlock *
-blk_alloc(int size)
+blk_alloc(int size, bool &reused)
 {
   ArenaBlock *blk;
 
+  reused = false;
   if (size == DEFAULT_BLOCK_SIZE) {
-    blk = static_cast<ArenaBlock *>(defaultSizeArenaBlock.alloc_void());
+    if (blockCache.head) {
+      blk             = blockCache.head;
+      blockCache.head = blk->next;
+      --blockCache.count;
+      reused = true;
+    } else {
+      blk = static_cast<ArenaBlock *>(defaultSizeArenaBlock.alloc_void());
+    }
   } else {
     blk = static_cast<ArenaBlock *>(ats_malloc(size + sizeof(ArenaBlock) - 8));
   }
@@ -64,7 +95,13 @@ blk_free(ArenaBlock *blk)
 
   size = blk->m_heap_end - &blk->data[0];
   if (size == DEFAULT_BLOCK_SIZE) {
-    defaultSizeArenaBlock.free_void(blk);
+    if (blockCache.count < BLOCK_CACHE_MAX) {
+      blk->next       = blockCache.head;
+      blockCache.head = blk;
+      ++blockCache.count;
+    } else {
+      defaultSizeArenaBlock.free_void(blk);
+    }
   } else {
     ats_free(blk);
   }
@@ -97,9 +134,13 @@ Arena::alloc(size_t size, size_t alignment)
   ArenaBlock  *b;
   unsigned int block_size;
   void        *mem;
+  bool         reused;
 
   ink_assert((alignment & (alignment - 1)) == 0);
 
+  ++m_stats.allocs;
+  m_stats.bytes += size;
+
   b = m_blocks;
   while (b) {
     mem = block_alloc(b, size, alignment);
@@ -114,10 +155,15 @@ Arena::alloc(size_t size, size_t alignment)
     block_size = DEFAULT_BLOCK_SIZE;
   }
 
-  b        = blk_alloc(block_size);
+  b        = blk_alloc(block_size, reused);
   b->next  = m_blocks;
   m_blocks = b;
 
+  ++m_stats.blocks;
+  if (reused) {
+    ++m_stats.blocks_reused;
+  }
+
   mem = block_alloc(b, size, alignment);
   return mem;
 }
@@ -156,4 +202,5 @@ Arena::reset()
     m_blocks = b;
   }
   ink_assert(m_blocks == nullptr);
+  m_stats = Stats{};
 }
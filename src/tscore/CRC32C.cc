@@ -0,0 +1,166 @@
+/** @file
+
+  CRC-32C (Castagnoli) checksum.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "tscore/CRC32C.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace
+{
+// Reflected Castagnoli polynomial.
+constexpr uint32_t POLY = 0x82F63B78;
+
+using Table = std::array<std::array<uint32_t, 256>, 8>;
+
+// Tables for slicing by 8 bytes: table[k][b] is the CRC of byte b followed by k zero bytes.
+constexpr Table
+make_table()
+{
+  Table table{};
+  for (uint32_t b = 0; b < 256; ++b) {
+    uint32_t crc = b;
+    for (int i = 0; i < 8; ++i) {
+      crc = (crc >> 1) ^ (POLY & (0 - (crc & 1)));
+    }
+    table[0][b] = crc;
+  }
+  for (uint32_t b = 0; b < 256; ++b) {
+    for (int k = 1; k < 8; ++k) {
+      table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+    }
+  }
+  return table;
+}
+
+constexpr Table TABLE = make_table();
+
+inline uint32_t
+load32(const uint8_t *p)
+{
+  return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint32_t
+crc32c_table(uint32_t crc, const uint8_t *p, size_t len)
+{
+  for (; len >= 8; p += 8, len -= 8) {
+    uint32_t lo = load32(p) ^ crc;
+    uint32_t hi = load32(p + 4);
+    crc = TABLE[7][lo & 0xFF] ^ TABLE[6][(lo >> 8) & 0xFF] ^ TABLE[5][(lo >> 16) & 0xFF] ^ TABLE[4][lo >> 24] ^
+          TABLE[3][hi & 0xFF] ^ TABLE[2][(hi >> 8) & 0xFF] ^ TABLE[1][(hi >> 16) & 0xFF] ^ TABLE[0][hi >> 24];
+  }
+  for (; len; ++p, --len) {
+    crc = (crc >> 8) ^ TABLE[0][(crc ^ *p) & 0xFF];
+  }
+  return crc;
+}
+
+#if defined(__x86_64__)
+
+__attribute__((target("sse4.2"))) uint32_t
+crc32c_hw(uint32_t crc, const uint8_t *p, size_t len)
+{
+  uint64_t c = crc;
+  for (; len >= 8; p += 8, len -= 8) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    c = _mm_crc32_u64(c, v);
+  }
+  crc = static_cast<uint32_t>(c);
+  for (; len; ++p, --len) {
+    crc = _mm_crc32_u8(crc, *p);
+  }
+  return crc;
+}
+
+using Impl = uint32_t (*)(uint32_t, const uint8_t *, size_t);
+
+Impl
+select_impl()
+{
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sse4.2") ? &crc32c_hw : &crc32c_table;
+}
+
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+
+uint32_t
+crc32c_hw(uint32_t crc, const uint8_t *p, size_t len)
+{
+  for (; len >= 8; p += 8, len -= 8) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    crc = __crc32cd(crc, v);
+  }
+  for (; len; ++p, --len) {
+    crc = __crc32cb(crc, *p);
+  }
+  return crc;
+}
+
+#endif
+
+} // namespace
+
+namespace ts
+{
+uint32_t
+crc32c_sw(const void *data, size_t len, uint32_t crc)
+{
+  return ~crc32c_table(~crc, static_cast<const uint8_t *>(data), len);
+}
+
+uint32_t
+crc32c(const void *data, size_t len, uint32_t crc)
+{
+#if defined(__x86_64__)
+  static const Impl impl = select_impl();
+  return ~impl(~crc, static_cast<const uint8_t *>(data), len);
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+  return ~crc32c_hw(~crc, static_cast<const uint8_t *>(data), len);
+#else
+  return crc32c_sw(data, len, crc);
+#endif
+}
+
+bool
+crc32c_hw_available()
+{
+#if defined(__x86_64__)
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sse4.2");
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace ts
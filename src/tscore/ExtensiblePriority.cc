@@ -0,0 +1,340 @@
+/** @file
+
+  Extensible Priorities (RFC 9218)
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "tscore/ExtensiblePriority.h"
+
+#include <algorithm>
+
+namespace
+{
+/** Just enough of a Structured Fields ([RFC 8941] 4.2) parser to read the integer and boolean members of a Dictionary.
+ *
+ * Other item types are validated and skipped.
+ */
+class SFParser
+{
+public:
+  enum class Type { INTEGER, BOOLEAN, OTHER };
+
+  struct Item {
+    Type    type  = Type::OTHER;
+    int64_t value = 0;
+  };
+
+  explicit SFParser(std::string_view s) : _s(s) {}
+
+  bool
+  at_end() const
+  {
+    return _pos >= _s.size();
+  }
+
+  char
+  peek() const
+  {
+    return at_end() ? '\0' : _s[_pos];
+  }
+
+  bool
+  consume(char c)
+  {
+    if (peek() == c) {
+      ++_pos;
+      return true;
+    }
+    return false;
+  }
+
+  void
+  skip_sp()
+  {
+    while (peek() == ' ') {
+      ++_pos;
+    }
+  }
+
+  void
+  skip_ows()
+  {
+    while (peek() == ' ' || peek() == '\t') {
+      ++_pos;
+    }
+  }
+
+  void
+  trim_end()
+  {
+    while (!_s.empty() && (_s.back() == ' ' || _s.back() == '\t')) {
+      _s.remove_suffix(1);
+    }
+  }
+
+  bool
+  key(std::string_view &k)
+  {
+    size_t start = _pos;
+    char   c     = peek();
+    if (!(is_lcalpha(c) || c == '*')) {
+      return false;
+    }
+    while (!at_end()) {
+      c = peek();
+      if (!(is_lcalpha(c) || is_digit(c) || c == '_' || c == '-' || c == '.' || c == '*')) {
+        break;
+      }
+      ++_pos;
+    }
+    k = _s.substr(start, _pos - start);
+    return true;
+  }
+
+  bool
+  bare_item(Item &item)
+  {
+    char c = peek();
+    if (c == '-' || is_digit(c)) {
+      return number(item);
+    } else if (c == '"') {
+      return string();
+    } else if (c == '*' || is_alpha(c)) {
+      return token();
+    } else if (c == ':') {
+      return binary();
+    } else if (c == '?') {
+      ++_pos;
+      if (peek() != '0' && peek() != '1') {
+        return false;
+      }
+      item.type  = Type::BOOLEAN;
+      item.value = peek() == '1';
+      ++_pos;
+      return true;
+    }
+    return false;
+  }
+
+  bool
+  parameters()
+  {
+    while (consume(';')) {
+      skip_sp();
+      std::string_view k;
+      if (!key(k)) {
+        return false;
+      }
+      Item item;
+      if (consume('=') && !bare_item(item)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool
+  inner_list()
+  {
+    if (!consume('(')) {
+      return false;
+    }
+    while (!at_end()) {
+      skip_sp();
+      if (consume(')')) {
+        return parameters();
+      }
+      Item item;
+      if (!bare_item(item) || !parameters()) {
+        return false;
+      }
+      if (peek() != ' ' && peek() != ')') {
+        return false;
+      }
+    }
+    return false;
+  }
+
+private:
+  static bool
+  is_digit(char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  static bool
+  is_lcalpha(char c)
+  {
+    return c >= 'a' && c <= 'z';
+  }
+
+  static bool
+  is_alpha(char c)
+  {
+    return is_lcalpha(c) || (c >= 'A' && c <= 'Z');
+  }
+
+  bool
+  number(Item &item)
+  {
+    bool negative = consume('-');
+    int  digits   = 0;
+    int  value    = 0;
+    while (is_digit(peek())) {
+      if (++digits > 15) {
+        return false;
+      }
+      // Only small values are of interest, larger ones are clamped.
+      value = std::min(value * 10 + (peek() - '0'), 1000);
+      ++_pos;
+    }
+    if (digits == 0) {
+      return false;
+    }
+    if (consume('.')) {
+      int fraction = 0;
+      while (is_digit(peek())) {
+        ++fraction;
+        ++_pos;
+      }
+      if (digits > 12 || fraction < 1 || fraction > 3) {
+        return false;
+      }
+      item.type = Type::OTHER;
+      return true;
+    }
+    item.type  = Type::INTEGER;
+    item.value = negative ? -value : value;
+    return true;
+  }
+
+  bool
+  string()
+  {
+    ++_pos;
+    while (!at_end()) {
+      char c = _s[_pos++];
+      if (c == '\\') {
+        if (peek() != '"' && peek() != '\\') {
+          return false;
+        }
+        ++_pos;
+      } else if (c == '"') {
+        return true;
+      } else if (c < 0x20 || c > 0x7e) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  bool
+  token()
+  {
+    static constexpr std::string_view extra{"!#$%&'*+-.^_`|~:/"};
+    ++_pos;
+    while (!at_end() && (is_alpha(peek()) || is_digit(peek()) || extra.find(peek()) != std::string_view::npos)) {
+      ++_pos;
+    }
+    return true;
+  }
+
+  bool
+  binary()
+  {
+    ++_pos;
+    while (!at_end()) {
+      char c = _s[_pos++];
+      if (c == ':') {
+        return true;
+      } else if (!(is_alpha(c) || is_digit(c) || c == '+' || c == '/' || c == '=')) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+  std::string_view _s;
+  size_t           _pos = 0;
+};
+
+} // namespace
+
+ExtensiblePriority
+ExtensiblePriority::parse(std::string_view value)
+{
+  ExtensiblePriority priority;
+  ExtensiblePriority parsed;
+  SFParser           p(value);
+
+  // [RFC 8941] 4.2. Parsing Structured Fields, discard leading and trailing spaces.
+  p.skip_sp();
+  p.trim_end();
+  while (!p.at_end()) {
+    std::string_view key;
+    SFParser::Item   item;
+    if (!p.key(key)) {
+      return priority;
+    }
+    if (p.consume('=')) {
+      if (p.peek() == '(') {
+        if (!p.inner_list()) {
+          return priority;
+        }
+        item.type = SFParser::Type::OTHER;
+      } else if (!p.bare_item(item) || !p.parameters()) {
+        return priority;
+      }
+    } else {
+      // A member without a value is boolean true.
+      item.type  = SFParser::Type::BOOLEAN;
+      item.value = 1;
+      if (!p.parameters()) {
+        return priority;
+      }
+    }
+
+    // [RFC 9218] 4.1 and 4.2, a later member of the same name overrides an earlier one.
+    if (key == "u") {
+      if (item.type == SFParser::Type::INTEGER && item.value >= 0 && item.value < URGENCY_LEVELS) {
+        parsed.urgency = item.value;
+      } else {
+        parsed.urgency = DEFAULT_URGENCY;
+      }
+    } else if (key == "i") {
+      parsed.incremental = item.type == SFParser::Type::BOOLEAN && item.value;
+    }
+
+    p.skip_ows();
+    if (p.at_end()) {
+      break;
+    }
+    if (!p.consume(',')) {
+      return priority;
+    }
+    p.skip_ows();
+    if (p.at_end()) {
+      // Trailing comma
+      return priority;
+    }
+  }
+
+  return parsed;
+}
@@ -38,8 +38,11 @@
 
 #include "tscore/ink_config.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <memory.h>
+#include <mutex>
 #include <cstdlib>
 #include <unistd.h>
 #include <sys/types.h>
@@ -53,6 +56,7 @@
 #include "tscore/ink_error.h"
 #include "tscore/ink_assert.h"
 #include "tscore/ink_align.h"
+#include "tscore/ink_hw.h"
 #include "tscore/hugepages.h"
 #include "tscore/Diags.h"
 #include "tscore/JeMiAllocator.h"
@@ -98,6 +102,117 @@ static const ink_freelist_ops *default_ops  = &freelist_ops;
 static ink_freelist_list      *freelists           = nullptr;
 static const ink_freelist_ops *freelist_global_ops = default_ops;
 
+// Operating system index of the NUMA node this thread is bound to, -1 if not bound.
+static thread_local int freelist_thread_node = -1;
+
+static inline InkFreeListNode &
+freelist_node(InkFreeList *f)
+{
+  return f->nodes[freelist_thread_node < 0 ? 0 : freelist_thread_node];
+}
+
+// Address space reserved for the chunks of a NUMA node, so that the node of an item is found from its address. The
+// arena of a node is reserved by the first chunk allocation of a thread bound to it, and is never released.
+struct FreeListArena {
+  uintptr_t           base   = 0;
+  size_t              size   = 0;
+  bool                failed = false;
+  std::atomic<size_t> used{0};
+};
+
+static FreeListArena         freelist_arenas[INK_FREELIST_MAX_NODES];
+static std::atomic<unsigned> freelist_arena_nodes{0}; // Bit mask of the nodes with an arena.
+static std::atomic<size_t>   freelist_arena_size{INK_FREELIST_NODE_LIMIT};
+static std::mutex            freelist_arena_mutex;
+
+// The arena of @a node, reserved if this is the first use. Returns nullptr if it could not be reserved.
+static FreeListArena *
+freelist_arena(int node)
+{
+  FreeListArena &arena = freelist_arenas[node];
+
+  if (freelist_arena_nodes.load(std::memory_order_acquire) & (1u << node)) {
+    return &arena;
+  }
+
+  std::lock_guard<std::mutex> lock(freelist_arena_mutex);
+  if (arena.base == 0 && !arena.failed) {
+    size_t size = INK_ALIGN(freelist_arena_size.load(), ats_pagesize());
+    void  *p    = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+      ink_warning("freelist: unable to reserve %zu bytes for NUMA node %d, its chunks will not be node local", size, node);
+      arena.failed = true;
+      return nullptr;
+    }
+#if TS_USE_HWLOC && HWLOC_API_VERSION >= 0x20000
+    hwloc_topology_t topology = ink_get_topology();
+    if (hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NUMANODE) > 1) {
+      if (hwloc_obj_t obj = hwloc_get_numanode_obj_by_os_index(topology, node); obj != nullptr) {
+        hwloc_set_area_membind(topology, p, size, obj->nodeset, HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_BYNODESET);
+      }
+    }
+#endif
+    arena.base = reinterpret_cast<uintptr_t>(p);
+    arena.size = size;
+    freelist_arena_nodes.fetch_or(1u << node, std::memory_order_release);
+  }
+  return arena.base ? &arena : nullptr;
+}
+
+// The list of the node whose arena holds @a item, or the list of this thread for items from other memory.
+static inline InkFreeListNode &
+freelist_home(InkFreeList *f, void *item)
+{
+  unsigned nodes = freelist_arena_nodes.load(std::memory_order_acquire);
+
+  for (int n = 0; nodes != 0; ++n, nodes >>= 1) {
+    if ((nodes & 1) && reinterpret_cast<uintptr_t>(item) - freelist_arenas[n].base < freelist_arenas[n].size) {
+      return f->nodes[n];
+    }
+  }
+  return freelist_node(f);
+}
+
+static int64_t
+freelist_used(const InkFreeList *f)
+{
+  int64_t zret = 0;
+  for (auto const &n : f->nodes) {
+    zret += n.used;
+  }
+  return zret;
+}
+
+static int64_t
+freelist_allocated(const InkFreeList *f)
+{
+  int64_t zret = 0;
+  for (auto const &n : f->nodes) {
+    zret += n.allocated;
+  }
+  return zret;
+}
+
+// Allocate a chunk from the arena of the NUMA node of this thread.
+// Returns nullptr if the thread is not bound, or the arena is full or could not be reserved.
+static void *
+freelist_node_chunk_alloc(size_t size)
+{
+  if (freelist_thread_node < 0) {
+    return nullptr;
+  }
+
+  FreeListArena *arena = freelist_arena(freelist_thread_node);
+  if (arena == nullptr || arena->used.load(std::memory_order_relaxed) + size > arena->size) {
+    return nullptr;
+  }
+  size_t offset = arena->used.fetch_add(size);
+  if (offset + size > arena->size) {
+    return nullptr;
+  }
+  return reinterpret_cast<void *>(arena->base + offset);
+}
+
 inline void
 dummy_forced_read(void *mem)
 {
@@ -135,7 +250,7 @@ ink_freelist_init(InkFreeList **fl, const char *name, uint32_t type_size, uint32
 
   /* its safe to add to this global list because ink_freelist_init()
      is only called from single-threaded initialization code. */
-  f = static_cast<InkFreeList *>(ats_memalign(alignment, sizeof(InkFreeList)));
+  f = static_cast<InkFreeList *>(ats_memalign(std::max<size_t>(alignment, alignof(InkFreeList)), sizeof(InkFreeList)));
   ink_zero(*f);
 
   fll       = static_cast<ink_freelist_list *>(ats_malloc(sizeof(ink_freelist_list)));
@@ -170,7 +285,9 @@ ink_freelist_init(InkFreeList **fl, const char *name, uint32_t type_size, uint32
     f->chunk_size = INK_ALIGN(chunk_size * f->type_size, ats_pagesize()) / f->type_size;
   }
   Debug(DEBUG_TAG "_init", "<%s> Chunk Size request/actual (%" PRIu32 "/%" PRIu32 ")", name, chunk_size, f->chunk_size);
-  SET_FREELIST_POINTER_VERSION(f->head, FROM_PTR(0), 0);
+  for (auto &n : f->nodes) {
+    SET_FREELIST_POINTER_VERSION(n.head, FROM_PTR(0), 0);
+  }
 
   *fl = f;
 }
@@ -197,84 +314,148 @@ ink_freelist_create(const char *name, uint32_t type_size, uint32_t chunk_size, u
 void *
 ink_freelist_new(InkFreeList *f)
 {
-  void *ptr;
-
-  if (likely(ptr = freelist_global_ops->fl_new(f))) {
-    ink_atomic_increment(reinterpret_cast<int *>(&f->used), 1);
-  }
-
-  return ptr;
+  return freelist_global_ops->fl_new(f);
 }
 
+// Pop an item from the list of @a node, nullptr if it is empty.
 static void *
-freelist_new(InkFreeList *f)
+freelist_pop(InkFreeListNode &node)
 {
   head_p item;
   head_p next;
   int    result = 0;
 
   do {
-    INK_QUEUE_LD(item, f->head);
+    INK_QUEUE_LD(item, node.head);
     if (TO_PTR(FREELIST_POINTER(item)) == nullptr) {
-      uint32_t i;
-      void    *newp       = nullptr;
-      size_t   alloc_size = static_cast<size_t>(f->chunk_size) * f->type_size;
-      size_t   alignment  = 0;
-
-      if (f->use_hugepages) {
-        alignment = ats_hugepage_size();
-        newp      = ats_alloc_hugepage(alloc_size);
-        if (newp == nullptr) {
-          f->hugepages_failure++;
-        }
+      return nullptr;
+    }
+    SET_FREELIST_POINTER_VERSION(next, *ADDRESS_OF_NEXT(TO_PTR(FREELIST_POINTER(item)), 0), FREELIST_VERSION(item) + 1);
+    result = ink_atomic_cas(&node.head.data, item.data, next.data);
+
+#ifdef SANITY
+    if (result) {
+      if (FREELIST_POINTER(item) == TO_PTR(FREELIST_POINTER(next))) {
+        ink_abort("ink_freelist_new: loop detected");
       }
+      if (((uintptr_t)(TO_PTR(FREELIST_POINTER(next)))) & 3) {
+        ink_abort("ink_freelist_new: bad list");
+      }
+      if (TO_PTR(FREELIST_POINTER(next))) {
+        dummy_forced_read(TO_PTR(FREELIST_POINTER(next)));
+      }
+    }
+#endif /* SANITY */
+  } while (result == 0);
 
+  return TO_PTR(FREELIST_POINTER(item));
+}
+
+// Push the items from @a head to @a tail, linked through their first word, on the list of @a node.
+static void
+freelist_push(InkFreeListNode &node, void *head, void *tail)
+{
+  void **adr_of_next = ADDRESS_OF_NEXT(tail, 0);
+  head_p h;
+  head_p item_pair;
+  int    result = 0;
+
+  while (!result) {
+    INK_QUEUE_LD(h, node.head);
+#ifdef SANITY
+    if (TO_PTR(FREELIST_POINTER(h)) == head) {
+      ink_abort("ink_freelist_free: trying to free item twice");
+    }
+    if (((uintptr_t)(TO_PTR(FREELIST_POINTER(h)))) & 3) {
+      ink_abort("ink_freelist_free: bad list");
+    }
+    if (TO_PTR(FREELIST_POINTER(h))) {
+      dummy_forced_read(TO_PTR(FREELIST_POINTER(h)));
+    }
+#endif /* SANITY */
+    *adr_of_next = FREELIST_POINTER(h);
+    SET_FREELIST_POINTER_VERSION(item_pair, FROM_PTR(head), FREELIST_VERSION(h));
+    INK_MEMORY_BARRIER;
+    result = ink_atomic_cas(&node.head.data, h.data, item_pair.data);
+  }
+}
+
+// Take an item from the list of another node, for a thread whose node has no memory left.
+static void *
+freelist_steal(InkFreeList *f, InkFreeListNode &node, InkFreeListNode *&from)
+{
+  int idx = &node - f->nodes;
+
+  for (int i = 1; i < INK_FREELIST_MAX_NODES; ++i) {
+    InkFreeListNode &victim = f->nodes[(idx + i) % INK_FREELIST_MAX_NODES];
+    if (void *ptr = freelist_pop(victim); ptr != nullptr) {
+      from = &victim;
+      return ptr;
+    }
+  }
+  return nullptr;
+}
+
+static void *
+freelist_new(InkFreeList *f)
+{
+  InkFreeListNode &node = freelist_node(f);
+  InkFreeListNode *from = &node;
+  void            *ptr  = nullptr;
+
+  while ((ptr = freelist_pop(node)) == nullptr) {
+    head_p   item;
+    uint32_t i;
+    void    *newp       = nullptr;
+    size_t   alloc_size = static_cast<size_t>(f->chunk_size) * f->type_size;
+    size_t   alignment  = 0;
+
+    if (f->use_hugepages) {
+      alignment = ats_hugepage_size();
+      newp      = ats_alloc_hugepage(alloc_size);
       if (newp == nullptr) {
-        alignment = ats_pagesize();
-        newp      = ats_memalign(alignment, INK_ALIGN(alloc_size, alignment));
+        f->hugepages_failure++;
       }
+    }
 
-      if (f->advice) {
-        ats_madvise(static_cast<caddr_t>(newp), INK_ALIGN(alloc_size, alignment), f->advice);
-      }
-      SET_FREELIST_POINTER_VERSION(item, newp, 0);
+    if (newp == nullptr) {
+      alignment = ats_pagesize();
+      newp      = freelist_node_chunk_alloc(INK_ALIGN(alloc_size, alignment));
+    }
 
-      ink_atomic_increment(reinterpret_cast<int *>(&f->allocated), f->chunk_size);
+    // The memory of this node is exhausted, use the free items of the other nodes before memory of any node.
+    if (newp == nullptr && freelist_thread_node >= 0 && (ptr = freelist_steal(f, node, from)) != nullptr) {
+      break;
+    }
 
-      /* free each of the new elements */
-      for (i = 0; i < f->chunk_size; i++) {
-        char *a = (static_cast<char *>(FREELIST_POINTER(item))) + i * f->type_size;
-#ifdef DEADBEEF
-        const char str[4] = {static_cast<char>(0xde), static_cast<char>(0xad), static_cast<char>(0xbe), static_cast<char>(0xef)};
-        for (int j = 0; j < static_cast<int>(f->type_size); j++) {
-          a[j] = str[j % 4];
-        }
-#endif
-        freelist_free(f, a);
-      }
+    if (newp == nullptr) {
+      newp = ats_memalign(alignment, INK_ALIGN(alloc_size, alignment));
+    }
 
-    } else {
-      SET_FREELIST_POINTER_VERSION(next, *ADDRESS_OF_NEXT(TO_PTR(FREELIST_POINTER(item)), 0), FREELIST_VERSION(item) + 1);
-      result = ink_atomic_cas(&f->head.data, item.data, next.data);
+    if (f->advice) {
+      ats_madvise(static_cast<caddr_t>(newp), INK_ALIGN(alloc_size, alignment), f->advice);
+    }
+    SET_FREELIST_POINTER_VERSION(item, newp, 0);
 
-#ifdef SANITY
-      if (result) {
-        if (FREELIST_POINTER(item) == TO_PTR(FREELIST_POINTER(next))) {
-          ink_abort("ink_freelist_new: loop detected");
-        }
-        if (((uintptr_t)(TO_PTR(FREELIST_POINTER(next)))) & 3) {
-          ink_abort("ink_freelist_new: bad list");
-        }
-        if (TO_PTR(FREELIST_POINTER(next))) {
-          dummy_forced_read(TO_PTR(FREELIST_POINTER(next)));
-        }
+    ink_atomic_increment(&node.allocated, static_cast<int32_t>(f->chunk_size));
+
+    /* free each of the new elements */
+    for (i = 0; i < f->chunk_size; i++) {
+      char *a = (static_cast<char *>(FREELIST_POINTER(item))) + i * f->type_size;
+#ifdef DEADBEEF
+      const char str[4] = {static_cast<char>(0xde), static_cast<char>(0xad), static_cast<char>(0xbe), static_cast<char>(0xef)};
+      for (int j = 0; j < static_cast<int>(f->type_size); j++) {
+        a[j] = str[j % 4];
       }
-#endif /* SANITY */
+#endif
+      freelist_push(node, a, a);
     }
-  } while (result == 0);
-  ink_assert(!((uintptr_t)TO_PTR(FREELIST_POINTER(item)) & (((uintptr_t)f->alignment) - 1)));
+  }
+  ink_assert(!((uintptr_t)ptr & (((uintptr_t)f->alignment) - 1)));
+  // The item is counted as used on the list it was taken from, freeing it counts it on the list it is returned to.
+  ink_atomic_increment(&from->used, 1);
 
-  return TO_PTR(FREELIST_POINTER(item));
+  return ptr;
 }
 
 static void *
@@ -287,6 +468,7 @@ malloc_new(InkFreeList *f)
   } else {
     newp = ats_malloc(f->type_size);
   }
+  ink_atomic_increment(&freelist_node(f).used, 1);
 
   return newp;
 }
@@ -295,19 +477,15 @@ void
 ink_freelist_free(InkFreeList *f, void *item)
 {
   if (likely(item != nullptr)) {
-    ink_assert(f->used != 0);
+    ink_assert(freelist_used(f) != 0);
     freelist_global_ops->fl_free(f, item);
-    ink_atomic_decrement(reinterpret_cast<int *>(&f->used), 1);
   }
 }
 
 static void
 freelist_free(InkFreeList *f, void *item)
 {
-  void **adr_of_next = ADDRESS_OF_NEXT(item, 0);
-  head_p h;
-  head_p item_pair;
-  int    result = 0;
+  InkFreeListNode &home = freelist_home(f, item);
 
   // ink_assert(!((long)item&(f->alignment-1))); XXX - why is this no longer working? -bcall
 
@@ -322,24 +500,8 @@ freelist_free(InkFreeList *f, void *item)
   }
 #endif /* DEADBEEF */
 
-  while (!result) {
-    INK_QUEUE_LD(h, f->head);
-#ifdef SANITY
-    if (TO_PTR(FREELIST_POINTER(h)) == item) {
-      ink_abort("ink_freelist_free: trying to free item twice");
-    }
-    if (((uintptr_t)(TO_PTR(FREELIST_POINTER(h)))) & 3) {
-      ink_abort("ink_freelist_free: bad list");
-    }
-    if (TO_PTR(FREELIST_POINTER(h))) {
-      dummy_forced_read(TO_PTR(FREELIST_POINTER(h)));
-    }
-#endif /* SANITY */
-    *adr_of_next = FREELIST_POINTER(h);
-    SET_FREELIST_POINTER_VERSION(item_pair, FROM_PTR(item), FREELIST_VERSION(h));
-    INK_MEMORY_BARRIER;
-    result = ink_atomic_cas(&f->head.data, h.data, item_pair.data);
-  }
+  freelist_push(home, item, item);
+  ink_atomic_decrement(&home.used, 1);
 }
 
 static void
@@ -350,25 +512,20 @@ malloc_free(InkFreeList *f, void *item)
   } else {
     ats_free(item);
   }
+  ink_atomic_decrement(&freelist_node(f).used, 1);
 }
 
 void
 ink_freelist_free_bulk(InkFreeList *f, void *head, void *tail, size_t num_item)
 {
-  ink_assert(f->used >= num_item);
+  ink_assert(freelist_used(f) >= static_cast<int64_t>(num_item));
 
   freelist_global_ops->fl_bulkfree(f, head, tail, num_item);
-  ink_atomic_decrement(reinterpret_cast<int *>(&f->used), num_item);
 }
 
 static void
 freelist_bulkfree(InkFreeList *f, void *head, void *tail, size_t num_item)
 {
-  void **adr_of_next = ADDRESS_OF_NEXT(tail, 0);
-  head_p h;
-  head_p item_pair;
-  int    result = 0;
-
   // ink_assert(!((long)item&(f->alignment-1))); XXX - why is this no longer working? -bcall
 
 #ifdef DEADBEEF
@@ -387,23 +544,36 @@ freelist_bulkfree(InkFreeList *f, void *head, void *tail, size_t num_item)
   }
 #endif /* DEADBEEF */
 
-  while (!result) {
-    INK_QUEUE_LD(h, f->head);
-#ifdef SANITY
-    if (TO_PTR(FREELIST_POINTER(h)) == head) {
-      ink_abort("ink_freelist_free: trying to free item twice");
-    }
-    if (((uintptr_t)(TO_PTR(FREELIST_POINTER(h)))) & 3) {
-      ink_abort("ink_freelist_free: bad list");
+  if (freelist_arena_nodes.load(std::memory_order_acquire) == 0) {
+    InkFreeListNode &node = freelist_node(f);
+    freelist_push(node, head, tail);
+    ink_atomic_decrement(&node.used, static_cast<int32_t>(num_item));
+    return;
+  }
+
+  // Split the items by their node, and return each part to the list of its node.
+  void   *heads[INK_FREELIST_MAX_NODES]  = {};
+  void   *tails[INK_FREELIST_MAX_NODES]  = {};
+  int32_t counts[INK_FREELIST_MAX_NODES] = {};
+  void   *item                           = head;
+  for (size_t i = 0; i < num_item; ++i) {
+    void *next = TO_PTR(*ADDRESS_OF_NEXT(item, 0));
+    int   n    = &freelist_home(f, item) - f->nodes;
+    if (heads[n] == nullptr) {
+      heads[n] = item;
+    } else {
+      *ADDRESS_OF_NEXT(tails[n], 0) = FROM_PTR(item);
     }
-    if (TO_PTR(FREELIST_POINTER(h))) {
-      dummy_forced_read(TO_PTR(FREELIST_POINTER(h)));
+    tails[n] = item;
+    ++counts[n];
+    item = next;
+  }
+
+  for (int n = 0; n < INK_FREELIST_MAX_NODES; ++n) {
+    if (heads[n] != nullptr) {
+      freelist_push(f->nodes[n], heads[n], tails[n]);
+      ink_atomic_decrement(&f->nodes[n].used, counts[n]);
     }
-#endif /* SANITY */
-    *adr_of_next = FREELIST_POINTER(h);
-    SET_FREELIST_POINTER_VERSION(item_pair, FROM_PTR(head), FREELIST_VERSION(h));
-    INK_MEMORY_BARRIER;
-    result = ink_atomic_cas(&f->head.data, h.data, item_pair.data);
   }
 }
 
@@ -414,13 +584,13 @@ malloc_bulkfree(InkFreeList *f, void *head, void *tail, size_t num_item)
   void *next;
 
   // Avoid compiler warnings
-  (void)f;
   (void)tail;
 
   for (size_t i = 0; i < num_item && item; ++i, item = next) {
     next = *static_cast<void **>(item); // find next item before freeing current item
     ats_free(item);
   }
+  ink_atomic_decrement(&freelist_node(f).used, static_cast<int32_t>(num_item));
 }
 
 void
@@ -429,8 +599,8 @@ ink_freelists_snap_baseline()
   ink_freelist_list *fll;
   fll = freelists;
   while (fll) {
-    fll->fl->allocated_base = fll->fl->allocated;
-    fll->fl->used_base      = fll->fl->used;
+    fll->fl->allocated_base = freelist_allocated(fll->fl);
+    fll->fl->used_base      = freelist_used(fll->fl);
     fll                     = fll->next;
   }
 }
@@ -449,12 +619,14 @@ ink_freelists_dump_baselinerel(FILE *f)
 
   fll = freelists;
   while (fll) {
-    int a = fll->fl->allocated - fll->fl->allocated_base;
+    uint32_t allocated = freelist_allocated(fll->fl);
+    uint32_t used      = freelist_used(fll->fl);
+    int      a         = allocated - fll->fl->allocated_base;
     if (a != 0) {
       fprintf(f, " %18" PRIu64 " | %18" PRIu64 " | %7u | %10u | memory/%s\n",
-              static_cast<uint64_t>(fll->fl->allocated - fll->fl->allocated_base) * static_cast<uint64_t>(fll->fl->type_size),
-              static_cast<uint64_t>(fll->fl->used - fll->fl->used_base) * static_cast<uint64_t>(fll->fl->type_size),
-              fll->fl->used - fll->fl->used_base, fll->fl->type_size, fll->fl->name ? fll->fl->name : "<unknown>");
+              static_cast<uint64_t>(allocated - fll->fl->allocated_base) * static_cast<uint64_t>(fll->fl->type_size),
+              static_cast<uint64_t>(used - fll->fl->used_base) * static_cast<uint64_t>(fll->fl->type_size),
+              used - fll->fl->used_base, fll->fl->type_size, fll->fl->name ? fll->fl->name : "<unknown>");
     }
     fll = fll->next;
   }
@@ -478,17 +650,80 @@ ink_freelists_dump(FILE *f)
   uint64_t total_used      = 0;
   fll                      = freelists;
   while (fll) {
+    uint64_t allocated = freelist_allocated(fll->fl);
+    uint64_t used      = freelist_used(fll->fl);
     fprintf(f, " %18" PRIu64 " | %18" PRIu64 " | %18" PRIu64 " | %18" PRIu64 " | %10u | %10u | %10u | memory/%s\n",
-            static_cast<uint64_t>(fll->fl->allocated) * static_cast<uint64_t>(fll->fl->type_size),
-            static_cast<uint64_t>(fll->fl->allocated),
-            static_cast<uint64_t>(fll->fl->used) * static_cast<uint64_t>(fll->fl->type_size), static_cast<uint64_t>(fll->fl->used),
+            allocated * static_cast<uint64_t>(fll->fl->type_size), allocated, used * static_cast<uint64_t>(fll->fl->type_size), used,
             fll->fl->type_size, fll->fl->chunk_size, fll->fl->hugepages_failure, fll->fl->name ? fll->fl->name : "<unknown>");
-    total_allocated += static_cast<uint64_t>(fll->fl->allocated) * static_cast<uint64_t>(fll->fl->type_size);
-    total_used      += static_cast<uint64_t>(fll->fl->used) * static_cast<uint64_t>(fll->fl->type_size);
+    total_allocated += allocated * static_cast<uint64_t>(fll->fl->type_size);
+    total_used      += used * static_cast<uint64_t>(fll->fl->type_size);
     fll              = fll->next;
   }
   fprintf(f, " %18" PRIu64 " | %18" PRIu64 " |            | TOTAL\n", total_allocated, total_used);
   fprintf(f, "-----------------------------------------------------------------------------------------\n");
+
+  // Per NUMA node totals, only if more than one node has been used.
+  uint64_t node_allocated[INK_FREELIST_MAX_NODES];
+  uint64_t node_free[INK_FREELIST_MAX_NODES];
+  int      n_nodes = 0;
+  for (int node = 0; node < INK_FREELIST_MAX_NODES; ++node) {
+    ink_freelists_node_stats(node, &node_allocated[node], &node_free[node]);
+    if (node_allocated[node] != 0 || node_free[node] != 0) {
+      ++n_nodes;
+    }
+  }
+  if (n_nodes > 1) {
+    fprintf(f, "     Allocated      |        Free        | NUMA Node\n");
+    fprintf(f, "--------------------|--------------------|-----------\n");
+    for (int node = 0; node < INK_FREELIST_MAX_NODES; ++node) {
+      if (node_allocated[node] != 0 || node_free[node] != 0) {
+        fprintf(f, " %18" PRIu64 " | %18" PRIu64 " | %d\n", node_allocated[node], node_free[node], node);
+      }
+    }
+    fprintf(f, "-----------------------------------------------------------------------------------------\n");
+  }
+}
+
+void
+ink_freelist_set_thread_node(int node)
+{
+  if (node >= INK_FREELIST_MAX_NODES) {
+    ink_warning("freelist: NUMA node %d is beyond the %d supported, using the default list", node, INK_FREELIST_MAX_NODES);
+    node = -1;
+  }
+  freelist_thread_node = node;
+}
+
+int
+ink_freelist_thread_node()
+{
+  return freelist_thread_node;
+}
+
+void
+ink_freelist_set_node_limit(size_t bytes)
+{
+  freelist_arena_size = bytes;
+}
+
+void
+ink_freelists_node_stats(int node, uint64_t *allocated, uint64_t *free)
+{
+  int idx = node < 0 ? 0 : node;
+
+  *allocated = 0;
+  *free      = 0;
+  if (idx >= INK_FREELIST_MAX_NODES) {
+    return;
+  }
+  for (ink_freelist_list *fll = freelists; fll; fll = fll->next) {
+    InkFreeListNode const &n = fll->fl->nodes[idx];
+    // Items from memory of no node, freed by a thread on another node, land in this list, so free may exceed allocated.
+    int64_t n_free = static_cast<int64_t>(n.allocated) - n.used;
+
+    *allocated += static_cast<uint64_t>(n.allocated) * fll->fl->type_size;
+    *free      += static_cast<uint64_t>(std::max<int64_t>(n_free, 0)) * fll->fl->type_size;
+  }
 }
 
 void
@@ -0,0 +1,75 @@
+/** @file
+
+  Unit tests for CRC-32C.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "tscore/CRC32C.h"
+
+#include <catch.hpp>
+
+#include <cstring>
+#include <vector>
+
+TEST_CASE("CRC32C check values", "[libts][CRC32C]")
+{
+  // RFC 3720, B.4.
+  uint8_t buf[32];
+
+  REQUIRE(ts::crc32c("123456789", 9) == 0xE3069283);
+  REQUIRE(ts::crc32c_sw("123456789", 9) == 0xE3069283);
+  REQUIRE(ts::crc32c(nullptr, 0) == 0);
+
+  memset(buf, 0, sizeof(buf));
+  REQUIRE(ts::crc32c(buf, sizeof(buf)) == 0x8A9136AA);
+  memset(buf, 0xFF, sizeof(buf));
+  REQUIRE(ts::crc32c(buf, sizeof(buf)) == 0x62A8AB43);
+  for (int i = 0; i < 32; ++i) {
+    buf[i] = i;
+  }
+  REQUIRE(ts::crc32c(buf, sizeof(buf)) == 0x46DD794E);
+  for (int i = 0; i < 32; ++i) {
+    buf[i] = 31 - i;
+  }
+  REQUIRE(ts::crc32c(buf, sizeof(buf)) == 0x113FDB5C);
+}
+
+TEST_CASE("CRC32C implementations agree", "[libts][CRC32C]")
+{
+  std::vector<uint8_t> data(4099);
+  uint32_t             x = 0x12345678;
+  for (auto &b : data) {
+    x = x * 1103515245 + 12345;
+    b = x >> 24;
+  }
+
+  // All alignments and tail lengths.
+  for (size_t offset = 0; offset < 8; ++offset) {
+    for (size_t len : {0, 1, 7, 8, 9, 63, 64, 65, 4000}) {
+      CHECK(ts::crc32c(data.data() + offset, len) == ts::crc32c_sw(data.data() + offset, len));
+    }
+  }
+
+  // In pieces.
+  uint32_t crc = ts::crc32c(data.data(), 1000);
+  crc          = ts::crc32c(data.data() + 1000, 3, crc);
+  crc          = ts::crc32c(data.data() + 1003, data.size() - 1003, crc);
+  REQUIRE(crc == ts::crc32c(data.data(), data.size()));
+}
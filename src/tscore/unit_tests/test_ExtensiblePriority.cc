@@ -0,0 +1,164 @@
+/** @file
+
+    Unit tests for ExtensiblePriority
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "tscore/ExtensiblePriority.h"
+#include "catch.hpp"
+
+TEST_CASE("ExtensiblePriority parse", "[libts][ExtensiblePriority]")
+{
+  struct {
+    const char *value;
+    uint8_t     urgency;
+    bool        incremental;
+  } const tests[] = {
+    {"",                      3, false},
+    {"u=0",                   0, false},
+    {"u=7, i",                7, true },
+    {"i",                     3, true },
+    {"i=?0",                  3, false},
+    {"i=?1",                  3, true },
+    {"  u=1,i  ",             1, true },
+    {"u=1;a=2, i;b",          1, true },
+    {"u=2, u=5",              5, false},
+    {"u=1, foo=(\"a\" b), i", 1, true },
+    {"x=:cHJldGVuZA==:, u=4", 4, false},
+    {"u=1.5",                 3, false},
+    {"u=8",                   3, false},
+    {"u=-1",                  3, false},
+    {"u=1, i=2",              1, false},
+    {"i=\"yes\"",             3, false},
+    // Not a valid Dictionary, ignored as a whole
+    {"u=1,",                  3, false},
+    {"u=1 i",                 3, false},
+    {"U=1",                   3, false},
+    {"u=1, i=?2",             3, false},
+    {"u=\"1",                 3, false},
+  };
+
+  for (auto const &t : tests) {
+    INFO(t.value);
+    ExtensiblePriority p = ExtensiblePriority::parse(t.value);
+    CHECK(p.urgency == t.urgency);
+    CHECK(p.incremental == t.incremental);
+  }
+}
+
+namespace
+{
+struct Stream {
+  explicit Stream(int i) : id(i) {}
+
+  int                                    id;
+  ExtensiblePriorityQueue<Stream>::Entry entry{this};
+};
+
+ExtensiblePriority
+prio(uint8_t urgency, bool incremental)
+{
+  ExtensiblePriority p;
+  p.urgency     = urgency;
+  p.incremental = incremental;
+  return p;
+}
+} // namespace
+
+TEST_CASE("ExtensiblePriorityQueue", "[libts][ExtensiblePriority]")
+{
+  ExtensiblePriorityQueue<Stream> q;
+  Stream                          s1(1), s3(3), s5(5), s7(7);
+
+  REQUIRE(q.empty());
+  REQUIRE(q.top() == nullptr);
+
+  SECTION("Urgency order")
+  {
+    q.reprioritize(s1.entry, prio(5, false));
+    q.reprioritize(s3.entry, prio(1, false));
+    q.push(s1.entry);
+    q.push(s5.entry);
+    q.push(s3.entry);
+
+    CHECK(q.top() == &s3);
+    q.remove(s3.entry);
+    CHECK(q.top() == &s5);
+    q.remove(s5.entry);
+    CHECK(q.top() == &s1);
+    q.remove(s1.entry);
+    CHECK(q.empty());
+  }
+
+  SECTION("Non-incremental streams are served one at a time")
+  {
+    q.push(s1.entry);
+    q.push(s3.entry);
+    q.push(s1.entry);
+
+    CHECK(q.top() == &s1);
+    q.sent(s1.entry);
+    CHECK(q.top() == &s1);
+    q.remove(s1.entry);
+    CHECK(q.top() == &s3);
+  }
+
+  SECTION("Incremental streams are served round robin")
+  {
+    for (Stream *s : {&s1, &s3, &s5}) {
+      q.reprioritize(s->entry, prio(3, true));
+      q.push(s->entry);
+    }
+
+    int order[6];
+    for (int &id : order) {
+      Stream *s = q.top();
+      id        = s->id;
+      q.sent(s->entry);
+    }
+    CHECK(order[0] == 1);
+    CHECK(order[1] == 3);
+    CHECK(order[2] == 5);
+    CHECK(order[3] == 1);
+    CHECK(order[4] == 3);
+    CHECK(order[5] == 5);
+  }
+
+  SECTION("Reprioritize a queued stream")
+  {
+    q.push(s1.entry);
+    q.push(s3.entry);
+    q.push(s7.entry);
+    CHECK(q.top() == &s1);
+
+    q.reprioritize(s7.entry, prio(0, false));
+    CHECK(q.top() == &s7);
+    CHECK(q.in(s7.entry));
+
+    q.reprioritize(s7.entry, prio(6, false));
+    CHECK(q.top() == &s1);
+    q.remove(s1.entry);
+    q.remove(s3.entry);
+    CHECK(q.top() == &s7);
+    q.remove(s7.entry);
+    CHECK(!q.in(s7.entry));
+    CHECK(q.empty());
+  }
+}
@@ -53,4 +53,12 @@ TEST_CASE("Histogram Basic", "[libts][histogram]")
   REQUIRE(h[2] == 0);
   REQUIRE(h[12] == 1); // sample 19 should be here.
   REQUIRE(h[14] == 1); // sample 27 should be here.
+
+  // The top of the last range and the overflow bucket.
+  h(511);
+  h(512);
+  h(1024);
+  REQUIRE(h[h.N_BUCKETS - 2] == 1);
+  REQUIRE(h[h.N_BUCKETS - 1] == 4);
+  REQUIRE(h.min_for_bucket(h.N_BUCKETS - 1) == 512);
 };
@@ -94,3 +94,32 @@ TEST_CASE("test arena", "[libts][arena]")
   delete[] test_regions;
   delete a;
 }
+
+TEST_CASE("test arena stats", "[libts][arena]")
+{
+  Arena a;
+
+  REQUIRE(a.stats().allocs == 0);
+
+  // Small allocations fit in a single default size block.
+  for (int i = 0; i < 4; ++i) {
+    a.alloc(16);
+  }
+  REQUIRE(a.stats().allocs == 4);
+  REQUIRE(a.stats().bytes == 64);
+  REQUIRE(a.stats().blocks == 1);
+
+  a.reset();
+  REQUIRE(a.stats().allocs == 0);
+  REQUIRE(a.stats().blocks == 0);
+
+  // The block released by the reset is recycled on this thread.
+  a.str_store("recycled", 8);
+  REQUIRE(a.stats().blocks == 1);
+  REQUIRE(a.stats().blocks_reused == 1);
+
+  // Oversize blocks are not recycled.
+  a.alloc(8192);
+  REQUIRE(a.stats().blocks == 2);
+  REQUIRE(a.stats().blocks_reused == 1);
+}
@@ -0,0 +1,155 @@
+/** @file
+
+    Freelist unit tests.
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one
+    or more contributor license agreements.  See the NOTICE file
+    distributed with this work for additional information
+    regarding copyright ownership.  The ASF licenses this file
+    to you under the Apache License, Version 2.0 (the
+    "License"); you may not use this file except in compliance
+    with the License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <catch.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "tscore/ink_queue.h"
+
+namespace
+{
+// Use node indices unlikely to be used by anything else in the test process.
+constexpr int NODE_A = 5;
+constexpr int NODE_B = 6;
+constexpr int NODE_C = 7;
+
+struct NodeStats {
+  uint64_t allocated = 0;
+  uint64_t free      = 0;
+};
+
+NodeStats
+node_stats(int node)
+{
+  NodeStats zret;
+  ink_freelists_node_stats(node, &zret.allocated, &zret.free);
+  return zret;
+}
+
+// Run @a fn on a new thread bound to @a node. Catch assertions are not thread safe, so @a fn only records results.
+template <typename F>
+void
+on_node(int node, F &&fn)
+{
+  std::thread t([&]() {
+    ink_freelist_set_thread_node(node);
+    fn();
+  });
+  t.join();
+}
+} // namespace
+
+TEST_CASE("freelist NUMA nodes", "[libts][freelist]")
+{
+  constexpr uint32_t TYPE_SIZE  = 64;
+  constexpr uint32_t CHUNK_SIZE = 64;
+  InkFreeList       *fl         = ink_freelist_create("test_freelist_node", TYPE_SIZE, CHUNK_SIZE, 8);
+  uint32_t           n_chunk    = fl->chunk_size;
+  uint64_t           chunk      = uint64_t(n_chunk) * fl->type_size;
+
+  REQUIRE(ink_freelist_thread_node() == -1);
+
+  auto base_a = node_stats(NODE_A);
+  auto base_b = node_stats(NODE_B);
+  auto base_c = node_stats(NODE_C);
+
+  std::vector<void *> items;
+  int                 thread_node = -1;
+  on_node(NODE_A, [&]() {
+    thread_node = ink_freelist_thread_node();
+    for (int i = 0; i < 10; ++i) {
+      items.push_back(ink_freelist_new(fl));
+    }
+  });
+  CHECK(thread_node == NODE_A);
+
+  // One chunk was allocated for node A and 10 items are in use.
+  auto a = node_stats(NODE_A);
+  CHECK(a.allocated - base_a.allocated == chunk);
+  CHECK(a.free - base_a.free == chunk - 10 * fl->type_size);
+  CHECK(node_stats(NODE_B).allocated == base_b.allocated);
+
+  // Items freed by a thread on node B go back to the node A list. Node B allocates its own chunk.
+  void *reused = nullptr;
+  on_node(NODE_B, [&]() {
+    for (auto item : items) {
+      ink_freelist_free(fl, item);
+    }
+    reused = ink_freelist_new(fl);
+  });
+  CHECK(std::find(items.begin(), items.end(), reused) == items.end());
+  CHECK(node_stats(NODE_A).free - base_a.free == chunk);
+
+  auto b = node_stats(NODE_B);
+  CHECK(b.allocated - base_b.allocated == chunk);
+  CHECK(b.free - base_b.free == chunk - fl->type_size);
+
+  // A bulk free of items of both nodes by a thread on node C returns each item to its node.
+  on_node(NODE_A, [&]() { items[0] = ink_freelist_new(fl); });
+  on_node(NODE_C, [&]() {
+    *static_cast<void **>(items[0]) = reused;
+    ink_freelist_free_bulk(fl, items[0], reused, 2);
+  });
+  CHECK(node_stats(NODE_A).free - base_a.free == chunk);
+  CHECK(node_stats(NODE_B).free - base_b.free == chunk);
+  CHECK(node_stats(NODE_C).free == base_c.free);
+  CHECK(node_stats(NODE_C).allocated == base_c.allocated);
+
+  // A thread on a node at its memory limit takes items from another node.
+  std::vector<void *> taken;
+  ink_freelist_set_node_limit(chunk);
+  on_node(NODE_C, [&]() {
+    for (uint32_t i = 0; i <= n_chunk; ++i) {
+      taken.push_back(ink_freelist_new(fl));
+    }
+  });
+  ink_freelist_set_node_limit(INK_FREELIST_NODE_LIMIT);
+  CHECK(node_stats(NODE_C).allocated - base_c.allocated == chunk);
+  CHECK(node_stats(NODE_C).free == base_c.free);
+  CHECK(node_stats(NODE_A).free - base_a.free + node_stats(NODE_B).free - base_b.free == 2 * chunk - fl->type_size);
+
+  // The stolen item goes back to its own node when freed.
+  on_node(NODE_C, [&]() {
+    for (auto item : taken) {
+      ink_freelist_free(fl, item);
+    }
+  });
+  CHECK(node_stats(NODE_A).free - base_a.free == chunk);
+  CHECK(node_stats(NODE_B).free - base_b.free == chunk);
+  CHECK(node_stats(NODE_C).free - base_c.free == chunk);
+}
+
+TEST_CASE("freelist NUMA node out of range", "[libts][freelist]")
+{
+  int thread_node = 0;
+  on_node(INK_FREELIST_MAX_NODES, [&]() { thread_node = ink_freelist_thread_node(); });
+  CHECK(thread_node == -1);
+
+  uint64_t allocated = 1;
+  uint64_t free      = 1;
+  ink_freelists_node_stats(INK_FREELIST_MAX_NODES, &allocated, &free);
+  CHECK(allocated == 0);
+  CHECK(free == 0);
+}
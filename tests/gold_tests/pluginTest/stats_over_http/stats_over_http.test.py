@@ -17,6 +17,7 @@
 #  limitations under the License.
 
 from enum import Enum
+from jsonrpc import Request, Response
 
 Test.Summary = 'Exercise stats-over-http plugin'
 Test.SkipUnless(Condition.PluginExists('stats_over_http.so'))
@@ -72,8 +73,78 @@ class StatsOverHttpPluginTest:
         tr.Processes.Default.TimeOut = 3
         self.__checkProcessAfter(tr)
 
+    def __testCaseFormat(self, description, headers, query, content_type, contains, excludes):
+        tr = Test.AddTestRun(description)
+        self.__checkProcessBefore(tr)
+        tr.Processes.Default.Command = f"curl -vs --http1.1 {headers} 'http://127.0.0.1:{self.ts.Variables.port}/_stats{query}'"
+        tr.Processes.Default.ReturnCode = 0
+        tr.Processes.Default.Streams.stderr = Testers.ContainsExpression(
+            f"Content-Type: {content_type}", f"The response should be {content_type}")
+        tr.Processes.Default.Streams.stdout = Testers.ContainsExpression(contains, "The body should be in the requested format")
+        tr.Processes.Default.Streams.stdout += Testers.ExcludesExpression(excludes, "The body should not be in another format")
+        tr.Processes.Default.TimeOut = 3
+        self.__checkProcessAfter(tr)
+
+    def __testCaseSince(self):
+        # No stat changed after a version far ahead of the current one, so only the trailer is returned.
+        tr = Test.AddTestRun("since filters out the stats that did not change")
+        self.__checkProcessBefore(tr)
+        tr.Processes.Default.Command = f"curl -vs --http1.1 'http://127.0.0.1:{self.ts.Variables.port}/_stats?since=1000000000'"
+        tr.Processes.Default.ReturnCode = 0
+        tr.Processes.Default.Streams.stdout = Testers.ContainsExpression(
+            '"snapshot_version": [0-9]+', "The response should carry the snapshot version")
+        tr.Processes.Default.Streams.stdout += Testers.ExcludesExpression("proxy.process", "No stat should have changed")
+        tr.Processes.Default.TimeOut = 3
+        self.__checkProcessAfter(tr)
+
+    def __testCaseRPC(self):
+        tr = Test.AddTestRun("stats_over_http_snapshot RPC returns all the stats")
+        self.__checkProcessBefore(tr)
+        tr.AddJsonRPCClientRequest(self.ts, Request.stats_over_http_snapshot())
+
+        def validate_snapshot(resp: Response):
+            if resp.is_error():
+                return (False, resp.error_as_str())
+            result = resp.result
+            if int(result['version']) < 1 or int(result['epoch_ms']) <= 0:
+                return (False, f"Bad snapshot version or time: {result}")
+            names = [stat['name'] for stat in result['stats']]
+            if 'proxy.process.http.incoming_requests' not in names:
+                return (False, "proxy.process.http.incoming_requests is missing")
+            return (True, "All good")
+
+        tr.Processes.Default.Streams.stdout = Testers.CustomJSONRPCResponse(validate_snapshot)
+        self.__checkProcessAfter(tr)
+
+        tr = Test.AddTestRun("stats_over_http_snapshot RPC filters with since")
+        self.__checkProcessBefore(tr)
+        tr.AddJsonRPCClientRequest(self.ts, Request.stats_over_http_snapshot(since=1000000000))
+
+        def validate_since(resp: Response):
+            if resp.is_error():
+                return (False, resp.error_as_str())
+            if resp.result['stats']:
+                return (False, f"No stat should have changed: {resp.result['stats']}")
+            return (True, "All good")
+
+        tr.Processes.Default.Streams.stdout = Testers.CustomJSONRPCResponse(validate_since)
+        self.__checkProcessAfter(tr)
+
     def run(self):
         self.__testCase0()
+        self.__testCaseFormat(
+            "Accept text/plain selects the Prometheus format", "-H 'Accept: text/plain'", "", "text/plain; version=0.0.4",
+            "traffic_server_info[{]version=", '"global"')
+        self.__testCaseFormat(
+            "format=prometheus selects the Prometheus format", "", "?format=prometheus", "text/plain; version=0.0.4",
+            "proxy_process_http_incoming_requests [0-9]+", '"global"')
+        self.__testCaseFormat(
+            "format=csv selects the CSV format", "", "?format=csv", "text/csv", "snapshot_version,[0-9]+", '"global"')
+        self.__testCaseFormat(
+            "format=json overrides the Accept header", "-H 'Accept: text/csv'", "?format=json", "text/json",
+            '"snapshot_version": [0-9]+', "snapshot_version,")
+        self.__testCaseSince()
+        self.__testCaseRPC()
 
 
 StatsOverHttpPluginTest().run()
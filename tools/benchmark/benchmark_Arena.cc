@@ -0,0 +1,65 @@
+/** @file
+
+  Benchmark transaction style arena allocation against individual heap allocation.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <array>
+
+#include "tscore/Arena.h"
+#include "tscore/ink_memory.h"
+
+namespace
+{
+// Sizes typical of the per transaction strings - host names, URLs, redirect targets.
+constexpr std::array<size_t, 8> SIZES = {24, 96, 17, 180, 40, 310, 64, 12};
+} // namespace
+
+TEST_CASE("Arena", "[tscore][arena]")
+{
+  for (int n : {8, 32, 128}) {
+    BENCHMARK("ats_malloc / ats_free x" + std::to_string(n))
+    {
+      std::array<void *, 128> ptrs;
+      for (int i = 0; i < n; ++i) {
+        ptrs[i] = ats_malloc(SIZES[i % SIZES.size()]);
+      }
+      for (int i = 0; i < n; ++i) {
+        ats_free(ptrs[i]);
+      }
+      return ptrs[0];
+    };
+
+    BENCHMARK("Arena alloc / reset x" + std::to_string(n))
+    {
+      Arena arena;
+      void *p = nullptr;
+      for (int i = 0; i < n; ++i) {
+        p = arena.alloc(SIZES[i % SIZES.size()]);
+      }
+      arena.reset();
+      return p;
+    };
+  }
+}
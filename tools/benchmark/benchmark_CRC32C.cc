@@ -0,0 +1,60 @@
+/** @file
+
+  Benchmark cache fragment checksums: the byte sum, table driven CRC-32C and CRC-32C with CPU instructions.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <vector>
+
+#include "tscore/CRC32C.h"
+
+TEST_CASE("CRC32C", "[tscore][crc32c]")
+{
+  // Small objects and the default target fragment size.
+  for (size_t size : {4096, 65536, 1048576}) {
+    std::vector<char> data(size);
+    for (size_t i = 0; i < size; ++i) {
+      data[i] = static_cast<char>(i * 131);
+    }
+
+    BENCHMARK("byte sum " + std::to_string(size))
+    {
+      uint32_t sum = 0;
+      for (char c : data) {
+        sum += c;
+      }
+      return sum;
+    };
+
+    BENCHMARK("crc32c table " + std::to_string(size))
+    {
+      return ts::crc32c_sw(data.data(), data.size());
+    };
+
+    BENCHMARK(std::string("crc32c ") + (ts::crc32c_hw_available() ? "hardware " : "table ") + std::to_string(size))
+    {
+      return ts::crc32c(data.data(), data.size());
+    };
+  }
+}
@@ -0,0 +1,240 @@
+/** @file
+
+  Micro benchmark for freelist memory access across NUMA nodes.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "tscore/ink_hw.h"
+#include "tscore/ink_memory.h"
+#include "tscore/ink_queue.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if TS_USE_HWLOC
+#include <hwloc.h>
+#endif
+
+namespace
+{
+// Args
+int block_size = 32768; // BUFFER_SIZE_INDEX_32K, the default IOBuffer block size.
+int nblocks    = 1024;
+
+#if TS_USE_HWLOC
+/// Blocks allocated by a thread on a specific NUMA node.
+struct Blocks {
+  InkFreeList        *fl = nullptr;
+  std::vector<void *> items;
+};
+
+/** Allocate blocks from a thread bound to @a alloc_node.
+ *
+ * @param numa_local Use the freelist of the node (as an ET_NET thread does), otherwise node 0 as before.
+ *
+ * The blocks are filled by the allocating thread, as an IOBuffer block is by the thread reading from
+ * the network.
+ */
+void
+fill_blocks(Blocks &blocks, hwloc_obj_t alloc_node, bool numa_local)
+{
+  std::thread t([&]() {
+    hwloc_set_cpubind(ink_get_topology(), alloc_node->cpuset, HWLOC_CPUBIND_THREAD | HWLOC_CPUBIND_STRICT);
+    if (numa_local) {
+      ink_freelist_set_thread_node(alloc_node->os_index);
+    }
+    for (int i = 0; i < nblocks; ++i) {
+      void *item = ink_freelist_new(blocks.fl);
+      memset(item, i, block_size);
+      blocks.items.push_back(item);
+    }
+  });
+  t.join();
+}
+
+Blocks
+alloc_blocks(hwloc_obj_t alloc_node, bool numa_local)
+{
+  Blocks zret;
+  // A separate freelist for each case so blocks are never reused across cases.
+  zret.fl = ink_freelist_create("benchmark_numa", block_size, 16, ats_pagesize());
+  fill_blocks(zret, alloc_node, numa_local);
+
+  return zret;
+}
+
+/// Free all the blocks from a thread bound to @a free_node.
+void
+free_blocks(Blocks &blocks, hwloc_obj_t free_node, bool numa_local)
+{
+  std::thread t([&]() {
+    hwloc_set_cpubind(ink_get_topology(), free_node->cpuset, HWLOC_CPUBIND_THREAD | HWLOC_CPUBIND_STRICT);
+    if (numa_local) {
+      ink_freelist_set_thread_node(free_node->os_index);
+    }
+    for (auto item : blocks.items) {
+      ink_freelist_free(blocks.fl, item);
+    }
+  });
+  t.join();
+  blocks.items.clear();
+}
+
+/// Read every block, as the thread writing to the network does.
+uint64_t
+read_blocks(Blocks const &blocks)
+{
+  uint64_t sum = 0;
+  for (auto item : blocks.items) {
+    auto p = static_cast<uint64_t const *>(item);
+    for (size_t i = 0; i < block_size / sizeof(uint64_t); ++i) {
+      sum += p[i];
+    }
+  }
+  return sum;
+}
+
+void
+print_node_stats(int n_nodes)
+{
+  hwloc_topology_t topology = ink_get_topology();
+  uint64_t         allocated, free;
+
+  for (int idx = 0; idx < n_nodes; ++idx) {
+    hwloc_obj_t node = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, idx);
+    ink_freelists_node_stats(node->os_index, &allocated, &free);
+    std::cout << "node " << node->os_index << " allocated " << allocated << " free " << free << std::endl;
+  }
+}
+
+TEST_CASE("freelist block access across NUMA nodes", "")
+{
+  hwloc_topology_t topology = ink_get_topology();
+  int              n_nodes  = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NODE);
+
+  if (n_nodes < 2) {
+    std::cout << "Only " << n_nodes << " NUMA node, cross node cases skipped." << std::endl;
+  }
+
+  for (int reader = 0; reader < n_nodes; ++reader) {
+    hwloc_obj_t read_node = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, reader);
+    hwloc_set_cpubind(topology, read_node->cpuset, HWLOC_CPUBIND_THREAD | HWLOC_CPUBIND_STRICT);
+
+    for (int writer = 0; writer < n_nodes; ++writer) {
+      hwloc_obj_t alloc_node = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, writer);
+
+      for (bool numa_local : {false, true}) {
+        Blocks      blocks = alloc_blocks(alloc_node, numa_local);
+        std::string name   = "alloc node " + std::to_string(alloc_node->os_index) + " read node " +
+                           std::to_string(read_node->os_index) + (numa_local ? " node freelist" : " shared freelist");
+
+        BENCHMARK(name.c_str())
+        {
+          return read_blocks(blocks);
+        };
+      }
+    }
+  }
+
+  print_node_stats(n_nodes);
+}
+
+/** Blocks allocated on one node, then freed and allocated again on another.
+ *
+ * This is the life of an IOBuffer block filled by a thread on one socket and released by a thread on
+ * the other, which then allocates blocks of its own. If the freed blocks stay in the list of the
+ * releasing node, its new blocks are remote memory.
+ */
+TEST_CASE("freelist bandwidth of blocks freed on another node", "")
+{
+  hwloc_topology_t topology = ink_get_topology();
+  int              n_nodes  = hwloc_get_nbobjs_by_type(topology, HWLOC_OBJ_NODE);
+
+  if (n_nodes < 2) {
+    std::cout << "Only " << n_nodes << " NUMA node, cross node cases skipped." << std::endl;
+    return;
+  }
+
+  for (int releaser = 0; releaser < n_nodes; ++releaser) {
+    hwloc_obj_t free_node = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, releaser);
+    hwloc_set_cpubind(topology, free_node->cpuset, HWLOC_CPUBIND_THREAD | HWLOC_CPUBIND_STRICT);
+
+    for (int writer = 0; writer < n_nodes; ++writer) {
+      if (writer == releaser) {
+        continue;
+      }
+      hwloc_obj_t alloc_node = hwloc_get_obj_by_type(topology, HWLOC_OBJ_NODE, writer);
+
+      for (bool numa_local : {false, true}) {
+        Blocks blocks = alloc_blocks(alloc_node, numa_local);
+        free_blocks(blocks, free_node, numa_local);
+        fill_blocks(blocks, free_node, numa_local);
+
+        auto     start = std::chrono::steady_clock::now();
+        uint64_t sum   = 0;
+        for (int round = 0; round < 20; ++round) {
+          sum += read_blocks(blocks);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double                        bytes   = 20.0 * blocks.items.size() * block_size;
+
+        std::cout << "alloc node " << alloc_node->os_index << " freed and read on node " << free_node->os_index
+                  << (numa_local ? " node freelist: " : " shared freelist: ") << bytes / elapsed.count() / (1 << 30)
+                  << " GiB/s (checksum " << sum << ")" << std::endl;
+      }
+    }
+  }
+
+  print_node_stats(n_nodes);
+}
+#endif // TS_USE_HWLOC
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  auto cli = session.cli() |
+             Opt(block_size, "bytes")["--ts-block-size"]("size of each block\n"
+                                                         "(default: 32768)") |
+             Opt(nblocks, "n")["--ts-nblocks"]("number of blocks read per iteration\n"
+                                               "(default: 1024)");
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}
@@ -0,0 +1,252 @@
+/** @file
+
+  Benchmark HTTP/2 DATA frame emission of a large object over a loopback TCP connection, with the
+  payload copied into the session write buffer or referenced by block. The frames are sent with
+  writev() like the cleartext write path, or in TLS record sized writes like the SSL write path,
+  which coalesces short blocks.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "tscore/Layout.h"
+#include "iocore/eventsystem/EventSystem.h"
+#include "records/RecordsConfig.h"
+#include "proxy/http2/Http2Frame.h"
+
+#include "iocore/utils/diags.i"
+
+namespace
+{
+constexpr int64_t OBJECT_SIZE       = 16 * 1024 * 1024;
+constexpr int64_t FRAME_SIZE        = 16384;
+constexpr int64_t RECORD_SIZE       = 16383;
+constexpr int64_t WRITE_BUFFER_HIGH = 256 * 1024;
+
+struct Mode {
+  const char *name;
+  bool        reference; ///< Reference the payload, else copy it.
+  bool        records;   ///< Send in TLS record sized writes, else with writev().
+};
+
+constexpr Mode MODES[] = {
+  {"copy, writev",       false, false},
+  {"reference, writev",  true,  false},
+  {"copy, records",      false, true },
+  {"reference, records", true,  true },
+};
+
+/// A connected pair of loopback TCP sockets, the writer non-blocking.
+struct Loopback {
+  int out = -1;
+  int in  = -1;
+
+  Loopback()
+  {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len   = sizeof(addr);
+    REQUIRE(bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+    REQUIRE(listen(listener, 1) == 0);
+    REQUIRE(getsockname(listener, reinterpret_cast<sockaddr *>(&addr), &addr_len) == 0);
+
+    out = socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(connect(out, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+    in = accept(listener, nullptr, nullptr);
+    REQUIRE(in >= 0);
+    close(listener);
+
+    int one = 1;
+    setsockopt(out, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    fcntl(out, F_SETFL, fcntl(out, F_GETFL) | O_NONBLOCK);
+    fcntl(in, F_SETFL, fcntl(in, F_GETFL) | O_NONBLOCK);
+  }
+
+  ~Loopback()
+  {
+    close(out);
+    close(in);
+  }
+
+  /// Read everything the peer has received.
+  void
+  drain()
+  {
+    static char sink[256 * 1024];
+    while (read(in, sink, sizeof(sink)) > 0) {}
+  }
+};
+
+/// The DATA frame emission before payloads were referenced.
+int64_t
+write_frame_copy(MIOBuffer *out, IOBufferReader *r, uint32_t len)
+{
+  uint8_t buf[HTTP2_FRAME_HEADER_LEN];
+  http2_write_frame_header({len, HTTP2_FRAME_TYPE_DATA, 0, 1}, make_iovec(buf));
+  int64_t written = out->write(buf, sizeof(buf));
+  for (int64_t done = 0; done < len;) {
+    int64_t n  = std::min<int64_t>(len - done, r->block_read_avail());
+    done      += out->write(r->start(), n);
+    r->consume(n);
+  }
+  return written + len;
+}
+
+/// Send everything in @a r, a block per iovec like UnixNetVConnection, or in record sized pieces like SSLNetVConnection.
+void
+flush(Loopback &net, IOBufferReader *r, bool records)
+{
+  static char staging[RECORD_SIZE];
+
+  while (r->read_avail()) {
+    ssize_t n;
+    if (records) {
+      int64_t l = std::min<int64_t>(r->block_read_avail(), RECORD_SIZE);
+      char   *p = r->start();
+      if (l < RECORD_SIZE && l < r->read_avail()) {
+        l = std::min<int64_t>(r->read_avail(), RECORD_SIZE);
+        r->memcpy(staging, l);
+        p = staging;
+      }
+      n = write(net.out, p, l);
+    } else {
+      IOVec           iov[64];
+      int             niov = 0;
+      IOBufferReader *tmp  = r->clone();
+      while (niov < 64 && tmp->block_read_avail()) {
+        iov[niov].iov_base  = tmp->start();
+        iov[niov].iov_len   = tmp->block_read_avail();
+        tmp->consume(iov[niov++].iov_len);
+      }
+      tmp->dealloc();
+      n = writev(net.out, iov, niov);
+    }
+    if (n > 0) {
+      r->consume(n);
+    } else {
+      net.drain();
+    }
+  }
+  net.drain();
+}
+
+/// Send the object in @a object as DATA frames, @return The bytes sent.
+int64_t
+send_object(Loopback &net, IOBufferReader *object, const Mode &mode)
+{
+  MIOBuffer      *out   = new_MIOBuffer(iobuffer_size_to_index(262144, MAX_BUFFER_SIZE_INDEX));
+  IOBufferReader *out_r = out->alloc_reader();
+  IOBufferReader *src   = object->clone();
+  int64_t         total = 0;
+
+  while (src->read_avail()) {
+    uint32_t len = std::min(src->read_avail(), FRAME_SIZE);
+    if (mode.reference) {
+      total += Http2DataFrame(1, 0, src, len, true).write_to(out);
+    } else {
+      total += write_frame_copy(out, src, len);
+    }
+    if (out_r->read_avail() >= WRITE_BUFFER_HIGH) {
+      flush(net, out_r, mode.records);
+    }
+  }
+  flush(net, out_r, mode.records);
+
+  src->dealloc();
+  free_MIOBuffer(out);
+  return total;
+}
+
+double
+cpu_seconds()
+{
+  rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+} // namespace
+
+TEST_CASE("HTTP/2 DATA frames", "[http2][data]")
+{
+  // The object as a cache or origin read delivers it, in 32K blocks.
+  MIOBuffer      *object   = new_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+  IOBufferReader *object_r = object->alloc_reader();
+  std::string     chunk(32768, '\0');
+  for (size_t i = 0; i < chunk.size(); ++i) {
+    chunk[i] = static_cast<char>(i * 131);
+  }
+  for (int64_t n = 0; n < OBJECT_SIZE; n += chunk.size()) {
+    object->write(chunk.data(), chunk.size());
+  }
+
+  Loopback net;
+
+  for (const Mode &mode : MODES) {
+    BENCHMARK(std::string("16MB object, ") + mode.name)
+    {
+      return send_object(net, object_r, mode);
+    };
+  }
+
+  // CPU time rather than wall time, the loopback connection is bounded by the kernel copy.
+  for (const Mode &mode : MODES) {
+    constexpr int rounds = 16;
+    double        start  = cpu_seconds();
+    int64_t       bytes  = 0;
+    for (int i = 0; i < rounds; ++i) {
+      bytes += send_object(net, object_r, mode);
+    }
+    std::printf("%-24s %.3f ns/byte CPU\n", mode.name, (cpu_seconds() - start) * 1e9 / bytes);
+  }
+
+  free_MIOBuffer(object);
+}
+
+int
+main(int argc, char *argv[])
+{
+  Layout::create();
+  init_diags("", nullptr);
+  RecProcessInit();
+  LibRecordsConfigInit();
+  ink_event_system_init(EVENT_SYSTEM_MODULE_PUBLIC_VERSION);
+
+  EThread *main_thread = new EThread;
+  main_thread->set_specific();
+
+  return Catch::Session().run(argc, argv);
+}
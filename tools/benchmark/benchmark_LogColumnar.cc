@@ -0,0 +1,311 @@
+/** @file
+
+  Benchmark columnar log output against ASCII: the cost of writing a buffer of entries on the log
+  preprocessing thread, the size of the output, and the speed of a downstream aggregation over it.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <netinet/in.h>
+
+#include "tscore/Layout.h"
+#include "tscore/ink_align.h"
+#include "iocore/eventsystem/EventSystem.h"
+#include "proxy/logging/Log.h"
+#include "proxy/logging/LogAccess.h"
+#include "proxy/logging/LogBuffer.h"
+#include "proxy/logging/LogColumnar.h"
+#include "proxy/logging/LogFormat.h"
+#include "proxy/logging/LogRenderPlan.h"
+
+#include "iocore/utils/diags.i"
+
+namespace
+{
+// The squid format.
+const char *SQUID = "%<cqtq> %<ttms> %<chi> %<crc>/%<pssc> %<psql> %<cqhm> %<pquc> %<caun> %<phr>/%<shn> %<psct>";
+
+// Entries of a buffer, about the default log buffer size of ASCII output.
+constexpr int ENTRIES = 512;
+
+// Marshal @a count entries with the repetition of live traffic: a few status codes, methods and
+// hosts, a few hundred URLs and clients, varying sizes and timestamps.
+std::vector<std::vector<int64_t>>
+make_entries(LogFieldList &fields, int count)
+{
+  const char *statuses[] = {"200", "200", "200", "304", "404", "206"};
+  const char *methods[]  = {"GET", "GET", "GET", "HEAD", "POST"};
+  const char *hosts[]    = {"origin1.example.com", "origin2.example.com", "cdn.example.net"};
+  const char *types[]    = {"text/html", "image/png", "application/javascript", "video/mp4"};
+
+  std::vector<std::vector<int64_t>> entries;
+  uint32_t                          rnd = 12345;
+  auto                              next = [&]() { return (rnd = rnd * 1103515245 + 12345) >> 8; };
+
+  for (int i = 0; i < count; ++i) {
+    std::string entry(sizeof(LogEntryHeader), '\0');
+    for (LogField *f = fields.first(); f; f = fields.next(f)) {
+      std::string sym = f->symbol();
+      size_t      pos = entry.size();
+      switch (f->type()) {
+      case LogField::sINT:
+      case LogField::dINT: {
+        int64_t v = 0;
+        if (f->is_time_field()) {
+          v = 1700000000 + i / 100;
+        } else if (sym == "pssc") {
+          v = atoi(statuses[next() % 6]);
+        } else if (sym == "crc") {
+          v = next() % 4; // the cache result code
+        } else if (sym == "phr") {
+          v = next() % 3;
+        } else if (sym == "psql") {
+          v = 200 + next() % 100000;
+        } else {
+          v = next() % 2000;
+        }
+        entry.resize(pos + INK_MIN_ALIGN);
+        LogAccess::marshal_int(entry.data() + pos, v);
+        break;
+      }
+      case LogField::STRING: {
+        std::string value;
+        if (sym == "pquc") {
+          value = std::string("http://") + hosts[next() % 3] + "/assets/" + std::to_string(next() % 400) + ".js";
+        } else if (sym == "cqhm") {
+          value = methods[next() % 5];
+        } else if (sym == "shn") {
+          value = hosts[next() % 3];
+        } else if (sym == "psct") {
+          value = types[next() % 4];
+        } else {
+          value = "-";
+        }
+        int len = INK_ALIGN_DEFAULT(value.size() + 1);
+        entry.resize(pos + len);
+        LogAccess::marshal_str(entry.data() + pos, value.c_str(), len);
+        break;
+      }
+      case LogField::IP: {
+        sockaddr_in sin{};
+        sin.sin_family      = AF_INET;
+        sin.sin_addr.s_addr = htonl(0x0a000000 + next() % 300);
+        entry.resize(pos + LogAccess::marshal_ip(nullptr, reinterpret_cast<sockaddr *>(&sin)));
+        LogAccess::marshal_ip(entry.data() + pos, reinterpret_cast<sockaddr *>(&sin));
+        break;
+      }
+      default:
+        FAIL("unexpected field type");
+      }
+    }
+    auto header            = reinterpret_cast<LogEntryHeader *>(entry.data());
+    header->timestamp      = 1700000000 + i / 100;
+    header->timestamp_usec = next() % 1000000;
+    header->entry_len      = entry.size();
+
+    // Copy to words for the alignment of the fields.
+    std::vector<int64_t> words(entry.size() / sizeof(int64_t));
+    memcpy(words.data(), entry.data(), entry.size());
+    entries.push_back(std::move(words));
+  }
+  return entries;
+}
+
+const LogEntryHeader *
+header(const std::vector<int64_t> &words)
+{
+  return reinterpret_cast<const LogEntryHeader *>(words.data());
+}
+
+template <typename F>
+double
+rate(F &&fn, int per_call)
+{
+  auto start  = std::chrono::steady_clock::now();
+  int  rounds = 0;
+  std::chrono::duration<double> elapsed;
+  do {
+    fn();
+    ++rounds;
+    elapsed = std::chrono::steady_clock::now() - start;
+  } while (elapsed.count() < 0.5);
+  return static_cast<double>(rounds) * per_call / elapsed.count();
+}
+
+// The ASCII aggregation: split each line at spaces, take the status after the '/' of the 4th
+// token and the size of the 5th.
+void
+scan_ascii(const std::string &text, std::map<int64_t, int64_t> &bytes_by_status)
+{
+  const char *p   = text.data();
+  const char *end = p + text.size();
+  while (p < end) {
+    const char *eol    = static_cast<const char *>(memchr(p, '\n', end - p));
+    const char *tok[5] = {p};
+    int         n      = 1;
+    for (const char *q = p; q < eol && n < 5; ++q) {
+      if (*q == ' ') {
+        tok[n++] = q + 1;
+      }
+    }
+    int64_t status = strtoll(static_cast<const char *>(memchr(tok[3], '/', eol - tok[3])) + 1, nullptr, 10);
+    bytes_by_status[status] += strtoll(tok[4], nullptr, 10);
+    p = eol + 1;
+  }
+}
+
+// The columnar aggregation: decode the two columns of each segment.
+void
+scan_columnar(const std::string &data, std::map<int64_t, int64_t> &bytes_by_status)
+{
+  LogColumnarSegment   segment;
+  std::vector<int64_t> status, bytes;
+  for (size_t pos = 0; pos < data.size() && segment.parse(data.data() + pos, data.size() - pos); pos += segment.length()) {
+    if (!segment.read_ints(segment.find("pssc"), status) || !segment.read_ints(segment.find("psql"), bytes)) {
+      continue;
+    }
+    for (size_t i = 0; i < status.size(); ++i) {
+      bytes_by_status[status[i]] += bytes[i];
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("Columnar log output", "[logging]")
+{
+  LogFormat format("bench", SQUID);
+  REQUIRE(format.valid());
+
+  auto              entries = make_entries(format.m_field_list, ENTRIES);
+  LogRenderPlan     plan(format.fieldlist(), format.printf_str(), LOG_ESCAPE_NONE);
+  LogColumnarSchema schema(format.fieldlist(), format.printf_str(), format.m_field_list);
+  LogColumnarWriter writer(schema);
+  REQUIRE(plan.valid());
+
+  // Write a buffer of entries, as the preprocessing thread does for each file format.
+  char line[LOG_MAX_FORMATTED_LINE];
+  auto write_ascii = [&](std::string &out) {
+    for (auto &e : entries) {
+      int len = plan.render(header(e), line, sizeof(line));
+      out.append(line, len);
+      out.push_back('\n');
+    }
+  };
+  auto write_columnar = [&](std::string &out) {
+    for (auto &e : entries) {
+      writer.add(header(e));
+    }
+    writer.finish(out);
+  };
+
+  // Some minutes of traffic, to scan.
+  std::string ascii, columnar;
+  for (int i = 0; i < 200; ++i) {
+    write_ascii(ascii);
+    write_columnar(columnar);
+  }
+
+  std::map<int64_t, int64_t> ascii_totals, columnar_totals;
+  scan_ascii(ascii, ascii_totals);
+  scan_columnar(columnar, columnar_totals);
+  REQUIRE(ascii_totals == columnar_totals);
+
+  // The columnar output renders as the ASCII output.
+  std::string rendered;
+  LogColumnarSegment segment;
+  REQUIRE(segment.parse(columnar.data(), columnar.size()));
+  REQUIRE(segment.for_each_entry([&](const LogEntryHeader *entry) {
+    int len = plan.render(entry, line, sizeof(line));
+    rendered.append(line, len);
+    rendered.push_back('\n');
+    return true;
+  }));
+  REQUIRE(ascii.compare(0, rendered.size(), rendered) == 0);
+
+  BENCHMARK("ascii write, 512 entries")
+  {
+    std::string out;
+    write_ascii(out);
+    return out.size();
+  };
+
+  BENCHMARK("columnar write, 512 entries")
+  {
+    std::string out;
+    write_columnar(out);
+    return out.size();
+  };
+
+  BENCHMARK("ascii scan")
+  {
+    std::map<int64_t, int64_t> totals;
+    scan_ascii(ascii, totals);
+    return totals.size();
+  };
+
+  BENCHMARK("columnar scan")
+  {
+    std::map<int64_t, int64_t> totals;
+    scan_columnar(columnar, totals);
+    return totals.size();
+  };
+
+  size_t rows = 200 * ENTRIES;
+  auto   report = [&](const char *name, const std::string &data, auto &&write, auto &&scan) {
+    double write_rate = rate(
+      [&]() {
+        std::string out;
+        write(out);
+      },
+      ENTRIES);
+    double scan_rate = rate(
+      [&]() {
+        std::map<int64_t, int64_t> totals;
+        scan(data, totals);
+      },
+      rows);
+    std::printf("%-10s %10.1f %16.0f %16.0f\n", name, static_cast<double>(data.size()) / rows, write_rate, scan_rate);
+  };
+
+  std::printf("\n%-10s %10s %16s %16s\n", "", "bytes/row", "write rows/sec", "scan rows/sec");
+  report("ascii", ascii, write_ascii, scan_ascii);
+  report("columnar", columnar, write_columnar, scan_columnar);
+}
+
+int
+main(int argc, char *argv[])
+{
+  Layout::create();
+  init_diags("", nullptr);
+  Log::init_fields();
+
+  return Catch::Session().run(argc, argv);
+}
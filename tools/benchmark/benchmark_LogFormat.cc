@@ -0,0 +1,166 @@
+/** @file
+
+  Benchmark rendering of log entries as ASCII for a 30 field format, by LogBuffer::to_ascii and by
+  the compiled LogRenderPlan, as done for each entry by the log preprocessing thread.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <netinet/in.h>
+
+#include "tscore/Layout.h"
+#include "tscore/ink_align.h"
+#include "iocore/eventsystem/EventSystem.h"
+#include "proxy/logging/Log.h"
+#include "proxy/logging/LogAccess.h"
+#include "proxy/logging/LogBuffer.h"
+#include "proxy/logging/LogFormat.h"
+#include "proxy/logging/LogRenderPlan.h"
+
+#include "iocore/utils/diags.i"
+
+namespace
+{
+// A squid like format extended with header and timing fields, 30 fields of every type.
+const char *FORMAT_30 = "%<cqtq> %<ttms> %<chi> %<crc>/%<pssc> %<psql> %<cqhm> %<pquc> %<caun> %<phr>/%<shn> %<psct> "
+                        "%<chp> %<cqpv> %<cqhl> %<pqcl> %<sssc> %<sscl> %<pscl> %<cqtr> %<cqssl> %<{Host}cqh> "
+                        "\"%<{User-Agent}cqh>\" \"%<{Referer}cqh>\" %<{Content-Type}psh> %<{Age}ssh> %<crat> %<shi> "
+                        "%<stms> %<cqtt>";
+
+constexpr int LINES = 1000;
+
+// Marshal an entry for @a fields with plausible values of each type.
+std::vector<char>
+make_entry(LogFieldList &fields)
+{
+  std::vector<char> entry(sizeof(LogEntryHeader));
+  int               i = 0;
+  for (LogField *f = fields.first(); f; f = fields.next(f), ++i) {
+    size_t pos = entry.size();
+    switch (f->type()) {
+    case LogField::sINT:
+    case LogField::dINT:
+      entry.resize(pos + INK_MIN_ALIGN);
+      LogAccess::marshal_int(entry.data() + pos, f->is_time_field() ? 1700000000 : 1000 + 37 * i);
+      break;
+    case LogField::STRING: {
+      std::string value = (i % 2) ? "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36" : "http://www.example.com/some/path";
+      int         len   = INK_ALIGN_DEFAULT(value.size() + 1);
+      entry.resize(pos + len);
+      LogAccess::marshal_str(entry.data() + pos, value.c_str(), len);
+      break;
+    }
+    case LogField::IP: {
+      sockaddr_in sin{};
+      sin.sin_family      = AF_INET;
+      sin.sin_addr.s_addr = htonl(0x0a000001 + i);
+      entry.resize(pos + LogAccess::marshal_ip(nullptr, reinterpret_cast<sockaddr *>(&sin)));
+      LogAccess::marshal_ip(entry.data() + pos, reinterpret_cast<sockaddr *>(&sin));
+      break;
+    }
+    default:
+      FAIL("unexpected field type");
+    }
+  }
+  auto header       = reinterpret_cast<LogEntryHeader *>(entry.data());
+  header->timestamp = 1700000000;
+  header->entry_len = entry.size();
+  return entry;
+}
+
+template <typename F>
+void
+report(const char *name, F &&render)
+{
+  auto start = std::chrono::steady_clock::now();
+  int  n     = 0;
+  for (int round = 0; round < 200; ++round) {
+    for (int i = 0; i < LINES; ++i) {
+      n += render() > 0;
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::printf("%-16s %.0f lines/sec\n", name, n / elapsed.count());
+}
+} // namespace
+
+TEST_CASE("Log format rendering", "[logging]")
+{
+  LogFormat format("bench", FORMAT_30);
+  REQUIRE(format.valid());
+  REQUIRE(format.field_count() == 30);
+
+  std::vector<char> entry  = make_entry(format.m_field_list);
+  auto              header = reinterpret_cast<LogEntryHeader *>(entry.data());
+  LogRenderPlan     plan(format.fieldlist(), format.printf_str(), LOG_ESCAPE_NONE);
+  REQUIRE(plan.valid());
+
+  char line[LOG_MAX_FORMATTED_LINE];
+  auto legacy = [&]() {
+    return LogBuffer::to_ascii(header, LOG_FORMAT_CUSTOM, line, sizeof(line), format.fieldlist(), format.printf_str(),
+                               LOG_SEGMENT_VERSION);
+  };
+  auto compiled = [&]() { return plan.render(header, line, sizeof(line)); };
+
+  int         len = legacy();
+  std::string expected(line, len);
+  REQUIRE(len > 0);
+  REQUIRE(compiled() == len);
+  REQUIRE(std::string(line, len) == expected);
+
+  BENCHMARK("to_ascii, 1000 lines")
+  {
+    int n = 0;
+    for (int i = 0; i < LINES; ++i) {
+      n += legacy();
+    }
+    return n;
+  };
+
+  BENCHMARK("LogRenderPlan, 1000 lines")
+  {
+    int n = 0;
+    for (int i = 0; i < LINES; ++i) {
+      n += compiled();
+    }
+    return n;
+  };
+
+  report("to_ascii", legacy);
+  report("LogRenderPlan", compiled);
+}
+
+int
+main(int argc, char *argv[])
+{
+  Layout::create();
+  init_diags("", nullptr);
+  Log::init_fields();
+
+  return Catch::Session().run(argc, argv);
+}
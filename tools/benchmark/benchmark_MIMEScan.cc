@@ -0,0 +1,199 @@
+/** @file
+
+  Benchmark HTTP/1.x header parsing with each header block scanner implementation.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include <array>
+#include <string>
+
+#include "proxy/hdrs/HTTP.h"
+#include "proxy/hdrs/MIMEScan.h"
+
+extern int cmd_disable_pfreelist;
+
+namespace
+{
+// A desktop browser navigation request.
+constexpr std::string_view BROWSER_REQUEST =
+  "GET /articles/2023/11/edge-caching-at-scale.html?utm_source=newsletter&utm_medium=email HTTP/1.1\r\n"
+  "Host: www.example.com\r\n"
+  "Connection: keep-alive\r\n"
+  "sec-ch-ua: \"Chromium\";v=\"118\", \"Google Chrome\";v=\"118\", \"Not=A?Brand\";v=\"99\"\r\n"
+  "sec-ch-ua-mobile: ?0\r\n"
+  "sec-ch-ua-platform: \"macOS\"\r\n"
+  "Upgrade-Insecure-Requests: 1\r\n"
+  "User-Agent: Mozilla/5.0 (Macintosh; Intel Mac OS X 10_15_7) AppleWebKit/537.36 (KHTML, like Gecko) "
+  "Chrome/118.0.0.0 Safari/537.36\r\n"
+  "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,image/apng,*/*;q=0.8,"
+  "application/signed-exchange;v=b3;q=0.7\r\n"
+  "Sec-Fetch-Site: same-origin\r\n"
+  "Sec-Fetch-Mode: navigate\r\n"
+  "Sec-Fetch-User: ?1\r\n"
+  "Sec-Fetch-Dest: document\r\n"
+  "Referer: https://www.example.com/articles/\r\n"
+  "Accept-Encoding: gzip, deflate, br\r\n"
+  "Accept-Language: en-US,en;q=0.9,de;q=0.8\r\n"
+  "Cookie: _ga=GA1.2.1234567890.1698765432; _gid=GA1.2.987654321.1698765432; session=eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9."
+  "eyJzdWIiOiIxMjM0NTY3ODkwIiwibmFtZSI6IkpvaG4gRG9lIiwiaWF0IjoxNTE2MjM5MDIyfQ.SflKxwRJSMeKKF2QT4fwpMeJf36POk6yJV_adQssw5c; "
+  "consent=functional%2Canalytics; ab_bucket=42\r\n"
+  "If-None-Match: \"5f3e2a-1b2c3d4e\"\r\n"
+  "If-Modified-Since: Tue, 14 Nov 2023 08:12:31 GMT\r\n"
+  "\r\n";
+
+// A request as forwarded by a downstream CDN tier.
+constexpr std::string_view CDN_REQUEST =
+  "GET /static/js/app.3f9c1e2b.chunk.js HTTP/1.1\r\n"
+  "Host: assets.example.com\r\n"
+  "X-Forwarded-For: 203.0.113.17, 198.51.100.4\r\n"
+  "X-Forwarded-Proto: https\r\n"
+  "Via: 1.1 edge-fra-03 (ApacheTrafficServer/10.0.0), 1.1 mid-ams-01 (ApacheTrafficServer/10.0.0)\r\n"
+  "CDN-Loop: example-cdn; edge=fra03, example-cdn; mid=ams01\r\n"
+  "X-Request-Id: 8f14e45f-ceea-467f-a9f0-1d2b3c4d5e6f\r\n"
+  "Accept: */*\r\n"
+  "Accept-Encoding: br, gzip\r\n"
+  "User-Agent: Mozilla/5.0 (iPhone; CPU iPhone OS 17_1 like Mac OS X) AppleWebKit/605.1.15 (KHTML, like Gecko) "
+  "Version/17.1 Mobile/15E148 Safari/604.1\r\n"
+  "Range: bytes=0-1048575\r\n"
+  "Cache-Control: max-age=0\r\n"
+  "\r\n";
+
+// An origin response for a cacheable static object.
+constexpr std::string_view CDN_RESPONSE = "HTTP/1.1 200 OK\r\n"
+                                          "Date: Tue, 14 Nov 2023 08:12:31 GMT\r\n"
+                                          "Content-Type: application/javascript; charset=utf-8\r\n"
+                                          "Content-Length: 183274\r\n"
+                                          "Connection: keep-alive\r\n"
+                                          "Cache-Control: public, max-age=31536000, immutable\r\n"
+                                          "ETag: \"65532b7f-2cbea\"\r\n"
+                                          "Last-Modified: Tue, 14 Nov 2023 07:55:11 GMT\r\n"
+                                          "Vary: Accept-Encoding\r\n"
+                                          "Accept-Ranges: bytes\r\n"
+                                          "Access-Control-Allow-Origin: *\r\n"
+                                          "Strict-Transport-Security: max-age=63072000; includeSubDomains; preload\r\n"
+                                          "X-Content-Type-Options: nosniff\r\n"
+                                          "Timing-Allow-Origin: *\r\n"
+                                          "Age: 1234\r\n"
+                                          "X-Cache: HIT, MISS\r\n"
+                                          "Server-Timing: cdn-cache;desc=HIT, edge;dur=1, origin;dur=0\r\n"
+                                          "\r\n";
+
+constexpr std::array<mime_scan::Impl, 3> IMPLS = {mime_scan::Impl::SCALAR, mime_scan::Impl::SSE2, mime_scan::Impl::AVX2};
+
+ParseResult
+parse_req(std::string_view msg)
+{
+  HTTPParser parser;
+  HTTPHdr    hdr;
+  // The parser may unfold lines in place, so parse a copy.
+  std::string text{msg};
+  const char *start = text.data();
+
+  http_parser_init(&parser);
+  hdr.create(HTTP_TYPE_REQUEST);
+  auto zret = hdr.parse_req(&parser, &start, text.data() + text.size(), true);
+  hdr.destroy();
+  http_parser_clear(&parser);
+  return zret;
+}
+
+ParseResult
+parse_resp(std::string_view msg)
+{
+  HTTPParser  parser;
+  HTTPHdr     hdr;
+  std::string text{msg};
+  const char *start = text.data();
+
+  http_parser_init(&parser);
+  hdr.create(HTTP_TYPE_RESPONSE);
+  auto zret = hdr.parse_resp(&parser, &start, text.data() + text.size(), true);
+  hdr.destroy();
+  http_parser_clear(&parser);
+  return zret;
+}
+
+} // namespace
+
+TEST_CASE("MIMEScan", "[hdrs][mimescan]")
+{
+  // A long field value without line terminators, the common case for value validation.
+  swoc::TextView COOKIE_VALUE{BROWSER_REQUEST};
+  COOKIE_VALUE.remove_prefix(COOKIE_VALUE.find("_ga="));
+  COOKIE_VALUE = COOKIE_VALUE.prefix(COOKIE_VALUE.find('\r'));
+
+  for (auto impl : IMPLS) {
+    if (!mime_scan::set_impl(impl)) {
+      continue;
+    }
+    std::string name = mime_scan::impl_name(impl);
+
+    BENCHMARK("find_control " + name)
+    {
+      return mime_scan::find_control(COOKIE_VALUE);
+    };
+
+    BENCHMARK("index lines " + name)
+    {
+      mime_scan::Index index;
+      swoc::TextView   text{BROWSER_REQUEST};
+      size_t           n = 0;
+      while (!text.empty()) {
+        bool nul_p = false;
+        auto lf    = index.find_eol(text, nul_p);
+        if (lf == mime_scan::npos) {
+          break;
+        }
+        n += index.find_colon(text.prefix(lf));
+        text.remove_prefix(lf + 1);
+      }
+      return n;
+    };
+
+    BENCHMARK("parse browser request " + name)
+    {
+      return parse_req(BROWSER_REQUEST);
+    };
+
+    BENCHMARK("parse CDN request " + name)
+    {
+      return parse_req(CDN_REQUEST);
+    };
+
+    BENCHMARK("parse CDN response " + name)
+    {
+      return parse_resp(CDN_RESPONSE);
+    };
+  }
+}
+
+int
+main(int argc, char *argv[])
+{
+  // No thread setup, forbid use of thread local allocators.
+  cmd_disable_pfreelist = true;
+  http_init();
+
+  return Catch::Session().run(argc, argv);
+}
@@ -0,0 +1,392 @@
+/** @file
+
+  Simulation of the pre-warming algorithms - requires Catch2 v2.9.0+
+
+  Replay a trace of connection requests against a model of the pre-warming queues of one thread,
+  and report the hit rate and the connections opened by each algorithm.
+
+  A trace has one request per line, "<time in milliseconds> <destination>", lines starting with
+  '#' are ignored. Without a trace, synthetic ones are used: steady demand, a ramp up and down,
+  and a spike.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "proxy/http/PreWarmAlgorithm.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Args
+std::string trace_file;
+int64_t     event_period     = 1000; // ms
+int64_t     handshake_time   = 50;   // ms
+int64_t     inactive_timeout = 30;   // s
+int         min_size         = 0;
+int         max_size         = -1;
+double      rate             = 1.0;
+int         budget           = 0;
+
+struct Request {
+  int64_t     time; // ms
+  std::string dst;
+};
+
+using Trace = std::vector<Request>;
+
+struct Result {
+  uint64_t hit    = 0;
+  uint64_t miss   = 0;
+  uint64_t opened = 0; ///< Handshakes
+  uint64_t wasted = 0; ///< Connections closed by the inactive timeout without being used
+};
+
+/**
+   Model of the pool of one destination, mirrors PreWarmQueue::Info
+ */
+struct Pool {
+  std::deque<int64_t> init_list; ///< Time the handshake completes
+  std::deque<int64_t> open_list; ///< Time the connection times out, newest first
+  uint32_t            hit    = 0;
+  uint32_t            miss   = 0;
+  PreWarm::Demand     demand;
+  uint32_t            target = 0;
+
+  uint32_t
+  size() const
+  {
+    return init_list.size() + open_list.size();
+  }
+
+  void
+  open(int64_t now, Result &result)
+  {
+    init_list.push_back(now + handshake_time);
+    ++result.opened;
+  }
+
+  // Move the completed handshakes to the open list and drop the timed out connections.
+  void
+  advance(int64_t now, Result &result)
+  {
+    while (!init_list.empty() && init_list.front() <= now) {
+      open_list.push_front(init_list.front() + inactive_timeout * 1000);
+      init_list.pop_front();
+    }
+    while (!open_list.empty() && open_list.back() <= now) {
+      open_list.pop_back();
+      ++result.wasted;
+    }
+  }
+};
+
+// PreWarmQueue::_prewarm_on_event_interval
+void
+on_event_interval(PreWarm::Algorithm algorithm, Pool &pool, int64_t now, Result &result)
+{
+  uint32_t n = 0;
+
+  switch (algorithm) {
+  case PreWarm::Algorithm::V3:
+    n = PreWarm::prewarm_size_v3_on_event_interval(pool.target, pool.size());
+    break;
+  case PreWarm::Algorithm::V2:
+    n = PreWarm::prewarm_size_v2_on_event_interval(pool.hit, pool.miss, pool.size(), min_size, max_size, rate);
+    break;
+  case PreWarm::Algorithm::V1:
+    n = PreWarm::prewarm_size_v1_on_event_interval(pool.hit + pool.miss, pool.size(), min_size, max_size);
+    break;
+  }
+
+  for (uint32_t i = 0; i < n; ++i) {
+    pool.open(now, result);
+  }
+}
+
+// PreWarmQueue::_prewarm_on_dequeue
+void
+on_dequeue(PreWarm::Algorithm algorithm, Pool &pool, int64_t now, Result &result)
+{
+  switch (algorithm) {
+  case PreWarm::Algorithm::V3:
+    if (pool.size() < pool.target) {
+      pool.open(now, result);
+    }
+    break;
+  case PreWarm::Algorithm::V2:
+    if (static_cast<int32_t>(pool.size()) < max_size) {
+      pool.open(now, result);
+    }
+    break;
+  case PreWarm::Algorithm::V1:
+    break;
+  }
+}
+
+// PreWarmQueue::_update_targets
+void
+update_targets(std::map<std::string, Pool> &pools)
+{
+  uint64_t sum_min    = 0;
+  uint64_t sum_target = 0;
+
+  for (auto &[dst, pool] : pools) {
+    pool.demand.update(pool.hit + pool.miss);
+    pool.target  = PreWarm::prewarm_target_v3(pool.demand, min_size, max_size, rate);
+    sum_min     += std::min<uint32_t>(min_size, pool.target);
+    sum_target  += pool.target;
+  }
+
+  const double scale = PreWarm::prewarm_budget_scale_v3(sum_min, sum_target, budget);
+  for (auto &[dst, pool] : pools) {
+    const uint32_t min = std::min<uint32_t>(min_size, pool.target);
+    pool.target        = min + static_cast<uint32_t>((pool.target - min) * scale);
+  }
+}
+
+void
+tick(PreWarm::Algorithm algorithm, std::map<std::string, Pool> &pools, int64_t now, Result &result)
+{
+  if (algorithm == PreWarm::Algorithm::V3) {
+    update_targets(pools);
+  }
+  for (auto &[dst, pool] : pools) {
+    pool.advance(now, result);
+    on_event_interval(algorithm, pool, now, result);
+    pool.hit  = 0;
+    pool.miss = 0;
+  }
+}
+
+Result
+simulate(PreWarm::Algorithm algorithm, Trace const &trace)
+{
+  Result                      result;
+  std::map<std::string, Pool> pools;
+
+  // The pools are configured up front, as they are from sni.yaml.
+  for (auto const &request : trace) {
+    pools[request.dst];
+  }
+
+  int64_t next_tick = 0;
+  for (auto const &request : trace) {
+    while (next_tick <= request.time) {
+      tick(algorithm, pools, next_tick, result);
+      next_tick += event_period;
+    }
+
+    Pool &pool = pools[request.dst];
+    pool.advance(request.time, result);
+    if (pool.open_list.empty()) {
+      ++pool.miss;
+      ++result.miss;
+    } else {
+      pool.open_list.pop_front();
+      ++pool.hit;
+      ++result.hit;
+    }
+    on_dequeue(algorithm, pool, request.time, result);
+  }
+
+  return result;
+}
+
+// Requests of @a dst at @a rps(t) per second, from @a start to @a end, in seconds.
+template <typename F>
+void
+generate(Trace &trace, std::mt19937 &rng, std::string const &dst, int start, int end, F &&rps)
+{
+  for (int s = start; s < end; ++s) {
+    std::poisson_distribution<int>         count(rps(s));
+    std::uniform_int_distribution<int64_t> offset(0, 999);
+    for (int i = count(rng); i > 0; --i) {
+      trace.push_back({s * 1000 + offset(rng), dst});
+    }
+  }
+}
+
+Trace
+finish(Trace trace)
+{
+  std::stable_sort(trace.begin(), trace.end(), [](Request const &lhs, Request const &rhs) { return lhs.time < rhs.time; });
+  return trace;
+}
+
+Trace
+steady_trace()
+{
+  Trace        trace;
+  std::mt19937 rng{1};
+
+  generate(trace, rng, "a.example:443", 0, 600, [](int) { return 20.0; });
+  generate(trace, rng, "b.example:443", 0, 600, [](int) { return 5.0; });
+  return finish(std::move(trace));
+}
+
+// A morning peak: the demand ramps up over two minutes, holds, and ramps down.
+Trace
+ramp_trace()
+{
+  Trace        trace;
+  std::mt19937 rng{2};
+
+  generate(trace, rng, "a.example:443", 0, 600, [](int s) {
+    double peak = 200.0;
+    if (s < 120) {
+      return 2.0 + peak * s / 120;
+    } else if (s < 360) {
+      return 2.0 + peak;
+    } else if (s < 480) {
+      return 2.0 + peak * (480 - s) / 120;
+    }
+    return 2.0;
+  });
+  generate(trace, rng, "b.example:443", 0, 600, [](int) { return 5.0; });
+  return finish(std::move(trace));
+}
+
+// A live event: the demand jumps for half a minute.
+Trace
+spike_trace()
+{
+  Trace        trace;
+  std::mt19937 rng{3};
+
+  generate(trace, rng, "a.example:443", 0, 600, [](int s) { return (s >= 300 && s < 330) ? 300.0 : 10.0; });
+  generate(trace, rng, "b.example:443", 0, 600, [](int) { return 5.0; });
+  return finish(std::move(trace));
+}
+
+Trace
+load_trace(std::string const &path)
+{
+  Trace         trace;
+  std::ifstream in(path);
+  std::string   line;
+
+  REQUIRE(in.is_open());
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    Request            request;
+    if (fields >> request.time >> request.dst) {
+      trace.push_back(request);
+    }
+  }
+  return finish(std::move(trace));
+}
+
+void
+report(std::string const &name, Trace const &trace)
+{
+  std::printf("%s: %zu requests\n", name.c_str(), trace.size());
+  std::printf("  %-9s %10s %10s %10s %10s %10s\n", "algorithm", "hit", "miss", "hit rate", "opened", "wasted");
+  for (auto algorithm : {PreWarm::Algorithm::V1, PreWarm::Algorithm::V2, PreWarm::Algorithm::V3}) {
+    Result   r     = simulate(algorithm, trace);
+    uint64_t total = r.hit + r.miss;
+
+    std::printf("  v%-8d %10" PRIu64 " %10" PRIu64 " %9.2f%% %10" PRIu64 " %10" PRIu64 "\n", static_cast<int>(algorithm), r.hit,
+                r.miss, total ? 100.0 * r.hit / total : 0.0, r.opened, r.wasted);
+    CHECK(total == trace.size());
+  }
+}
+
+TEST_CASE("PreWarm algorithms", "")
+{
+  if (!trace_file.empty()) {
+    report(trace_file, load_trace(trace_file));
+    return;
+  }
+
+  SECTION("steady")
+  {
+    report("steady", steady_trace());
+  }
+  SECTION("ramp")
+  {
+    report("ramp", ramp_trace());
+  }
+  SECTION("spike")
+  {
+    report("spike", spike_trace());
+  }
+}
+
+TEST_CASE("PreWarm simulation cost", "")
+{
+  Trace trace = trace_file.empty() ? ramp_trace() : load_trace(trace_file);
+
+  BENCHMARK("v3")
+  {
+    return simulate(PreWarm::Algorithm::V3, trace).hit;
+  };
+}
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  auto cli = session.cli() |
+             Opt(trace_file, "path")["--ts-trace"]("trace to replay, \"<time in ms> <destination>\" per line\n"
+                                                   "(default: synthetic traces)") |
+             Opt(event_period, "ms")["--ts-event-period"]("proxy.config.tunnel.prewarm.event_period\n"
+                                                          "(default: 1000)") |
+             Opt(handshake_time, "ms")["--ts-handshake-time"]("time to open a connection\n"
+                                                              "(default: 50)") |
+             Opt(inactive_timeout, "s")["--ts-inactive-timeout"]("tunnel_prewarm_inactive_timeout\n"
+                                                                  "(default: 30)") |
+             Opt(min_size, "n")["--ts-min"]("tunnel_prewarm_min\n"
+                                            "(default: 0)") |
+             Opt(max_size, "n")["--ts-max"]("tunnel_prewarm_max\n"
+                                            "(default: -1)") |
+             Opt(rate, "r")["--ts-rate"]("tunnel_prewarm_rate\n"
+                                         "(default: 1.0)") |
+             Opt(budget, "n")["--ts-budget"]("proxy.config.tunnel.prewarm.max_connections for the thread\n"
+                                             "(default: 0)");
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}
@@ -0,0 +1,97 @@
+#!/usr/bin/env bash
+#
+#  Measure HTTP/3 download throughput and loss through an emulated
+#  bottleneck with a shallow buffer, for each proxy.config.udp.pacing mode.
+#
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+# This needs root, iproute2 with the ifb module, a curl built with HTTP/3
+# (see build_h3_tools.sh) and a running traffic_server that accepts QUIC on
+# all addresses and serves OBJECT_PATH, for instance from its cache.
+#
+# The client runs in its own network namespace behind a veth pair. The
+# bottleneck is netem on the ingress of the client, redirected through an
+# ifb device, so that the egress of traffic_server keeps the fq qdisc which
+# honors SO_TXTIME departure times.
+#
+#   BANDWIDTH=20mbit DELAY=40ms LIMIT=30 ./pacing_netem.sh
+
+set -e
+
+BANDWIDTH=${BANDWIDTH:-"50mbit"}
+DELAY=${DELAY:-"30ms"}
+LIMIT=${LIMIT:-"40"} # packets, the buffer at the bottleneck
+PORT=${PORT:-"4443"}
+OBJECT_PATH=${OBJECT_PATH:-"/10MB"}
+RUNS=${RUNS:-"5"}
+MODES=${MODES:-"0 1 2"}
+CURL=${CURL:-"curl"}
+TRAFFIC_CTL=${TRAFFIC_CTL:-"traffic_ctl"}
+
+NS=ats_pacing
+SERVER_ADDR=10.199.0.1
+CLIENT_ADDR=10.199.0.2
+
+cleanup() {
+  ip netns del ${NS} 2>/dev/null || true
+  ip link del ats_pacing0 2>/dev/null || true
+}
+trap cleanup EXIT
+
+cleanup
+ip netns add ${NS}
+ip link add ats_pacing0 type veth peer name ats_pacing1
+ip link set ats_pacing1 netns ${NS}
+ip addr add ${SERVER_ADDR}/24 dev ats_pacing0
+ip link set ats_pacing0 up
+tc qdisc replace dev ats_pacing0 root fq
+
+ip netns exec ${NS} ip addr add ${CLIENT_ADDR}/24 dev ats_pacing1
+ip netns exec ${NS} ip link set ats_pacing1 up
+ip netns exec ${NS} ip link set lo up
+ip netns exec ${NS} ip link add ifb0 type ifb
+ip netns exec ${NS} ip link set ifb0 up
+ip netns exec ${NS} tc qdisc add dev ats_pacing1 handle ffff: ingress
+ip netns exec ${NS} tc filter add dev ats_pacing1 parent ffff: matchall action mirred egress redirect dev ifb0
+ip netns exec ${NS} tc qdisc add dev ifb0 root netem delay ${DELAY} rate ${BANDWIDTH} limit ${LIMIT}
+
+# Sent and dropped packets of the bottleneck
+bottleneck_counters() {
+  ip netns exec ${NS} tc -s qdisc show dev ifb0 | awk '/Sent/ { gsub(",", ""); print $4, $7 }'
+}
+
+printf "%-6s %14s %10s\n" "pacing" "Mbit/s" "loss %"
+for mode in ${MODES}; do
+  ${TRAFFIC_CTL} config set proxy.config.udp.pacing ${mode} >/dev/null
+  ${TRAFFIC_CTL} server restart >/dev/null
+  sleep 3
+
+  read -r sent_before dropped_before <<<"$(bottleneck_counters)"
+  total=0
+  for _ in $(seq ${RUNS}); do
+    bps=$(ip netns exec ${NS} ${CURL} -sk --http3-only -o /dev/null -w '%{speed_download}' \
+      "https://${SERVER_ADDR}:${PORT}${OBJECT_PATH}")
+    total=$(echo "${total} + ${bps}" | bc -l)
+  done
+  read -r sent_after dropped_after <<<"$(bottleneck_counters)"
+
+  sent=$((sent_after - sent_before))
+  dropped=$((dropped_after - dropped_before))
+  mbps=$(echo "${total} * 8 / ${RUNS} / 1000000" | bc -l)
+  loss=$(echo "${dropped} * 100 / (${sent} + ${dropped} + 1)" | bc -l)
+  printf "%-6s %14.2f %10.3f\n" "${mode}" "${mbps}" "${loss}"
+done